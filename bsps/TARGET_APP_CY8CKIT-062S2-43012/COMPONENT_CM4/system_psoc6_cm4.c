@@ -338,6 +338,8 @@ void Cy_SystemInitFpuEnable(void)
     #include "cy_pra.h"
 #endif /* defined(CY_DEVICE_SECURE) */
 
+#include "cybsp_boot.h"
+
 
 /*******************************************************************************
 * SystemCoreClockUpdate()
@@ -398,6 +400,8 @@ uint8_t cy_delayFreqMhz  = (uint8_t)CY_SYSLIB_DIV_ROUNDUP(CY_CLK_SYSTEM_FREQ_HZ_
 
 void SystemInit(void)
 {
+    cybsp_boot_mark(CYBSP_BOOT_DATA_INIT);
+
     Cy_PDL_Init(CY_DEVICE_CFG);
 
 #ifdef __CM0P_PRESENT
@@ -506,6 +510,8 @@ void SystemInit(void)
     /* Initialize Protected Register Access driver */
     Cy_PRA_Init();
 #endif /* defined(CY_DEVICE_SECURE) */
+
+    cybsp_boot_mark(CYBSP_BOOT_SYSTEM_INIT);
 }
 
 
@@ -36,6 +36,17 @@ BSP_COMPONENTS:=CM0P_SLEEP WIFI_INTERFACE_SDIO
 # Any additional defines to apply when using this board.
 BSP_DEFINES:=CY_USING_HAL
 
+# CYBSP_OVERLAP_CLOCK_LOCK: cybsp_clock.c wraps the PDL calls of the generated
+# init_cycfg_system() that wait for the WCO, FLL and PLLs. A call is wrapped
+# only if it reaches the linker, not if it is inlined, so the linker lists
+# every object that references a wrapper: cycfg_system.o must be among them.
+CYBSP_CLOCK_WRAPS=Cy_SysClk_WcoEnable Cy_SysClk_ClkLfSetSource Cy_SysClk_FllEnable \
+                  Cy_SysClk_ClkHfSetSource Cy_SysClk_PllEnable
+ifneq ($(filter CYBSP_OVERLAP_CLOCK_LOCK,$(DEFINES)),)
+LDFLAGS+=$(foreach fn,$(CYBSP_CLOCK_WRAPS),-Wl,--wrap=$(fn))
+LDFLAGS+=$(foreach fn,$(CYBSP_CLOCK_WRAPS),-Wl,--trace-symbol=__wrap_$(fn))
+endif
+
 ################################################################################
 # ALL ITEMS BELOW THIS POINT ARE AUTO GENERATED BY THE BSP ASSISTANT TOOL.
 # DO NOT MODIFY DIRECTLY. CHANGES SHOULD BE MADE THROUGH THE BSP ASSISTANT.
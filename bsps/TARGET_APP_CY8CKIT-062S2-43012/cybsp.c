@@ -26,9 +26,12 @@
 *******************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 #include "cy_syspm.h"
 #include "cy_sysclk.h"
 #include "cybsp.h"
+#include "cybsp_clock.h"
+#include "cycfg.h"
 #if defined(CY_USING_HAL)
 #include "cyhal_hwmgr.h"
 #include "cyhal_syspm.h"
@@ -53,7 +56,64 @@ extern "C" {
     #define CYBSP_SYSCLK_PM_CALLBACK_ORDER  (255u)
 #endif
 
+#define CYBSP_CONFIG_BIT(config)    (1UL << (uint32_t)(config))
+#define CYBSP_CONFIG_ALL            (CYBSP_CONFIG_BIT(CYBSP_CONFIG_COUNT) - 1UL)
+
+// Init thunk of a board configuration subsystem and the subsystems that must be applied before it
+typedef struct
+{
+    void     (*init)(void);
+    uint32_t depends;
+} cybsp_config_thunk_t;
+
+// The dependencies keep the order of cycfg_config_init(): the SWO pin needs the trace clock divider
+// and the CSD clock assignment needs the CSD divider
+static const cybsp_config_thunk_t cybsp_config_thunks[CYBSP_CONFIG_COUNT] =
+{
+    [CYBSP_CONFIG_CLOCKS]      = { init_cycfg_clocks,      0UL                                   },
+    [CYBSP_CONFIG_ROUTING]     = { init_cycfg_routing,     0UL                                   },
+    [CYBSP_CONFIG_PERIPHERALS] = { init_cycfg_peripherals, CYBSP_CONFIG_BIT(CYBSP_CONFIG_CLOCKS) },
+    [CYBSP_CONFIG_PINS]        = { init_cycfg_pins,        CYBSP_CONFIG_BIT(CYBSP_CONFIG_CLOCKS) |
+                                   CYBSP_CONFIG_BIT(CYBSP_CONFIG_ROUTING) },
+    [CYBSP_CONFIG_CLK_LF]      = { cybsp_clock_lf_init,    0UL                                   }
+};
+
+// Registered power management handlers, in registration order
+static cybsp_pm_handler_t* cybsp_pm_first = NULL;
+static cybsp_pm_handler_t* cybsp_pm_last  = NULL;
+
+// Set while the system clock handler has switched the CPU to the IMO for deep sleep
+static bool cybsp_pm_on_imo = false;
+
+// Subsystems that init_cycfg_system() applies unless cybsp_clock.c defers them
+#if defined(CYBSP_OVERLAP_CLOCK_LOCK)
+    #define CYBSP_CONFIG_SYSTEM     (0UL)
+#else
+    #define CYBSP_CONFIG_SYSTEM     CYBSP_CONFIG_BIT(CYBSP_CONFIG_CLK_LF)
+#endif
+
+// Subsystems that have been applied
+static uint32_t cybsp_config_done = 0UL;
+
+// The power management handlers are timed with the DWT cycle counter of the CM4
+#if (__CORTEX_M == 4U)
+    #define CYBSP_PM_CYCLES()       (DWT->CYCCNT)
+#else
+    #define CYBSP_PM_CYCLES()       (0UL)
+#endif
+
 #if !defined(CYBSP_CUSTOM_SYSCLK_PM_CALLBACK)
+// Switches the CPU to the IMO on deep sleep entry and locks the FLL again on exit
+static cybsp_pm_handler_t cybsp_sysclk_pm_handler =
+{
+    .name     = "sysclk",
+    .callback = &Cy_SysClk_DeepSleepCallback,
+    .type     = CY_SYSPM_DEEPSLEEP,
+    .params   = { NULL, NULL },
+    .order    = CYBSP_SYSCLK_PM_CALLBACK_ORDER
+};
+
+
 //--------------------------------------------------------------------------------------------------
 // cybsp_register_sysclk_pm_callback
 //
@@ -63,17 +123,9 @@ extern "C" {
 //--------------------------------------------------------------------------------------------------
 static cy_rslt_t cybsp_register_sysclk_pm_callback(void)
 {
-    cy_rslt_t                             result                         = CY_RSLT_SUCCESS;
-    static cy_stc_syspm_callback_params_t cybsp_sysclk_pm_callback_param = { NULL, NULL };
-    static cy_stc_syspm_callback_t        cybsp_sysclk_pm_callback       =
-    {
-        .callback       = &Cy_SysClk_DeepSleepCallback,
-        .type           = CY_SYSPM_DEEPSLEEP,
-        .callbackParams = &cybsp_sysclk_pm_callback_param,
-        .order          = CYBSP_SYSCLK_PM_CALLBACK_ORDER
-    };
+    cy_rslt_t result = cybsp_pm_register(&cybsp_sysclk_pm_handler);
 
-    if (!Cy_SysPm_RegisterCallback(&cybsp_sysclk_pm_callback))
+    if (CY_RSLT_SUCCESS != result)
     {
         result = CYBSP_RSLT_ERR_SYSCLK_PM_CALLBACK;
     }
@@ -84,6 +136,98 @@ static cy_rslt_t cybsp_register_sysclk_pm_callback(void)
 #endif // if !defined(CYBSP_CUSTOM_SYSCLK_PM_CALLBACK)
 
 
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_find
+//
+// Returns the registered handler of a low power mode with the given name, or NULL.
+//--------------------------------------------------------------------------------------------------
+static cybsp_pm_handler_t* cybsp_pm_find(const char* name, cy_en_syspm_callback_type_t type)
+{
+    cybsp_pm_handler_t* handler = cybsp_pm_first;
+
+    while ((NULL != handler) && ((handler->type != type) || (0 != strcmp(handler->name, name))))
+    {
+        handler = handler->next;
+    }
+    return handler;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_timed_callback
+//
+// SysPm callback of every registered handler: calls the driver callback and records its run time.
+// It runs with interrupts disabled. The cycles are counted at the CPU clock, which is the IMO from
+// the system clock handler's deep sleep entry until its exit.
+//--------------------------------------------------------------------------------------------------
+static cy_en_syspm_status_t cybsp_pm_timed_callback(cy_stc_syspm_callback_params_t* callbackParams,
+                                                    cy_en_syspm_callback_mode_t mode)
+{
+    cybsp_pm_handler_t*  handler = (cybsp_pm_handler_t*)callbackParams->context;
+    uint32_t             clock_mhz;
+    uint32_t             start;
+    uint32_t             cycles;
+    cybsp_pm_phase_t     phase;
+    cybsp_pm_timing_t*   timing;
+    cy_en_syspm_status_t status;
+
+    clock_mhz = (cybsp_pm_on_imo ? CY_SYSCLK_IMO_FREQ : SystemCoreClock) / 1000000UL;
+    start     = CYBSP_PM_CYCLES();
+    status    = handler->callback(&handler->params, mode);
+    cycles    = CYBSP_PM_CYCLES() - start;
+
+    #if !defined(CYBSP_CUSTOM_SYSCLK_PM_CALLBACK)
+    if (handler == &cybsp_sysclk_pm_handler)
+    {
+        cybsp_pm_on_imo = (CY_SYSPM_BEFORE_TRANSITION == mode) && (CY_SYSPM_SUCCESS == status);
+    }
+    #endif
+
+    switch (mode)
+    {
+        case CY_SYSPM_CHECK_READY:
+            phase = CYBSP_PM_PHASE_CHECK;
+            break;
+
+        case CY_SYSPM_BEFORE_TRANSITION:
+            phase = CYBSP_PM_PHASE_ENTRY;
+            break;
+
+        case CY_SYSPM_AFTER_TRANSITION:
+            phase = CYBSP_PM_PHASE_EXIT;
+            break;
+
+        default:
+            // CHECK_FAIL undoes a CHECK_READY and is not on the transition path
+            phase = CYBSP_PM_PHASE_COUNT;
+            break;
+    }
+
+    if ((CYBSP_PM_PHASE_COUNT != phase) && (0UL != clock_mhz))
+    {
+        timing          = &handler->timing[phase];
+        timing->last_ns = (uint32_t)(((uint64_t)cycles * 1000UL) / clock_mhz);
+        timing->count++;
+        if (timing->last_ns > timing->max_ns)
+        {
+            timing->max_ns = timing->last_ns;
+        }
+    }
+    return status;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_boot_mark
+//
+// Default startup stage hook, replaced by the application to profile the startup.
+//--------------------------------------------------------------------------------------------------
+__WEAK void cybsp_boot_mark(uint32_t stage)
+{
+    CY_UNUSED_PARAMETER(stage);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 // cybsp_init
 //--------------------------------------------------------------------------------------------------
@@ -93,10 +237,12 @@ cy_rslt_t cybsp_init(void)
     // Setup hardware manager to track resource usage then initialize all system (clock/power) board
     // configuration
     cy_rslt_t result = cyhal_hwmgr_init();
+    cybsp_boot_mark(CYBSP_BOOT_HWMGR);
 
     if (CY_RSLT_SUCCESS == result)
     {
         result = cyhal_syspm_init();
+        cybsp_boot_mark(CYBSP_BOOT_SYSPM);
     }
     #else // if defined(CY_USING_HAL)
     cy_rslt_t result = CY_RSLT_SUCCESS;
@@ -123,7 +269,23 @@ cy_rslt_t cybsp_init(void)
     // the CM4 if necessary.
     #if defined(CORE_NAME_CM0P_0) || !(__CM0P_PRESENT) || (defined(CORE_NAME_CM4_0) && \
     defined(CY_USING_PREBUILT_CM0P_IMAGE))
+    #if defined(CYBSP_LAZY_CONFIG)
+    // The other subsystems are applied on first use by cybsp_config_require()
+    cybsp_clock_overlap_begin();
+    init_cycfg_system();
+    cybsp_clock_overlap_end();
+    cybsp_config_done = CYBSP_CONFIG_SYSTEM;
+    #else
+    cybsp_clock_overlap_begin();
     cycfg_config_init();
+    cybsp_clock_overlap_end();
+    cybsp_config_done = CYBSP_CONFIG_ALL & ~CYBSP_CONFIG_BIT(CYBSP_CONFIG_CLK_LF);
+    cybsp_config_done |= CYBSP_CONFIG_SYSTEM;
+    #endif
+    cybsp_boot_mark(CYBSP_BOOT_CYCFG);
+    #else
+    // Configured by the other core
+    cybsp_config_done = CYBSP_CONFIG_ALL;
     #endif
 
     // Do any additional configuration reservations that are needed on all cores.
@@ -151,13 +313,148 @@ cy_rslt_t cybsp_init(void)
     }
     #endif // defined(CYBSP_WIFI_CAPABLE) && defined(CYHAL_UDB_SIO) && defined(CY_USING_HAL)
 
+    #if !defined(CYBSP_LAZY_CONFIG)
+    // With CYBSP_OVERLAP_CLOCK_LOCK, the WCO has been starting up since init_cycfg_system()
+    cybsp_config_require(CYBSP_CONFIG_CLK_LF);
+    #endif
+
     // CYHAL_HWMGR_RSLT_ERR_INUSE error code could be returned if any needed for BSP resource was
     // reserved by user previously. Please review the Device Configurator (design.modus) and the BSP
     // reservation list (cyreservedresources.list) to make sure no resources are reserved by both.
+    cybsp_boot_mark(CYBSP_BOOT_CYBSP);
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_config_require
+//--------------------------------------------------------------------------------------------------
+void cybsp_config_require(cybsp_config_t config)
+{
+    const cybsp_config_thunk_t* thunk = &cybsp_config_thunks[config];
+
+    if (0UL == (cybsp_config_done & CYBSP_CONFIG_BIT(config)))
+    {
+        for (uint32_t depend = 0UL; depend < (uint32_t)CYBSP_CONFIG_COUNT; depend++)
+        {
+            if (0UL != (thunk->depends & CYBSP_CONFIG_BIT(depend)))
+            {
+                cybsp_config_require((cybsp_config_t)depend);
+            }
+        }
+
+        thunk->init();
+        cybsp_config_done |= CYBSP_CONFIG_BIT(config);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_register
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_pm_register(cybsp_pm_handler_t* handler)
+{
+    cy_rslt_t                 result = CY_RSLT_SUCCESS;
+    const cybsp_pm_handler_t* after;
+
+    if (NULL != handler->after)
+    {
+        after = cybsp_pm_find(handler->after, handler->type);
+        if ((NULL == after) || (after->order > handler->order))
+        {
+            result = CYBSP_RSLT_ERR_PM_ORDER;
+        }
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        // Start the cycle counter unless it is already running. It is not cleared, the application
+        // may count from reset.
+        #if (__CORTEX_M == 4U)
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+        #endif
+
+        (void)memset(handler->timing, 0, sizeof(handler->timing));
+        handler->pdl_params.base    = NULL;
+        handler->pdl_params.context = handler;
+        handler->pdl.callback       = &cybsp_pm_timed_callback;
+        handler->pdl.type           = handler->type;
+        handler->pdl.skipMode       = handler->skip_mode;
+        handler->pdl.callbackParams = &handler->pdl_params;
+        handler->pdl.prevItm        = NULL;
+        handler->pdl.nextItm        = NULL;
+        handler->pdl.order          = handler->order;
+        handler->next               = NULL;
+
+        if (!Cy_SysPm_RegisterCallback(&handler->pdl))
+        {
+            result = CYBSP_RSLT_ERR_PM_CALLBACK;
+        }
+    }
+
+    if (CY_RSLT_SUCCESS == result)
+    {
+        if (NULL == cybsp_pm_last)
+        {
+            cybsp_pm_first = handler;
+        }
+        else
+        {
+            cybsp_pm_last->next = handler;
+        }
+        cybsp_pm_last = handler;
+    }
     return result;
 }
 
 
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_next
+//--------------------------------------------------------------------------------------------------
+const cybsp_pm_handler_t* cybsp_pm_next(const cybsp_pm_handler_t* handler)
+{
+    return (NULL == handler) ? cybsp_pm_first : handler->next;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_budget
+//--------------------------------------------------------------------------------------------------
+void cybsp_pm_budget(cy_en_syspm_callback_type_t type, uint32_t* entry_ns, uint32_t* exit_ns)
+{
+    const cybsp_pm_handler_t* handler;
+
+    *entry_ns = 0UL;
+    *exit_ns  = 0UL;
+    for (handler = cybsp_pm_first; NULL != handler; handler = handler->next)
+    {
+        if (handler->type == type)
+        {
+            *entry_ns += handler->timing[CYBSP_PM_PHASE_CHECK].max_ns +
+                         handler->timing[CYBSP_PM_PHASE_ENTRY].max_ns;
+            *exit_ns  += handler->timing[CYBSP_PM_PHASE_EXIT].max_ns;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_reset
+//--------------------------------------------------------------------------------------------------
+void cybsp_pm_reset(void)
+{
+    cybsp_pm_handler_t* handler;
+    uint32_t            interruptState = Cy_SysLib_EnterCriticalSection();
+
+    for (handler = cybsp_pm_first; NULL != handler; handler = handler->next)
+    {
+        (void)memset(handler->timing, 0, sizeof(handler->timing));
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+
 #if defined(__cplusplus)
 }
 #endif
@@ -27,7 +27,9 @@
 #pragma once
 
 #include "cy_result.h"
+#include "cy_syspm.h"
 #include "cybsp_types.h"
+#include "cybsp_boot.h"
 #include "cybsp_hw_config.h"
 #if defined(COMPONENT_WICED_BLE) || defined(COMPONENT_WICED_DUALMODE)
 #include "cybsp_bt_config.h"
@@ -47,8 +49,71 @@ extern "C" {
 #define CYBSP_RSLT_ERR_SYSCLK_PM_CALLBACK  \
     (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 0))
 
+/** Failed to register a power management handler with the SysPm driver */
+#define CYBSP_RSLT_ERR_PM_CALLBACK  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 1))
+
+/** A power management handler declares a predecessor that is not registered before it */
+#define CYBSP_RSLT_ERR_PM_ORDER  \
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_ABSTRACTION_BSP, 2))
+
 /** \} group_bsp_errors */
 
+/**
+ * Board configuration subsystems of the Device Configurator that can be applied on first use, see
+ * \ref cybsp_config_require. The system configuration (power, clock paths, FLL and PLLs) is always
+ * applied by \ref cybsp_init.
+ */
+typedef enum
+{
+    CYBSP_CONFIG_CLOCKS,        //!< Peripheral clock dividers, init_cycfg_clocks()
+    CYBSP_CONFIG_ROUTING,       //!< Analog routing, init_cycfg_routing()
+    CYBSP_CONFIG_PERIPHERALS,   //!< Peripheral clock assignments, init_cycfg_peripherals()
+    CYBSP_CONFIG_PINS,          //!< Pin configurations, init_cycfg_pins()
+    CYBSP_CONFIG_CLK_LF,        //!< CLK_LF on the WCO, cybsp_clock_lf_init()
+    CYBSP_CONFIG_COUNT          //!< Number of subsystems, not a valid subsystem
+} cybsp_config_t;
+
+/** Transition phases of a power management handler that are timed */
+typedef enum
+{
+    CYBSP_PM_PHASE_CHECK,       //!< CY_SYSPM_CHECK_READY
+    CYBSP_PM_PHASE_ENTRY,       //!< CY_SYSPM_BEFORE_TRANSITION
+    CYBSP_PM_PHASE_EXIT,        //!< CY_SYSPM_AFTER_TRANSITION
+    CYBSP_PM_PHASE_COUNT        //!< Number of phases, not a valid phase
+} cybsp_pm_phase_t;
+
+/** Run time of a power management handler in one phase */
+typedef struct
+{
+    uint32_t count;             //!< Calls since registration or \ref cybsp_pm_reset
+    uint32_t last_ns;           //!< Run time of the last call
+    uint32_t max_ns;            //!< Longest run time
+} cybsp_pm_timing_t;
+
+/**
+ * Power management handler of a driver, registered with \ref cybsp_pm_register. The driver fills
+ * in the fields up to `after` and keeps the handler in static storage; the registry owns the rest.
+ */
+typedef struct cybsp_pm_handler
+{
+    const char*                    name;        //!< Unique name, for the report and `after`
+    Cy_SysPmCallback               callback;    //!< PDL callback of the driver
+    cy_en_syspm_callback_type_t    type;        //!< Low power mode, such as CY_SYSPM_DEEPSLEEP
+    uint32_t                       skip_mode;   //!< CY_SYSPM_SKIP_* modes not to call it for
+    cy_stc_syspm_callback_params_t params;      //!< Passed to the callback
+    uint8_t                        order;       //!< PDL callback order: before the transition
+                                                //!< lower orders run first, after it last
+    const char*                    after;       //!< Handler of the same type that must run before
+                                                //!< this one on entry, and so after it on exit,
+                                                //!< or NULL
+
+    cybsp_pm_timing_t              timing[CYBSP_PM_PHASE_COUNT]; //!< Run time of each phase
+    cy_stc_syspm_callback_params_t pdl_params;  //!< Parameters of the timing wrapper
+    cy_stc_syspm_callback_t        pdl;         //!< Callback registered with the SysPm driver
+    struct cybsp_pm_handler*       next;        //!< Next handler in registration order
+} cybsp_pm_handler_t;
+
 /**
  * \addtogroup group_bsp_functions Functions
  * \{
@@ -63,6 +128,60 @@ extern "C" {
  */
 cy_rslt_t cybsp_init(void);
 
+//--------------------------------------------------------------------------------------------------
+// cybsp_config_require
+//
+// Applies a board configuration subsystem, after the subsystems it depends on, unless this has been
+// done already. When `CYBSP_LAZY_CONFIG` is defined, \ref cybsp_init only applies the system
+// configuration and makes the resource reservations of all subsystems; a driver that relies on a
+// Device Configurator setting, such as CapSense or SWO trace, calls this before its first use.
+// Otherwise all subsystems are applied by \ref cybsp_init and this does nothing. It must not be
+// called from an interrupt.
+//
+// When `CYBSP_OVERLAP_CLOCK_LOCK` is defined, the system configuration does not wait for the WCO
+// crystal to start. CLK_LF stays on the ILO until `CYBSP_CONFIG_CLK_LF` is required, which waits
+// for the WCO; without `CYBSP_LAZY_CONFIG` this is done at the end of \ref cybsp_init.
+//--------------------------------------------------------------------------------------------------
+void cybsp_config_require(cybsp_config_t config);
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_register
+//
+// Registers the power management handler of a driver with the SysPm driver, wrapped so that the
+// run time of every call is recorded. The handler runs in the PDL order of its `order` field, with
+// handlers of the same order in registration order. If `after` names a handler, that handler must
+// already be registered for the same low power mode with an order not above this one, which makes
+// the PDL run it first on entry and last on exit; otherwise CYBSP_RSLT_ERR_PM_ORDER is returned.
+// \ref cybsp_init registers the system clock handler as "sysclk", at order 255.
+//--------------------------------------------------------------------------------------------------
+cy_rslt_t cybsp_pm_register(cybsp_pm_handler_t* handler);
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_next
+//
+// Returns the registered handler after `handler`, or the first one if `handler` is NULL, in
+// registration order. Returns NULL after the last one.
+//--------------------------------------------------------------------------------------------------
+const cybsp_pm_handler_t* cybsp_pm_next(const cybsp_pm_handler_t* handler);
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_budget
+//
+// Returns the worst-case time in ns spent in the handlers on entry to and exit from a low power
+// mode: the sum of the longest CHECK_READY and BEFORE_TRANSITION calls of every handler of that
+// mode, and the sum of their longest AFTER_TRANSITION calls. Handlers that run while the system
+// clock handler has the CPU on the IMO are timed at the IMO frequency; the run time of the system
+// clock handler's exit, which locks the FLL again, is an upper bound.
+//--------------------------------------------------------------------------------------------------
+void cybsp_pm_budget(cy_en_syspm_callback_type_t type, uint32_t* entry_ns, uint32_t* exit_ns);
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_pm_reset
+//
+// Clears the run times of all registered handlers.
+//--------------------------------------------------------------------------------------------------
+void cybsp_pm_reset(void);
+
 #if defined(CYBSP_CUSTOM_SYSCLK_PM_CALLBACK)
 //--------------------------------------------------------------------------------------------------
 // cybsp_register_custom_sysclk_pm_callback
@@ -70,7 +189,9 @@ cy_rslt_t cybsp_init(void);
 // Registers a power management callback that prepares the clock system for entering deep sleep mode
 // and restore the clocks upon wakeup from deep sleep. The application should implement this
 // function and define `CYBSP_CUSTOM_SYSCLK_PM_CALLBACK` if it needs to replace the default SysClk
-// DeepSleep callback behavior with application specific logic.
+// DeepSleep callback behavior with application specific logic. Registering it with
+// \ref cybsp_pm_register under the name "sysclk" keeps the handlers that declare it as `after`
+// working.
 // NOTE: This is called automatically as part of \ref cybsp_init
 //--------------------------------------------------------------------------------------------------
 cy_rslt_t cybsp_register_custom_sysclk_pm_callback(void);
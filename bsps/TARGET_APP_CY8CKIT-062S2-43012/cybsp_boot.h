@@ -0,0 +1,59 @@
+/***********************************************************************************************//**
+ * \file cybsp_boot.h
+ *
+ * \brief
+ * Startup stages that the BSP marks, for a boot time profiler of the application.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2018-2022 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * Startup stages that the BSP marks through \ref cybsp_boot_mark, in the order they end
+ */
+typedef enum
+{
+    CYBSP_BOOT_DATA_INIT,       //!< .data copied and .bss cleared, SystemInit() entered
+    CYBSP_BOOT_SYSTEM_INIT,     //!< SystemInit()
+    CYBSP_BOOT_HWMGR,           //!< cyhal_hwmgr_init() in \ref cybsp_init
+    CYBSP_BOOT_SYSPM,           //!< cyhal_syspm_init() in \ref cybsp_init
+    CYBSP_BOOT_CYCFG,           //!< Device Configurator settings applied by \ref cybsp_init
+    CYBSP_BOOT_CYBSP            //!< Rest of \ref cybsp_init
+} cybsp_boot_stage_t;
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_boot_mark
+//
+// Called by the BSP at the end of each startup stage with a \ref cybsp_boot_stage_t. The BSP
+// provides a weak definition that does nothing; an application that profiles its startup defines
+// its own. The first two stages end before main(), so it must not rely on the C library.
+//--------------------------------------------------------------------------------------------------
+void cybsp_boot_mark(uint32_t stage);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
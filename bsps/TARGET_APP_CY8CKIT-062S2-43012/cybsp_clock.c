@@ -0,0 +1,345 @@
+/***************************************************************************//**
+* \file cybsp_clock.c
+*
+* Description:
+* Starts the WCO, FLL and PLLs of the generated system configuration together
+* and lets the rest of the board initialization run while they lock.
+*
+********************************************************************************
+* \copyright
+* Copyright 2018-2022 Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation
+*
+* SPDX-License-Identifier: Apache-2.0
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include "cy_device_headers.h"
+#include "cy_sysclk.h"
+#include "cy_syslib.h"
+#include "cy_wdt.h"
+#include "cybsp_clock.h"
+#include "cycfg_system.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+#if defined(CYBSP_OVERLAP_CLOCK_LOCK)
+
+// The generated init_cycfg_system() is left as the Device Configurator writes it. bsp.mk links it
+// with --wrap for the PDL calls that wait for a clock, and the wrappers below turn those calls into
+// a start while cybsp_clock_overlap_begin() is in effect. Calls from anywhere else, and all calls
+// outside of cybsp_init(), go straight to the PDL.
+#if !defined(__GNUC__)
+    #error "CYBSP_OVERLAP_CLOCK_LOCK needs the --wrap option of the GNU linker"
+#endif
+#if defined(CY_DEVICE_SECURE)
+    #error "CYBSP_OVERLAP_CLOCK_LOCK does not support the secure device configuration through PRA"
+#endif
+
+// CLK_HF0 runs from the IMO on this path while the FLL locks. Path 0 has the FLL and paths 1 to
+// SRSS_NUM_PLL have the PLLs, so it is the first path after them.
+#define CYBSP_CLOCK_PARK_PATH       (SRSS_NUM_PLL + 1UL)
+#define CYBSP_CLOCK_PARK_HF_IN      ((cy_en_clkhf_in_sources_t)CYBSP_CLOCK_PARK_PATH)
+
+#if (SRSS_NUM_PLL + 1UL) >= SRSS_NUM_CLKPATH
+    #error "CYBSP_OVERLAP_CLOCK_LOCK needs a clock path without the FLL or a PLL to park CLK_HF0"
+#endif
+#if defined(CY_CFG_SYSCLK_CLKHF0_CLKPATH_NUM) && (CY_CFG_SYSCLK_CLKHF0_CLKPATH_NUM != 0UL)
+    #error "CYBSP_OVERLAP_CLOCK_LOCK expects CLK_HF0 to run from the FLL on CLK_PATH0"
+#endif
+// The other CLK_HF clocks are not parked, so they must not run from the parking path or a PLL
+#if defined(srss_0_clock_0_hfclk_1_ENABLED) || defined(srss_0_clock_0_hfclk_2_ENABLED) || \
+    defined(srss_0_clock_0_hfclk_3_ENABLED) || defined(srss_0_clock_0_hfclk_4_ENABLED)
+    #error "CYBSP_OVERLAP_CLOCK_LOCK only handles CLK_HF0"
+#endif
+
+// Error codes of cycfg_ClockStartupError() in cycfg_system.c
+#define CYBSP_CLOCK_PLL_ERROR       (3UL)
+#define CYBSP_CLOCK_FLL_ERROR       (4UL)
+#define CYBSP_CLOCK_WCO_ERROR       (5UL)
+
+// The timeouts that init_cycfg_system() passes to the PDL
+#define CYBSP_CLOCK_WCO_TIMEOUT_US  (1000000UL)
+#define CYBSP_CLOCK_FLL_TIMEOUT_US  (200000UL)
+#define CYBSP_CLOCK_PLL_TIMEOUT_US  (10000UL)
+
+void cycfg_ClockStartupError(uint32_t error);
+
+cy_en_sysclk_status_t __real_Cy_SysClk_WcoEnable(uint32_t timeoutus);
+void __real_Cy_SysClk_ClkLfSetSource(cy_en_clklf_in_sources_t source);
+cy_en_sysclk_status_t __real_Cy_SysClk_FllEnable(uint32_t timeoutus);
+cy_en_sysclk_status_t __real_Cy_SysClk_ClkHfSetSource(uint32_t clkHf,
+                                                      cy_en_clkhf_in_sources_t source);
+cy_en_sysclk_status_t __real_Cy_SysClk_PllEnable(uint32_t clkPath, uint32_t timeoutus);
+
+// Set between cybsp_clock_overlap_begin() and cybsp_clock_overlap_end()
+static bool cybsp_clock_overlap = false;
+
+// The WCO has been enabled and CLK_LF waits for it in cybsp_clock_lf_init()
+static bool cybsp_clock_wco_started = false;
+static bool cybsp_clock_lf_pending  = false;
+static cy_en_clklf_in_sources_t cybsp_clock_lf_source;
+
+// The FLL has been enabled, CLK_HF0 is parked and its switch to CLK_PATH0 is pending
+static bool cybsp_clock_fll_started = false;
+static bool cybsp_clock_hf0_pending = false;
+static cy_en_clkpath_in_sources_t cybsp_clock_park_source;
+
+// Paths of the PLLs that have been enabled and not waited for
+static uint32_t cybsp_clock_pll_started = 0UL;
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_wait
+//
+// Polls a lock or ready status every microsecond and reports a clock startup error on timeout
+//--------------------------------------------------------------------------------------------------
+static void cybsp_clock_wait(bool (*ready)(uint32_t arg), uint32_t arg, uint32_t timeoutus,
+                             uint32_t error)
+{
+    while (!ready(arg))
+    {
+        if (0UL == timeoutus--)
+        {
+            cycfg_ClockStartupError(error);
+        }
+        Cy_SysLib_DelayUs(1U);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_wco_ready, cybsp_clock_fll_ready, cybsp_clock_pll_ready
+//--------------------------------------------------------------------------------------------------
+static bool cybsp_clock_wco_ready(uint32_t arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+    return Cy_SysClk_WcoOkay();
+}
+
+
+static bool cybsp_clock_fll_ready(uint32_t arg)
+{
+    CY_UNUSED_PARAMETER(arg);
+    return Cy_SysClk_FllLocked();
+}
+
+
+static bool cybsp_clock_pll_ready(uint32_t clkPath)
+{
+    return Cy_SysClk_PllLocked(clkPath);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// __wrap_Cy_SysClk_WcoEnable
+//
+// Enables the crystal without waiting for it to start
+//--------------------------------------------------------------------------------------------------
+cy_en_sysclk_status_t __wrap_Cy_SysClk_WcoEnable(uint32_t timeoutus)
+{
+    cy_en_sysclk_status_t result;
+
+    if (cybsp_clock_overlap)
+    {
+        (void)__real_Cy_SysClk_WcoEnable(0UL);
+        cybsp_clock_wco_started = true;
+        result = CY_SYSCLK_SUCCESS;
+    }
+    else
+    {
+        result = __real_Cy_SysClk_WcoEnable(timeoutus);
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// __wrap_Cy_SysClk_ClkLfSetSource
+//
+// Keeps CLK_LF on the ILO until the WCO it is switched to has started
+//--------------------------------------------------------------------------------------------------
+void __wrap_Cy_SysClk_ClkLfSetSource(cy_en_clklf_in_sources_t source)
+{
+    if (cybsp_clock_overlap && cybsp_clock_wco_started && (CY_SYSCLK_CLKLF_IN_WCO == source))
+    {
+        cybsp_clock_lf_source  = source;
+        cybsp_clock_lf_pending = true;
+    }
+    else
+    {
+        __real_Cy_SysClk_ClkLfSetSource(source);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// __wrap_Cy_SysClk_FllEnable
+//
+// A zero timeout selects the FLL output before it has locked, so CLK_HF0 is first parked on the
+// IMO through a path without the FLL
+//--------------------------------------------------------------------------------------------------
+cy_en_sysclk_status_t __wrap_Cy_SysClk_FllEnable(uint32_t timeoutus)
+{
+    cy_en_sysclk_status_t result;
+
+    if (cybsp_clock_overlap)
+    {
+        cybsp_clock_park_source = Cy_SysClk_ClkPathGetSource(CYBSP_CLOCK_PARK_PATH);
+        Cy_SysClk_ClkPathSetSource(CYBSP_CLOCK_PARK_PATH, CY_SYSCLK_CLKPATH_IN_IMO);
+        (void)__real_Cy_SysClk_ClkHfSetSource(0UL, CYBSP_CLOCK_PARK_HF_IN);
+        result = __real_Cy_SysClk_FllEnable(0UL);
+        cybsp_clock_fll_started = (CY_SYSCLK_SUCCESS == result);
+    }
+    else
+    {
+        result = __real_Cy_SysClk_FllEnable(timeoutus);
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// __wrap_Cy_SysClk_ClkHfSetSource
+//
+// Defers the switch of CLK_HF0 to the FLL until it has locked
+//--------------------------------------------------------------------------------------------------
+cy_en_sysclk_status_t __wrap_Cy_SysClk_ClkHfSetSource(uint32_t clkHf,
+                                                      cy_en_clkhf_in_sources_t source)
+{
+    cy_en_sysclk_status_t result;
+
+    if (cybsp_clock_overlap && cybsp_clock_fll_started && (0UL == clkHf) &&
+        (CY_SYSCLK_CLKHF_IN_CLKPATH0 == source))
+    {
+        cybsp_clock_hf0_pending = true;
+        result = CY_SYSCLK_SUCCESS;
+    }
+    else
+    {
+        result = __real_Cy_SysClk_ClkHfSetSource(clkHf, source);
+    }
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// __wrap_Cy_SysClk_PllEnable
+//
+// Enables a PLL without waiting for it to lock
+//--------------------------------------------------------------------------------------------------
+cy_en_sysclk_status_t __wrap_Cy_SysClk_PllEnable(uint32_t clkPath, uint32_t timeoutus)
+{
+    cy_en_sysclk_status_t result;
+
+    if (cybsp_clock_overlap && (clkPath > 0UL) && (clkPath <= SRSS_NUM_PLL))
+    {
+        result = __real_Cy_SysClk_PllEnable(clkPath, 0UL);
+        if (CY_SYSCLK_SUCCESS == result)
+        {
+            cybsp_clock_pll_started |= (1UL << clkPath);
+        }
+    }
+    else
+    {
+        result = __real_Cy_SysClk_PllEnable(clkPath, timeoutus);
+    }
+    return result;
+}
+
+
+#endif // defined(CYBSP_OVERLAP_CLOCK_LOCK)
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_overlap_begin
+//--------------------------------------------------------------------------------------------------
+void cybsp_clock_overlap_begin(void)
+{
+    #if defined(CYBSP_OVERLAP_CLOCK_LOCK)
+    cybsp_clock_overlap = true;
+    #endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_overlap_end
+//--------------------------------------------------------------------------------------------------
+void cybsp_clock_overlap_end(void)
+{
+    #if defined(CYBSP_OVERLAP_CLOCK_LOCK)
+    cybsp_clock_overlap = false;
+
+    if (cybsp_clock_fll_started)
+    {
+        cybsp_clock_wait(cybsp_clock_fll_ready, 0UL, CYBSP_CLOCK_FLL_TIMEOUT_US,
+                         CYBSP_CLOCK_FLL_ERROR);
+        if (cybsp_clock_hf0_pending)
+        {
+            (void)__real_Cy_SysClk_ClkHfSetSource(0UL, CY_SYSCLK_CLKHF_IN_CLKPATH0);
+            cybsp_clock_hf0_pending = false;
+        }
+        Cy_SysClk_ClkPathSetSource(CYBSP_CLOCK_PARK_PATH, cybsp_clock_park_source);
+        cybsp_clock_fll_started = false;
+    }
+
+    for (uint32_t clkPath = 1UL; clkPath <= SRSS_NUM_PLL; clkPath++)
+    {
+        if (0UL != (cybsp_clock_pll_started & (1UL << clkPath)))
+        {
+            cybsp_clock_wait(cybsp_clock_pll_ready, clkPath, CYBSP_CLOCK_PLL_TIMEOUT_US,
+                             CYBSP_CLOCK_PLL_ERROR);
+        }
+    }
+    cybsp_clock_pll_started = 0UL;
+
+    // init_cycfg_system() computed the core clock with CLK_HF0 still on the IMO
+    SystemCoreClockUpdate();
+    #endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_lf_init
+//--------------------------------------------------------------------------------------------------
+void cybsp_clock_lf_init(void)
+{
+    #if defined(CYBSP_OVERLAP_CLOCK_LOCK)
+    if (cybsp_clock_lf_pending)
+    {
+        // Unlike init_cycfg_system(), this may run after the application has locked the WDT
+        bool wdt_locked = Cy_WDT_Locked();
+
+        cybsp_clock_wait(cybsp_clock_wco_ready, 0UL, CYBSP_CLOCK_WCO_TIMEOUT_US,
+                         CYBSP_CLOCK_WCO_ERROR);
+        if (wdt_locked)
+        {
+            Cy_WDT_Unlock();
+        }
+        __real_Cy_SysClk_ClkLfSetSource(cybsp_clock_lf_source);
+        if (wdt_locked)
+        {
+            Cy_WDT_Lock();
+        }
+        cybsp_clock_lf_pending = false;
+    }
+    #endif
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
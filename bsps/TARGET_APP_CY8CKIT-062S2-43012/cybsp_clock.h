@@ -0,0 +1,62 @@
+/***********************************************************************************************//**
+ * \file cybsp_clock.h
+ *
+ * \brief
+ * Overlapped start of the WCO, FLL and PLLs of the generated system configuration.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2018-2022 Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#pragma once
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_overlap_begin
+//
+// Called by \ref cybsp_init before the generated init_cycfg_system(). When
+// `CYBSP_OVERLAP_CLOCK_LOCK` is defined, the WCO, FLL and PLLs that it enables are started without
+// waiting for them, and CLK_HF0 runs from the IMO until \ref cybsp_clock_overlap_end. Otherwise
+// this does nothing.
+//--------------------------------------------------------------------------------------------------
+void cybsp_clock_overlap_begin(void);
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_overlap_end
+//
+// Waits for the FLL and PLLs started since \ref cybsp_clock_overlap_begin to lock and switches
+// CLK_HF0 to the FLL. CLK_LF stays on the ILO until \ref cybsp_clock_lf_init.
+//--------------------------------------------------------------------------------------------------
+void cybsp_clock_overlap_end(void);
+
+//--------------------------------------------------------------------------------------------------
+// cybsp_clock_lf_init
+//
+// Init thunk of `CYBSP_CONFIG_CLK_LF`: waits for the WCO started by the system configuration and
+// switches CLK_LF to it, with the WDT unlocked if the application has locked it. Does nothing if
+// the system configuration has already switched CLK_LF.
+//--------------------------------------------------------------------------------------------------
+void cybsp_clock_lf_init(void);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
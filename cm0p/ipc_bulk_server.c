@@ -0,0 +1,203 @@
+/******************************************************************************
+* File Name:   ipc_bulk_server.c
+*
+* Description: This file contains the CM0+ end of the message rings to and from
+*              the CM4 core. It returns every message from the CM4 on the ring
+*              back, as a loopback for the measurement of the channel.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_bulk_server.h"
+#include "trace.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* CM0+ NVIC line of the doorbell */
+#define IPC_BULK_SERVER_IRQ         (NvicMux4_IRQn)
+#define IPC_BULK_SERVER_PRIORITY    (3U)
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void ipc_bulk_server_isr(void);
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Set by the doorbell, or while messages wait for room in the ring to the
+ * CM4 */
+static volatile bool ipc_bulk_server_notified = false;
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_server_init
+********************************************************************************
+* Summary:
+* This function initializes the shared memory and enables the doorbell of the
+* CM4. It must run before the CM4 is enabled.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_bulk_server_init(void)
+{
+    static const cy_stc_sysint_t irq_cfg =
+    {
+        .intrSrc = ((uint32_t)IPC_BULK_SERVER_IRQ <<
+                    CY_SYSINT_INTRSRC_MUXIRQ_SHIFT) |
+                   (uint32_t)(cpuss_interrupts_ipc_0_IRQn + IPC_RING_INTR_CM0P),
+        .intrPriority = IPC_BULK_SERVER_PRIORITY
+    };
+
+    ipc_shared_init();
+
+    Cy_IPC_Drv_SetInterruptMask(Cy_IPC_Drv_GetIntrBaseAddr(IPC_RING_INTR_CM0P),
+                                CY_IPC_NO_NOTIFICATION, (1UL << IPC_RING_CHAN));
+
+    (void)Cy_SysInt_Init(&irq_cfg, ipc_bulk_server_isr);
+    NVIC_EnableIRQ(IPC_BULK_SERVER_IRQ);
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_server_pending
+********************************************************************************
+* Summary:
+* This function tells whether the ring from the CM4 needs
+* ipc_bulk_server_process().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true if the doorbell rang or messages are left
+*
+*******************************************************************************/
+bool ipc_bulk_server_pending(void)
+{
+    return ipc_bulk_server_notified;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_server_process
+********************************************************************************
+* Summary:
+* This function returns the messages from the CM4 on the ring back, in
+* batches of the messages that follow each other, until the ring is empty.
+* The CM4 doorbell is rung when the ring to the CM4 was empty. When that ring
+* is full, the rest stays in the ring from the CM4 and the function is called
+* again from the main loop: the CM4 drains its ring without any further
+* notification.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_bulk_server_process(void)
+{
+    const void *msgs;
+    uint32_t count;
+    uint32_t written;
+    bool doorbell;
+
+    if (!ipc_bulk_server_notified)
+    {
+        return;
+    }
+    ipc_bulk_server_notified = false;
+
+    while ((count = ipc_ring_peek(&ipc_shared.to_cm0p, &msgs)) != 0U)
+    {
+        written = ipc_ring_write(&ipc_shared.to_cm4, msgs, count, &doorbell);
+        TRACE_MARK("ring.loop", written);
+        if (doorbell)
+        {
+            Cy_IPC_Drv_AcquireNotify(
+                Cy_IPC_Drv_GetIpcBaseAddress(IPC_RING_CHAN),
+                (1UL << IPC_RING_INTR_CM4));
+        }
+
+        if (written != 0U)
+        {
+            ipc_ring_release(&ipc_shared.to_cm0p, written);
+        }
+        if (written != count)
+        {
+            ipc_bulk_server_notified = true;
+            break;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_server_isr
+********************************************************************************
+* Summary:
+* This function handles the doorbell of the CM4.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_bulk_server_isr(void)
+{
+    IPC_INTR_STRUCT_Type *intr = Cy_IPC_Drv_GetIntrBaseAddr(IPC_RING_INTR_CM0P);
+
+    Cy_IPC_Drv_ClearInterrupt(intr, CY_IPC_NO_NOTIFICATION,
+                              Cy_IPC_Drv_ExtractAcquireMask(
+                                  Cy_IPC_Drv_GetInterruptStatusMasked(intr)));
+
+    ipc_bulk_server_notified = true;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,556 @@
+/******************************************************************************
+* File Name:   ipc_console_server.c
+*
+* Description: This file contains the CM0+ end of the console. Once the CM4
+*              starts it, the CM0+ drives the debug UART: it formats the records
+*              the CM4 queues in shared memory, edits the command lines with the
+*              editor of the shell and passes the completed lines to the CM4.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "ipc_rpc_server.h"
+#include "ipc_console_server.h"
+#include "shell_edit.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* SCB and pins of the debug UART of the kit, see CYBSP_DEBUG_UART_* */
+#define IPC_CONSOLE_SERVER_SCB      (SCB5)
+#define IPC_CONSOLE_SERVER_PORT     (GPIO_PRT5)
+#define IPC_CONSOLE_SERVER_RX       (0U)
+#define IPC_CONSOLE_SERVER_TX       (1U)
+#define IPC_CONSOLE_SERVER_RTS      (2U)
+#define IPC_CONSOLE_SERVER_CTS      (3U)
+
+/* CM0+ NVIC line of the SCB interrupt */
+#define IPC_CONSOLE_SERVER_IRQ      (NvicMux5_IRQn)
+#define IPC_CONSOLE_SERVER_PRIORITY (3U)
+
+/* Receive FIFO level at which RTS stops the sender */
+#define IPC_CONSOLE_SERVER_RTS_LEVEL (96U)
+
+/* Transmit FIFO level below which the transmit ring is refilled into it */
+#define IPC_CONSOLE_SERVER_TX_LEVEL (16U)
+
+/* Size of the transmit ring, a power of two. A record is only formatted when
+ * IPC_CONSOLE_SERVER_TX_ROOM bytes are free, so the main loop rarely waits
+ * for the UART and RPC calls are served while the text goes out. */
+#define IPC_CONSOLE_SERVER_TX_SIZE  (512U)
+#define IPC_CONSOLE_SERVER_TX_ROOM  (256U)
+
+/* Bytes taken from the receive FIFO at once */
+#define IPC_CONSOLE_SERVER_RX_CHUNK (16U)
+
+#define IPC_CONSOLE_SERVER_PUTS(text) \
+    ipc_console_server_write((text), sizeof(text) - 1U)
+
+/* Command lines go to the CM4 as they are */
+#if (SHELL_LINE_SIZE != IPC_CONSOLE_LINE_SIZE)
+#error "SHELL_LINE_SIZE must match IPC_CONSOLE_LINE_SIZE"
+#endif
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static ipc_rpc_status_t ipc_console_server_start(volatile ipc_rpc_msg_t *msg);
+static void ipc_console_server_record(const ipc_console_record_t *record);
+static void ipc_console_server_write(const char *data, size_t length);
+static void ipc_console_server_pump(void);
+static void ipc_console_server_line(char *line, uint32_t length);
+static void ipc_console_server_isr(void);
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const cy_stc_scb_uart_config_t ipc_console_server_config =
+{
+    .uartMode                   = CY_SCB_UART_STANDARD,
+    .enableMutliProcessorMode   = false,
+    .smartCardRetryOnNack       = false,
+    .irdaInvertRx               = false,
+    .irdaEnableLowPowerReceiver = false,
+    .oversample                 = IPC_CONSOLE_OVERSAMPLE,
+    .enableMsbFirst             = false,
+    .dataWidth                  = 8UL,
+    .parity                     = CY_SCB_UART_PARITY_NONE,
+    .stopBits                   = CY_SCB_UART_STOP_BITS_1,
+    .enableInputFilter          = false,
+    .breakWidth                 = 11UL,
+    .dropOnFrameError           = false,
+    .dropOnParityError          = false,
+    .receiverAddress            = 0UL,
+    .receiverAddressMask        = 0UL,
+    .acceptAddrInFifo           = false,
+    .enableCts                  = true,
+    .ctsPolarity                = CY_SCB_UART_ACTIVE_LOW,
+    .rtsRxFifoLevel             = IPC_CONSOLE_SERVER_RTS_LEVEL,
+    .rtsPolarity                = CY_SCB_UART_ACTIVE_LOW,
+    .rxFifoTriggerLevel         = 0UL,
+    .rxFifoIntEnableMask        = CY_SCB_UART_RX_NOT_EMPTY,
+    .txFifoTriggerLevel         = IPC_CONSOLE_SERVER_TX_LEVEL,
+    .txFifoIntEnableMask        = 0UL
+};
+
+static cy_stc_scb_uart_context_t ipc_console_server_context;
+
+/* Disables the SCB around Deep Sleep and keeps the system out of it while
+ * the UART transmits or has received data */
+static cy_stc_syspm_callback_params_t ipc_console_server_pm_params =
+{
+    .base = IPC_CONSOLE_SERVER_SCB,
+    .context = &ipc_console_server_context
+};
+static cy_stc_syspm_callback_t ipc_console_server_pm =
+{
+    .callback = Cy_SCB_UART_DeepSleepCallback,
+    .type = CY_SYSPM_DEEPSLEEP,
+    .skipMode = 0UL,
+    .callbackParams = &ipc_console_server_pm_params,
+    .prevItm = NULL,
+    .nextItm = NULL,
+    .order = 0U
+};
+
+/* Set once the CM4 started the console */
+static bool ipc_console_server_started = false;
+
+/* Set by the interrupt, which masks its cause until the main loop handled it */
+static volatile bool ipc_console_server_rx_notified = false;
+static volatile bool ipc_console_server_tx_notified = false;
+
+/* Transmit ring, written and read in the main loop only. Both indices run
+ * freely. */
+static uint8_t ipc_console_server_tx[IPC_CONSOLE_SERVER_TX_SIZE];
+static uint32_t ipc_console_server_tx_head = 0U;
+static uint32_t ipc_console_server_tx_tail = 0U;
+
+/* Command lines the ring to the CM4 had no room for */
+static uint32_t ipc_console_server_lines_dropped = 0U;
+
+
+/*******************************************************************************
+* Function Name: ipc_console_server_init
+********************************************************************************
+* Summary:
+* This function registers the start call of the console. The UART is left
+* alone until the CM4 makes it, so CM4 images that drive the UART themselves
+* run unchanged.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_console_server_init(void)
+{
+    ipc_rpc_server_register(IPC_RPC_FUNC_CONSOLE_START,
+                            ipc_console_server_start);
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_server_pending
+********************************************************************************
+* Summary:
+* This function tells whether the console needs ipc_console_server_process().
+* Records are only pending while the transmit ring has room for their text.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true if the UART or the records need service
+*
+*******************************************************************************/
+bool ipc_console_server_pending(void)
+{
+    return ipc_console_server_started &&
+           (ipc_console_server_rx_notified || ipc_console_server_tx_notified ||
+            ((ipc_ring_count(&ipc_shared.records) != 0U) &&
+             ((IPC_CONSOLE_SERVER_TX_SIZE - (ipc_console_server_tx_head -
+                                             ipc_console_server_tx_tail)) >=
+              IPC_CONSOLE_SERVER_TX_ROOM)));
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_server_process
+********************************************************************************
+* Summary:
+* This function passes the received bytes to the line editor, formats the
+* records from the CM4 while the transmit ring has room, and refills the
+* transmit FIFO. The interrupt is then armed again: on the receive FIFO, on
+* the transmit FIFO level while the ring holds text, and on the end of the
+* transmission once it is empty, which Deep Sleep waits for.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_console_server_process(void)
+{
+    CySCB_Type *base = IPC_CONSOLE_SERVER_SCB;
+    uint8_t rx[IPC_CONSOLE_SERVER_RX_CHUNK];
+    const void *records;
+    uint32_t count;
+    uint32_t index;
+
+    if (!ipc_console_server_started)
+    {
+        return;
+    }
+
+    if (ipc_console_server_rx_notified)
+    {
+        ipc_console_server_rx_notified = false;
+
+        while ((count = Cy_SCB_UART_GetArray(base, rx, sizeof(rx))) != 0U)
+        {
+            shell_edit_input(rx, count);
+        }
+
+        Cy_SCB_ClearRxInterrupt(base, CY_SCB_UART_RX_NOT_EMPTY);
+        Cy_SCB_SetRxInterruptMask(base, CY_SCB_UART_RX_NOT_EMPTY);
+    }
+
+    while (((IPC_CONSOLE_SERVER_TX_SIZE - (ipc_console_server_tx_head -
+                                           ipc_console_server_tx_tail)) >=
+            IPC_CONSOLE_SERVER_TX_ROOM) &&
+           ((count = ipc_ring_peek(&ipc_shared.records, &records)) != 0U))
+    {
+        for (index = 0U; index < count; index++)
+        {
+            ipc_console_server_record(
+                &((const ipc_console_record_t *)records)[index]);
+        }
+        ipc_ring_release(&ipc_shared.records, count);
+    }
+
+    ipc_console_server_tx_notified = false;
+    ipc_console_server_pump();
+
+    Cy_SCB_ClearTxInterrupt(base, CY_SCB_UART_TX_TRIGGER | CY_SCB_UART_TX_DONE);
+    if (ipc_console_server_tx_head != ipc_console_server_tx_tail)
+    {
+        Cy_SCB_SetTxInterruptMask(base, CY_SCB_UART_TX_TRIGGER);
+    }
+    else if (!Cy_SCB_UART_IsTxComplete(base))
+    {
+        Cy_SCB_SetTxInterruptMask(base, CY_SCB_UART_TX_DONE);
+    }
+    else
+    {
+        Cy_SCB_SetTxInterruptMask(base, 0UL);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_server_start
+********************************************************************************
+* Summary:
+* This function serves IPC_RPC_FUNC_CONSOLE_START. The CM4 has reserved the
+* SCB and its pins and connected the SCB to a clock of the baud rate times
+* IPC_CONSOLE_OVERSAMPLE. The function configures the SCB and routes the pins
+* to it.
+*
+* Parameters:
+*  msg         Call, args[0] is the baud rate, for the record
+*
+* Return:
+*  ipc_rpc_status_t    IPC_RPC_STATUS_OK, or IPC_RPC_STATUS_FAILED with the
+*                      SCB status in the result
+*
+*******************************************************************************/
+static ipc_rpc_status_t ipc_console_server_start(volatile ipc_rpc_msg_t *msg)
+{
+    static const cy_stc_sysint_t irq_cfg =
+    {
+        .intrSrc = ((uint32_t)IPC_CONSOLE_SERVER_IRQ <<
+                    CY_SYSINT_INTRSRC_MUXIRQ_SHIFT) |
+                   (uint32_t)scb_5_interrupt_IRQn,
+        .intrPriority = IPC_CONSOLE_SERVER_PRIORITY
+    };
+    cy_en_scb_uart_status_t status;
+
+    if (ipc_console_server_started)
+    {
+        return IPC_RPC_STATUS_OK;
+    }
+
+    status = Cy_SCB_UART_Init(IPC_CONSOLE_SERVER_SCB,
+                              &ipc_console_server_config,
+                              &ipc_console_server_context);
+    if (status != CY_SCB_UART_SUCCESS)
+    {
+        msg->result = (uint32_t)status;
+        return IPC_RPC_STATUS_FAILED;
+    }
+
+    Cy_GPIO_Pin_FastInit(IPC_CONSOLE_SERVER_PORT, IPC_CONSOLE_SERVER_RX,
+                         CY_GPIO_DM_HIGHZ, 1UL, P5_0_SCB5_UART_RX);
+    Cy_GPIO_Pin_FastInit(IPC_CONSOLE_SERVER_PORT, IPC_CONSOLE_SERVER_TX,
+                         CY_GPIO_DM_STRONG_IN_OFF, 1UL, P5_1_SCB5_UART_TX);
+    Cy_GPIO_Pin_FastInit(IPC_CONSOLE_SERVER_PORT, IPC_CONSOLE_SERVER_RTS,
+                         CY_GPIO_DM_STRONG_IN_OFF, 1UL, P5_2_SCB5_UART_RTS);
+    Cy_GPIO_Pin_FastInit(IPC_CONSOLE_SERVER_PORT, IPC_CONSOLE_SERVER_CTS,
+                         CY_GPIO_DM_HIGHZ, 1UL, P5_3_SCB5_UART_CTS);
+
+    (void)Cy_SysPm_RegisterCallback(&ipc_console_server_pm);
+
+    shell_edit_init(ipc_console_server_write, ipc_console_server_line);
+
+    (void)Cy_SysInt_Init(&irq_cfg, ipc_console_server_isr);
+    NVIC_EnableIRQ(IPC_CONSOLE_SERVER_IRQ);
+
+    Cy_SCB_UART_Enable(IPC_CONSOLE_SERVER_SCB);
+
+    ipc_console_server_started = true;
+    msg->result = msg->args[0];
+
+    return IPC_RPC_STATUS_OK;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_server_record
+********************************************************************************
+* Summary:
+* This function formats one record into the transmit ring.
+*
+* Parameters:
+*  record      Record from the CM4
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_console_server_record(const ipc_console_record_t *record)
+{
+    uint32_t age;
+    const char *line;
+
+    switch (record->kind)
+    {
+        case IPC_CONSOLE_RECORD_LOG:
+            app_log_format((const uint8_t *)record, ipc_console_server_write);
+            break;
+
+        case IPC_CONSOLE_RECORD_TEXT:
+            ipc_console_server_write((const char *)record->payload,
+                                     (record->length <
+                                      IPC_CONSOLE_PAYLOAD_SIZE) ?
+                                     record->length : IPC_CONSOLE_PAYLOAD_SIZE);
+            break;
+
+        case IPC_CONSOLE_RECORD_PROMPT:
+            shell_edit_prompt();
+            break;
+
+        case IPC_CONSOLE_RECORD_HISTORY:
+            for (age = shell_edit_history_count(); age > 0U; age--)
+            {
+                line = shell_edit_history_line(age);
+                IPC_CONSOLE_SERVER_PUTS("  ");
+                ipc_console_server_write(line, strlen(line));
+                IPC_CONSOLE_SERVER_PUTS("\r\n");
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_server_write
+********************************************************************************
+* Summary:
+* This function appends text to the transmit ring. When the ring is full it
+* waits for the UART to take some, which only happens for text longer than
+* IPC_CONSOLE_SERVER_TX_ROOM.
+*
+* Parameters:
+*  data        Text to send
+*  length      Number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_console_server_write(const char *data, size_t length)
+{
+    while (length > 0U)
+    {
+        if ((ipc_console_server_tx_head - ipc_console_server_tx_tail) ==
+            IPC_CONSOLE_SERVER_TX_SIZE)
+        {
+            ipc_console_server_pump();
+            continue;
+        }
+
+        ipc_console_server_tx[ipc_console_server_tx_head &
+                              (IPC_CONSOLE_SERVER_TX_SIZE - 1U)] =
+            (uint8_t)*data++;
+        ipc_console_server_tx_head++;
+        length--;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_server_pump
+********************************************************************************
+* Summary:
+* This function moves text from the transmit ring into the transmit FIFO,
+* as much as it takes.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_console_server_pump(void)
+{
+    uint32_t index;
+    uint32_t count;
+    uint32_t placed;
+
+    do
+    {
+        index = ipc_console_server_tx_tail & (IPC_CONSOLE_SERVER_TX_SIZE - 1U);
+        count = ipc_console_server_tx_head - ipc_console_server_tx_tail;
+        if (count > (IPC_CONSOLE_SERVER_TX_SIZE - index))
+        {
+            count = IPC_CONSOLE_SERVER_TX_SIZE - index;
+        }
+
+        placed = (count != 0U) ?
+                 Cy_SCB_UART_PutArray(IPC_CONSOLE_SERVER_SCB,
+                                      &ipc_console_server_tx[index], count) :
+                 0U;
+        ipc_console_server_tx_tail += placed;
+    } while (placed != 0U);
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_server_line
+********************************************************************************
+* Summary:
+* This function passes a completed command line to the CM4 and rings its
+* doorbell if the ring was empty. When the CM4 has not taken the previous
+* lines, the line is dropped with a message.
+*
+* Parameters:
+*  line        NUL terminated line
+*  length      Characters in the line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_console_server_line(char *line, uint32_t length)
+{
+    char msg[IPC_CONSOLE_LINE_SIZE];
+    bool doorbell;
+
+    (void)memset(msg, 0, sizeof(msg));
+    (void)memcpy(msg, line, (length < sizeof(msg)) ? length : sizeof(msg) - 1U);
+
+    if (ipc_ring_write(&ipc_shared.lines, msg, 1U, &doorbell) == 0U)
+    {
+        ipc_console_server_lines_dropped++;
+        IPC_CONSOLE_SERVER_PUTS("Busy, line dropped\r\n");
+        shell_edit_prompt();
+        return;
+    }
+
+    if (doorbell)
+    {
+        Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(IPC_RING_CHAN),
+                                 (1UL << IPC_CONSOLE_INTR_CM4));
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_server_isr
+********************************************************************************
+* Summary:
+* This is the SCB interrupt. It masks the causes that fired and leaves the
+* work to the main loop, which arms them again.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_console_server_isr(void)
+{
+    CySCB_Type *base = IPC_CONSOLE_SERVER_SCB;
+
+    if (Cy_SCB_GetRxInterruptStatusMasked(base) != 0UL)
+    {
+        Cy_SCB_SetRxInterruptMask(base, 0UL);
+        ipc_console_server_rx_notified = true;
+    }
+
+    if (Cy_SCB_GetTxInterruptStatusMasked(base) != 0UL)
+    {
+        Cy_SCB_SetTxInterruptMask(base, 0UL);
+        ipc_console_server_tx_notified = true;
+    }
+}
+
+/* [] END OF FILE */
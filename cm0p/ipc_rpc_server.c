@@ -0,0 +1,330 @@
+/******************************************************************************
+* File Name:   ipc_rpc_server.c
+*
+* Description: This file contains the RPC server of the CM0+ image. The
+*              notification of a call only raises a flag; the call runs in the
+*              main loop, so that a long one such as a flash write does not
+*              block the interrupts of the CM0+.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_rpc_server.h"
+#include "trace.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* CM0+ NVIC line of the notification. Lines 0 and 1 are taken by the system
+ * IPC pipe of the PDL. */
+#define IPC_RPC_SERVER_IRQ          (NvicMux3_IRQn)
+#define IPC_RPC_SERVER_PRIORITY     (3U)
+
+#if (CY_FLASH_SIZEOF_ROW != IPC_RPC_FLASH_ROW_SIZE)
+#error "IPC_RPC_FLASH_ROW_SIZE does not match the flash row of the device"
+#endif
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void ipc_rpc_server_isr(void);
+static ipc_rpc_status_t ipc_rpc_ping(volatile ipc_rpc_msg_t *msg);
+static ipc_rpc_status_t ipc_rpc_gpio_write(volatile ipc_rpc_msg_t *msg);
+static ipc_rpc_status_t ipc_rpc_flash_write_row(volatile ipc_rpc_msg_t *msg);
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static ipc_rpc_handler_t ipc_rpc_handlers[IPC_RPC_FUNC_COUNT] =
+{
+    [IPC_RPC_FUNC_PING] = ipc_rpc_ping,
+    [IPC_RPC_FUNC_GPIO_WRITE] = ipc_rpc_gpio_write,
+    [IPC_RPC_FUNC_FLASH_WRITE_ROW] = ipc_rpc_flash_write_row,
+};
+
+/* Set by the notification, cleared by ipc_rpc_server_process() */
+static volatile bool ipc_rpc_server_notified = false;
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_server_init
+********************************************************************************
+* Summary:
+* This function enables the notification of calls on IPC_RPC_INTR_SERVER.
+* It must run before the CM4 is enabled, which probes the server at once.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_rpc_server_init(void)
+{
+    static const cy_stc_sysint_t irq_cfg =
+    {
+        .intrSrc = ((uint32_t)IPC_RPC_SERVER_IRQ <<
+                    CY_SYSINT_INTRSRC_MUXIRQ_SHIFT) |
+                   (uint32_t)(cpuss_interrupts_ipc_0_IRQn + IPC_RPC_INTR_SERVER),
+        .intrPriority = IPC_RPC_SERVER_PRIORITY
+    };
+
+    Cy_IPC_Drv_SetInterruptMask(Cy_IPC_Drv_GetIntrBaseAddr(IPC_RPC_INTR_SERVER),
+                                CY_IPC_NO_NOTIFICATION,
+                                (1UL << IPC_RPC_CHAN));
+
+    (void)Cy_SysInt_Init(&irq_cfg, ipc_rpc_server_isr);
+    NVIC_EnableIRQ(IPC_RPC_SERVER_IRQ);
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_server_register
+********************************************************************************
+* Summary:
+* This function replaces the handler of a function, NULL removes it.
+*
+* Parameters:
+*  func        Function to serve
+*  handler     Handler of the function
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_rpc_server_register(ipc_rpc_func_t func, ipc_rpc_handler_t handler)
+{
+    if ((uint32_t)func < (uint32_t)IPC_RPC_FUNC_COUNT)
+    {
+        ipc_rpc_handlers[func] = handler;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_server_pending
+********************************************************************************
+* Summary:
+* This function tells whether a call waits for ipc_rpc_server_process(). The
+* main loop checks it with the interrupts masked before it sleeps.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true if a call was notified
+*
+*******************************************************************************/
+bool ipc_rpc_server_pending(void)
+{
+    return ipc_rpc_server_notified;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_server_process
+********************************************************************************
+* Summary:
+* This function runs the notified call and releases the channel, which tells
+* the CM4 that the result is in the message. A call the CM4 has given up on
+* in the meantime is skipped: the channel is no longer locked.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_rpc_server_process(void)
+{
+    IPC_STRUCT_Type *ipc = Cy_IPC_Drv_GetIpcBaseAddress(IPC_RPC_CHAN);
+    volatile ipc_rpc_msg_t *msg;
+    uint32_t address;
+    ipc_rpc_status_t status = IPC_RPC_STATUS_NO_FUNC;
+
+    if (!ipc_rpc_server_notified)
+    {
+        return;
+    }
+    ipc_rpc_server_notified = false;
+
+    if (Cy_IPC_Drv_ReadMsgWord(ipc, &address) != CY_IPC_DRV_SUCCESS)
+    {
+        return;
+    }
+    msg = (volatile ipc_rpc_msg_t *)address;
+
+    TRACE_BEGIN("rpc.serve", msg->func);
+    if ((msg->func < (uint32_t)IPC_RPC_FUNC_COUNT) &&
+        (ipc_rpc_handlers[msg->func] != NULL))
+    {
+        status = ipc_rpc_handlers[msg->func](msg);
+    }
+    msg->status = (uint32_t)status;
+    TRACE_END("rpc.serve", msg->func);
+
+    /* The message must be complete before the CM4 sees the channel free */
+    __DMB();
+    (void)Cy_IPC_Drv_LockRelease(ipc, CY_IPC_NO_NOTIFICATION);
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_server_isr
+********************************************************************************
+* Summary:
+* This function handles the notification of a call.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_rpc_server_isr(void)
+{
+    IPC_INTR_STRUCT_Type *intr = Cy_IPC_Drv_GetIntrBaseAddr(IPC_RPC_INTR_SERVER);
+    uint32_t notify = Cy_IPC_Drv_ExtractAcquireMask(
+                          Cy_IPC_Drv_GetInterruptStatusMasked(intr));
+
+    Cy_IPC_Drv_ClearInterrupt(intr, CY_IPC_NO_NOTIFICATION, notify);
+
+    if ((notify & (1UL << IPC_RPC_CHAN)) != 0UL)
+    {
+        ipc_rpc_server_notified = true;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_ping
+********************************************************************************
+* Summary:
+* This function answers IPC_RPC_FUNC_PING with its first argument plus one.
+*
+* Parameters:
+*  msg         Message of the call
+*
+* Return:
+*  ipc_rpc_status_t IPC_RPC_STATUS_OK
+*
+*******************************************************************************/
+static ipc_rpc_status_t ipc_rpc_ping(volatile ipc_rpc_msg_t *msg)
+{
+    msg->result = msg->args[0] + 1U;
+
+    return IPC_RPC_STATUS_OK;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_gpio_write
+********************************************************************************
+* Summary:
+* This function drives a pin for IPC_RPC_FUNC_GPIO_WRITE. The CM4 configures
+* the pin; writing its output register from either core is safe, as the
+* driver uses the atomic set and clear registers.
+*
+* Parameters:
+*  msg         Message of the call: port, pin and value
+*
+* Return:
+*  ipc_rpc_status_t IPC_RPC_STATUS_OK or IPC_RPC_STATUS_BAD_ARGS
+*
+*******************************************************************************/
+static ipc_rpc_status_t ipc_rpc_gpio_write(volatile ipc_rpc_msg_t *msg)
+{
+    if ((msg->args[0] >= IOSS_GPIO_GPIO_PORT_NR) ||
+        (msg->args[1] >= CY_GPIO_PINS_MAX))
+    {
+        return IPC_RPC_STATUS_BAD_ARGS;
+    }
+
+    Cy_GPIO_Write(Cy_GPIO_PortToAddr(msg->args[0]), msg->args[1],
+                  (msg->args[2] != 0U) ? 1UL : 0UL);
+
+    return IPC_RPC_STATUS_OK;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_flash_write_row
+********************************************************************************
+* Summary:
+* This function writes a row for IPC_RPC_FUNC_FLASH_WRITE_ROW. Only the rows
+* of the emulated EEPROM are accepted: it is the work flash, a sector of its
+* own, so the CM4 keeps running from the main flash during the write and the
+* application image cannot be overwritten. The data stays in the SRAM of the
+* caller until the call is over.
+*
+* Parameters:
+*  msg         Message of the call: row address and data address
+*
+* Return:
+*  ipc_rpc_status_t IPC_RPC_STATUS_OK, IPC_RPC_STATUS_BAD_ARGS, or
+*              IPC_RPC_STATUS_FAILED with the flash driver status as result
+*
+*******************************************************************************/
+static ipc_rpc_status_t ipc_rpc_flash_write_row(volatile ipc_rpc_msg_t *msg)
+{
+    uint32_t row = msg->args[0];
+    uint32_t data = msg->args[1];
+    cy_en_flashdrv_status_t status;
+
+    if ((row < CY_EM_EEPROM_BASE) ||
+        (row >= (CY_EM_EEPROM_BASE + CY_EM_EEPROM_SIZE)) ||
+        ((row % CY_FLASH_SIZEOF_ROW) != 0U) ||
+        ((data % sizeof(uint32_t)) != 0U) ||
+        (data < CY_SRAM_BASE) ||
+        ((data + CY_FLASH_SIZEOF_ROW) > (CY_SRAM_BASE + CY_SRAM_SIZE)))
+    {
+        return IPC_RPC_STATUS_BAD_ARGS;
+    }
+
+    status = Cy_Flash_WriteRow(row, (const uint32_t *)data);
+    msg->result = (uint32_t)status;
+
+    return (status == CY_FLASH_DRV_SUCCESS) ? IPC_RPC_STATUS_OK :
+           IPC_RPC_STATUS_FAILED;
+}
+
+/* [] END OF FILE */
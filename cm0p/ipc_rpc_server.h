@@ -0,0 +1,77 @@
+/******************************************************************************
+* File Name:   ipc_rpc_server.h
+*
+* Description: This file contains the declarations of the RPC server of the CM0+
+*              image, which runs housekeeping functions for the CM4 application.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_RPC_SERVER_H
+#define IPC_RPC_SERVER_H
+
+#include "cy_pdl.h"
+#include "ipc_rpc_msg.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Function of the server. Returns the status of the call and stores its
+ * result in msg->result. */
+typedef ipc_rpc_status_t (*ipc_rpc_handler_t)(volatile ipc_rpc_msg_t *msg);
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void ipc_rpc_server_init(void);
+void ipc_rpc_server_register(ipc_rpc_func_t func, ipc_rpc_handler_t handler);
+bool ipc_rpc_server_pending(void);
+void ipc_rpc_server_process(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_RPC_SERVER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,109 @@
+/******************************************************************************
+* File Name:   main.c
+*
+* Description: This is the source code of the CM0+ image of the application. It
+*              starts the CM4 and serves its remote procedure calls and
+*              message rings, in Deep Sleep in between like the CM0P_SLEEP
+*              image it replaces.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_pdl.h"
+#include "ipc_rpc_server.h"
+#include "ipc_bulk_server.h"
+#include "ipc_console_server.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Start of the CM4 image, after the CM0P_FLASH_SIZE bytes of this one */
+#if defined(CM0P_FLASH_SIZE)
+#define CM4_APPL_ADDR               (CY_FLASH_BASE + CM0P_FLASH_SIZE)
+#else
+#define CM4_APPL_ADDR               (CY_CORTEX_M4_APPL_ADDR)
+#endif
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* This is the main function of the CM0+ core. The RPC server, the shared
+* message rings and the trace buffer are ready before the CM4 starts, the
+* console once the CM4 starts it. Trace records carry the time 0 until the
+* CM4 has started the timebase. The pending check and the sleep run with the interrupts masked,
+* so a call notified in between wakes the core instead of waiting for the
+* next interrupt.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32_t state;
+
+    __enable_irq();
+
+    ipc_rpc_server_init();
+    ipc_bulk_server_init();
+    ipc_console_server_init();
+    trace_start(&ipc_shared.trace);
+
+    Cy_SysEnableCM4(CM4_APPL_ADDR);
+
+    for (;;)
+    {
+        state = Cy_SysLib_EnterCriticalSection();
+        if (!ipc_rpc_server_pending() && !ipc_bulk_server_pending() &&
+            !ipc_console_server_pending())
+        {
+            (void)Cy_SysPm_CpuEnterDeepSleep(CY_SYSPM_WAIT_FOR_INTERRUPT);
+        }
+        Cy_SysLib_ExitCriticalSection(state);
+
+        ipc_rpc_server_process();
+        ipc_bulk_server_process();
+        ipc_console_server_process();
+    }
+}
+
+/* [] END OF FILE */
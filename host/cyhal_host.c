@@ -0,0 +1,1609 @@
+/******************************************************************************
+* File Name:   cyhal_host.c
+*
+* Description: This file implements the HAL subset used by the application on a
+*              Linux host. Timers count on the monotonic clock or on a virtual
+*              clock, GPIO outputs are recorded, the debug UART is standard
+*              input and output, and interrupts are delivered from
+*              cyhal_syspm_sleep().
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "cyhal.h"
+#include "cybsp.h"
+#include "cy_retarget_io.h"
+#include "cy_tcpwm_counter.h"
+#include "cy_syslib.h"
+#include "ipc_shared.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define HOST_NS_PER_S               (1000000000ULL)
+
+/* Number of timers that can be allocated at the same time */
+#define HOST_TIMER_COUNT            (4U)
+
+/* Number of pins that can be addressed, 8 per port */
+#define HOST_GPIO_COUNT             (256U)
+
+/* Number of PWMs that can be allocated at the same time */
+#define HOST_PWM_COUNT              (4U)
+
+/* Standard input bytes read ahead of cyhal_uart_getc() */
+#define HOST_INPUT_BUFFER_SIZE      (256U)
+
+/* Wait forever in host_input_wait() */
+#define HOST_WAIT_FOREVER           (UINT64_MAX)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Stand-in for the TCPWM block, only its address is used */
+struct TCPWM_Type
+{
+    uint32_t reserved;
+};
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+cyhal_uart_t cy_retarget_io_uart_obj;
+
+static struct TCPWM_Type host_tcpwm;
+
+/* Clock. With HOST_CLOCK=virtual, time only advances when the application
+ * sleeps, straight to the next timer event. */
+static bool host_virtual_clock = false;
+static uint64_t host_virtual_ns = 0;
+static uint64_t host_start_ns = 0;
+static uint64_t host_run_limit_ns = 0;
+
+static cyhal_timer_t *host_timers[HOST_TIMER_COUNT];
+static cyhal_pwm_t *host_pwms[HOST_PWM_COUNT];
+
+/* GPIO output state and trace */
+static bool host_gpio_state[HOST_GPIO_COUNT];
+static bool host_gpio_output[HOST_GPIO_COUNT];
+static uint32_t host_gpio_toggles[HOST_GPIO_COUNT];
+static FILE *host_gpio_trace = NULL;
+
+/* Standard input read ahead, the emulated receive FIFO */
+static uint8_t host_input[HOST_INPUT_BUFFER_SIZE];
+static uint32_t host_input_head = 0;
+static uint32_t host_input_tail = 0;
+static bool host_input_closed = false;
+
+/* UART that receives the receive interrupt */
+static cyhal_uart_t *host_uart = NULL;
+
+static uint32_t host_sleeps = 0;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint64_t host_now_ns(void);
+static uint64_t host_timer_now_ticks(const cyhal_timer_t *obj);
+static bool host_timer_next_event(const cyhal_timer_t *obj, uint64_t after,
+                                  uint64_t *ticks, cyhal_timer_event_t *event);
+static void host_report(void);
+static void host_pwm_account(cyhal_pwm_t *obj);
+
+
+/*******************************************************************************
+* Function Name: host_clock_ns
+********************************************************************************
+* Summary:
+* This function reads the host monotonic clock.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint64_t    Monotonic time in ns
+*
+*******************************************************************************/
+static uint64_t host_clock_ns(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * HOST_NS_PER_S) + (uint64_t)now.tv_nsec;
+}
+
+
+/*******************************************************************************
+* Function Name: host_now_ns
+********************************************************************************
+* Summary:
+* This function returns the time since cybsp_init() on the clock that drives
+* the emulated peripherals.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint64_t    Time in ns
+*
+*******************************************************************************/
+static uint64_t host_now_ns(void)
+{
+    if (host_virtual_clock)
+    {
+        return host_virtual_ns;
+    }
+
+    return host_clock_ns() - host_start_ns;
+}
+
+
+/*******************************************************************************
+* Function Name: host_ns_to_ticks
+********************************************************************************
+* Summary:
+* This function converts a time to the number of counter ticks elapsed at a
+* given frequency, without overflowing for long runs.
+*
+* Parameters:
+*  ns          Time in ns
+*  hz          Counter frequency
+*
+* Return:
+*  uint64_t    Number of whole ticks
+*
+*******************************************************************************/
+static uint64_t host_ns_to_ticks(uint64_t ns, uint32_t hz)
+{
+    return ((ns / HOST_NS_PER_S) * hz) + (((ns % HOST_NS_PER_S) * hz) /
+                                          HOST_NS_PER_S);
+}
+
+
+/*******************************************************************************
+* Function Name: host_ticks_to_ns
+********************************************************************************
+* Summary:
+* This function returns the time at which a tick count is reached.
+*
+* Parameters:
+*  ticks       Number of ticks
+*  hz          Counter frequency
+*
+* Return:
+*  uint64_t    Time in ns, rounded up
+*
+*******************************************************************************/
+static uint64_t host_ticks_to_ns(uint64_t ticks, uint32_t hz)
+{
+    return ((ticks / hz) * HOST_NS_PER_S) +
+           ((((ticks % hz) * HOST_NS_PER_S) + hz - 1U) / hz);
+}
+
+
+/*******************************************************************************
+* Function Name: host_report
+********************************************************************************
+* Summary:
+* This function prints a summary of the run to standard error at exit.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void host_report(void)
+{
+    uint64_t now = host_now_ns();
+    uint32_t pin;
+    uint32_t index;
+
+    for (index = 0U; index < HOST_PWM_COUNT; index++)
+    {
+        if (host_pwms[index] != NULL)
+        {
+            host_pwm_account(host_pwms[index]);
+        }
+    }
+
+    (void)fflush(stdout);
+    (void)fprintf(stderr, "\nhost: %llu.%03llu s (%s clock), %lu sleeps\n",
+                  (unsigned long long)(now / HOST_NS_PER_S),
+                  (unsigned long long)((now % HOST_NS_PER_S) / 1000000U),
+                  host_virtual_clock ? "virtual" : "real",
+                  (unsigned long)host_sleeps);
+
+    for (pin = 0U; pin < HOST_GPIO_COUNT; pin++)
+    {
+        if (host_gpio_toggles[pin] != 0U)
+        {
+            (void)fprintf(stderr, "host: P%u_%u changed %lu times\n",
+                          CYHAL_GET_PORT(pin), CYHAL_GET_PIN(pin),
+                          (unsigned long)host_gpio_toggles[pin]);
+        }
+    }
+
+    if (host_gpio_trace != NULL)
+    {
+        (void)fclose(host_gpio_trace);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: cybsp_init
+********************************************************************************
+* Summary:
+* This function initializes the shared memory, as the CM0+ image does before
+* the CM4 starts, and sets up the host emulation from the environment:
+*  HOST_CLOCK=virtual     run on a virtual clock instead of real time
+*  HOST_RUN_TIME=<s>      exit after this many seconds of (virtual) time
+*  HOST_GPIO_TRACE=<file> record every GPIO output change
+*
+* Parameters:
+*  none
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, or an error if the trace file cannot be
+*              created
+*
+*******************************************************************************/
+cy_rslt_t cybsp_init(void)
+{
+    const char *clock = getenv("HOST_CLOCK");
+    const char *run_time = getenv("HOST_RUN_TIME");
+    const char *trace = getenv("HOST_GPIO_TRACE");
+
+    /* The CM0+ image sets up the shared memory before it starts the CM4 */
+    ipc_shared_init();
+
+    host_start_ns = host_clock_ns();
+    host_virtual_clock = (clock != NULL) && (strcmp(clock, "virtual") == 0);
+
+    if (run_time != NULL)
+    {
+        host_run_limit_ns = (uint64_t)(strtod(run_time, NULL) *
+                                       (double)HOST_NS_PER_S);
+    }
+
+    if (trace != NULL)
+    {
+        host_gpio_trace = fopen(trace, "w");
+        if (host_gpio_trace == NULL)
+        {
+            return CY_RSLT_HOST_ERROR;
+        }
+    }
+
+    (void)atexit(host_report);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: cybsp_config_require
+********************************************************************************
+* Summary:
+* This function applies a board configuration subsystem on the kit. The host
+* has no Device Configurator design, so there is nothing to apply.
+*
+* Parameters:
+*  config      Subsystem required by the driver
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cybsp_config_require(cybsp_config_t config)
+{
+    (void) config;
+}
+
+
+/*******************************************************************************
+* Function Name: cybsp_pm_next
+********************************************************************************
+* Summary:
+* This function walks the SysPm handler registry. The host has no SysPm
+* driver, so no handler is ever registered.
+*
+* Parameters:
+*  handler     Previous handler, or NULL for the first
+*
+* Return:
+*  const cybsp_pm_handler_t *  NULL
+*
+*******************************************************************************/
+const cybsp_pm_handler_t *cybsp_pm_next(const cybsp_pm_handler_t *handler)
+{
+    (void) handler;
+
+    return NULL;
+}
+
+
+/*******************************************************************************
+* Function Name: cybsp_pm_budget
+********************************************************************************
+* Summary:
+* This function returns the handler time of a low power mode transition,
+* which is 0 on the host.
+*
+* Parameters:
+*  type        Low power mode
+*  entry_ns    Entry time in ns
+*  exit_ns     Exit time in ns
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cybsp_pm_budget(cy_en_syspm_callback_type_t type, uint32_t *entry_ns,
+                     uint32_t *exit_ns)
+{
+    (void) type;
+
+    *entry_ns = 0U;
+    *exit_ns = 0U;
+}
+
+
+/*******************************************************************************
+* Function Name: cybsp_pm_reset
+********************************************************************************
+* Summary:
+* This function clears the handler run times, of which the host has none.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cybsp_pm_reset(void)
+{
+}
+
+
+/*******************************************************************************
+* Function Name: cy_retarget_io_init_fc
+********************************************************************************
+* Summary:
+* This function connects the debug UART to standard input and output. The
+* pins, flow control and baud rate are ignored.
+*
+* Parameters:
+*  tx, rx, cts, rts    Debug UART pins, not used
+*  baudrate            Baud rate, not used
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t cy_retarget_io_init_fc(cyhal_gpio_t tx, cyhal_gpio_t rx,
+                                 cyhal_gpio_t cts, cyhal_gpio_t rts,
+                                 uint32_t baudrate)
+{
+    (void)tx;
+    (void)rx;
+    (void)cts;
+    (void)rts;
+    (void)baudrate;
+
+    memset(&cy_retarget_io_uart_obj, 0, sizeof(cy_retarget_io_uart_obj));
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: cy_retarget_io_init
+********************************************************************************
+* Summary:
+* This function connects the debug UART without flow control.
+*
+* Parameters:
+*  tx, rx      Debug UART pins, not used
+*  baudrate    Baud rate, not used
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t cy_retarget_io_init(cyhal_gpio_t tx, cyhal_gpio_t rx,
+                              uint32_t baudrate)
+{
+    return cy_retarget_io_init_fc(tx, rx, NC, NC, baudrate);
+}
+
+
+/*******************************************************************************
+* Function Name: host_trace
+********************************************************************************
+* Summary:
+* This function writes a line to the GPIO trace file, if there is one,
+* prefixed with the time and the pin name.
+*
+* Parameters:
+*  pin         Pin the line is about
+*  line        Rest of the line, without the line feed
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void host_trace(cyhal_gpio_t pin, const char *line)
+{
+    uint64_t now;
+
+    if (host_gpio_trace != NULL)
+    {
+        now = host_now_ns();
+        (void)fprintf(host_gpio_trace, "%llu.%09llu P%u_%u %s\n",
+                      (unsigned long long)(now / HOST_NS_PER_S),
+                      (unsigned long long)(now % HOST_NS_PER_S),
+                      CYHAL_GET_PORT(pin), CYHAL_GET_PIN(pin), line);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: host_gpio_set
+********************************************************************************
+* Summary:
+* This function updates an output pin and records the change.
+*
+* Parameters:
+*  pin         Pin to update
+*  value       New level
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void host_gpio_set(cyhal_gpio_t pin, bool value)
+{
+    if ((pin >= HOST_GPIO_COUNT) || (host_gpio_state[pin] == value))
+    {
+        return;
+    }
+
+    host_gpio_state[pin] = value;
+    host_gpio_toggles[pin]++;
+
+    host_trace(pin, value ? "1" : "0");
+}
+
+
+/*******************************************************************************
+* HAL GPIO
+********************************************************************************
+* Outputs keep their level in host_gpio_state. Every change is counted for the
+* exit report and written to the trace file.
+*******************************************************************************/
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction,
+                          cyhal_gpio_drive_mode_t drive_mode, bool init_val)
+{
+    (void)drive_mode;
+
+    if (pin >= HOST_GPIO_COUNT)
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+
+    host_gpio_output[pin] = (direction != CYHAL_GPIO_DIR_INPUT);
+    host_gpio_state[pin] = init_val;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+void cyhal_gpio_free(cyhal_gpio_t pin)
+{
+    if (pin < HOST_GPIO_COUNT)
+    {
+        host_gpio_output[pin] = false;
+    }
+}
+
+
+void cyhal_gpio_write(cyhal_gpio_t pin, bool value)
+{
+    if ((pin < HOST_GPIO_COUNT) && host_gpio_output[pin])
+    {
+        host_gpio_set(pin, value);
+    }
+}
+
+
+bool cyhal_gpio_read(cyhal_gpio_t pin)
+{
+    return (pin < HOST_GPIO_COUNT) ? host_gpio_state[pin] : false;
+}
+
+
+void cyhal_gpio_toggle(cyhal_gpio_t pin)
+{
+    cyhal_gpio_write(pin, !cyhal_gpio_read(pin));
+}
+
+
+/*******************************************************************************
+* Function Name: host_timer_now_ticks
+********************************************************************************
+* Summary:
+* This function returns the number of ticks of a timer's clock since boot.
+*
+* Parameters:
+*  obj         Timer
+*
+* Return:
+*  uint64_t    Tick count
+*
+*******************************************************************************/
+static uint64_t host_timer_now_ticks(const cyhal_timer_t *obj)
+{
+    return host_ns_to_ticks(host_now_ns(), obj->frequency_hz);
+}
+
+
+/*******************************************************************************
+* Function Name: host_timer_count_at
+********************************************************************************
+* Summary:
+* This function returns the counter value of a running timer at a tick count.
+*
+* Parameters:
+*  obj         Timer
+*  ticks       Tick count since boot
+*
+* Return:
+*  uint32_t    Counter value
+*
+*******************************************************************************/
+static uint32_t host_timer_count_at(const cyhal_timer_t *obj, uint64_t ticks)
+{
+    uint64_t period = (uint64_t)obj->cfg.period + 1U;
+
+    return (uint32_t)((obj->cfg.value + (ticks - obj->start_ticks)) % period);
+}
+
+
+/*******************************************************************************
+* Function Name: host_timer_next_event
+********************************************************************************
+* Summary:
+* This function finds the first enabled event of a running timer after a tick
+* count. The compare event occurs when the counter reaches the compare value,
+* the terminal count event when it wraps to zero.
+*
+* Parameters:
+*  obj         Timer
+*  after       Tick count to search from, exclusive
+*  ticks       Returns the tick count of the event
+*  event       Returns the events occurring at that tick count
+*
+* Return:
+*  bool        true if there is such an event
+*
+*******************************************************************************/
+static bool host_timer_next_event(const cyhal_timer_t *obj, uint64_t after,
+                                  uint64_t *ticks, cyhal_timer_event_t *event)
+{
+    uint64_t period = (uint64_t)obj->cfg.period + 1U;
+    uint64_t count;
+    uint64_t distance;
+    uint64_t nearest = UINT64_MAX;
+    uint32_t events = CYHAL_TIMER_IRQ_NONE;
+
+    if ((!obj->running) || (obj->callback == NULL))
+    {
+        return false;
+    }
+
+    count = host_timer_count_at(obj, after);
+
+    if ((0U != (obj->events & CYHAL_TIMER_IRQ_CAPTURE_COMPARE)) &&
+        obj->cfg.is_compare)
+    {
+        distance = ((obj->cfg.compare_value + period) - count) % period;
+        nearest = (distance == 0U) ? period : distance;
+        events = CYHAL_TIMER_IRQ_CAPTURE_COMPARE;
+    }
+
+    if (0U != (obj->events & CYHAL_TIMER_IRQ_TERMINAL_COUNT))
+    {
+        distance = period - count;
+        if (distance < nearest)
+        {
+            nearest = distance;
+            events = CYHAL_TIMER_IRQ_TERMINAL_COUNT;
+        }
+        else if (distance == nearest)
+        {
+            events |= CYHAL_TIMER_IRQ_TERMINAL_COUNT;
+        }
+    }
+
+    if (events == CYHAL_TIMER_IRQ_NONE)
+    {
+        return false;
+    }
+
+    *ticks = after + nearest;
+    *event = (cyhal_timer_event_t)events;
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: host_timer_latch
+********************************************************************************
+* Summary:
+* This function latches the events a timer has raised up to now as pending,
+* like the interrupt flags of the TCPWM.
+*
+* Parameters:
+*  obj         Timer
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void host_timer_latch(cyhal_timer_t *obj)
+{
+    uint64_t now = host_timer_now_ticks(obj);
+    uint64_t ticks;
+    cyhal_timer_event_t event;
+
+    if (host_timer_next_event(obj, obj->polled_ticks, &ticks, &event) &&
+        (ticks <= now))
+    {
+        obj->pending = (cyhal_timer_event_t)(obj->pending | event);
+    }
+
+    obj->polled_ticks = now;
+}
+
+
+/*******************************************************************************
+* Function Name: host_timer_rebase
+********************************************************************************
+* Summary:
+* This function freezes the current counter value as the new starting point,
+* before the counter is stopped or its clock changes.
+*
+* Parameters:
+*  obj         Timer
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void host_timer_rebase(cyhal_timer_t *obj)
+{
+    host_timer_latch(obj);
+
+    if (obj->running)
+    {
+        obj->cfg.value = host_timer_count_at(obj, obj->polled_ticks);
+    }
+    obj->start_ticks = obj->polled_ticks;
+}
+
+
+/*******************************************************************************
+* HAL clock
+********************************************************************************
+* The clock tree of the host does not change, so a divider only keeps what it
+* was set to.
+*******************************************************************************/
+cy_rslt_t cyhal_clock_allocate(cyhal_clock_t *clock, cyhal_clock_block_t block)
+{
+    (void)block;
+
+    memset(clock, 0, sizeof(*clock));
+    clock->divider = 1U;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+cy_rslt_t cyhal_clock_set_frequency(cyhal_clock_t *clock, uint32_t hz,
+                                    const cyhal_clock_tolerance_t *tolerance)
+{
+    (void)tolerance;
+
+    if (hz == 0U)
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+
+    clock->frequency_hz = hz;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+uint32_t cyhal_clock_get_frequency(const cyhal_clock_t *clock)
+{
+    return clock->frequency_hz;
+}
+
+
+cy_rslt_t cyhal_clock_set_enabled(cyhal_clock_t *clock, bool enabled,
+                                  bool wait_for_lock)
+{
+    (void)wait_for_lock;
+
+    clock->enabled = enabled;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+void cyhal_clock_free(cyhal_clock_t *clock)
+{
+    clock->enabled = false;
+}
+
+
+/*******************************************************************************
+* HAL timer
+********************************************************************************
+* The counter value is derived from the clock: it is cfg.value at start_ticks
+* and counts up from there, wrapping after cfg.period. Only the up counting,
+* continuous mode is emulated.
+*******************************************************************************/
+cy_rslt_t cyhal_timer_init(cyhal_timer_t *obj, cyhal_gpio_t pin,
+                           const cyhal_clock_t *clk)
+{
+    uint8_t channel;
+
+    (void)pin;
+
+    for (channel = 0U; channel < HOST_TIMER_COUNT; channel++)
+    {
+        if (host_timers[channel] == NULL)
+        {
+            memset(obj, 0, sizeof(*obj));
+            obj->tcpwm.base = &host_tcpwm;
+            obj->tcpwm.resource.type = CYHAL_RSC_TCPWM;
+            obj->tcpwm.resource.channel_num = channel;
+            obj->cfg.period = 0xFFFFFFFFU;
+            obj->frequency_hz = ((clk != NULL) && (clk->frequency_hz != 0U)) ?
+                                clk->frequency_hz : 1000000U;
+            host_timers[channel] = obj;
+
+            return CY_RSLT_SUCCESS;
+        }
+    }
+
+    return CY_RSLT_HOST_ERROR;
+}
+
+
+void cyhal_timer_free(cyhal_timer_t *obj)
+{
+    host_timers[obj->tcpwm.resource.channel_num] = NULL;
+}
+
+
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t *obj,
+                                const cyhal_timer_cfg_t *cfg)
+{
+    /* Only the up counting, continuous mode is emulated */
+    if ((cfg->direction != CYHAL_TIMER_DIR_UP) || (!cfg->is_continuous))
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+
+    host_timer_rebase(obj);
+    obj->cfg = *cfg;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+cy_rslt_t cyhal_timer_set_frequency(cyhal_timer_t *obj, uint32_t hz)
+{
+    if (hz == 0U)
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+
+    host_timer_rebase(obj);
+    obj->frequency_hz = hz;
+    obj->start_ticks = host_timer_now_ticks(obj);
+    obj->polled_ticks = obj->start_ticks;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+cy_rslt_t cyhal_timer_start(cyhal_timer_t *obj)
+{
+    host_timer_rebase(obj);
+    obj->running = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+cy_rslt_t cyhal_timer_stop(cyhal_timer_t *obj)
+{
+    host_timer_rebase(obj);
+    obj->running = false;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+cy_rslt_t cyhal_timer_reset(cyhal_timer_t *obj)
+{
+    host_timer_rebase(obj);
+    obj->cfg.value = 0U;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+uint32_t cyhal_timer_read(const cyhal_timer_t *obj)
+{
+    if (!obj->running)
+    {
+        return obj->cfg.value;
+    }
+
+    return host_timer_count_at(obj, host_timer_now_ticks(obj));
+}
+
+
+void cyhal_timer_register_callback(cyhal_timer_t *obj,
+                                   cyhal_timer_event_callback_t callback,
+                                   void *callback_arg)
+{
+    obj->callback = callback;
+    obj->callback_arg = callback_arg;
+}
+
+
+void cyhal_timer_enable_event(cyhal_timer_t *obj, cyhal_timer_event_t event,
+                              uint8_t intr_priority, bool enable)
+{
+    (void)intr_priority;
+
+    host_timer_latch(obj);
+
+    if (enable)
+    {
+        obj->events = (cyhal_timer_event_t)(obj->events | event);
+    }
+    else
+    {
+        obj->events = (cyhal_timer_event_t)(obj->events & ~event);
+        obj->pending = (cyhal_timer_event_t)(obj->pending & ~event);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_Counter_SetCompare0
+********************************************************************************
+* Summary:
+* This function changes the compare value of a running counter. Events raised
+* with the old value are kept pending.
+*
+* Parameters:
+*  base        TCPWM block, the host stand-in
+*  cntNum      Counter number, as in the timer's resource
+*  compare0    New compare value
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_TCPWM_Counter_SetCompare0(TCPWM_Type *base, uint32_t cntNum,
+                                  uint32_t compare0)
+{
+    cyhal_timer_t *obj;
+
+    if ((base != &host_tcpwm) || (cntNum >= HOST_TIMER_COUNT) ||
+        (host_timers[cntNum] == NULL))
+    {
+        return;
+    }
+
+    obj = host_timers[cntNum];
+    host_timer_latch(obj);
+    obj->cfg.compare_value = compare0;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_Counter_GetCounter
+********************************************************************************
+* Summary:
+* This function reads the counter of a timer, as the CM0+ reads the timebase.
+*
+* Parameters:
+*  base        TCPWM block, the host stand-in
+*  cntNum      Counter number, as in the timer's resource
+*
+* Return:
+*  uint32_t    Counter value, 0 for an unknown counter
+*
+*******************************************************************************/
+uint32_t Cy_TCPWM_Counter_GetCounter(TCPWM_Type const *base, uint32_t cntNum)
+{
+    if ((base != &host_tcpwm) || (cntNum >= HOST_TIMER_COUNT) ||
+        (host_timers[cntNum] == NULL))
+    {
+        return 0U;
+    }
+
+    return cyhal_timer_read(host_timers[cntNum]);
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_GetInterruptStatus
+********************************************************************************
+* Summary:
+* This function returns the interrupt flags of a counter: its enabled events
+* that have occurred and not been delivered yet.
+*
+* Parameters:
+*  base        TCPWM block, the host stand-in
+*  cntNum      Counter number, as in the timer's resource
+*
+* Return:
+*  uint32_t    CY_TCPWM_INT_ON_TC and CY_TCPWM_INT_ON_CC flags
+*
+*******************************************************************************/
+uint32_t Cy_TCPWM_GetInterruptStatus(TCPWM_Type const *base, uint32_t cntNum)
+{
+    cyhal_timer_t *obj;
+    uint32_t status = 0U;
+
+    if ((base != &host_tcpwm) || (cntNum >= HOST_TIMER_COUNT) ||
+        (host_timers[cntNum] == NULL))
+    {
+        return 0U;
+    }
+
+    obj = host_timers[cntNum];
+    host_timer_latch(obj);
+
+    if (0U != (obj->pending & CYHAL_TIMER_IRQ_TERMINAL_COUNT))
+    {
+        status |= CY_TCPWM_INT_ON_TC;
+    }
+    if (0U != (obj->pending & CYHAL_TIMER_IRQ_CAPTURE_COMPARE))
+    {
+        status |= CY_TCPWM_INT_ON_CC;
+    }
+
+    return status;
+}
+
+
+/*******************************************************************************
+* Function Name: Cy_TCPWM_ClearInterrupt
+********************************************************************************
+* Summary:
+* This function clears interrupt flags of a counter, so that the events are
+* not delivered.
+*
+* Parameters:
+*  base        TCPWM block, the host stand-in
+*  cntNum      Counter number, as in the timer's resource
+*  source      CY_TCPWM_INT_ON_TC and CY_TCPWM_INT_ON_CC flags to clear
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_TCPWM_ClearInterrupt(TCPWM_Type *base, uint32_t cntNum,
+                             uint32_t source)
+{
+    cyhal_timer_t *obj;
+    uint32_t events = CYHAL_TIMER_IRQ_NONE;
+
+    if ((base != &host_tcpwm) || (cntNum >= HOST_TIMER_COUNT) ||
+        (host_timers[cntNum] == NULL))
+    {
+        return;
+    }
+
+    if (0U != (source & CY_TCPWM_INT_ON_TC))
+    {
+        events |= CYHAL_TIMER_IRQ_TERMINAL_COUNT;
+    }
+    if (0U != (source & CY_TCPWM_INT_ON_CC))
+    {
+        events |= CYHAL_TIMER_IRQ_CAPTURE_COMPARE;
+    }
+
+    obj = host_timers[cntNum];
+    host_timer_latch(obj);
+    obj->pending = (cyhal_timer_event_t)(obj->pending & ~events);
+}
+
+
+/*******************************************************************************
+* Function Name: host_input_wait
+********************************************************************************
+* Summary:
+* This function reads standard input into the read ahead buffer, waiting up to
+* the given time for data. Line feeds are turned into carriage returns, which
+* is what a terminal sends for the 'Enter' key.
+*
+* Parameters:
+*  timeout_ns  Time to wait, 0 to only read what is available or
+*              HOST_WAIT_FOREVER
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void host_input_wait(uint64_t timeout_ns)
+{
+    struct pollfd input = { .fd = STDIN_FILENO, .events = POLLIN };
+    struct timespec timeout;
+    uint8_t data[HOST_INPUT_BUFFER_SIZE];
+    uint32_t room = HOST_INPUT_BUFFER_SIZE - (host_input_head - host_input_tail);
+    ssize_t length;
+    ssize_t index;
+    int ready;
+
+    if (host_input_closed || (room == 0U))
+    {
+        if (timeout_ns != HOST_WAIT_FOREVER)
+        {
+            timeout.tv_sec = (time_t)(timeout_ns / HOST_NS_PER_S);
+            timeout.tv_nsec = (long)(timeout_ns % HOST_NS_PER_S);
+            (void)nanosleep(&timeout, NULL);
+        }
+        return;
+    }
+
+    timeout.tv_sec = (time_t)(timeout_ns / HOST_NS_PER_S);
+    timeout.tv_nsec = (long)(timeout_ns % HOST_NS_PER_S);
+    ready = ppoll(&input, 1, (timeout_ns == HOST_WAIT_FOREVER) ? NULL : &timeout,
+                  NULL);
+    if (ready <= 0)
+    {
+        return;
+    }
+
+    length = read(STDIN_FILENO, data, room);
+    if (length <= 0)
+    {
+        if ((length == 0) || (errno != EINTR))
+        {
+            host_input_closed = true;
+        }
+        return;
+    }
+
+    for (index = 0; index < length; index++)
+    {
+        host_input[host_input_head % HOST_INPUT_BUFFER_SIZE] =
+            (data[index] == '\n') ? (uint8_t)'\r' : data[index];
+        host_input_head++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: host_pwm_account
+********************************************************************************
+* Summary:
+* This function adds the level changes a running PWM output has made since it
+* was started to the change count of its pin.
+*
+* Parameters:
+*  obj         PWM
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void host_pwm_account(cyhal_pwm_t *obj)
+{
+    uint64_t now = host_now_ns();
+    uint64_t periods;
+
+    if (obj->running && (obj->period_us != 0U) && (obj->pulse_width_us != 0U) &&
+        (obj->pulse_width_us < obj->period_us) && (obj->pin < HOST_GPIO_COUNT))
+    {
+        periods = (now - obj->start_ns) / ((uint64_t)obj->period_us * 1000U);
+        host_gpio_toggles[obj->pin] += (uint32_t)(2U * periods);
+    }
+
+    obj->start_ns = now;
+}
+
+
+/*******************************************************************************
+* HAL PWM
+********************************************************************************
+* The output waveform is not simulated edge by edge: the trace file gets a
+* line when the PWM starts, changes or stops, and the level changes made in
+* between are added to the pin's count.
+*******************************************************************************/
+cy_rslt_t cyhal_pwm_init(cyhal_pwm_t *obj, cyhal_gpio_t pin,
+                         const cyhal_clock_t *clk)
+{
+    uint32_t index;
+
+    (void)clk;
+
+    if ((pin >= HOST_GPIO_COUNT) || host_gpio_output[pin])
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+
+    for (index = 0U; index < HOST_PWM_COUNT; index++)
+    {
+        if (host_pwms[index] == NULL)
+        {
+            memset(obj, 0, sizeof(*obj));
+            obj->pin = pin;
+            host_pwms[index] = obj;
+
+            return CY_RSLT_SUCCESS;
+        }
+    }
+
+    return CY_RSLT_HOST_ERROR;
+}
+
+
+void cyhal_pwm_free(cyhal_pwm_t *obj)
+{
+    uint32_t index;
+
+    (void)cyhal_pwm_stop(obj);
+
+    for (index = 0U; index < HOST_PWM_COUNT; index++)
+    {
+        if (host_pwms[index] == obj)
+        {
+            host_pwms[index] = NULL;
+        }
+    }
+}
+
+
+cy_rslt_t cyhal_pwm_set_period(cyhal_pwm_t *obj, uint32_t period_us,
+                               uint32_t pulse_width_us)
+{
+    char line[48];
+
+    if (pulse_width_us > period_us)
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+
+    host_pwm_account(obj);
+    obj->period_us = period_us;
+    obj->pulse_width_us = pulse_width_us;
+
+    if (obj->running)
+    {
+        (void)snprintf(line, sizeof(line), "pwm %lu/%lu us",
+                       (unsigned long)pulse_width_us, (unsigned long)period_us);
+        host_trace(obj->pin, line);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+cy_rslt_t cyhal_pwm_set_duty_cycle(cyhal_pwm_t *obj, float duty_cycle,
+                                   uint32_t frequencyhz)
+{
+    uint32_t period_us;
+
+    if ((frequencyhz == 0U) || (duty_cycle < 0.0f) || (duty_cycle > 100.0f))
+    {
+        return CY_RSLT_HOST_ERROR;
+    }
+
+    period_us = 1000000U / frequencyhz;
+
+    return cyhal_pwm_set_period(obj, period_us,
+                                (uint32_t)(((float)period_us * duty_cycle) /
+                                           100.0f));
+}
+
+
+cy_rslt_t cyhal_pwm_start(cyhal_pwm_t *obj)
+{
+    char line[48];
+
+    if (!obj->running)
+    {
+        obj->running = true;
+        obj->start_ns = host_now_ns();
+
+        (void)snprintf(line, sizeof(line), "pwm %lu/%lu us",
+                       (unsigned long)obj->pulse_width_us,
+                       (unsigned long)obj->period_us);
+        host_trace(obj->pin, line);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+cy_rslt_t cyhal_pwm_stop(cyhal_pwm_t *obj)
+{
+    if (obj->running)
+    {
+        host_pwm_account(obj);
+        obj->running = false;
+
+        host_trace(obj->pin, "pwm stop");
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* HAL UART
+********************************************************************************
+* The receive FIFO is the standard input read ahead buffer, transmitted bytes
+* go to standard output.
+*******************************************************************************/
+cy_rslt_t cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value, uint32_t timeout)
+{
+    (void)obj;
+
+    if (host_input_head == host_input_tail)
+    {
+        host_input_wait((timeout == 0U) ? HOST_WAIT_FOREVER :
+                        ((uint64_t)timeout * 1000000U));
+    }
+
+    if (host_input_head == host_input_tail)
+    {
+        return CY_RSLT_ERR_CSP_UART_GETC_TIMEOUT;
+    }
+
+    *value = host_input[host_input_tail % HOST_INPUT_BUFFER_SIZE];
+    host_input_tail++;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+cy_rslt_t cyhal_uart_putc(cyhal_uart_t *obj, uint32_t value)
+{
+    (void)obj;
+
+    (void)putchar((int)(value & 0xFFU));
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+uint32_t cyhal_uart_readable(cyhal_uart_t *obj)
+{
+    (void)obj;
+
+    if (host_input_head == host_input_tail)
+    {
+        host_input_wait(0U);
+    }
+
+    return host_input_head - host_input_tail;
+}
+
+
+void cyhal_uart_register_callback(cyhal_uart_t *obj,
+                                  cyhal_uart_event_callback_t callback,
+                                  void *callback_arg)
+{
+    obj->callback = callback;
+    obj->callback_arg = callback_arg;
+    host_uart = obj;
+}
+
+
+void cyhal_uart_enable_event(cyhal_uart_t *obj, cyhal_uart_event_t event,
+                             uint8_t intr_priority, bool enable)
+{
+    (void)intr_priority;
+
+    if (enable)
+    {
+        obj->events = (cyhal_uart_event_t)(obj->events | event);
+    }
+    else
+    {
+        obj->events = (cyhal_uart_event_t)(obj->events & ~event);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: host_dispatch
+********************************************************************************
+* Summary:
+* This function runs the interrupt callbacks of every event that has occurred:
+* pending and due timer events, and the receive interrupt while there is
+* unread input.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true if a callback was run
+*
+*******************************************************************************/
+static bool host_dispatch(void)
+{
+    cyhal_timer_t *obj;
+    cyhal_timer_event_t event;
+    uint32_t channel;
+    bool dispatched = false;
+
+    for (channel = 0U; channel < HOST_TIMER_COUNT; channel++)
+    {
+        obj = host_timers[channel];
+        if (obj == NULL)
+        {
+            continue;
+        }
+
+        host_timer_latch(obj);
+        event = (cyhal_timer_event_t)(obj->pending & obj->events);
+        obj->pending = CYHAL_TIMER_IRQ_NONE;
+
+        if ((event != CYHAL_TIMER_IRQ_NONE) && (obj->callback != NULL))
+        {
+            obj->callback(obj->callback_arg, event);
+            dispatched = true;
+        }
+    }
+
+    if ((host_uart != NULL) && (host_uart->callback != NULL) &&
+        (0U != (host_uart->events & CYHAL_UART_IRQ_RX_NOT_EMPTY)) &&
+        (cyhal_uart_readable(host_uart) > 0U))
+    {
+        host_uart->callback(host_uart->callback_arg,
+                            CYHAL_UART_IRQ_RX_NOT_EMPTY);
+        dispatched = true;
+    }
+
+    return dispatched;
+}
+
+
+/*******************************************************************************
+* Function Name: host_next_event_ns
+********************************************************************************
+* Summary:
+* This function returns the time of the next timer event.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint64_t    Time in ns, HOST_WAIT_FOREVER if no timer event is enabled
+*
+*******************************************************************************/
+static uint64_t host_next_event_ns(void)
+{
+    uint64_t next = HOST_WAIT_FOREVER;
+    uint64_t ticks;
+    uint64_t event_ns;
+    cyhal_timer_event_t event;
+    uint32_t channel;
+
+    for (channel = 0U; channel < HOST_TIMER_COUNT; channel++)
+    {
+        if ((host_timers[channel] != NULL) &&
+            host_timer_next_event(host_timers[channel],
+                                  host_timers[channel]->polled_ticks,
+                                  &ticks, &event))
+        {
+            event_ns = host_ticks_to_ns(ticks,
+                                        host_timers[channel]->frequency_hz);
+            if (event_ns < next)
+            {
+                next = event_ns;
+            }
+        }
+    }
+
+    if ((host_run_limit_ns != 0U) && (host_run_limit_ns < next))
+    {
+        next = host_run_limit_ns;
+    }
+
+    return next;
+}
+
+
+/*******************************************************************************
+* Function Name: cyhal_syspm_sleep
+********************************************************************************
+* Summary:
+* This function waits for the next interrupt and runs its callback. It
+* returns immediately if an event is already pending, like WFI. On the
+* virtual clock, time jumps to the next timer event unless input is
+* available. The process exits at HOST_RUN_TIME, or when no event can occur
+* any more.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t cyhal_syspm_sleep(void)
+{
+    uint64_t next;
+    uint64_t now;
+
+    host_sleeps++;
+    (void)fflush(stdout);
+
+    if (host_dispatch())
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    next = host_next_event_ns();
+    now = host_now_ns();
+
+    if ((host_run_limit_ns != 0U) && (now >= host_run_limit_ns))
+    {
+        exit(EXIT_SUCCESS);
+    }
+
+    if (host_virtual_clock)
+    {
+        host_input_wait(0U);
+        if ((host_input_head == host_input_tail) || (host_uart == NULL))
+        {
+            if (next == HOST_WAIT_FOREVER)
+            {
+                if (host_input_closed)
+                {
+                    exit(EXIT_SUCCESS);
+                }
+                host_input_wait(HOST_WAIT_FOREVER);
+            }
+            else if (next > host_virtual_ns)
+            {
+                host_virtual_ns = next;
+            }
+        }
+    }
+    else if (next == HOST_WAIT_FOREVER)
+    {
+        if (host_input_closed)
+        {
+            exit(EXIT_SUCCESS);
+        }
+        host_input_wait(HOST_WAIT_FOREVER);
+    }
+    else if (next > now)
+    {
+        host_input_wait(next - now);
+    }
+
+    (void)host_dispatch();
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* HAL system and PDL critical section
+********************************************************************************
+* Interrupt callbacks only run from cyhal_syspm_sleep(), so there is nothing
+* to mask in a critical section.
+*******************************************************************************/
+uint32_t cyhal_system_critical_section_enter(void)
+{
+    return 0U;
+}
+
+
+void cyhal_system_critical_section_exit(uint32_t old_state)
+{
+    (void)old_state;
+}
+
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    return cyhal_system_critical_section_enter();
+}
+
+
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    cyhal_system_critical_section_exit(savedIntrStatus);
+}
+
+
+void cyhal_system_delay_ms(uint32_t milliseconds)
+{
+    struct timespec delay =
+    {
+        .tv_sec = (time_t)(milliseconds / 1000U),
+        .tv_nsec = (long)((milliseconds % 1000U) * 1000000U)
+    };
+
+    if (host_virtual_clock)
+    {
+        host_virtual_ns += (uint64_t)milliseconds * 1000000U;
+    }
+    else
+    {
+        (void)nanosleep(&delay, NULL);
+    }
+}
+
+/* [] END OF FILE */
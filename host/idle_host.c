@@ -0,0 +1,127 @@
+/******************************************************************************
+* File Name:   idle_host.c
+*
+* Description: This file implements the idle manager interface of source/idle.h
+*              for the Linux host build. The host has no Deep Sleep, so the
+*              event loop always sleeps until the next emulated interrupt; the
+*              locks are only counted. The soft timer clock stands in for the
+*              LPTimer, and as there are no SysPm callbacks the Sleep
+*              transitions are reported to the power state tracker here.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "idle.h"
+#include "power_stats.h"
+#include "soft_timer.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uint32_t idle_locks = 0;
+static uint32_t idle_tick_hz = 0;
+
+
+cy_rslt_t idle_init(uint32_t tick_hz, cyhal_gpio_t wake_pin,
+                    uint32_t hold_ticks)
+{
+    (void) wake_pin;
+    (void) hold_ticks;
+
+    idle_tick_hz = tick_hz;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+void idle_sleep(void)
+{
+    power_stats_enter(POWER_STATE_SLEEP);
+    cyhal_syspm_sleep();
+    power_stats_enter(POWER_STATE_ACTIVE);
+    power_stats_wake(POWER_WAKE_OTHER);
+}
+
+
+void idle_lock(void)
+{
+    idle_locks++;
+}
+
+
+void idle_unlock(void)
+{
+    CY_ASSERT(idle_locks != 0U);
+    idle_locks--;
+}
+
+
+void idle_hold(void)
+{
+}
+
+
+void idle_get_stats(idle_stats_t *stats)
+{
+    stats->deepsleeps = 0U;
+    stats->refused = 0U;
+    stats->late = 0U;
+    stats->wake_latency_us = 0U;
+    stats->wake_latency_max_us = 0U;
+}
+
+
+void idle_print_stats(void)
+{
+    printf("Deep Sleep: not emulated, %lu locks held\r\n",
+           (unsigned long)idle_locks);
+}
+
+
+uint32_t idle_lf_read(void)
+{
+    return (idle_tick_hz == 0U) ? 0U : soft_timer_now();
+}
+
+
+uint32_t idle_lf_frequency(void)
+{
+    return idle_tick_hz;
+}
+
+/* [] END OF FILE */
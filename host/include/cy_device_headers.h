@@ -0,0 +1,125 @@
+/******************************************************************************
+* File Name:   cy_device_headers.h
+*
+* Description: This file provides the subset of the device and CMSIS core
+*              definitions used by the application for the Linux host build.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CY_DEVICE_HEADERS_H
+#define CY_DEVICE_HEADERS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define __STATIC_INLINE             static inline
+#define __STATIC_FORCEINLINE        static inline __attribute__((always_inline))
+#define __WEAK                      __attribute__((weak))
+#define __USED                      __attribute__((used))
+
+/* Static storage the startup code leaves alone, zeroed on the host */
+#define CY_NOINIT
+
+/* There is only one thread on the host and the emulated interrupts run from
+ * cyhal_syspm_sleep(), so these are compiler barriers at most */
+#define __DMB()                     __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#define __DSB()                     __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#define __ISB()                     __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#define __NOP()                     do { } while (0)
+#define __enable_irq()              do { } while (0)
+#define __disable_irq()             do { } while (0)
+
+
+/*******************************************************************************
+* Function Name: __CLZ
+********************************************************************************
+* Summary:
+* This function counts the leading zero bits, 32 for a zero value as on the
+* Cortex-M4.
+*
+* Parameters:
+*  value       Value to scan
+*
+* Return:
+*  uint32_t    Number of leading zero bits
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t __CLZ(uint32_t value)
+{
+    return (value == 0U) ? 32U : (uint32_t)__builtin_clz(value);
+}
+
+
+/*******************************************************************************
+* Function Name: __RBIT
+********************************************************************************
+* Summary:
+* This function reverses the bit order of a value.
+*
+* Parameters:
+*  value       Value to reverse
+*
+* Return:
+*  uint32_t    Reversed value
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t __RBIT(uint32_t value)
+{
+    value = ((value >> 1) & 0x55555555U) | ((value & 0x55555555U) << 1);
+    value = ((value >> 2) & 0x33333333U) | ((value & 0x33333333U) << 2);
+    value = ((value >> 4) & 0x0F0F0F0FU) | ((value & 0x0F0F0F0FU) << 4);
+
+    return __builtin_bswap32(value);
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CY_DEVICE_HEADERS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,151 @@
+/******************************************************************************
+* File Name:   cybsp.h
+*
+* Description: This file declares the board support of the Linux host build: the
+*              pins of the CY8CKIT-062S2-43012 used by the application and
+*              cybsp_init().
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CYBSP_H
+#define CYBSP_H
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Same pin assignment as the kit */
+#define CYBSP_USER_LED              CYHAL_GET_GPIO(1U, 5U)
+#define CYBSP_USER_LED1             CYBSP_USER_LED
+#define CYBSP_USER_LED2             CYHAL_GET_GPIO(11U, 1U)
+#define CYBSP_LED_RGB_RED           CYHAL_GET_GPIO(1U, 1U)
+#define CYBSP_LED_RGB_GREEN         CYHAL_GET_GPIO(0U, 5U)
+#define CYBSP_LED_RGB_BLUE          CYHAL_GET_GPIO(7U, 3U)
+#define CYBSP_DEBUG_UART_RX         CYHAL_GET_GPIO(5U, 0U)
+#define CYBSP_DEBUG_UART_TX         CYHAL_GET_GPIO(5U, 1U)
+#define CYBSP_DEBUG_UART_RTS        CYHAL_GET_GPIO(5U, 2U)
+#define CYBSP_DEBUG_UART_CTS        CYHAL_GET_GPIO(5U, 3U)
+
+/* The user LEDs are active low */
+#define CYBSP_LED_STATE_ON          (0U)
+#define CYBSP_LED_STATE_OFF         (1U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Startup stages of the cybsp_boot_mark() hook, see cybsp_boot.h of the
+ * BSP. The host cybsp_init() marks none of them. */
+typedef enum
+{
+    CYBSP_BOOT_DATA_INIT,
+    CYBSP_BOOT_SYSTEM_INIT,
+    CYBSP_BOOT_HWMGR,
+    CYBSP_BOOT_SYSPM,
+    CYBSP_BOOT_CYCFG,
+    CYBSP_BOOT_CYBSP
+} cybsp_boot_stage_t;
+
+/* Board configuration subsystems of cybsp_config_require(). The host has no
+ * Device Configurator design. */
+typedef enum
+{
+    CYBSP_CONFIG_CLOCKS,
+    CYBSP_CONFIG_ROUTING,
+    CYBSP_CONFIG_PERIPHERALS,
+    CYBSP_CONFIG_PINS,
+    CYBSP_CONFIG_CLK_LF,
+    CYBSP_CONFIG_COUNT
+} cybsp_config_t;
+
+/* Low power modes of the SysPm handler registry */
+typedef enum
+{
+    CY_SYSPM_SLEEP,
+    CY_SYSPM_DEEPSLEEP
+} cy_en_syspm_callback_type_t;
+
+typedef enum
+{
+    CYBSP_PM_PHASE_CHECK,
+    CYBSP_PM_PHASE_ENTRY,
+    CYBSP_PM_PHASE_EXIT,
+    CYBSP_PM_PHASE_COUNT
+} cybsp_pm_phase_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint32_t last_ns;
+    uint32_t max_ns;
+} cybsp_pm_timing_t;
+
+/* The reporting fields of a registered handler */
+typedef struct cybsp_pm_handler
+{
+    const char *name;
+    cy_en_syspm_callback_type_t type;
+    cybsp_pm_timing_t timing[CYBSP_PM_PHASE_COUNT];
+    struct cybsp_pm_handler *next;
+} cybsp_pm_handler_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t cybsp_init(void);
+void cybsp_config_require(cybsp_config_t config);
+void cybsp_boot_mark(uint32_t stage);
+const cybsp_pm_handler_t *cybsp_pm_next(const cybsp_pm_handler_t *handler);
+void cybsp_pm_budget(cy_en_syspm_callback_type_t type, uint32_t *entry_ns,
+                     uint32_t *exit_ns);
+void cybsp_pm_reset(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CYBSP_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,312 @@
+/******************************************************************************
+* File Name:   cyhal.h
+*
+* Description: This file declares the subset of the HAL and PDL used by the
+*              application, implemented for the Linux host build in
+*              host/cyhal_host.c.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CYHAL_H
+#define CYHAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include "cy_device_headers.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define CY_RSLT_SUCCESS             ((cy_rslt_t)0x00000000U)
+
+/* Result codes as composed by cy_result.h */
+#define CY_RSLT_TYPE_ERROR          (2U)
+#define CY_RSLT_MODULE_MIDDLEWARE_BASE  (0x0A00U)
+#define CY_RSLT_CREATE(type, module, code) \
+    ((cy_rslt_t)((((module) & 0x3FFFU) << 18U) | (((code) & 0xFFFFU) << 0U) | \
+                 (((type) & 0x3U) << 16U)))
+
+/* Generic failure of the host implementation */
+#define CY_RSLT_HOST_ERROR          ((cy_rslt_t)0x04020001U)
+
+/* Timeout of cyhal_uart_getc() */
+#define CY_RSLT_ERR_CSP_UART_GETC_TIMEOUT   ((cy_rslt_t)0x04021001U)
+
+#define CY_ASSERT(x)                do { if (!(x)) { abort(); } } while (0)
+
+/* Pin numbering of the HAL: port in the upper bits, pin in the lower three */
+#define CYHAL_GET_GPIO(port, pin)   ((cyhal_gpio_t)(((port) << 3U) + (pin)))
+#define CYHAL_GET_PORT(pin)         ((uint8_t)((uint32_t)(pin) >> 3U))
+#define CYHAL_GET_PIN(pin)          ((uint8_t)((uint32_t)(pin) & 0x07U))
+#define NC                          ((cyhal_gpio_t)0xFFU)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef uint32_t cy_rslt_t;
+typedef uint32_t cyhal_gpio_t;
+
+typedef enum
+{
+    CYHAL_RSC_DW,
+    CYHAL_RSC_GPIO,
+    CYHAL_RSC_SCB,
+    CYHAL_RSC_TCPWM
+} cyhal_resource_t;
+
+typedef struct
+{
+    cyhal_resource_t type;
+    uint8_t block_num;
+    uint8_t channel_num;
+} cyhal_resource_inst_t;
+
+/* Clock divider. The host CLK_PERI never changes, so a clock only records
+ * its settings; an emulated timer takes its rate from the clock it is
+ * initialized with, if that has one. */
+typedef enum
+{
+    CYHAL_CLOCK_BLOCK_PERIPHERAL_8BIT,
+    CYHAL_CLOCK_BLOCK_PERIPHERAL_16BIT,
+    CYHAL_CLOCK_BLOCK_PERIPHERAL_16_5BIT,
+    CYHAL_CLOCK_BLOCK_PERIPHERAL_24_5BIT
+} cyhal_clock_block_t;
+
+typedef struct
+{
+    uint32_t type;
+    uint32_t value;
+} cyhal_clock_tolerance_t;
+
+typedef struct
+{
+    uint32_t divider;
+    uint32_t frequency_hz;
+    bool enabled;
+} cyhal_clock_t;
+
+/* GPIO */
+typedef enum
+{
+    CYHAL_GPIO_DIR_INPUT,
+    CYHAL_GPIO_DIR_OUTPUT,
+    CYHAL_GPIO_DIR_BIDIRECTIONAL
+} cyhal_gpio_direction_t;
+
+typedef enum
+{
+    CYHAL_GPIO_DRIVE_NONE,
+    CYHAL_GPIO_DRIVE_ANALOG,
+    CYHAL_GPIO_DRIVE_PULLUP,
+    CYHAL_GPIO_DRIVE_PULLDOWN,
+    CYHAL_GPIO_DRIVE_OPENDRAINDRIVESLOW,
+    CYHAL_GPIO_DRIVE_OPENDRAINDRIVESHIGH,
+    CYHAL_GPIO_DRIVE_STRONG,
+    CYHAL_GPIO_DRIVE_PULLUPDOWN
+} cyhal_gpio_drive_mode_t;
+
+/* Timer. The TCPWM fields mirror the real object so that PDL calls made
+ * with them reach the emulated counter. */
+typedef struct TCPWM_Type TCPWM_Type;
+
+typedef enum
+{
+    CYHAL_TIMER_DIR_UP,
+    CYHAL_TIMER_DIR_DOWN,
+    CYHAL_TIMER_DIR_UP_DOWN
+} cyhal_timer_direction_t;
+
+typedef enum
+{
+    CYHAL_TIMER_IRQ_NONE            = 0,
+    CYHAL_TIMER_IRQ_TERMINAL_COUNT  = 1 << 0,
+    CYHAL_TIMER_IRQ_CAPTURE_COMPARE = 1 << 1,
+    CYHAL_TIMER_IRQ_ALL             = (1 << 2) - 1
+} cyhal_timer_event_t;
+
+typedef void (*cyhal_timer_event_callback_t)(void *callback_arg,
+                                             cyhal_timer_event_t event);
+
+typedef struct
+{
+    bool is_continuous;
+    cyhal_timer_direction_t direction;
+    bool is_compare;
+    uint32_t period;
+    uint32_t compare_value;
+    uint32_t value;
+} cyhal_timer_cfg_t;
+
+typedef struct
+{
+    struct
+    {
+        TCPWM_Type *base;
+        cyhal_resource_inst_t resource;
+    } tcpwm;
+
+    /* Host emulation state */
+    cyhal_timer_cfg_t cfg;
+    uint32_t frequency_hz;
+    bool running;
+    uint64_t start_ticks;       /* Host tick count at which value was loaded */
+    uint64_t polled_ticks;      /* Host tick count of the last event check */
+    cyhal_timer_event_callback_t callback;
+    void *callback_arg;
+    cyhal_timer_event_t events;
+    cyhal_timer_event_t pending;    /* Raised, not yet delivered */
+} cyhal_timer_t;
+
+/* PWM */
+typedef struct
+{
+    cyhal_gpio_t pin;
+
+    /* Host emulation state */
+    uint32_t period_us;
+    uint32_t pulse_width_us;
+    bool running;
+    uint64_t start_ns;          /* Time of the last start */
+} cyhal_pwm_t;
+
+/* UART */
+typedef enum
+{
+    CYHAL_UART_IRQ_NONE                 = 0,
+    CYHAL_UART_IRQ_TX_TRANSMIT_IN_FIFO  = 1 << 1,
+    CYHAL_UART_IRQ_TX_DONE              = 1 << 2,
+    CYHAL_UART_IRQ_TX_ERROR             = 1 << 3,
+    CYHAL_UART_IRQ_RX_FULL              = 1 << 4,
+    CYHAL_UART_IRQ_RX_DONE              = 1 << 5,
+    CYHAL_UART_IRQ_RX_ERROR             = 1 << 6,
+    CYHAL_UART_IRQ_RX_NOT_EMPTY         = 1 << 7,
+    CYHAL_UART_IRQ_TX_EMPTY             = 1 << 8
+} cyhal_uart_event_t;
+
+typedef void (*cyhal_uart_event_callback_t)(void *callback_arg,
+                                            cyhal_uart_event_t event);
+
+typedef struct
+{
+    cyhal_uart_event_callback_t callback;
+    void *callback_arg;
+    cyhal_uart_event_t events;
+} cyhal_uart_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* GPIO: outputs are recorded, see HOST_GPIO_TRACE in README.md */
+cy_rslt_t cyhal_gpio_init(cyhal_gpio_t pin, cyhal_gpio_direction_t direction,
+                          cyhal_gpio_drive_mode_t drive_mode, bool init_val);
+void cyhal_gpio_free(cyhal_gpio_t pin);
+void cyhal_gpio_write(cyhal_gpio_t pin, bool value);
+bool cyhal_gpio_read(cyhal_gpio_t pin);
+void cyhal_gpio_toggle(cyhal_gpio_t pin);
+
+/* Clock: records its settings */
+cy_rslt_t cyhal_clock_allocate(cyhal_clock_t *clock, cyhal_clock_block_t block);
+cy_rslt_t cyhal_clock_set_frequency(cyhal_clock_t *clock, uint32_t hz,
+                                    const cyhal_clock_tolerance_t *tolerance);
+uint32_t cyhal_clock_get_frequency(const cyhal_clock_t *clock);
+cy_rslt_t cyhal_clock_set_enabled(cyhal_clock_t *clock, bool enabled,
+                                  bool wait_for_lock);
+void cyhal_clock_free(cyhal_clock_t *clock);
+
+/* Timer: counts on the host clock, events run from cyhal_syspm_sleep() */
+cy_rslt_t cyhal_timer_init(cyhal_timer_t *obj, cyhal_gpio_t pin,
+                           const cyhal_clock_t *clk);
+void cyhal_timer_free(cyhal_timer_t *obj);
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t *obj,
+                                const cyhal_timer_cfg_t *cfg);
+cy_rslt_t cyhal_timer_set_frequency(cyhal_timer_t *obj, uint32_t hz);
+cy_rslt_t cyhal_timer_start(cyhal_timer_t *obj);
+cy_rslt_t cyhal_timer_stop(cyhal_timer_t *obj);
+cy_rslt_t cyhal_timer_reset(cyhal_timer_t *obj);
+uint32_t cyhal_timer_read(const cyhal_timer_t *obj);
+void cyhal_timer_register_callback(cyhal_timer_t *obj,
+                                   cyhal_timer_event_callback_t callback,
+                                   void *callback_arg);
+void cyhal_timer_enable_event(cyhal_timer_t *obj, cyhal_timer_event_t event,
+                              uint8_t intr_priority, bool enable);
+
+/* PWM: the output is not simulated edge by edge, its level changes are
+ * counted when it stops */
+cy_rslt_t cyhal_pwm_init(cyhal_pwm_t *obj, cyhal_gpio_t pin,
+                         const cyhal_clock_t *clk);
+void cyhal_pwm_free(cyhal_pwm_t *obj);
+cy_rslt_t cyhal_pwm_set_period(cyhal_pwm_t *obj, uint32_t period_us,
+                               uint32_t pulse_width_us);
+cy_rslt_t cyhal_pwm_set_duty_cycle(cyhal_pwm_t *obj, float duty_cycle,
+                                   uint32_t frequencyhz);
+cy_rslt_t cyhal_pwm_start(cyhal_pwm_t *obj);
+cy_rslt_t cyhal_pwm_stop(cyhal_pwm_t *obj);
+
+/* UART: reads stdin and writes stdout */
+cy_rslt_t cyhal_uart_getc(cyhal_uart_t *obj, uint8_t *value,
+                          uint32_t timeout);
+cy_rslt_t cyhal_uart_putc(cyhal_uart_t *obj, uint32_t value);
+uint32_t cyhal_uart_readable(cyhal_uart_t *obj);
+void cyhal_uart_register_callback(cyhal_uart_t *obj,
+                                  cyhal_uart_event_callback_t callback,
+                                  void *callback_arg);
+void cyhal_uart_enable_event(cyhal_uart_t *obj, cyhal_uart_event_t event,
+                             uint8_t intr_priority, bool enable);
+
+/* System */
+cy_rslt_t cyhal_syspm_sleep(void);
+uint32_t cyhal_system_critical_section_enter(void);
+void cyhal_system_critical_section_exit(uint32_t old_state);
+void cyhal_system_delay_ms(uint32_t milliseconds);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CYHAL_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,269 @@
+/******************************************************************************
+* File Name:   ipc_bulk_host.c
+*
+* Description: This file implements the CM4 end of the message rings of
+*              source/ipc_bulk.h for the Linux host build. The CM0+ is emulated
+*              in place: whenever the CM4 end runs, the messages it sent are
+*              returned on the ring back, with the doorbell of the real image.
+*              The rings and their code are the same as on the device.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "event_loop.h"
+#include "ipc_bulk.h"
+#include "trace.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static ipc_bulk_handler_t ipc_bulk_handler = NULL;
+static bool ipc_bulk_active = false;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void ipc_bulk_loopback(void);
+static void ipc_bulk_handle_event(const event_t *event);
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_init
+********************************************************************************
+* Summary:
+* This function turns the channel on. cybsp_init() has initialized the rings
+* in place of the CM0+.
+*
+* Parameters:
+*  handler     Handler of the messages from the emulated CM0+
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t ipc_bulk_init(ipc_bulk_handler_t handler)
+{
+    ipc_bulk_handler = handler;
+    event_loop_register(EVENT_IPC_RING, ipc_bulk_handle_event);
+    ipc_bulk_active = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_ready
+********************************************************************************
+* Summary:
+* This function tells whether the channel is on.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true after ipc_bulk_init()
+*
+*******************************************************************************/
+bool ipc_bulk_ready(void)
+{
+    return ipc_bulk_active;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_send
+********************************************************************************
+* Summary:
+* This function writes messages to the emulated CM0+, which returns them
+* at once as far as the ring back has room.
+*
+* Parameters:
+*  msgs        'count' messages of IPC_SHARED_MSG_SIZE bytes
+*  count       Number of messages
+*
+* Return:
+*  uint32_t    Number of messages written, from the first
+*
+*******************************************************************************/
+uint32_t ipc_bulk_send(const void *msgs, uint32_t count)
+{
+    uint32_t written;
+    bool doorbell;
+
+    if (!ipc_bulk_active)
+    {
+        return 0U;
+    }
+
+    written = ipc_ring_write(&ipc_shared.to_cm0p, msgs, count, &doorbell);
+    TRACE_MARK("ring.send", written);
+    ipc_bulk_loopback();
+
+    return written;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_poll
+********************************************************************************
+* Summary:
+* This function passes the messages from the emulated CM0+ to the handler in
+* batches until the ring is empty, and lets the CM0+ return the messages
+* that waited for room.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    Number of messages handled
+*
+*******************************************************************************/
+uint32_t ipc_bulk_poll(void)
+{
+    const void *msgs;
+    uint32_t count;
+    uint32_t total = 0U;
+
+    if (!ipc_bulk_active)
+    {
+        return 0U;
+    }
+
+    while ((count = ipc_ring_peek(&ipc_shared.to_cm4, &msgs)) != 0U)
+    {
+        if (ipc_bulk_handler != NULL)
+        {
+            ipc_bulk_handler(msgs, count);
+        }
+        ipc_ring_release(&ipc_shared.to_cm4, count);
+        total += count;
+
+        ipc_bulk_loopback();
+    }
+
+    return total;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_get_stats
+********************************************************************************
+* Summary:
+* This function reads the counters of both rings.
+*
+* Parameters:
+*  stats       Location to store the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_bulk_get_stats(ipc_bulk_stats_t *stats)
+{
+    stats->sent = ipc_shared.to_cm0p.head;
+    stats->full = ipc_shared.to_cm0p.full;
+    stats->doorbells_sent = ipc_shared.to_cm0p.doorbells;
+    stats->received = ipc_shared.to_cm4.tail;
+    stats->batches = ipc_shared.to_cm4.batches;
+    stats->doorbells_received = ipc_shared.to_cm4.doorbells;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_loopback
+********************************************************************************
+* Summary:
+* This function does the work of the CM0+ image: it returns the messages of
+* the ring from the CM4 on the ring back, and posts the doorbell event when
+* that ring was empty. It traces into the buffer of the CM0+.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_bulk_loopback(void)
+{
+    const void *msgs;
+    uint32_t count;
+    uint32_t written;
+    bool doorbell;
+
+    while ((count = ipc_ring_peek(&ipc_shared.to_cm0p, &msgs)) != 0U)
+    {
+        written = ipc_ring_write(&ipc_shared.to_cm4, msgs, count, &doorbell);
+        trace_record(&ipc_shared.trace, TRACE_TYPE_MARK, "ring.loop", written);
+        if (doorbell)
+        {
+            (void)event_post(EVENT_IPC_RING, 0U);
+        }
+        if (written != 0U)
+        {
+            ipc_ring_release(&ipc_shared.to_cm0p, written);
+        }
+        if (written != count)
+        {
+            break;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_handle_event
+********************************************************************************
+* Summary:
+* This function handles the doorbell event in the main loop.
+*
+* Parameters:
+*  event       Doorbell event, no payload
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_bulk_handle_event(const event_t *event)
+{
+    (void)event;
+
+    (void)ipc_bulk_poll();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,381 @@
+/******************************************************************************
+* File Name:   ipc_console_host.c
+*
+* Description: This file implements the CM4 end of the console of
+*              source/ipc_console.h for the Linux host build. The CM0+ is
+*              emulated in place: records are formatted to standard output as
+*              they are sent, and standard input goes through the line editor of
+*              the shell, whose lines reach the handler from the event loop. The
+*              formatter and the editor are the same as on the CM0+.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "cy_retarget_io.h"
+#include "event_loop.h"
+#include "shell_edit.h"
+#include "app_log.h"
+#include "ipc_console.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the receive ring, the receive FIFO of the emulated CM0+ */
+#define IPC_CONSOLE_RX_SIZE         (256U)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static ipc_console_handler_t ipc_console_handler = NULL;
+static bool ipc_console_started = false;
+static ipc_console_stats_t ipc_console_stats;
+
+/* Input taken by the interrupt, free running write and read positions */
+static uint8_t ipc_console_rx[IPC_CONSOLE_RX_SIZE];
+static uint32_t ipc_console_rx_head = 0U;
+static uint32_t ipc_console_rx_tail = 0U;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void ipc_console_output(const char *data, size_t length);
+static void ipc_console_line(char *line, uint32_t length);
+static void ipc_console_handle_event(const event_t *event);
+static void isr_console_rx(void *callback_arg, cyhal_uart_event_t event);
+
+
+/*******************************************************************************
+* Function Name: ipc_console_init
+********************************************************************************
+* Summary:
+* This function starts the emulated console.
+*
+* Parameters:
+*  baudrate    Not used
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t ipc_console_init(uint32_t baudrate)
+{
+    (void)baudrate;
+
+    shell_edit_init(ipc_console_output, ipc_console_line);
+    ipc_console_started = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_input_init
+********************************************************************************
+* Summary:
+* This function takes standard input for the line editor, on the receive
+* event of the emulated debug UART.
+*
+* Parameters:
+*  handler     Handler of the command lines
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, or IPC_CONSOLE_RSLT_ERR_NO_SERVER if
+*              ipc_console_init() did not run
+*
+*******************************************************************************/
+cy_rslt_t ipc_console_input_init(ipc_console_handler_t handler)
+{
+    if (!ipc_console_started)
+    {
+        return IPC_CONSOLE_RSLT_ERR_NO_SERVER;
+    }
+
+    ipc_console_handler = handler;
+
+    event_loop_register(EVENT_UART_RX, ipc_console_handle_event);
+    cyhal_uart_register_callback(&cy_retarget_io_uart_obj, isr_console_rx,
+                                 NULL);
+    cyhal_uart_enable_event(&cy_retarget_io_uart_obj,
+                            CYHAL_UART_IRQ_RX_NOT_EMPTY,
+                            IPC_CONSOLE_INTR_PRIORITY, true);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+bool ipc_console_ready(void)
+{
+    return ipc_console_started;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_send
+********************************************************************************
+* Summary:
+* This function formats a record in place, as the CM0+ would.
+*
+* Parameters:
+*  record      Record of IPC_CONSOLE_RECORD_SIZE bytes
+*
+* Return:
+*  bool        true if the console runs
+*
+*******************************************************************************/
+bool ipc_console_send(const void *record)
+{
+    const ipc_console_record_t *rec = (const ipc_console_record_t *)record;
+    uint32_t age;
+    const char *line;
+
+    if (!ipc_console_started)
+    {
+        return false;
+    }
+
+    ipc_console_stats.records++;
+
+    switch (rec->kind)
+    {
+        case IPC_CONSOLE_RECORD_LOG:
+            app_log_format((const uint8_t *)rec, ipc_console_output);
+            break;
+
+        case IPC_CONSOLE_RECORD_TEXT:
+            ipc_console_output((const char *)rec->payload, rec->length);
+            break;
+
+        case IPC_CONSOLE_RECORD_PROMPT:
+            shell_edit_prompt();
+            break;
+
+        case IPC_CONSOLE_RECORD_HISTORY:
+            for (age = shell_edit_history_count(); age > 0U; age--)
+            {
+                line = shell_edit_history_line(age);
+                ipc_console_output("  ", 2U);
+                ipc_console_output(line, strlen(line));
+                ipc_console_output("\r\n", 2U);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    (void)fflush(stdout);
+
+    return true;
+}
+
+
+size_t ipc_console_write(const char *data, size_t length)
+{
+    ipc_console_record_t record;
+    size_t queued = 0U;
+    uint32_t chunk;
+
+    while (queued < length)
+    {
+        chunk = ((length - queued) < IPC_CONSOLE_PAYLOAD_SIZE) ?
+                (uint32_t)(length - queued) : IPC_CONSOLE_PAYLOAD_SIZE;
+
+        record.kind = (uint8_t)IPC_CONSOLE_RECORD_TEXT;
+        record.length = (uint8_t)chunk;
+        (void)memcpy(record.payload, &data[queued], chunk);
+        if (!ipc_console_send(&record))
+        {
+            break;
+        }
+        queued += chunk;
+    }
+
+    ipc_console_stats.text_bytes += (uint32_t)queued;
+
+    return queued;
+}
+
+
+void ipc_console_prompt(void)
+{
+    static const ipc_console_record_t record =
+    {
+        .kind = (uint8_t)IPC_CONSOLE_RECORD_PROMPT
+    };
+
+    (void)fflush(stdout);
+    (void)ipc_console_send(&record);
+}
+
+
+void ipc_console_history(void)
+{
+    static const ipc_console_record_t record =
+    {
+        .kind = (uint8_t)IPC_CONSOLE_RECORD_HISTORY
+    };
+
+    (void)fflush(stdout);
+    (void)ipc_console_send(&record);
+}
+
+
+void ipc_console_get_stats(ipc_console_stats_t *stats)
+{
+    *stats = ipc_console_stats;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_output
+********************************************************************************
+* Summary:
+* This function is the UART of the emulated CM0+.
+*
+* Parameters:
+*  data        Text to send
+*  length      Number of bytes
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_console_output(const char *data, size_t length)
+{
+    (void)fwrite(data, 1U, length, stdout);
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_line
+********************************************************************************
+* Summary:
+* This function passes a line completed by the editor to the handler. It
+* runs from the event loop, where the handler runs on the device.
+*
+* Parameters:
+*  line        NUL terminated line
+*  length      Not used
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_console_line(char *line, uint32_t length)
+{
+    (void)length;
+
+    (void)fflush(stdout);
+    ipc_console_stats.lines++;
+
+    if (ipc_console_handler != NULL)
+    {
+        ipc_console_handler(line);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_handle_event
+********************************************************************************
+* Summary:
+* This function feeds the received input to the line editor.
+*
+* Parameters:
+*  event       Receive event, no payload
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_console_handle_event(const event_t *event)
+{
+    uint8_t value;
+
+    (void)event;
+
+    while (ipc_console_rx_tail != ipc_console_rx_head)
+    {
+        value = ipc_console_rx[ipc_console_rx_tail % IPC_CONSOLE_RX_SIZE];
+        ipc_console_rx_tail++;
+        shell_edit_input(&value, 1U);
+    }
+
+    (void)fflush(stdout);
+}
+
+
+/*******************************************************************************
+* Function Name: isr_console_rx
+********************************************************************************
+* Summary:
+* This is the emulated receive-not-empty interrupt. It moves the input into
+* the receive ring, dropping what does not fit, and posts the event the
+* command line doorbell posts on the device.
+*
+* Parameters:
+*  callback_arg    Not used
+*  event           UART interrupt triggers
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void isr_console_rx(void *callback_arg, cyhal_uart_event_t event)
+{
+    uint8_t value;
+
+    (void)callback_arg;
+    (void)event;
+
+    while (cyhal_uart_readable(&cy_retarget_io_uart_obj) > 0U)
+    {
+        (void)cyhal_uart_getc(&cy_retarget_io_uart_obj, &value, 0U);
+        if ((ipc_console_rx_head - ipc_console_rx_tail) < IPC_CONSOLE_RX_SIZE)
+        {
+            ipc_console_rx[ipc_console_rx_head % IPC_CONSOLE_RX_SIZE] = value;
+            ipc_console_rx_head++;
+        }
+    }
+
+    (void)event_post(EVENT_UART_RX, 0U);
+}
+
+/* [] END OF FILE */
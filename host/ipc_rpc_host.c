@@ -0,0 +1,192 @@
+/******************************************************************************
+* File Name:   ipc_rpc_host.c
+*
+* Description: This file implements the remote procedure calls of
+*              source/ipc_rpc.h for the Linux host build. There is no second
+*              core: a call runs in place, which makes the 'rpc bench' round
+*              trip the cost of the client code alone. Only the ping is served.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "ipc_rpc.h"
+#include "ipc_shared.h"
+#include "trace.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static ipc_rpc_stats_t ipc_rpc_stats;
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_init
+********************************************************************************
+* Summary:
+* This function does nothing on the host.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t ipc_rpc_init(void)
+{
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_ready
+********************************************************************************
+* Summary:
+* This function tells that calls are served.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true
+*
+*******************************************************************************/
+bool ipc_rpc_ready(void)
+{
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_call
+********************************************************************************
+* Summary:
+* This function runs a call in place. The ping returns its first argument
+* plus one like on the CM0+; the other functions drive hardware the host does
+* not have and fail. The call is traced on both sides, the server side into
+* the trace buffer of the CM0+.
+*
+* Parameters:
+*  func        Function of the server
+*  args        IPC_RPC_ARGS arguments
+*  result      Location to store the result, may be NULL
+*  timeout_us  Not used
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, or IPC_RPC_RSLT_ERR_STATUS for other
+*              functions than the ping
+*
+*******************************************************************************/
+cy_rslt_t ipc_rpc_call(ipc_rpc_func_t func, const uint32_t args[IPC_RPC_ARGS],
+                       uint32_t *result, uint32_t timeout_us)
+{
+    uint32_t value = 0U;
+    cy_rslt_t rslt = CY_RSLT_SUCCESS;
+
+    (void)timeout_us;
+
+    TRACE_BEGIN("rpc.call", (uint32_t)func);
+    trace_record(&ipc_shared.trace, TRACE_TYPE_BEGIN, "rpc.serve",
+                 (uint32_t)func);
+
+    ipc_rpc_stats.calls++;
+    if (func == IPC_RPC_FUNC_PING)
+    {
+        value = args[0] + 1U;
+    }
+    else
+    {
+        ipc_rpc_stats.errors++;
+        rslt = IPC_RPC_RSLT_ERR_STATUS;
+    }
+
+    trace_record(&ipc_shared.trace, TRACE_TYPE_END, "rpc.serve",
+                 (uint32_t)func);
+    TRACE_END("rpc.call", (uint32_t)func);
+
+    if (result != NULL)
+    {
+        *result = value;
+    }
+
+    return rslt;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_post
+********************************************************************************
+* Summary:
+* This function runs a call in place and drops its result.
+*
+* Parameters:
+*  func        Function of the server
+*  args        IPC_RPC_ARGS arguments
+*  timeout_us  Not used
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t ipc_rpc_post(ipc_rpc_func_t func, const uint32_t args[IPC_RPC_ARGS],
+                       uint32_t timeout_us)
+{
+    (void)ipc_rpc_call(func, args, NULL, timeout_us);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_get_stats
+********************************************************************************
+* Summary:
+* This function copies the call counters.
+*
+* Parameters:
+*  stats       Location to store the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_rpc_get_stats(ipc_rpc_stats_t *stats)
+{
+    *stats = ipc_rpc_stats;
+}
+
+/* [] END OF FILE */
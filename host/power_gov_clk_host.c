@@ -0,0 +1,107 @@
+/******************************************************************************
+* File Name:   power_gov_clk_host.c
+*
+* Description: This file implements the clock side of source/power_gov.h for the
+*              Linux host build. The host clocks do not change, so an operating
+*              point is only recorded; the notifiers still run, which exercises
+*              the drivers and the governor.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "power_gov.h"
+#include "cycle_counter.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const power_gov_cfg_t *power_gov_clk_current = NULL;
+
+
+/*******************************************************************************
+* Function Name: power_gov_clk_init
+********************************************************************************
+* Summary:
+* This function starts the host in the LP point.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t power_gov_clk_init(void)
+{
+    power_gov_clk_current = power_gov_cfg(POWER_GOV_LP);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_clk_apply
+********************************************************************************
+* Summary:
+* This function records the new operating point. The time it takes is
+* measured like on the device, and is close to nothing.
+*
+* Parameters:
+*  from        Current operating point
+*  to          New operating point
+*  clock_ns    Location to store the time the change took
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t power_gov_clk_apply(const power_gov_cfg_t *from,
+                              const power_gov_cfg_t *to, uint32_t *clock_ns)
+{
+    uint32_t start = cycle_counter_read();
+
+    CY_ASSERT(from == power_gov_clk_current);
+    (void)from;
+    power_gov_clk_current = to;
+
+    /* The host cycle counter counts nanoseconds */
+    *clock_ns = cycle_counter_read() - start;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
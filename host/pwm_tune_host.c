@@ -0,0 +1,188 @@
+/******************************************************************************
+* File Name:   pwm_tune_host.c
+*
+* Description: This file implements the PWM retuning interface of
+*              source/pwm_tune.h for the Linux host build. The emulated PWM
+*              counts microseconds and has no buffered registers, so a group
+*              runs on a 1 MHz clock without a divider and a change is applied
+*              at once.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "pwm_tune.h"
+#include "idle.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Tick rate of the emulated PWM */
+#define PWM_TUNE_HOST_CLOCK_HZ      (1000000UL)
+
+
+/*******************************************************************************
+* Function Name: pwm_tune_init
+********************************************************************************
+* Summary:
+* This function initializes the PWMs of a group.
+*
+* Parameters:
+*  group       Group object to initialize
+*  pwms        PWM objects, initialized by this function
+*  pins        Output pin of each PWM
+*  count       Number of PWMs, at most PWM_TUNE_MAX_CHANNELS
+*
+* Return:
+*  cy_rslt_t   Result of cyhal_pwm_init()
+*
+*******************************************************************************/
+cy_rslt_t pwm_tune_init(pwm_tune_group_t *group, cyhal_pwm_t *const pwms[],
+                        const cyhal_gpio_t pins[], uint32_t count)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t index;
+
+    group->count = 0U;
+    group->running = false;
+    group->pending_divider = 0U;
+    group->max_period = UINT32_MAX;
+    group->clock.divider = 1U;
+    group->tune.divider = 1U;
+    group->loaded_divider = 1U;
+    group->tune.period = 0U;
+
+    for (index = 0U; (index < count) && (result == CY_RSLT_SUCCESS); index++)
+    {
+        result = cyhal_pwm_init(pwms[index], pins[index], &group->clock);
+        if (result == CY_RSLT_SUCCESS)
+        {
+            group->pwm[index] = pwms[index];
+            group->count++;
+        }
+    }
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        pwm_tune_free(group);
+    }
+
+    return result;
+}
+
+
+void pwm_tune_free(pwm_tune_group_t *group)
+{
+    uint32_t index;
+
+    if (group->running)
+    {
+        idle_unlock();
+    }
+
+    for (index = 0U; index < group->count; index++)
+    {
+        cyhal_pwm_free(group->pwm[index]);
+    }
+    group->count = 0U;
+    group->running = false;
+}
+
+
+cy_rslt_t pwm_tune_solve(const pwm_tune_group_t *group, uint32_t freq_mhz,
+                         timer_tune_t *tune)
+{
+    return timer_tune_solve(PWM_TUNE_HOST_CLOCK_HZ, freq_mhz, 1U,
+                            group->max_period, tune);
+}
+
+
+void pwm_tune_apply(pwm_tune_group_t *group, const timer_tune_t *tune,
+                    const uint32_t pulse_permille[])
+{
+    uint32_t index;
+
+    group->tune = *tune;
+
+    for (index = 0U; index < group->count; index++)
+    {
+        group->compare[index] = (uint32_t)(((uint64_t)tune->period *
+                                            pulse_permille[index]) /
+                                           PWM_TUNE_PERMILLE);
+        (void)cyhal_pwm_set_period(group->pwm[index], tune->period,
+                                   group->compare[index]);
+    }
+}
+
+
+cy_rslt_t pwm_tune_start(pwm_tune_group_t *group)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t index;
+
+    for (index = 0U; (index < group->count) && (result == CY_RSLT_SUCCESS);
+         index++)
+    {
+        result = cyhal_pwm_start(group->pwm[index]);
+    }
+    if ((result == CY_RSLT_SUCCESS) && !group->running)
+    {
+        idle_lock();
+        group->running = true;
+    }
+
+    return result;
+}
+
+
+cy_rslt_t pwm_tune_stop(pwm_tune_group_t *group)
+{
+    uint32_t index;
+
+    for (index = 0U; index < group->count; index++)
+    {
+        (void)cyhal_pwm_stop(group->pwm[index]);
+    }
+    if (group->running)
+    {
+        idle_unlock();
+    }
+    group->running = false;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/******************************************************************************
+* File Name:   rgb_pattern_dma_host.c
+*
+* Description: This file implements the DMA player interface of
+*              source/rgb_pattern_dma.h for the Linux host build. There is no
+*              DMA to stream the tables, so the first frame of a pattern is
+*              applied and held. The CPU-fed mode of the pattern engine plays
+*              the whole animation.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "rgb_pattern_dma.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static cyhal_pwm_t *rgb_pattern_dma_pwm[RGB_PATTERN_CHANNELS];
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_dma_init
+********************************************************************************
+* Summary:
+* This function remembers the PWM of a color. The emulated PWM counts
+* microseconds, so a period has as many ticks as microseconds.
+*
+* Parameters:
+*  channel       Color index
+*  pwm           PWM object of the color
+*  period_ticks  Location to store the number of counter ticks per period
+*
+* Return:
+*  cy_rslt_t     CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t rgb_pattern_dma_init(uint32_t channel, cyhal_pwm_t *pwm,
+                               uint32_t *period_ticks)
+{
+    rgb_pattern_dma_pwm[channel] = pwm;
+    *period_ticks = pwm->period_us;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+void rgb_pattern_dma_play(uint32_t channel, const uint16_t *table,
+                          uint32_t length, bool loop)
+{
+    cyhal_pwm_t *pwm = rgb_pattern_dma_pwm[channel];
+
+    (void) length;
+    (void) loop;
+
+    (void)cyhal_pwm_set_period(pwm, pwm->period_us, table[0]);
+}
+
+
+void rgb_pattern_dma_stop(uint32_t channel)
+{
+    (void) channel;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,392 @@
+/******************************************************************************
+* File Name:   app_log_bench.c
+*
+* Description: This file is a host measurement of the tokenized log of
+*              source/app_log.c against the printf log it replaces. For a set of
+*              typical log calls it prints the bytes sent on the UART and the
+*              time spent on the CPU per call in both modes. Each frame is
+*              formatted back with app_log_format() and must give the same text
+*              as printf.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "app_log.h"
+#include "uart_tx.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_NS_PER_S              (1000000000ULL)
+
+/* Calls measured per log call, overridden by the first argument */
+#define BENCH_DEFAULT_CALLS         (200000UL)
+
+/* Largest formatted line */
+#define BENCH_TEXT_SIZE             (128U)
+
+/* Runs one log call in both modes. The text is formatted with snprintf(),
+ * which is what printf() costs before the UART; the frame goes through
+ * APP_LOG() to uart_tx_write(). */
+#define BENCH_CASE(result, calls, fmt, ...)                                   \
+    do                                                                        \
+    {                                                                         \
+        uint64_t begin;                                                       \
+        uint32_t call;                                                        \
+        int length = 0;                                                       \
+                                                                              \
+        begin = bench_now_ns();                                               \
+        for (call = 0U; call < (calls); call++)                               \
+        {                                                                     \
+            length = snprintf(bench_text, sizeof(bench_text), fmt,            \
+                              ##__VA_ARGS__);                                 \
+            bench_consume(bench_text);                                        \
+        }                                                                     \
+        (result).text_ns = bench_now_ns() - begin;                            \
+        (result).text_bytes = (uint32_t)length;                               \
+                                                                              \
+        begin = bench_now_ns();                                               \
+        for (call = 0U; call < (calls); call++)                               \
+        {                                                                     \
+            APP_LOG(fmt, ##__VA_ARGS__);                                      \
+        }                                                                     \
+        (result).frame_ns = bench_now_ns() - begin;                           \
+        (result).frame_bytes = (uint32_t)bench_frame_length;                  \
+        (result).calls = (calls);                                             \
+        (result).name = fmt;                                                  \
+    } while (0)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Results of one log call */
+typedef struct
+{
+    const char *name;           /* Format string */
+    uint32_t calls;
+    uint32_t text_bytes;        /* Per call */
+    uint32_t frame_bytes;       /* Per call */
+    uint64_t text_ns;           /* For all calls */
+    uint64_t frame_ns;
+    bool match;                 /* The frame formats to the same text */
+} bench_result_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Last text and last frame of a log call */
+static char bench_text[BENCH_TEXT_SIZE];
+static uint8_t bench_frame[APP_LOG_FRAME_SIZE];
+static size_t bench_frame_length;
+
+/* Output of app_log_format() */
+static char bench_decoded[BENCH_TEXT_SIZE];
+static size_t bench_decoded_length;
+
+/* Keeps the compiler from dropping the formatted text */
+static volatile char bench_sink;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint64_t bench_now_ns(void);
+static void bench_consume(const char *text);
+static void bench_decode_write(const char *data, size_t length);
+static void bench_check(bench_result_t *result, const char *expected);
+static void bench_print(const bench_result_t *result);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* This function measures each log call and prints a table of the results.
+* The exit status is 1 if a frame does not format to the text of printf.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Optional number of calls per log call
+*
+* Return:
+*  int         0 if every frame formats to the expected text
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static const char name[] = "uart_rx";
+    unsigned long calls = BENCH_DEFAULT_CALLS;
+    bench_result_t results[6];
+    uint32_t count = 0U;
+    uint32_t index;
+    uint32_t text_bytes = 0U;
+    uint32_t frame_bytes = 0U;
+    uint64_t text_ns = 0U;
+    uint64_t frame_ns = 0U;
+    bool pass = true;
+    unsigned long tick = 0x7A3F12UL;
+    unsigned long big = 0x123456789UL;
+    void *pointer = bench_frame;
+    float temperature = 23.6875f;
+    double ratio = 0.1;
+
+    if (argc > 1)
+    {
+        calls = strtoul(argv[1], NULL, 10);
+    }
+    if (calls == 0U)
+    {
+        calls = 1U;
+    }
+
+    BENCH_CASE(results[count], calls, "LED blinking paused \r\n");
+    bench_check(&results[count++], bench_text);
+
+    BENCH_CASE(results[count], calls, "console bench %lu of %lu, tick %lu\r\n",
+               (unsigned long)calls, 1000UL, tick);
+    bench_check(&results[count++], bench_text);
+
+    BENCH_CASE(results[count], calls, "%s: %d events, %u overflows\r\n",
+               name, -12, 3U);
+    bench_check(&results[count++], bench_text);
+
+    BENCH_CASE(results[count], calls, "temperature %.2f C\r\n",
+               temperature);
+    bench_check(&results[count++], bench_text);
+
+    /* A double is narrowed to single precision on the wire */
+    BENCH_CASE(results[count], calls, "ratio %.9f\r\n", ratio);
+    (void)snprintf(bench_text, sizeof(bench_text), "ratio %.9f\r\n",
+                   (double)(float)ratio);
+    bench_check(&results[count++], bench_text);
+
+    /* long and pointers are 64 bits wide on the host. %p is formatted with
+     * at least 8 hex digits, as by tools/app_log_decode.py. */
+    BENCH_CASE(results[count], calls, "buffer %p, %lu bytes\r\n",
+               pointer, big);
+    (void)snprintf(bench_text, sizeof(bench_text),
+                   "buffer 0x%08lx, %lu bytes\r\n",
+                   (unsigned long)(uintptr_t)pointer, big);
+    bench_check(&results[count++], bench_text);
+
+    printf("%-40s %6s %6s %8s %8s\n", "log call", "text B", "frame B",
+           "text ns", "frame ns");
+
+    for (index = 0U; index < count; index++)
+    {
+        bench_print(&results[index]);
+        pass = pass && results[index].match;
+        text_bytes += results[index].text_bytes;
+        frame_bytes += results[index].frame_bytes;
+        text_ns += results[index].text_ns / results[index].calls;
+        frame_ns += results[index].frame_ns / results[index].calls;
+    }
+
+    printf("bytes %.1fx fewer, time %.1fx shorter\n",
+           (double)text_bytes / (double)frame_bytes,
+           (double)text_ns / (double)frame_ns);
+    printf("%s\n", pass ? "PASS" : "FAIL");
+
+    return pass ? 0 : 1;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_now_ns
+********************************************************************************
+* Summary:
+* This function reads the monotonic clock of the host.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint64_t    Time in ns
+*
+*******************************************************************************/
+static uint64_t bench_now_ns(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * BENCH_NS_PER_S) + (uint64_t)now.tv_nsec;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_consume
+********************************************************************************
+* Summary:
+* This function stands in for the UART output of the text.
+*
+* Parameters:
+*  text        Formatted text
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_consume(const char *text)
+{
+    bench_sink = text[0];
+}
+
+
+/*******************************************************************************
+* Function Name: bench_decode_write
+********************************************************************************
+* Summary:
+* This function collects the output of app_log_format().
+*
+* Parameters:
+*  data        Text to append
+*  length      Number of characters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_decode_write(const char *data, size_t length)
+{
+    if (length > (sizeof(bench_decoded) - 1U - bench_decoded_length))
+    {
+        length = sizeof(bench_decoded) - 1U - bench_decoded_length;
+    }
+
+    memcpy(&bench_decoded[bench_decoded_length], data, length);
+    bench_decoded_length += length;
+    bench_decoded[bench_decoded_length] = '\0';
+}
+
+
+/*******************************************************************************
+* Function Name: bench_check
+********************************************************************************
+* Summary:
+* This function formats the last frame back to text and compares it with
+* the expected text.
+*
+* Parameters:
+*  result      Log call to check
+*  expected    Text of printf
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_check(bench_result_t *result, const char *expected)
+{
+    bench_decoded_length = 0U;
+    bench_decoded[0] = '\0';
+    app_log_format(bench_frame, bench_decode_write);
+
+    result->match = (strcmp(bench_decoded, expected) == 0);
+    if (!result->match)
+    {
+        printf("mismatch: \"%s\" for \"%s\"\n", bench_decoded, expected);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: bench_print
+********************************************************************************
+* Summary:
+* This function prints the results of a log call on one line.
+*
+* Parameters:
+*  result      Log call to print
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_print(const bench_result_t *result)
+{
+    char name[41];
+    uint32_t index;
+
+    /* The format string without its line end */
+    (void)snprintf(name, sizeof(name), "%s", result->name);
+    for (index = 0U; name[index] != '\0'; index++)
+    {
+        if ((name[index] == '\r') || (name[index] == '\n'))
+        {
+            name[index] = '\0';
+            break;
+        }
+    }
+
+    printf("%-40s %6lu %6lu %8.1f %8.1f\n", name,
+           (unsigned long)result->text_bytes,
+           (unsigned long)result->frame_bytes,
+           (double)result->text_ns / (double)result->calls,
+           (double)result->frame_ns / (double)result->calls);
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_write
+********************************************************************************
+* Summary:
+* This function stands in for the debug UART driver. It keeps the last frame
+* instead of sending it.
+*
+* Parameters:
+*  data        Frame to send
+*  length      Number of bytes
+*
+* Return:
+*  size_t      Number of bytes taken, all of them
+*
+*******************************************************************************/
+size_t uart_tx_write(const void *data, size_t length)
+{
+    memcpy(bench_frame, data, length);
+    bench_frame_length = length;
+
+    return length;
+}
+
+/* [] END OF FILE */
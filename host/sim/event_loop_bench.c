@@ -0,0 +1,587 @@
+/******************************************************************************
+* File Name:   event_loop_bench.c
+*
+* Description: This file is a host measurement of the two main loops of the
+*              application: the polling loop of the original example, which
+*              spins in cyhal_uart_getc() with a 1 ms timeout and then checks
+*              the timer flag, and the event loop of source/event_loop.c, which
+*              sleeps until an interrupt posts an event. A thread stands in for
+*              the timer and UART interrupts and drives both loops with the same
+*              events. For each loop it prints the CPU duty cycle, the delay
+*              from the post to the handler, and the lateness of the wakeups of
+*              the interrupt thread itself, which is the noise of the host.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "event_queue.h"
+#include "event_loop.h"
+#include "latency_hist.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_NS_PER_MS             (1000000ULL)
+#define BENCH_NS_PER_S              (1000000000ULL)
+
+/* Run time of each loop in ms, overridden by the first argument */
+#define BENCH_DEFAULT_RUN_MS        (2000UL)
+
+/* The timer interrupt fires every BENCH_TICK_MS, a received character
+ * arrives every 1 to 2 * BENCH_RX_MEAN_MS at random */
+#define BENCH_TICK_MS               (10UL)
+#define BENCH_RX_MEAN_MS            (25UL)
+
+/* Timeout of cyhal_uart_getc() in the polling loop, as in the original
+ * main.c */
+#define BENCH_GETC_TIMEOUT_MS       (1UL)
+
+/* Events measured: the received character and the timer tick */
+#define BENCH_SOURCES               (2U)
+
+/* Row of the lateness of the interrupt thread's own wakeups */
+#define BENCH_HOST_WAKE             (BENCH_SOURCES)
+#define BENCH_ROWS                  (BENCH_SOURCES + 1U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Main loop under test */
+typedef enum
+{
+    BENCH_LOOP_POLLING = 0,     /* Spins in getc, then checks the flag */
+    BENCH_LOOP_EVENT            /* Sleeps until an event is posted */
+} bench_loop_t;
+
+/* One run of a loop */
+typedef struct
+{
+    bench_loop_t loop;
+    uint32_t run_ms;
+    volatile uint32_t done;     /* Set by the interrupt thread at the end */
+
+    /* Polling loop: the receive FIFO and the timer interrupt flag, each
+     * with the time it was set, 0 while clear */
+    volatile uint64_t rx_posted_ns;
+    volatile uint64_t tick_posted_ns;
+
+    /* Event loop: one queue per event ID, as in source/event_loop.c, and
+     * a semaphore that stands in for the wakeup from WFI */
+    event_queue_t queues[BENCH_SOURCES];
+    sem_t wakeup;
+
+    /* Results, the last row is the wakeup lateness of the interrupt thread */
+    uint32_t posted[BENCH_ROWS];
+    uint32_t lost[BENCH_ROWS];          /* Overwritten before handled */
+    latency_hist_t latency[BENCH_ROWS];
+    uint64_t latency_sum_ns[BENCH_ROWS];
+    uint64_t cpu_ns;                    /* CPU time of the main loop */
+    uint64_t wall_ns;
+} bench_run_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static event_t bench_storage[BENCH_SOURCES][EVENT_QUEUE_CAPACITY];
+
+static const char *const bench_loop_names[] = { "polling", "event" };
+static const char *const bench_source_names[] = { "uart rx", "timer",
+                                                   "host" };
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint64_t bench_clock_ns(clockid_t clock);
+static uint32_t bench_random(uint32_t *seed);
+static void bench_run(bench_run_t *run);
+static void *bench_interrupts(void *arg);
+static void bench_post(bench_run_t *run, uint32_t source);
+static void bench_handle(bench_run_t *run, uint32_t source,
+                         uint64_t posted_ns);
+static void bench_polling_loop(bench_run_t *run);
+static void bench_event_loop(bench_run_t *run);
+static void bench_print(const bench_run_t *run);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* This function runs the polling loop and then the event loop with the same
+* events and prints their results. The exit status is 1 if the event loop
+* lost an event.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Optional run time of each loop in ms
+*
+* Return:
+*  int         0 if the event loop handled every event
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static bench_run_t runs[2];
+    unsigned long run_ms = BENCH_DEFAULT_RUN_MS;
+    uint32_t index;
+
+    if (argc > 1)
+    {
+        run_ms = strtoul(argv[1], NULL, 10);
+    }
+
+    printf("%lu ms per loop, tick every %lu ms, character every %lu ms "
+           "on average\n", run_ms, (unsigned long)BENCH_TICK_MS,
+           (unsigned long)BENCH_RX_MEAN_MS);
+    printf("%-8s %6s %-8s %7s %5s %9s %9s %9s %9s\n", "loop", "duty", "event",
+           "posted", "lost", "mean us", "p50 us <", "p99 us <", "max us");
+
+    for (index = 0U; index < 2U; index++)
+    {
+        runs[index].loop = (bench_loop_t)index;
+        runs[index].run_ms = (uint32_t)run_ms;
+        bench_run(&runs[index]);
+        bench_print(&runs[index]);
+    }
+
+    index = (uint32_t)BENCH_LOOP_EVENT;
+    if ((runs[index].lost[0] != 0U) || (runs[index].lost[1] != 0U) ||
+        (runs[index].latency[0].count != runs[index].posted[0]) ||
+        (runs[index].latency[1].count != runs[index].posted[1]))
+    {
+        printf("FAIL\n");
+        return 1;
+    }
+
+    printf("PASS\n");
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_clock_ns
+********************************************************************************
+* Summary:
+* This function reads a clock of the host.
+*
+* Parameters:
+*  clock       CLOCK_MONOTONIC or CLOCK_THREAD_CPUTIME_ID
+*
+* Return:
+*  uint64_t    Time in ns
+*
+*******************************************************************************/
+static uint64_t bench_clock_ns(clockid_t clock)
+{
+    struct timespec now;
+
+    (void)clock_gettime(clock, &now);
+
+    return ((uint64_t)now.tv_sec * BENCH_NS_PER_S) + (uint64_t)now.tv_nsec;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_random
+********************************************************************************
+* Summary:
+* This function returns the next number of a linear congruential generator.
+*
+* Parameters:
+*  seed        State of the generator
+*
+* Return:
+*  uint32_t    Random number, 15 bits
+*
+*******************************************************************************/
+static uint32_t bench_random(uint32_t *seed)
+{
+    *seed = (*seed * 1103515245U) + 12345U;
+
+    return (*seed >> 16) & 0x7FFFU;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_run
+********************************************************************************
+* Summary:
+* This function runs one loop on the main thread against the interrupt
+* thread until the run time is over, and measures the CPU time the loop
+* used.
+*
+* Parameters:
+*  run         Run to perform, with the loop and the run time set
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_run(bench_run_t *run)
+{
+    pthread_t interrupts;
+    uint64_t cpu_ns;
+    uint64_t wall_ns;
+    uint32_t source;
+
+    for (source = 0U; source < BENCH_SOURCES; source++)
+    {
+        event_queue_init(&run->queues[source], bench_storage[source],
+                         EVENT_QUEUE_CAPACITY);
+    }
+    for (source = 0U; source < BENCH_ROWS; source++)
+    {
+        latency_hist_reset(&run->latency[source]);
+    }
+    (void)sem_init(&run->wakeup, 0, 0U);
+
+    cpu_ns = bench_clock_ns(CLOCK_THREAD_CPUTIME_ID);
+    wall_ns = bench_clock_ns(CLOCK_MONOTONIC);
+    (void)pthread_create(&interrupts, NULL, bench_interrupts, run);
+
+    if (run->loop == BENCH_LOOP_POLLING)
+    {
+        bench_polling_loop(run);
+    }
+    else
+    {
+        bench_event_loop(run);
+    }
+
+    run->cpu_ns = bench_clock_ns(CLOCK_THREAD_CPUTIME_ID) - cpu_ns;
+    run->wall_ns = bench_clock_ns(CLOCK_MONOTONIC) - wall_ns;
+    (void)pthread_join(interrupts, NULL);
+    (void)sem_destroy(&run->wakeup);
+}
+
+
+/*******************************************************************************
+* Function Name: bench_interrupts
+********************************************************************************
+* Summary:
+* This is the thread that stands in for the timer and UART interrupts. It
+* sleeps until the next tick or character is due and posts it to the loop
+* under test, with the same sequence of events for both loops. It also
+* records how late it woke up, a delay that comes from the host alone.
+*
+* Parameters:
+*  arg         Run under test
+*
+* Return:
+*  void *      NULL
+*
+*******************************************************************************/
+static void *bench_interrupts(void *arg)
+{
+    bench_run_t *run = (bench_run_t *)arg;
+    uint64_t start_ns = bench_clock_ns(CLOCK_MONOTONIC);
+    uint64_t end_ns = start_ns + ((uint64_t)run->run_ms * BENCH_NS_PER_MS);
+    uint64_t tick_ns = start_ns + (BENCH_TICK_MS * BENCH_NS_PER_MS);
+    uint64_t rx_ns = start_ns;
+    uint64_t next_ns;
+    uint32_t late_ns;
+    uint32_t seed = 1U;
+    struct timespec wake;
+
+    rx_ns += 1U + ((bench_random(&seed) * 2U * BENCH_RX_MEAN_MS *
+                    BENCH_NS_PER_MS) >> 15);
+
+    for (;;)
+    {
+        next_ns = (tick_ns < rx_ns) ? tick_ns : rx_ns;
+        if (next_ns >= end_ns)
+        {
+            break;
+        }
+
+        wake.tv_sec = (time_t)(next_ns / BENCH_NS_PER_S);
+        wake.tv_nsec = (long)(next_ns % BENCH_NS_PER_S);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake,
+                               NULL) != 0)
+        {
+        }
+
+        late_ns = (uint32_t)(bench_clock_ns(CLOCK_MONOTONIC) - next_ns);
+        run->posted[BENCH_HOST_WAKE]++;
+        latency_hist_record(&run->latency[BENCH_HOST_WAKE], late_ns);
+        run->latency_sum_ns[BENCH_HOST_WAKE] += late_ns;
+
+        if (next_ns == tick_ns)
+        {
+            bench_post(run, (uint32_t)EVENT_TIMER_TICK);
+            tick_ns += BENCH_TICK_MS * BENCH_NS_PER_MS;
+        }
+        else
+        {
+            bench_post(run, (uint32_t)EVENT_UART_RX);
+            rx_ns += 1U + ((bench_random(&seed) * 2U * BENCH_RX_MEAN_MS *
+                            BENCH_NS_PER_MS) >> 15);
+        }
+    }
+
+    /* Let the loop handle what is still pending, then stop it */
+    next_ns = bench_clock_ns(CLOCK_MONOTONIC) +
+              (2U * BENCH_GETC_TIMEOUT_MS * BENCH_NS_PER_MS);
+    wake.tv_sec = (time_t)(next_ns / BENCH_NS_PER_S);
+    wake.tv_nsec = (long)(next_ns % BENCH_NS_PER_S);
+    (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    run->done = 1U;
+    (void)sem_post(&run->wakeup);
+
+    return NULL;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_post
+********************************************************************************
+* Summary:
+* This function is the body of an interrupt. For the polling loop it sets
+* the flag of the source, which overwrites an event that was not handled
+* yet. For the event loop it queues an event and wakes the loop.
+*
+* Parameters:
+*  run         Run under test
+*  source      EVENT_UART_RX or EVENT_TIMER_TICK
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_post(bench_run_t *run, uint32_t source)
+{
+    uint64_t now_ns = bench_clock_ns(CLOCK_MONOTONIC);
+    volatile uint64_t *flag = (source == (uint32_t)EVENT_UART_RX) ?
+                              &run->rx_posted_ns : &run->tick_posted_ns;
+    event_t event;
+
+    run->posted[source]++;
+
+    if (run->loop == BENCH_LOOP_POLLING)
+    {
+        if (__atomic_exchange_n(flag, now_ns, __ATOMIC_SEQ_CST) != 0U)
+        {
+            run->lost[source]++;
+        }
+    }
+    else
+    {
+        event.id = source;
+        event.data = 0U;
+        event.timestamp = (uint32_t)now_ns;
+        if (!event_queue_push(&run->queues[source], &event))
+        {
+            run->lost[source]++;
+        }
+        (void)sem_post(&run->wakeup);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: bench_handle
+********************************************************************************
+* Summary:
+* This function is the handler of an event. It records the delay from the
+* post.
+*
+* Parameters:
+*  run         Run under test
+*  source      EVENT_UART_RX or EVENT_TIMER_TICK
+*  posted_ns   Time of the post, the low 32 bits are enough
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_handle(bench_run_t *run, uint32_t source,
+                         uint64_t posted_ns)
+{
+    uint32_t delay_ns = (uint32_t)bench_clock_ns(CLOCK_MONOTONIC) -
+                        (uint32_t)posted_ns;
+
+    latency_hist_record(&run->latency[source], delay_ns);
+    run->latency_sum_ns[source] += delay_ns;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_polling_loop
+********************************************************************************
+* Summary:
+* This function is the main loop of the original example. It waits for a
+* character in cyhal_uart_getc(), which polls the receive FIFO until the
+* timeout, and then checks the flag of the timer interrupt.
+*
+* Parameters:
+*  run         Run under test
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_polling_loop(bench_run_t *run)
+{
+    uint64_t timeout_ns;
+    uint64_t posted_ns;
+
+    while (run->done == 0U)
+    {
+        /* cyhal_uart_getc(&cy_retarget_io_uart_obj, &uart_read_value, 1) */
+        timeout_ns = bench_clock_ns(CLOCK_MONOTONIC) +
+                     (BENCH_GETC_TIMEOUT_MS * BENCH_NS_PER_MS);
+        while ((run->rx_posted_ns == 0U) &&
+               (bench_clock_ns(CLOCK_MONOTONIC) < timeout_ns))
+        {
+        }
+
+        posted_ns = __atomic_exchange_n(&run->rx_posted_ns, 0U,
+                                        __ATOMIC_SEQ_CST);
+        if (posted_ns != 0U)
+        {
+            bench_handle(run, (uint32_t)EVENT_UART_RX, posted_ns);
+        }
+
+        /* if (true == timer_interrupt_flag) */
+        posted_ns = __atomic_exchange_n(&run->tick_posted_ns, 0U,
+                                        __ATOMIC_SEQ_CST);
+        if (posted_ns != 0U)
+        {
+            bench_handle(run, (uint32_t)EVENT_TIMER_TICK, posted_ns);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: bench_event_loop
+********************************************************************************
+* Summary:
+* This function is the dispatch of event_loop_run(). It sleeps while no
+* event is queued and then drains the queues in the order of their event
+* IDs.
+*
+* Parameters:
+*  run         Run under test
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_event_loop(bench_run_t *run)
+{
+    uint32_t source;
+    uint32_t count;
+    event_t event;
+
+    while (run->done == 0U)
+    {
+        if ((event_queue_count(&run->queues[0]) == 0U) &&
+            (event_queue_count(&run->queues[1]) == 0U))
+        {
+            /* idle_sleep() */
+            (void)sem_wait(&run->wakeup);
+        }
+
+        for (source = 0U; source < BENCH_SOURCES; source++)
+        {
+            count = event_queue_count(&run->queues[source]);
+            while ((count > 0U) &&
+                   event_queue_pop(&run->queues[source], &event))
+            {
+                bench_handle(run, source, event.timestamp);
+                count--;
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: bench_print
+********************************************************************************
+* Summary:
+* This function prints the results of a run, one line per event and one for
+* the wakeup lateness of the interrupt thread.
+*
+* Parameters:
+*  run         Run to print
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_print(const bench_run_t *run)
+{
+    uint32_t source;
+    const latency_hist_t *hist;
+    char duty[8] = "";
+
+    /* The duty cycle is printed on the first line of the loop only */
+    (void)snprintf(duty, sizeof(duty), "%5.1f%%",
+                   100.0 * (double)run->cpu_ns / (double)run->wall_ns);
+
+    for (source = 0U; source < BENCH_ROWS; source++)
+    {
+        hist = &run->latency[source];
+
+        printf("%-8s %6s %-8s %7lu %5lu %9.1f %9.1f %9.1f %9.1f\n",
+               (source == 0U) ? bench_loop_names[run->loop] : "",
+               (source == 0U) ? duty : "",
+               bench_source_names[source],
+               (unsigned long)run->posted[source],
+               (unsigned long)run->lost[source],
+               (hist->count == 0U) ? 0.0 :
+               ((double)run->latency_sum_ns[source] / 1000.0 /
+                (double)hist->count),
+               (double)latency_hist_percentile(hist, 500U) / 1000.0,
+               (double)latency_hist_percentile(hist, 990U) / 1000.0,
+               (double)hist->max / 1000.0);
+    }
+}
+
+/* [] END OF FILE */
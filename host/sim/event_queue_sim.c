@@ -0,0 +1,517 @@
+/******************************************************************************
+* File Name:   event_queue_sim.c
+*
+* Description: This file is a host stress test of the event queue of
+*              source/event_queue.c. A producer thread stands in for an
+*              interrupt that posts events, the main thread for the event loop
+*              that takes them. It checks that no event is lost, repeated or
+*              damaged, and that the overflow counter matches the events the
+*              queue refused, both for bursts that overflow the queue on purpose
+*              and for a consumer that falls behind at random.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "event_queue.h"
+#include "event_loop.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Capacity of the queue, as in the event loop */
+#define SIM_CAPACITY                (EVENT_QUEUE_CAPACITY)
+
+/* Events of the free running phase, overridden by the first argument */
+#define SIM_DEFAULT_EVENTS          (2000000UL)
+
+/* Bursts of the overflow phase, and the most events each overflows by */
+#define SIM_BURSTS                  (10000UL)
+#define SIM_MAX_EXTRA               (3U * SIM_CAPACITY)
+
+/* One in this many events the consumer pauses for SIM_PAUSE_SPINS */
+#define SIM_PAUSE_RATE              (64U)
+#define SIM_PAUSE_SPINS             (2000U)
+
+/* The producer posts a burst of up to SIM_MAX_BURST events, one every 0 to
+ * SIM_MAX_GAP_SPINS, then yields the CPU, so that the threads interleave
+ * even on a host with one CPU */
+#define SIM_MAX_BURST               (2U * SIM_CAPACITY)
+#define SIM_MAX_GAP_SPINS           (200U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Free running phase: the producer posts without retrying, as an interrupt
+ * would, and marks the events the queue took */
+typedef struct
+{
+    event_queue_t queue;
+    uint32_t events;
+    uint8_t *accepted;          /* Per event, written before it is posted */
+    volatile uint32_t done;     /* Set by the producer after the last post */
+    uint32_t refused;           /* Posts that returned false */
+} sim_free_t;
+
+/* Overflow phase: the producer fills the empty queue beyond its capacity
+ * while the consumer waits, then the consumer drains it */
+typedef struct
+{
+    event_queue_t queue;
+    sem_t filled;               /* The producer has posted a burst */
+    sem_t drained;              /* The consumer has emptied the queue */
+    uint32_t next;              /* Sequence number of the next post */
+    uint32_t first;             /* Sequence number of the burst */
+    uint32_t posted;            /* Events posted in the burst */
+    uint32_t refused;           /* Of them refused */
+    uint32_t wrong_refusals;    /* Bursts refused in the wrong places */
+} sim_burst_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static event_t sim_storage[SIM_CAPACITY];
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void sim_event(event_t *event, uint32_t sequence);
+static bool sim_check(const event_t *event, uint32_t sequence);
+static uint32_t sim_random(uint32_t *seed);
+static int sim_run_free(uint32_t events);
+static void *sim_free_producer(void *arg);
+static int sim_run_bursts(void);
+static void *sim_burst_producer(void *arg);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* This function runs both phases and prints their results. The exit status
+* is 1 if an event was lost, repeated, out of order or damaged, or the
+* overflow counter does not match the refused posts.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Optional number of events of the free running phase
+*
+* Return:
+*  int         0 if both phases passed
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    unsigned long events = SIM_DEFAULT_EVENTS;
+    int status;
+
+    if (argc > 1)
+    {
+        events = strtoul(argv[1], NULL, 10);
+    }
+
+    printf("%u slots\n", SIM_CAPACITY);
+    status = sim_run_bursts();
+    status |= sim_run_free((uint32_t)events);
+    printf("%s\n", (status == 0) ? "PASS" : "FAIL");
+
+    return status;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_event
+********************************************************************************
+* Summary:
+* This function fills in an event from its sequence number.
+*
+* Parameters:
+*  event       Event to fill in
+*  sequence    Sequence number
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sim_event(event_t *event, uint32_t sequence)
+{
+    event->id = sequence % EVENT_COUNT;
+    event->data = sequence;
+    event->timestamp = ~sequence;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_check
+********************************************************************************
+* Summary:
+* This function checks an event filled in by sim_event().
+*
+* Parameters:
+*  event       Event to check
+*  sequence    Expected sequence number
+*
+* Return:
+*  bool        true if the event is the expected one and intact
+*
+*******************************************************************************/
+static bool sim_check(const event_t *event, uint32_t sequence)
+{
+    return (event->data == sequence) &&
+           (event->id == (sequence % EVENT_COUNT)) &&
+           (event->timestamp == ~sequence);
+}
+
+
+/*******************************************************************************
+* Function Name: sim_random
+********************************************************************************
+* Summary:
+* This function returns the next number of a linear congruential generator.
+*
+* Parameters:
+*  seed        State of the generator
+*
+* Return:
+*  uint32_t    Random number, 15 bits
+*
+*******************************************************************************/
+static uint32_t sim_random(uint32_t *seed)
+{
+    *seed = (*seed * 1103515245U) + 12345U;
+
+    return (*seed >> 16) & 0x7FFFU;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_run_bursts
+********************************************************************************
+* Summary:
+* This function runs the overflow phase. Each burst posts the capacity of
+* the queue plus 0 to SIM_MAX_EXTRA events into the empty queue. Exactly the
+* extra events must be refused and counted as overflows, and the consumer
+* must then take the first events of the burst, in order.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int         0 if the phase passed
+*
+*******************************************************************************/
+static int sim_run_bursts(void)
+{
+    static sim_burst_t run;
+    pthread_t producer;
+    event_t event;
+    uint32_t burst;
+    uint32_t taken;
+    uint32_t lost = 0U;
+    uint32_t corrupt = 0U;
+    uint64_t refused = 0U;
+
+    memset(&run, 0, sizeof(run));
+    event_queue_init(&run.queue, sim_storage, SIM_CAPACITY);
+    (void)sem_init(&run.filled, 0, 0U);
+    (void)sem_init(&run.drained, 0, 0U);
+    (void)pthread_create(&producer, NULL, sim_burst_producer, &run);
+
+    for (burst = 0U; burst < SIM_BURSTS; burst++)
+    {
+        (void)sem_wait(&run.filled);
+
+        for (taken = 0U; event_queue_pop(&run.queue, &event); taken++)
+        {
+            if (!sim_check(&event, run.first + taken))
+            {
+                corrupt++;
+            }
+        }
+        if (taken != (run.posted - run.refused))
+        {
+            lost++;
+        }
+        refused += run.refused;
+
+        (void)sem_post(&run.drained);
+    }
+
+    (void)pthread_join(producer, NULL);
+    (void)sem_destroy(&run.filled);
+    (void)sem_destroy(&run.drained);
+
+    printf("overflow: %lu bursts, %lu posts, %llu refused, "
+           "%lu overflows counted\n", (unsigned long)SIM_BURSTS,
+           (unsigned long)run.next, (unsigned long long)refused,
+           (unsigned long)run.queue.overflows);
+    printf("          %lu bursts short, %lu damaged, %lu refused in the "
+           "wrong place\n", (unsigned long)lost, (unsigned long)corrupt,
+           (unsigned long)run.wrong_refusals);
+
+    return ((lost == 0U) && (corrupt == 0U) && (run.wrong_refusals == 0U) &&
+            (refused == run.queue.overflows) &&
+            ((run.next - refused) == run.queue.pushed)) ? 0 : 1;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_burst_producer
+********************************************************************************
+* Summary:
+* This is the producer thread of the overflow phase. It posts each burst
+* into the queue the consumer has emptied and checks that the posts fail
+* from the first one beyond the capacity on.
+*
+* Parameters:
+*  arg         Run of the phase
+*
+* Return:
+*  void *      NULL
+*
+*******************************************************************************/
+static void *sim_burst_producer(void *arg)
+{
+    sim_burst_t *run = (sim_burst_t *)arg;
+    event_t event;
+    uint32_t burst;
+    uint32_t index;
+    uint32_t seed = 1U;
+    uint32_t overflows;
+    bool accepted;
+    bool wrong;
+
+    for (burst = 0U; burst < SIM_BURSTS; burst++)
+    {
+        run->first = run->next;
+        run->posted = SIM_CAPACITY + (sim_random(&seed) %
+                                      (SIM_MAX_EXTRA + 1U));
+        run->refused = 0U;
+        overflows = run->queue.overflows;
+        wrong = false;
+
+        for (index = 0U; index < run->posted; index++)
+        {
+            sim_event(&event, run->next);
+            accepted = event_queue_push(&run->queue, &event);
+            if (accepted != (index < SIM_CAPACITY))
+            {
+                wrong = true;
+            }
+            if (!accepted)
+            {
+                run->refused++;
+            }
+            run->next++;
+        }
+        if (wrong || ((run->queue.overflows - overflows) != run->refused))
+        {
+            run->wrong_refusals++;
+        }
+
+        (void)sem_post(&run->filled);
+        (void)sem_wait(&run->drained);
+    }
+
+    return NULL;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_run_free
+********************************************************************************
+* Summary:
+* This function runs the free running phase. The producer posts as fast as
+* it can while the consumer takes the events and pauses now and then, so
+* that the queue overflows at random. Every event taken must have been
+* accepted, in increasing order, and every accepted event must be taken.
+*
+* Parameters:
+*  events      Number of events to post
+*
+* Return:
+*  int         0 if the phase passed
+*
+*******************************************************************************/
+static int sim_run_free(uint32_t events)
+{
+    static sim_free_t run;
+    pthread_t producer;
+    event_t event;
+    uint32_t received = 0U;
+    uint32_t expected = 0U;
+    uint32_t corrupt = 0U;
+    uint32_t unaccepted = 0U;
+    uint32_t accepted = 0U;
+    uint32_t index;
+    uint32_t seed = 2U;
+    volatile uint32_t spin;
+    bool done;
+
+    memset(&run, 0, sizeof(run));
+    run.events = events;
+    run.accepted = calloc(events, 1U);
+    if (run.accepted == NULL)
+    {
+        return 1;
+    }
+    event_queue_init(&run.queue, sim_storage, SIM_CAPACITY);
+    (void)pthread_create(&producer, NULL, sim_free_producer, &run);
+
+    do
+    {
+        /* Read the flag before the queue, so nothing posted before it is
+         * missed */
+        done = (run.done != 0U);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        while (event_queue_pop(&run.queue, &event))
+        {
+            /* Events refused in between are skipped, never repeated or
+             * reordered */
+            if ((event.data < expected) || (event.data >= events) ||
+                !sim_check(&event, event.data))
+            {
+                corrupt++;
+                continue;
+            }
+            if (run.accepted[event.data] == 0U)
+            {
+                unaccepted++;
+            }
+            expected = event.data + 1U;
+            received++;
+
+            if ((sim_random(&seed) % SIM_PAUSE_RATE) == 0U)
+            {
+                for (spin = 0U; spin < SIM_PAUSE_SPINS; spin++)
+                {
+                }
+            }
+        }
+
+        if (!done)
+        {
+            (void)sched_yield();
+        }
+    } while (!done);
+
+    (void)pthread_join(producer, NULL);
+
+    for (index = 0U; index < events; index++)
+    {
+        accepted += run.accepted[index];
+    }
+    free(run.accepted);
+
+    printf("free:     %lu posts, %lu refused, %lu overflows counted, "
+           "%lu taken\n", (unsigned long)events, (unsigned long)run.refused,
+           (unsigned long)run.queue.overflows, (unsigned long)received);
+    printf("          %lu lost, %lu damaged or out of order, %lu not "
+           "accepted\n", (unsigned long)(accepted - received),
+           (unsigned long)corrupt, (unsigned long)unaccepted);
+
+    return ((received == accepted) && (corrupt == 0U) &&
+            (unaccepted == 0U) && (run.refused == run.queue.overflows) &&
+            (run.queue.pushed == accepted) &&
+            ((accepted + run.refused) == events)) ? 0 : 1;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_free_producer
+********************************************************************************
+* Summary:
+* This is the producer thread of the free running phase. It posts in bursts
+* at random intervals, like an interrupt. It marks each event accepted
+* before it posts it, so the consumer finds the mark set for every event it
+* takes, and clears the mark again when the queue is full.
+*
+* Parameters:
+*  arg         Run of the phase
+*
+* Return:
+*  void *      NULL
+*
+*******************************************************************************/
+static void *sim_free_producer(void *arg)
+{
+    sim_free_t *run = (sim_free_t *)arg;
+    event_t event;
+    uint32_t sequence;
+    uint32_t burst = 0U;
+    uint32_t seed = 3U;
+    uint32_t gap;
+    volatile uint32_t spin;
+
+    for (sequence = 0U; sequence < run->events; sequence++)
+    {
+        if (burst == 0U)
+        {
+            (void)sched_yield();
+            burst = 1U + (sim_random(&seed) % SIM_MAX_BURST);
+        }
+        burst--;
+        gap = sim_random(&seed) % (SIM_MAX_GAP_SPINS + 1U);
+        for (spin = 0U; spin < gap; spin++)
+        {
+        }
+
+        sim_event(&event, sequence);
+        run->accepted[sequence] = 1U;
+        if (!event_queue_push(&run->queue, &event))
+        {
+            run->accepted[sequence] = 0U;
+            run->refused++;
+        }
+    }
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    run->done = 1U;
+
+    return NULL;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,385 @@
+/******************************************************************************
+* File Name:   ipc_ring_sim.c
+*
+* Description: This file is a host simulation of the message rings of
+*              source/ipc_ring.c between the two cores. A producer and a
+*              consumer thread stand in for the CM4 and the CM0+, a semaphore
+*              for the IPC doorbell. It checks that every message arrives once,
+*              in order and intact, and that no doorbell is missed, and measures
+*              the throughput for a range of message sizes.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ipc_ring.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SIM_SLOTS                   (64U)
+#define SIM_MAX_MSG_SIZE            (256U)
+#define SIM_MAX_BATCH               (8U)
+
+/* Messages per size, overridden by the first argument */
+#define SIM_DEFAULT_MSGS            (500000UL)
+
+/* A consumer waiting this long with messages in the ring missed a doorbell */
+#define SIM_DOORBELL_TIMEOUT_MS     (1000L)
+
+#define SIM_NS_PER_S                (1000000000ULL)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* One run of the simulation */
+typedef struct
+{
+    ipc_ring_t ring;
+    uint32_t msg_size;
+    uint32_t msgs;
+    sem_t doorbell;             /* IPC notify event of the consumer */
+    uint32_t received;
+    uint32_t corrupt;           /* Out of order or damaged messages */
+    uint32_t missed_doorbells;  /* Waits that timed out with messages waiting */
+    uint32_t waits;             /* Times the consumer waited for the doorbell */
+} sim_run_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const uint32_t sim_sizes[] = { 4U, 8U, 16U, 32U, 64U, 128U, 256U };
+
+static uint8_t sim_slots[SIM_SLOTS * SIM_MAX_MSG_SIZE]
+    __attribute__((aligned(IPC_RING_LINE)));
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void sim_fill(uint8_t *msg, uint32_t size, uint32_t sequence);
+static bool sim_check(const uint8_t *msg, uint32_t size, uint32_t sequence);
+static void *sim_producer(void *arg);
+static void *sim_consumer(void *arg);
+static uint64_t sim_now_ns(void);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* This function runs the simulation for every message size and prints the
+* results. The exit status is 1 if any message was lost, repeated, out of
+* order or damaged, or a doorbell was missed.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Optional number of messages per size
+*
+* Return:
+*  int         0 if all runs passed
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    static sim_run_t run;
+    unsigned long msgs = SIM_DEFAULT_MSGS;
+    pthread_t producer;
+    pthread_t consumer;
+    uint64_t start;
+    uint64_t elapsed;
+    uint32_t index;
+    int status = 0;
+
+    if (argc > 1)
+    {
+        msgs = strtoul(argv[1], NULL, 10);
+    }
+
+    printf("%u slots, %lu messages per size\n", SIM_SLOTS, msgs);
+    printf("%6s %12s %10s %11s %11s %8s %8s\n", "bytes", "msgs/s", "MB/s",
+           "doorbells", "avg batch", "waits", "errors");
+
+    for (index = 0U; index < (sizeof(sim_sizes) / sizeof(sim_sizes[0]));
+         index++)
+    {
+        memset(&run, 0, sizeof(run));
+        run.msg_size = sim_sizes[index];
+        run.msgs = (uint32_t)msgs;
+        ipc_ring_init(&run.ring, sim_slots, run.msg_size, SIM_SLOTS);
+        (void)sem_init(&run.doorbell, 0, 0U);
+
+        start = sim_now_ns();
+        (void)pthread_create(&consumer, NULL, sim_consumer, &run);
+        (void)pthread_create(&producer, NULL, sim_producer, &run);
+        (void)pthread_join(producer, NULL);
+        (void)pthread_join(consumer, NULL);
+        elapsed = sim_now_ns() - start;
+        (void)sem_destroy(&run.doorbell);
+
+        if ((run.received != run.msgs) || (run.corrupt != 0U) ||
+            (run.missed_doorbells != 0U))
+        {
+            status = 1;
+        }
+
+        printf("%6lu %12.0f %10.1f %11lu %11.2f %8lu %8lu\n",
+               (unsigned long)run.msg_size,
+               (double)run.received * SIM_NS_PER_S / (double)elapsed,
+               (double)run.received * run.msg_size * 1000.0 /
+               (double)elapsed,
+               (unsigned long)run.ring.doorbells,
+               (run.ring.batches != 0U) ?
+               ((double)run.received / run.ring.batches) : 0.0,
+               (unsigned long)run.waits,
+               (unsigned long)(run.corrupt + run.missed_doorbells +
+                               (run.msgs - run.received)));
+    }
+
+    printf("%s\n", (status == 0) ? "PASS" : "FAIL");
+
+    return status;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_fill
+********************************************************************************
+* Summary:
+* This function writes the sequence number and a pattern derived from it.
+*
+* Parameters:
+*  msg         Message to fill
+*  size        Message size, at least 4
+*  sequence    Sequence number
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void sim_fill(uint8_t *msg, uint32_t size, uint32_t sequence)
+{
+    uint32_t index;
+
+    memcpy(msg, &sequence, sizeof(sequence));
+    for (index = sizeof(sequence); index < size; index++)
+    {
+        msg[index] = (uint8_t)(sequence + index);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: sim_check
+********************************************************************************
+* Summary:
+* This function checks a message written by sim_fill().
+*
+* Parameters:
+*  msg         Message to check
+*  size        Message size
+*  sequence    Expected sequence number
+*
+* Return:
+*  bool        true if the message is the expected one and intact
+*
+*******************************************************************************/
+static bool sim_check(const uint8_t *msg, uint32_t size, uint32_t sequence)
+{
+    uint32_t value;
+    uint32_t index;
+
+    memcpy(&value, msg, sizeof(value));
+    if (value != sequence)
+    {
+        return false;
+    }
+    for (index = sizeof(sequence); index < size; index++)
+    {
+        if (msg[index] != (uint8_t)(sequence + index))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_producer
+********************************************************************************
+* Summary:
+* This is the producer thread. It writes the messages in batches of 1 to
+* SIM_MAX_BATCH, retries what the full ring refuses, and rings the doorbell
+* when ipc_ring_write() asks for it.
+*
+* Parameters:
+*  arg         Run of the simulation
+*
+* Return:
+*  void *      NULL
+*
+*******************************************************************************/
+static void *sim_producer(void *arg)
+{
+    sim_run_t *run = (sim_run_t *)arg;
+    uint8_t batch[SIM_MAX_BATCH * SIM_MAX_MSG_SIZE];
+    uint32_t sent = 0U;
+    uint32_t count;
+    uint32_t index;
+    uint32_t seed = 1U;
+    bool doorbell;
+
+    while (sent < run->msgs)
+    {
+        seed = (seed * 1103515245U) + 12345U;
+        count = 1U + ((seed >> 16) % SIM_MAX_BATCH);
+        if (count > (run->msgs - sent))
+        {
+            count = run->msgs - sent;
+        }
+        for (index = 0U; index < count; index++)
+        {
+            sim_fill(&batch[index * run->msg_size], run->msg_size,
+                     sent + index);
+        }
+
+        count = ipc_ring_write(&run->ring, batch, count, &doorbell);
+        if (doorbell)
+        {
+            (void)sem_post(&run->doorbell);
+        }
+        sent += count;
+    }
+
+    return NULL;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_consumer
+********************************************************************************
+* Summary:
+* This is the consumer thread. It takes the waiting messages in batches and
+* waits for the doorbell only after a peek that follows its last release
+* found the ring empty, as the CM0+ image does. A wait that times out while
+* messages are waiting is a missed doorbell; the consumer then goes on.
+*
+* Parameters:
+*  arg         Run of the simulation
+*
+* Return:
+*  void *      NULL
+*
+*******************************************************************************/
+static void *sim_consumer(void *arg)
+{
+    sim_run_t *run = (sim_run_t *)arg;
+    const void *msgs;
+    struct timespec deadline;
+    uint32_t count;
+    uint32_t index;
+    int result;
+
+    while (run->received < run->msgs)
+    {
+        count = ipc_ring_peek(&run->ring, &msgs);
+        if (count == 0U)
+        {
+            run->waits++;
+            (void)clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec += SIM_DOORBELL_TIMEOUT_MS / 1000L;
+            do
+            {
+                result = sem_timedwait(&run->doorbell, &deadline);
+            } while ((result != 0) && (errno == EINTR));
+
+            if ((result != 0) && (ipc_ring_count(&run->ring) != 0U))
+            {
+                run->missed_doorbells++;
+            }
+            continue;
+        }
+
+        for (index = 0U; index < count; index++)
+        {
+            if (!sim_check(&((const uint8_t *)msgs)[index * run->msg_size],
+                           run->msg_size, run->received + index))
+            {
+                run->corrupt++;
+            }
+        }
+        ipc_ring_release(&run->ring, count);
+        run->received += count;
+    }
+
+    return NULL;
+}
+
+
+/*******************************************************************************
+* Function Name: sim_now_ns
+********************************************************************************
+* Summary:
+* This function reads the monotonic clock.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint64_t    Time in nanoseconds
+*
+*******************************************************************************/
+static uint64_t sim_now_ns(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * SIM_NS_PER_S) + (uint64_t)now.tv_nsec;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,496 @@
+/******************************************************************************
+* File Name:   soft_timer_bench.c
+*
+* Description: This file is a host benchmark of the soft timer wheel of
+*              source/soft_timer.c. It replaces the hardware timer and the event
+*              loop by a counter that it moves itself, and measures the time per
+*              soft_timer_start(), soft_timer_stop() and expiry with 10, 100 and
+*              1000 timers running. It also checks that every timer expires once
+*              and never early.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cy_tcpwm_counter.h"
+#include "soft_timer.h"
+#include "event_loop.h"
+#include "power_gov.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BENCH_NS_PER_S              (1000000000ULL)
+
+/* Starts and stops measured per population size, overridden by the first
+ * argument */
+#define BENCH_DEFAULT_OPS           (1000000UL)
+
+/* Longest delay of a timer, 10 s at the 100 us tick of main.c, which puts
+ * the timers on the three lower levels of the wheel */
+#define BENCH_MAX_DELAY             (100000UL)
+
+/* Largest population, for the storage of the timers */
+#define BENCH_MAX_TIMERS            (1000U)
+
+/* The hardware counter is 16 bits wide, as in source/soft_timer.c */
+#define BENCH_COUNTER_MASK          (0xFFFFUL)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Results of one population size, in ns per operation */
+typedef struct
+{
+    double start_ns;
+    double stop_ns;
+    double expire_ns;
+    uint32_t wakeups;           /* Handler runs to expire the population */
+    uint32_t errors;            /* Timers that expired early or not once */
+} bench_result_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Stand-in for the TCPWM counter and its compare value */
+static uint32_t bench_counter;
+static uint32_t bench_compare;
+
+/* Set by event_post(), cleared when the handler runs */
+static bool bench_pending;
+static event_handler_t bench_handler;
+
+static soft_timer_t bench_timers[BENCH_MAX_TIMERS];
+static uint32_t bench_expiries[BENCH_MAX_TIMERS];
+static uint32_t bench_expired;
+static uint32_t bench_early;
+
+/* Population sizes measured */
+static const uint32_t bench_sizes[] = { 10U, 100U, 1000U };
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint64_t bench_now_ns(void);
+static uint32_t bench_random(uint32_t *seed);
+static uint32_t bench_delay(uint32_t *seed);
+static void bench_callback(void *callback_arg);
+static void bench_run(uint32_t timers, uint32_t ops, bench_result_t *result);
+static uint32_t bench_expire(uint32_t timers);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* This function measures each population size and prints a table of the
+* results. The exit status is 1 if a timer expired early or not exactly
+* once.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Optional number of starts and stops per population size
+*
+* Return:
+*  int         0 if every timer expired as expected
+*
+*******************************************************************************/
+int main(int argc, char *argv[])
+{
+    const timer_cfg_t cfg = TIMER_CFG_INIT(1000000UL, 100UL);
+    unsigned long ops = BENCH_DEFAULT_OPS;
+    bench_result_t result;
+    uint32_t index;
+    uint32_t errors = 0U;
+
+    if (argc > 1)
+    {
+        ops = strtoul(argv[1], NULL, 10);
+    }
+
+    if (soft_timer_init(&cfg) != CY_RSLT_SUCCESS)
+    {
+        printf("soft_timer_init failed\nFAIL\n");
+        return 1;
+    }
+
+    printf("%7s %10s %10s %10s %8s\n",
+           "timers", "start ns", "stop ns", "expire ns", "wakeups");
+
+    for (index = 0U; index < (sizeof(bench_sizes) / sizeof(bench_sizes[0]));
+         index++)
+    {
+        bench_run(bench_sizes[index], (uint32_t)ops, &result);
+        errors += result.errors;
+
+        printf("%7lu %10.1f %10.1f %10.1f %8lu\n",
+               (unsigned long)bench_sizes[index], result.start_ns,
+               result.stop_ns, result.expire_ns,
+               (unsigned long)result.wakeups);
+    }
+
+    printf("%s\n", (errors == 0U) ? "PASS" : "FAIL");
+
+    return (errors == 0U) ? 0 : 1;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_now_ns
+********************************************************************************
+* Summary:
+* This function reads the monotonic clock of the host.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint64_t    Time in ns
+*
+*******************************************************************************/
+static uint64_t bench_now_ns(void)
+{
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * BENCH_NS_PER_S) + (uint64_t)now.tv_nsec;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_random
+********************************************************************************
+* Summary:
+* This function returns the next number of a linear congruential generator.
+*
+* Parameters:
+*  seed        State of the generator
+*
+* Return:
+*  uint32_t    Random number, 15 bits
+*
+*******************************************************************************/
+static uint32_t bench_random(uint32_t *seed)
+{
+    *seed = (*seed * 1103515245U) + 12345U;
+
+    return (*seed >> 16) & 0x7FFFU;
+}
+
+
+/*******************************************************************************
+* Function Name: bench_delay
+********************************************************************************
+* Summary:
+* This function returns a random timer delay.
+*
+* Parameters:
+*  seed        State of the generator
+*
+* Return:
+*  uint32_t    Delay in ticks, 1 to BENCH_MAX_DELAY
+*
+*******************************************************************************/
+static uint32_t bench_delay(uint32_t *seed)
+{
+    uint32_t value = (bench_random(seed) << 15) | bench_random(seed);
+
+    return 1U + (value % BENCH_MAX_DELAY);
+}
+
+
+/*******************************************************************************
+* Function Name: bench_callback
+********************************************************************************
+* Summary:
+* This function is the callback of every timer. It counts the expiry and
+* checks that the timer is not early.
+*
+* Parameters:
+*  callback_arg    Timer that expired
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_callback(void *callback_arg)
+{
+    soft_timer_t *timer = (soft_timer_t *)callback_arg;
+
+    bench_expiries[timer - bench_timers]++;
+    bench_expired++;
+
+    if ((soft_timer_now() - timer->expires) > SOFT_TIMER_MAX_DELAY)
+    {
+        bench_early++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: bench_run
+********************************************************************************
+* Summary:
+* This function measures one population size. Each round starts every timer
+* with a random delay and then stops every timer, so a start links into a
+* wheel that holds up to the population and a stop unlinks from a full one.
+* Then the whole population is started once more and left to expire.
+*
+* Parameters:
+*  timers      Number of timers
+*  ops         Starts and stops to measure, rounded to whole rounds
+*  result      Location to store the results
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void bench_run(uint32_t timers, uint32_t ops, bench_result_t *result)
+{
+    uint32_t rounds = (ops + timers - 1U) / timers;
+    uint32_t seed = timers;
+    uint32_t round;
+    uint32_t index;
+    uint64_t start_ns = 0U;
+    uint64_t stop_ns = 0U;
+    uint64_t begin;
+    uint32_t delays[BENCH_MAX_TIMERS];
+
+    for (index = 0U; index < timers; index++)
+    {
+        soft_timer_setup(&bench_timers[index], bench_callback,
+                         &bench_timers[index]);
+        bench_expiries[index] = 0U;
+    }
+
+    for (round = 0U; round < rounds; round++)
+    {
+        /* Draw the delays outside of the measurement */
+        for (index = 0U; index < timers; index++)
+        {
+            delays[index] = bench_delay(&seed);
+        }
+
+        begin = bench_now_ns();
+        for (index = 0U; index < timers; index++)
+        {
+            soft_timer_start(&bench_timers[index], delays[index], 0U);
+        }
+        start_ns += bench_now_ns() - begin;
+
+        begin = bench_now_ns();
+        for (index = 0U; index < timers; index++)
+        {
+            soft_timer_stop(&bench_timers[index]);
+        }
+        stop_ns += bench_now_ns() - begin;
+    }
+
+    for (index = 0U; index < timers; index++)
+    {
+        soft_timer_start(&bench_timers[index], bench_delay(&seed), 0U);
+    }
+
+    bench_expired = 0U;
+    bench_early = 0U;
+    begin = bench_now_ns();
+    result->wakeups = bench_expire(timers);
+    result->expire_ns = (double)(bench_now_ns() - begin) / (double)timers;
+
+    result->start_ns = (double)start_ns / ((double)rounds * (double)timers);
+    result->stop_ns = (double)stop_ns / ((double)rounds * (double)timers);
+
+    result->errors = bench_early;
+    for (index = 0U; index < timers; index++)
+    {
+        if (bench_expiries[index] != 1U)
+        {
+            result->errors++;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: bench_expire
+********************************************************************************
+* Summary:
+* This function runs the timer event until every timer has expired. Before
+* each run the counter jumps to the compare value, as if the CPU slept until
+* the compare interrupt; an event posted while the wheel was reprogrammed is
+* handled without moving the counter.
+*
+* Parameters:
+*  timers      Number of timers running
+*
+* Return:
+*  uint32_t    Number of handler runs
+*
+*******************************************************************************/
+static uint32_t bench_expire(uint32_t timers)
+{
+    const event_t event = { .id = EVENT_TIMER_TICK };
+    uint32_t wakeups = 0U;
+
+    while (bench_expired < timers)
+    {
+        if (!bench_pending)
+        {
+            bench_counter = bench_compare;
+        }
+        bench_pending = false;
+
+        bench_handler(&event);
+        wakeups++;
+    }
+
+    return wakeups;
+}
+
+
+/*******************************************************************************
+* Stand-ins for the hardware timer, the event loop and the power governor.
+* The counter only moves in bench_expire(), so the measurements do not
+* include any time spent in them.
+*******************************************************************************/
+cy_rslt_t cyhal_timer_init(cyhal_timer_t *obj, cyhal_gpio_t pin,
+                           const cyhal_clock_t *clk)
+{
+    (void)obj;
+    (void)pin;
+    (void)clk;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_timer_configure(cyhal_timer_t *obj,
+                                const cyhal_timer_cfg_t *cfg)
+{
+    (void)obj;
+    bench_compare = cfg->compare_value;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_timer_set_frequency(cyhal_timer_t *obj, uint32_t hz)
+{
+    (void)obj;
+    (void)hz;
+
+    return CY_RSLT_SUCCESS;
+}
+
+cy_rslt_t cyhal_timer_start(cyhal_timer_t *obj)
+{
+    (void)obj;
+
+    return CY_RSLT_SUCCESS;
+}
+
+uint32_t cyhal_timer_read(const cyhal_timer_t *obj)
+{
+    (void)obj;
+
+    return bench_counter;
+}
+
+void cyhal_timer_register_callback(cyhal_timer_t *obj,
+                                   cyhal_timer_event_callback_t callback,
+                                   void *callback_arg)
+{
+    (void)obj;
+    (void)callback;
+    (void)callback_arg;
+}
+
+void cyhal_timer_enable_event(cyhal_timer_t *obj, cyhal_timer_event_t event,
+                              uint8_t intr_priority, bool enable)
+{
+    (void)obj;
+    (void)event;
+    (void)intr_priority;
+    (void)enable;
+}
+
+void Cy_TCPWM_Counter_SetCompare0(TCPWM_Type *base, uint32_t cntNum,
+                                  uint32_t compare0)
+{
+    (void)base;
+    (void)cntNum;
+
+    bench_compare = compare0 & BENCH_COUNTER_MASK;
+}
+
+uint32_t cyhal_system_critical_section_enter(void)
+{
+    return 0U;
+}
+
+void cyhal_system_critical_section_exit(uint32_t old_state)
+{
+    (void)old_state;
+}
+
+void event_loop_register(event_id_t id, event_handler_t handler)
+{
+    (void)id;
+
+    bench_handler = handler;
+}
+
+bool event_post(event_id_t id, uint32_t data)
+{
+    (void)id;
+    (void)data;
+
+    bench_pending = true;
+
+    return true;
+}
+
+void power_gov_register(power_gov_notifier_t *notifier)
+{
+    (void)notifier;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,285 @@
+/******************************************************************************
+* File Name:   timer_cfg_test.c
+*
+* Description: This file is a host test of the compile time timer configuration
+*              of source/timer_cfg.h. CLK_PERI is made a variable, so that the
+*              macros can be checked at run time against a brute force search
+*              over the whole range: every clock of the power governor, every
+*              tick resolution from the undivided clock to beyond the largest
+*              divider, and periods up to the 32-bit counter.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* The macros read CLK_PERI from this variable instead of a constant */
+static uint32_t test_clk_peri_hz;
+#define TIMER_CFG_CLK_PERI_HZ       (test_clk_peri_hz)
+
+#include "timer_cfg.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Tick resolutions tried, in us; the largest divider is reached at 655 us */
+#define TEST_MAX_RESOLUTION_US      (700UL)
+
+/* Factor between two periods tried, and the longest period */
+#define TEST_PERIOD_STEP            (1.01)
+#define TEST_MAX_TICKS              (4294967295.0)
+
+/* Failures printed before the rest are only counted */
+#define TEST_MAX_REPORTS            (10UL)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* CLK_PERI of the operating points of source/power_gov.c */
+static const uint32_t test_clocks[] =
+{
+    100000000UL, 25000000UL, 12500000UL
+};
+
+static unsigned long test_checks;
+static unsigned long test_failures;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void test_expect(bool condition, const char *what,
+                        uint32_t resolution_us, double period_us);
+static uint32_t test_ref_divider(uint32_t resolution_us);
+static void test_resolution(uint32_t resolution_us);
+static void test_period(uint32_t resolution_us, uint32_t period_us);
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+* Summary:
+* This function runs the checks for every clock and resolution and prints
+* the number of checks and failures.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  int         0 if all checks passed
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32_t index;
+    uint32_t resolution_us;
+
+    for (index = 0U; index < (sizeof(test_clocks) / sizeof(test_clocks[0]));
+         index++)
+    {
+        test_clk_peri_hz = test_clocks[index];
+        for (resolution_us = 1U; resolution_us <= TEST_MAX_RESOLUTION_US;
+             resolution_us++)
+        {
+            test_resolution(resolution_us);
+        }
+    }
+
+    printf("%lu checks, %lu failed\n", test_checks, test_failures);
+    printf("%s\n", (test_failures == 0U) ? "PASS" : "FAIL");
+
+    return (test_failures == 0U) ? 0 : 1;
+}
+
+
+/*******************************************************************************
+* Function Name: test_expect
+********************************************************************************
+* Summary:
+* This function counts a check and reports it if it failed.
+*
+* Parameters:
+*  condition      Result of the check
+*  what           Name of the check
+*  resolution_us  Resolution of the checked configuration
+*  period_us      Period of the checked configuration, 0 if none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_expect(bool condition, const char *what,
+                        uint32_t resolution_us, double period_us)
+{
+    test_checks++;
+    if (!condition)
+    {
+        if (test_failures < TEST_MAX_REPORTS)
+        {
+            printf("FAIL %s: CLK_PERI %lu Hz, resolution %lu us, "
+                   "period %.0f us\n", what,
+                   (unsigned long)test_clk_peri_hz,
+                   (unsigned long)resolution_us, period_us);
+        }
+        test_failures++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: test_ref_divider
+********************************************************************************
+* Summary:
+* This function searches the slowest divider whose tick is not longer than
+* the resolution, the largest divider when all of them are.
+*
+* Parameters:
+*  resolution_us  Tick resolution
+*
+* Return:
+*  uint32_t       Divider, 1 if even the undivided clock is too slow
+*
+*******************************************************************************/
+static uint32_t test_ref_divider(uint32_t resolution_us)
+{
+    uint32_t divider;
+
+    for (divider = (uint32_t)TIMER_CFG_MAX_DIVIDER; divider > 1U; divider--)
+    {
+        /* divider / CLK_PERI <= resolution_us / 1e6 */
+        if (((uint64_t)divider * 1000000U) <=
+            ((uint64_t)test_clk_peri_hz * resolution_us))
+        {
+            break;
+        }
+    }
+
+    return divider;
+}
+
+
+/*******************************************************************************
+* Function Name: test_resolution
+********************************************************************************
+* Summary:
+* This function checks the divider and tick rate of a resolution, then the
+* periods from 1 us to the longest the 32-bit counter holds at that tick.
+*
+* Parameters:
+*  resolution_us  Tick resolution
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_resolution(uint32_t resolution_us)
+{
+    uint32_t divider = test_ref_divider(resolution_us);
+    uint32_t tick_hz = test_clk_peri_hz / divider;
+    double period_us;
+    double max_period_us = TEST_MAX_TICKS * 1e6 / tick_hz;
+
+    test_expect(TIMER_CFG_INIT_DIVIDER(resolution_us) == divider, "divider",
+                resolution_us, 0.0);
+    test_expect(TIMER_CFG_INIT_HZ(resolution_us) == tick_hz, "tick rate",
+                resolution_us, 0.0);
+
+    /* The tick resolves the time, unless no divider is slow enough */
+    if (divider < TIMER_CFG_MAX_DIVIDER)
+    {
+        test_expect(((uint64_t)(divider + 1U) * 1000000U) >
+                    ((uint64_t)test_clk_peri_hz * resolution_us),
+                    "slowest divider", resolution_us, 0.0);
+    }
+
+    for (period_us = 1.0; period_us <= max_period_us;
+         period_us = ceil(period_us * TEST_PERIOD_STEP))
+    {
+        test_period(resolution_us, (uint32_t)period_us);
+    }
+    test_period(resolution_us, (uint32_t)max_period_us);
+}
+
+
+/*******************************************************************************
+* Function Name: test_period
+********************************************************************************
+* Summary:
+* This function checks the ticks, the error and the configuration that
+* TIMER_CFG_INIT() gives for a period against floating point references.
+*
+* Parameters:
+*  resolution_us  Tick resolution
+*  period_us      Period
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void test_period(uint32_t resolution_us, uint32_t period_us)
+{
+    const timer_cfg_t cfg = TIMER_CFG_INIT(period_us, resolution_us);
+    uint32_t tick_hz = TIMER_CFG_INIT_HZ(resolution_us);
+    long double exact = (long double)tick_hz * period_us / 1e6L;
+    uint32_t ticks = TIMER_CFG_TICKS(tick_hz, period_us);
+    long double error_ppm;
+
+    test_expect((long double)ticks == floorl(exact + 0.5L), "ticks",
+                resolution_us, period_us);
+
+    /* Rounded to a tick, so the error stays within half a tick */
+    error_ppm = fabsl((long double)ticks - exact) * 1e6L / exact;
+    test_expect(fabsl((long double)TIMER_CFG_ERROR_PPM(tick_hz, period_us) -
+                      floorl(error_ppm)) <= 1.0L, "error",
+                resolution_us, period_us);
+
+    test_expect(cfg.timer.is_continuous && !cfg.timer.is_compare &&
+                (cfg.timer.direction == CYHAL_TIMER_DIR_UP) &&
+                (cfg.timer.value == 0U) && (cfg.timer.compare_value == 0U),
+                "counter mode", resolution_us, period_us);
+    test_expect(cfg.timer.period == (ticks - 1U), "period register",
+                resolution_us, period_us);
+    test_expect((cfg.divider == TIMER_CFG_INIT_DIVIDER(resolution_us)) &&
+                (cfg.tick_hz == tick_hz), "divider of the configuration",
+                resolution_us, period_us);
+}
+
+/* [] END OF FILE */
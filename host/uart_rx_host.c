@@ -0,0 +1,219 @@
+/******************************************************************************
+* File Name:   uart_rx_host.c
+*
+* Description: This file implements the receive interface of source/uart_rx.h
+*              for the Linux host build. There is no DMA: the receive interrupt
+*              copies standard input into the ring and every burst is reported
+*              as an idle line.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "uart_rx.h"
+#include "event_loop.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static cyhal_uart_t *uart_rx_uart;
+static uart_rx_callback_t uart_rx_callback;
+
+/* Ring storage and its free running write and read positions */
+static uint8_t uart_rx_buffer[UART_RX_BUFFER_SIZE];
+static uint32_t uart_rx_head = 0;
+static uint32_t uart_rx_tail = 0;
+
+static uart_rx_stats_t uart_rx_stats;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void isr_uart_rx(void *callback_arg, cyhal_uart_event_t event);
+static void uart_rx_handle_event(const event_t *event);
+
+
+/*******************************************************************************
+* Function Name: uart_rx_init
+********************************************************************************
+* Summary:
+* This function takes over the receive path of the UART. The idle time is not
+* used: input arrives in bursts from standard input.
+*
+* Parameters:
+*  uart        UART object, normally cy_retarget_io_uart_obj
+*  idle_ticks  Not used
+*  callback    Function called from the event loop when data is available
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS
+*
+*******************************************************************************/
+cy_rslt_t uart_rx_init(cyhal_uart_t *uart, uint32_t idle_ticks,
+                       uart_rx_callback_t callback)
+{
+    (void) idle_ticks;
+
+    uart_rx_uart = uart;
+    uart_rx_callback = callback;
+
+    event_loop_register(EVENT_UART_RX, uart_rx_handle_event);
+    cyhal_uart_register_callback(uart, isr_uart_rx, NULL);
+    cyhal_uart_enable_event(uart, CYHAL_UART_IRQ_RX_NOT_EMPTY,
+                            UART_RX_INTR_PRIORITY, true);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+size_t uart_rx_available(void)
+{
+    return (size_t)(uart_rx_head - uart_rx_tail);
+}
+
+
+size_t uart_rx_peek(const uint8_t **data)
+{
+    uint32_t offset = uart_rx_tail % UART_RX_BUFFER_SIZE;
+    uint32_t length = uart_rx_head - uart_rx_tail;
+
+    if (length > (UART_RX_BUFFER_SIZE - offset))
+    {
+        length = UART_RX_BUFFER_SIZE - offset;
+    }
+
+    *data = &uart_rx_buffer[offset];
+
+    return (size_t)length;
+}
+
+
+void uart_rx_consume(size_t length)
+{
+    CY_ASSERT(length <= (size_t)(uart_rx_head - uart_rx_tail));
+
+    uart_rx_tail += (uint32_t)length;
+}
+
+
+void uart_rx_get_stats(uart_rx_stats_t *stats)
+{
+    *stats = uart_rx_stats;
+}
+
+
+/*******************************************************************************
+* Function Name: uart_rx_handle_event
+********************************************************************************
+* Summary:
+* This function runs from the event loop after input has been received and
+* hands it to the application.
+*
+* Parameters:
+*  event       Receive event, payload not used
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_rx_handle_event(const event_t *event)
+{
+    (void) event;
+
+    uart_rx_stats.idle_events++;
+
+    if ((uart_rx_callback != NULL) && (uart_rx_head != uart_rx_tail))
+    {
+        uart_rx_callback(true);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: isr_uart_rx
+********************************************************************************
+* Summary:
+* This is the emulated receive-not-empty interrupt. It moves all available
+* input into the ring, overwriting the oldest unread bytes when it is full
+* like the DMA does, and posts one event per burst.
+*
+* Parameters:
+*  callback_arg    Not used
+*  event           UART interrupt triggers
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void isr_uart_rx(void *callback_arg, cyhal_uart_event_t event)
+{
+    uint8_t value;
+    uint32_t received = 0U;
+    bool overrun = false;
+
+    (void) callback_arg;
+    (void) event;
+
+    while (cyhal_uart_readable(uart_rx_uart) > 0U)
+    {
+        (void)cyhal_uart_getc(uart_rx_uart, &value, 0U);
+
+        uart_rx_buffer[uart_rx_head % UART_RX_BUFFER_SIZE] = value;
+        uart_rx_head++;
+        received++;
+
+        if ((uart_rx_head - uart_rx_tail) > UART_RX_BUFFER_SIZE)
+        {
+            uart_rx_tail++;
+            uart_rx_stats.bytes_lost++;
+            overrun = true;
+        }
+    }
+
+    uart_rx_stats.bytes_received += received;
+    if (overrun)
+    {
+        uart_rx_stats.ring_overruns++;
+    }
+
+    if (received != 0U)
+    {
+        (void)event_post(EVENT_UART_RX, 0U);
+    }
+}
+
+/* [] END OF FILE */
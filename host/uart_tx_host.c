@@ -0,0 +1,110 @@
+/******************************************************************************
+* File Name:   uart_tx_host.c
+*
+* Description: This file implements the transmit interface of source/uart_tx.h
+*              for the Linux host build. Data is written to standard output
+*              right away.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "uart_tx.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static uart_tx_policy_t uart_tx_policy;
+static uart_tx_stats_t uart_tx_stats;
+
+
+cy_rslt_t uart_tx_init(cyhal_uart_t *uart, uart_tx_policy_t policy)
+{
+    (void) uart;
+
+    uart_tx_policy = policy;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+void uart_tx_set_policy(uart_tx_policy_t policy)
+{
+    uart_tx_policy = policy;
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_write
+********************************************************************************
+* Summary:
+* This function writes data through the stdio buffer of standard output, so
+* that it stays in order with printf output. Nothing is ever dropped, the
+* policy has no effect.
+*
+* Parameters:
+*  data        Bytes to transmit
+*  length      Number of bytes
+*
+* Return:
+*  size_t      Number of bytes written
+*
+*******************************************************************************/
+size_t uart_tx_write(const void *data, size_t length)
+{
+    size_t written = fwrite(data, 1U, length, stdout);
+
+    (void) uart_tx_policy;
+
+    uart_tx_stats.bytes_queued += (uint32_t)written;
+
+    return written;
+}
+
+
+void uart_tx_flush(void)
+{
+    (void)fflush(stdout);
+}
+
+
+void uart_tx_get_stats(uart_tx_stats_t *stats)
+{
+    *stats = uart_tx_stats;
+}
+
+/* [] END OF FILE */
@@ -42,48 +42,92 @@
 #include "cyhal.h"
 #include "cybsp.h"
 #include "cy_retarget_io.h"
+#include "event_loop.h"
+#include "soft_timer.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
+#include "app_log.h"
+#include "profile.h"
+#include "boot_time.h"
+#include "rgb_pattern.h"
+#include "led_blink.h"
+#include "timer_cfg.h"
+#include "idle.h"
+#include "power_stats.h"
+#include "power_gov.h"
+#include "ipc_rpc.h"
+#include "ipc_bulk.h"
+#include "ipc_cmd.h"
+#include "ipc_console.h"
+#include "timebase.h"
+#include "trace.h"
+#include "shell.h"
 
 
 /*******************************************************************************
 * Macros
 *******************************************************************************/
-/* LED blink timer clock value in Hz  */
-#define LED_BLINK_TIMER_CLOCK_HZ          (10000)
+/* Shortest time the soft timers have to resolve */
+#define SOFT_TIMER_RESOLUTION_US          (100UL)
+
+/* Time between two LED toggles */
+#define LED_BLINK_TOGGLE_US               (1000000UL)
+
+/* LED blink timer clock value in Hz. This is the tick rate of all soft
+ * timers, the slowest one that meets SOFT_TIMER_RESOLUTION_US. */
+#define LED_BLINK_TIMER_CLOCK_HZ          \
+    TIMER_CFG_INIT_HZ(SOFT_TIMER_RESOLUTION_US)
 
 /* LED blink timer period value */
-#define LED_BLINK_TIMER_PERIOD            (9999)
+#define LED_BLINK_TIMER_PERIOD            \
+    TIMER_CFG_INIT_PERIOD(LED_BLINK_TOGGLE_US, SOFT_TIMER_RESOLUTION_US)
 
+/* Debug UART receive idle time */
+#define UART_RX_IDLE_US                   (1000UL)
+#define UART_RX_IDLE_TICKS                \
+    TIMER_CFG_TICKS(LED_BLINK_TIMER_CLOCK_HZ, UART_RX_IDLE_US)
 
-/*******************************************************************************
-* Global Variables
-*******************************************************************************/
-bool timer_interrupt_flag = false;
-bool led_blink_active_flag = true;
+/* Time the console keeps the system out of Deep Sleep after the last input */
+#define CONSOLE_HOLD_US                   (10000000UL)
+#define CONSOLE_HOLD_TICKS                \
+    TIMER_CFG_TICKS(LED_BLINK_TIMER_CLOCK_HZ, CONSOLE_HOLD_US)
+
+/* Operating point the power governor drops to while the system is idle */
+#define GOV_IDLE_POINT                    (POWER_GOV_ULP50)
 
-/* Variable for storing character read from terminal */
-uint8_t uart_read_value;
 
-/* Timer object used for blinking the LED */
-cyhal_timer_t led_blink_timer;
+/* The timer settings above must be reachable with the BSP clocks */
+TIMER_CFG_ASSERT_INIT(LED_BLINK_TOGGLE_US, SOFT_TIMER_RESOLUTION_US,
+                      SOFT_TIMER_MAX_DELAY);
+TIMER_CFG_ASSERT_PERIOD(LED_BLINK_TIMER_CLOCK_HZ, UART_RX_IDLE_US,
+                        SOFT_TIMER_MAX_DELAY);
+TIMER_CFG_ASSERT_PERIOD(LED_BLINK_TIMER_CLOCK_HZ, CONSOLE_HOLD_US,
+                        SOFT_TIMER_MAX_DELAY);
+TIMER_CFG_ASSERT_PERIOD(LED_BLINK_TIMER_CLOCK_HZ,
+                        1000000UL / RGB_PATTERN_FRAME_HZ, SOFT_TIMER_MAX_DELAY);
 
 
 /*******************************************************************************
 * Function Prototypes
 *******************************************************************************/
 void timer_init(void);
-static void isr_timer(void *callback_arg, cyhal_timer_event_t event);
+#if defined(APP_UART_CM0P)
+static void handle_console_line(char *line);
+#else
+static void handle_uart_rx(bool idle);
+#endif
 
 /*******************************************************************************
 * Function Name: main
 ********************************************************************************
 * Summary:
 * This is the main function. It sets up a timer to trigger a periodic interrupt.
-* The main while loop checks for the status of a flag set by the interrupt and
-* toggles an LED at 1Hz to create an LED blinky. Will be achieving the 1Hz Blink
-* rate based on the The LED_BLINK_TIMER_CLOCK_HZ and LED_BLINK_TIMER_PERIOD
-* Macros,i.e. (LED_BLINK_TIMER_PERIOD + 1) / LED_BLINK_TIMER_CLOCK_HZ = X ,Here,
-* X denotes the desired blink rate. The while loop also checks whether the
-* 'Enter' key was pressed and stops/restarts LED blinking.
+* The timer and debug UART interrupts post events to the event loop, which
+* toggles an LED at 1Hz to create an LED blinky and sleeps the CPU in between.
+* The LED toggles every LED_BLINK_TOGGLE_US; timer_cfg.h converts the time to
+* ticks of LED_BLINK_TIMER_CLOCK_HZ and fails the build if it cannot be met.
+* The UART event handler feeds the command shell, where 'Enter' on an empty
+* line stops/restarts LED blinking and 'help' lists the commands.
 *
 * Parameters:
 *  none
@@ -98,6 +142,11 @@ int main(void)
 
 #if defined (CY_DEVICE_SECURE)
     cyhal_wdt_t wdt_obj;
+#endif /* #if defined (CY_DEVICE_SECURE) */
+
+    boot_time_stamp(BOOT_TIME_MAIN);
+
+#if defined (CY_DEVICE_SECURE)
 
     /* Clear watchdog timer so that it doesn't trigger a reset */
     result = cyhal_wdt_init(&wdt_obj, cyhal_wdt_get_max_timeout_ms());
@@ -105,8 +154,14 @@ int main(void)
     cyhal_wdt_free(&wdt_obj);
 #endif /* #if defined (CY_DEVICE_SECURE) */
 
+    /* Start the cycle counter first so that the initialization can be
+     * profiled */
+    profile_init();
+
     /* Initialize the device and board peripherals */
+    PROFILE_BEGIN(PROFILE_CYBSP_INIT);
     result = cybsp_init();
+    PROFILE_END(PROFILE_CYBSP_INIT);
 
     /* Board init failed. Stop program execution */
     if (result != CY_RSLT_SUCCESS)
@@ -114,9 +169,40 @@ int main(void)
         CY_ASSERT(0);
     }
 
+#if defined(PROFILE_ITM)
+    /* Export every profiled scope on the SWO pin from here on */
+    profile_itm_init();
+#endif
+
     /* Enable global interrupts */
     __enable_irq();
 
+    /* Record trace events from here on. They carry the time 0 until the
+     * timebase runs. */
+    trace_init();
+
+#if defined(APP_UART_CM0P)
+    /* Hand the debug UART to the CM0+, which formats the log output and
+     * edits the command lines. It is started through the RPC server, which
+     * is probed first. */
+    result = ipc_rpc_init();
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = ipc_console_init(CY_RETARGET_IO_BAUDRATE);
+    }
+
+    /* CM0+ console init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+#else
+    /* The HAL takes a peripheral divider and the pins of the UART. Apply the
+     * dividers and pin settings of the design first, as cybsp_init() does
+     * without CYBSP_LAZY_CONFIG. */
+    cybsp_config_require(CYBSP_CONFIG_CLOCKS);
+    cybsp_config_require(CYBSP_CONFIG_PINS);
+
     /* Initialize retarget-io to use the debug UART port */
     result = cy_retarget_io_init_fc(CYBSP_DEBUG_UART_TX, CYBSP_DEBUG_UART_RX,
             CYBSP_DEBUG_UART_CTS,CYBSP_DEBUG_UART_RTS,CY_RETARGET_IO_BAUDRATE);
@@ -127,7 +213,21 @@ int main(void)
         CY_ASSERT(0);
     }
 
-    /* Initialize the User LED */
+    /* Queue printf output and let DMA transmit it in the background. When
+     * the queue is full, wait for room rather than losing output. */
+    result = uart_tx_init(&cy_retarget_io_uart_obj, UART_TX_POLICY_BLOCK);
+
+    /* UART transmit init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+#endif /* defined(APP_UART_CM0P) */
+
+    boot_time_stamp(BOOT_TIME_RETARGET_IO);
+
+    /* Initialize the User LED, after the pin settings of the design */
+    cybsp_config_require(CYBSP_CONFIG_PINS);
     result = cyhal_gpio_init(CYBSP_USER_LED, CYHAL_GPIO_DIR_OUTPUT,
                              CYHAL_GPIO_DRIVE_STRONG, CYBSP_LED_STATE_OFF);
 
@@ -137,148 +237,233 @@ int main(void)
         CY_ASSERT(0);
     }
 
+    boot_time_stamp(BOOT_TIME_GPIO);
+
     /* \x1b[2J\x1b[;H - ANSI ESC sequence for clear screen */
-    printf("\x1b[2J\x1b[;H");
+    APP_LOG("\x1b[2J\x1b[;H");
+
+    APP_LOG("****************** "
+            "HAL: Hello World! Example "
+            "****************** \r\n\n");
 
-    printf("****************** "
-           "HAL: Hello World! Example "
-           "****************** \r\n\n");
+    APP_LOG("Hello World!!!\r\n\n");
+    APP_LOG("For more projects, "
+            "visit our code examples repositories:\r\n\n");
 
-    printf("Hello World!!!\r\n\n");
-    printf("For more projects, "
-           "visit our code examples repositories:\r\n\n");
+    APP_LOG("https://github.com/Infineon/"
+            "Code-Examples-for-ModusToolbox-Software\r\n\n");
 
-    printf("https://github.com/Infineon/"
-           "Code-Examples-for-ModusToolbox-Software\r\n\n");
+    boot_time_stamp(BOOT_TIME_BANNER);
+
+    /* Initialize the event queues before any interrupt can post to them */
+    event_loop_init();
 
     /* Initialize timer to toggle the LED */
     timer_init();
 
-    printf("Press 'Enter' key to pause or "
-           "resume blinking the user LED \r\n\r\n");
+    boot_time_stamp(BOOT_TIME_TIMER);
+
+    /* Initialize the RGB LED PWMs and the DMA channels feeding them */
+    result = rgb_pattern_init(LED_BLINK_TIMER_CLOCK_HZ);
+
+    /* RGB LED init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Start the timebase both cores stamp their trace records with. It
+     * takes the first free 32-bit counter, after the PWMs of the LED pins
+     * have taken theirs. */
+    result = timebase_init();
 
-    for (;;)
+    /* Timebase init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
     {
-        /* Check if 'Enter' key was pressed */
-        if (cyhal_uart_getc(&cy_retarget_io_uart_obj, &uart_read_value, 1)
-             == CY_RSLT_SUCCESS)
-        {
-            if (uart_read_value == '\r')
-            {
-                /* Pause LED blinking by stopping the timer */
-                if (led_blink_active_flag)
-                {
-                    cyhal_timer_stop(&led_blink_timer);
-
-                    printf("LED blinking paused \r\n");
-                }
-                else /* Resume LED blinking by starting the timer */
-                {
-                    cyhal_timer_start(&led_blink_timer);
-
-                    printf("LED blinking resumed\r\n");
-                }
-
-                /* Move cursor to previous line */
-                printf("\x1b[1F");
-
-                led_blink_active_flag ^= 1;
-            }
-        }
-        /* Check if timer elapsed (interrupt fired) and toggle the LED */
-        if (timer_interrupt_flag)
-        {
-            /* Clear the flag */
-            timer_interrupt_flag = false;
-
-            /* Invert the USER LED state */
-            cyhal_gpio_toggle(CYBSP_USER_LED);
-        }
+        CY_ASSERT(0);
     }
-}
 
+    APP_LOG("Press 'Enter' key to pause or "
+            "resume blinking the user LED \r\n");
+    APP_LOG("Type 'help' and 'Enter' to list the other commands \r\n\r\n");
 
-/*******************************************************************************
-* Function Name: timer_init
-********************************************************************************
-* Summary:
-* This function creates and configures a Timer object. The timer ticks
-* continuously and produces a periodic interrupt on every terminal count
-* event. The period is defined by the 'period' and 'compare_value' of the
-* timer configuration structure 'led_blink_timer_cfg'. Without any changes,
-* this application is designed to produce an interrupt every 1 second.
-*
-* Parameters:
-*  none
-*
-* Return :
-*  void
-*
-*******************************************************************************/
- void timer_init(void)
- {
-    cy_rslt_t result;
+    /* Empty command lines pause and resume the blinking */
+    shell_init(led_blink_toggle);
+
+#if defined(APP_UART_CM0P)
+    /* Run the command lines the CM0+ has edited from the event loop */
+    result = ipc_console_input_init(handle_console_line);
+#else
+    /* Receive debug UART input through DMA and handle it from the event
+     * loop */
+    result = uart_rx_init(&cy_retarget_io_uart_obj, UART_RX_IDLE_TICKS,
+                          handle_uart_rx);
+#endif
+
+    /* UART receive init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Enter Deep Sleep between soft timer deadlines. UART input wakes the
+     * system and keeps it awake for CONSOLE_HOLD_US. */
+    result = idle_init(LED_BLINK_TIMER_CLOCK_HZ, CYBSP_DEBUG_UART_RX,
+                       CONSOLE_HOLD_TICKS);
 
-    const cyhal_timer_cfg_t led_blink_timer_cfg =
+    /* Idle manager init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
     {
-        .compare_value = 0,                 /* Timer compare value, not used */
-        .period = LED_BLINK_TIMER_PERIOD,   /* Defines the timer period */
-        .direction = CYHAL_TIMER_DIR_UP,    /* Timer counts up */
-        .is_compare = false,                /* Don't use compare mode */
-        .is_continuous = true,              /* Run timer indefinitely */
-        .value = 0                          /* Initial value of counter */
-    };
-
-    /* Initialize the timer object. Does not use input pin ('pin' is NC) and
-     * does not use a pre-configured clock source ('clk' is NULL). */
-    result = cyhal_timer_init(&led_blink_timer, NC, NULL);
+        CY_ASSERT(0);
+    }
 
-    /* timer init failed. Stop program execution */
+    /* Track the time in each power state and what woke the CPU */
+    result = power_stats_init();
+
+    /* Power state tracker init failed. Stop program execution */
     if (result != CY_RSLT_SUCCESS)
     {
         CY_ASSERT(0);
     }
 
-    /* Configure timer period and operation mode such as count direction,
-       duration */
-    cyhal_timer_configure(&led_blink_timer, &led_blink_timer_cfg);
+#if !defined(APP_UART_CM0P)
+    /* Probe the RPC server of the CM0+ image. Without it the application
+     * runs on, only the 'rpc' command reports the server missing. */
+    result = ipc_rpc_init();
 
-    /* Set the frequency of timer's clock source */
-    cyhal_timer_set_frequency(&led_blink_timer, LED_BLINK_TIMER_CLOCK_HZ);
+    /* RPC client init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+#endif
 
-    /* Assign the ISR to execute on timer interrupt */
-    cyhal_timer_register_callback(&led_blink_timer, isr_timer, NULL);
+    /* Message rings to and from the CM0+, if its image serves them */
+    result = ipc_bulk_init(ring_bench_receive);
 
-    /* Set the event on which timer interrupt occurs and enable it */
-    cyhal_timer_enable_event(&led_blink_timer, CYHAL_TIMER_IRQ_TERMINAL_COUNT,
-                              7, true);
+    /* Ring channel init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
 
-    /* Start the timer with the configured settings */
-    cyhal_timer_start(&led_blink_timer);
- }
+    /* Drop to ULP while the system is idle. The drivers whose clocks come
+     * from CLK_PERI have registered their notifiers in their init. */
+    result = power_gov_init(GOV_IDLE_POINT);
+
+    /* Power governor init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
 
+    boot_time_stamp(BOOT_TIME_LOOP);
 
+    APP_LOG("Boot time %lu us, type 'boot' for the stages\r\n",
+            (unsigned long)boot_time_total_us());
+    shell_prompt();
+
+    /* Dispatch events and sleep while idle. Does not return. */
+    event_loop_run();
+}
+
+
+#if defined(APP_UART_CM0P)
 /*******************************************************************************
-* Function Name: isr_timer
+* Function Name: handle_console_line
 ********************************************************************************
 * Summary:
-* This is the interrupt handler function for the timer interrupt.
+* This function runs from the event loop when the CM0+ has completed a
+* command line. The CM0+ has echoed and edited it, the shell runs it.
+* Input keeps the system out of Deep Sleep like the local UART input.
 *
 * Parameters:
-*    callback_arg    Arguments passed to the interrupt callback
-*    event            Timer/counter interrupt triggers
+*  line        NUL terminated command line
 *
 * Return:
 *  void
+*
 *******************************************************************************/
-static void isr_timer(void *callback_arg, cyhal_timer_event_t event)
+static void handle_console_line(char *line)
 {
-    (void) callback_arg;
-    (void) event;
+    idle_hold();
 
-    /* Set the interrupt flag and process it from the main while(1) loop */
-    timer_interrupt_flag = true;
+    shell_execute(line);
 }
+#else
+/*******************************************************************************
+* Function Name: handle_uart_rx
+********************************************************************************
+* Summary:
+* This function runs from the event loop when the debug UART has received
+* data. It reads the data in place from the receive ring and passes it to the
+* command shell, which runs a command when the 'Enter' key completes a line.
+* 'Enter' on an empty line pauses or resumes the LED blinking. Input keeps
+* the system out of Deep Sleep, where the UART cannot receive.
+*
+* Parameters:
+*  idle        true if the line has gone idle after the data, not used
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void handle_uart_rx(bool idle)
+{
+    const uint8_t *rx_data;
+    size_t rx_length;
 
-/* [] END OF FILE */
+    (void) idle;
+
+    idle_hold();
 
+    while ((rx_length = uart_rx_peek(&rx_data)) > 0U)
+    {
+        shell_input(rx_data, rx_length);
+
+        uart_rx_consume(rx_length);
+    }
+}
+#endif /* defined(APP_UART_CM0P) */
+
+
+/*******************************************************************************
+* Function Name: timer_init
+********************************************************************************
+* Summary:
+* This function starts the soft timer service on a hardware timer and creates
+* a periodic soft timer for the LED. The hardware timer counts continuously
+* and its compare value is reprogrammed to the next soft timer deadline, so
+* further periodic jobs can share it. TIMER_CFG_INIT() derives the tick rate
+* from SOFT_TIMER_RESOLUTION_US and the LED period, LED_BLINK_TOGGLE_US, in
+* ticks of it. Without any changes, this application is designed to toggle
+* the LED every 1 second.
+*
+* Parameters:
+*  none
+*
+* Return :
+*  void
+*
+*******************************************************************************/
+ void timer_init(void)
+ {
+    cy_rslt_t result;
+
+    const timer_cfg_t led_blink_timer_cfg =
+        TIMER_CFG_INIT(LED_BLINK_TOGGLE_US, SOFT_TIMER_RESOLUTION_US);
+
+    /* Initialize the hardware timer shared by all soft timers */
+    result = soft_timer_init(&led_blink_timer_cfg);
+
+    /* timer init failed. Stop program execution */
+    if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    /* Start the periodic LED blink timer */
+    led_blink_init(LED_BLINK_TIMER_CLOCK_HZ, LED_BLINK_TIMER_PERIOD + 1);
+ }
+
+/* [] END OF FILE */
@@ -0,0 +1,73 @@
+/******************************************************************************
+* File Name:   cm0p_image.c
+*
+* Description: This file places the CM0+ image built in cm0p/ at the start of
+*              the flash, in the .cy_m0p_image section the CM4 linker script
+*              reserves for it, like the prebuilt CM0P_SLEEP image it replaces.
+*              Built only with CM0P_IMAGE=RPC in the Makefile.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Image from the PREBUILD step, relative to the application directory the
+ * compiler runs in */
+#ifndef CM0P_IMAGE_BIN
+#define CM0P_IMAGE_BIN              "cm0p/build/cm0p.bin"
+#endif
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Included as is: the section name and cy_m0p_image symbol are those of the
+ * prebuilt images, and the startup of the CM0+ expects its vector table at
+ * the first byte. */
+__asm__(
+    "    .section .cy_m0p_image, \"a\", %progbits\n"
+    "    .balign 4\n"
+    "    .global cy_m0p_image\n"
+    "    .type cy_m0p_image, %object\n"
+    "cy_m0p_image:\n"
+    "    .incbin \"" CM0P_IMAGE_BIN "\"\n"
+    "    .size cy_m0p_image, . - cy_m0p_image\n"
+    "    .previous\n"
+);
+
+/* [] END OF FILE */
@@ -0,0 +1,245 @@
+/******************************************************************************
+* File Name:   app_log.c
+*
+* Description: This file contains the encoder of the tokenized log mode. Each
+*              log call is sent to the debug UART as a small binary frame that
+*              the host side decoder in tools/ turns back into text, or to the
+*              CM0+, which formats it with app_log_format.c.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdarg.h>
+#include <string.h>
+#include "uart_tx.h"
+#include "app_log.h"
+#if defined(APP_UART_CM0P)
+#include "ipc_console.h"
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Frame layout: marker, payload length (one varint byte, the payload is
+ * shorter than 128 bytes), then the payload: varint token and arguments */
+#define APP_LOG_HEADER_SIZE         (2U)
+#define APP_LOG_PAYLOAD_SIZE        (APP_LOG_FRAME_SIZE - APP_LOG_HEADER_SIZE)
+
+/* Longest varint of a 64 bit value */
+#define APP_LOG_VARINT_MAX          (10U)
+
+/* A frame is queued as a console record of kind IPC_CONSOLE_RECORD_LOG, which
+ * is APP_LOG_FRAME_MARKER */
+#if defined(APP_UART_CM0P) && (APP_LOG_FRAME_SIZE != IPC_CONSOLE_RECORD_SIZE)
+#error "A log frame must fill an IPC_CONSOLE_RECORD_SIZE record"
+#endif
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t app_log_put_varint(uint8_t *dst, uint64_t value);
+
+
+/*******************************************************************************
+* Function Name: app_log_put_varint
+********************************************************************************
+* Summary:
+* This function writes a value as a little endian base-128 varint, seven bits
+* per byte with the top bit set on all but the last byte.
+*
+* Parameters:
+*  dst         Destination, at least APP_LOG_VARINT_MAX bytes
+*  value       Value to encode
+*
+* Return:
+*  uint32_t    Number of bytes written
+*
+*******************************************************************************/
+static uint32_t app_log_put_varint(uint8_t *dst, uint64_t value)
+{
+    uint32_t length = 0;
+
+    /* Most arguments fit 32 bits, keep the common loop on 32 bit math */
+    if (value <= UINT32_MAX)
+    {
+        uint32_t value32 = (uint32_t)value;
+
+        while (value32 >= 0x80U)
+        {
+            dst[length++] = (uint8_t)(value32 | 0x80U);
+            value32 >>= 7;
+        }
+        dst[length++] = (uint8_t)value32;
+        return length;
+    }
+
+    while (value >= 0x80U)
+    {
+        dst[length++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    dst[length++] = (uint8_t)value;
+    return length;
+}
+
+
+/*******************************************************************************
+* Function Name: app_log_emit
+********************************************************************************
+* Summary:
+* This function encodes one log call into a frame and queues it on the debug
+* UART, or for the CM0+ with APP_UART_CM0P. No formatting happens on the CM4:
+* signed integers are zigzag encoded so that small negative values stay
+* short, floating point values are sent as single precision and strings are
+* sent with a length prefix. Arguments that do not fit the frame are dropped;
+* the decoder reports the entry as truncated.
+*
+* Parameters:
+*  token       Address of the format string in the .app_log_fmt section, or
+*              in the flash with APP_UART_CM0P
+*  types       Argument count and classes, built by APP_LOG_TYPES()
+*  ...         Arguments of the log call
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void app_log_emit(uint32_t token, uint32_t types, ...)
+{
+    uint8_t frame[APP_LOG_FRAME_SIZE];
+    uint8_t *payload = &frame[APP_LOG_HEADER_SIZE];
+    uint32_t length;
+    uint32_t count = types & 0x0FU;
+    uint32_t type;
+    uint32_t index;
+    va_list args;
+
+    length = app_log_put_varint(payload, token);
+
+    va_start(args, types);
+    for (index = 0U; index < count; index++)
+    {
+        type = (types >> (4U + (2U * index))) & 0x03U;
+
+        if ((APP_LOG_PAYLOAD_SIZE - length) < APP_LOG_VARINT_MAX)
+        {
+            break;
+        }
+
+        if (type == APP_LOG_TYPE_INT)
+        {
+            int32_t value = va_arg(args, int32_t);
+            uint32_t zigzag = ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+
+            length += app_log_put_varint(&payload[length], zigzag);
+        }
+        else if (type == APP_LOG_TYPE_INT64)
+        {
+            int64_t value = va_arg(args, int64_t);
+            uint64_t zigzag = ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+
+            length += app_log_put_varint(&payload[length], zigzag);
+        }
+        else if (type == APP_LOG_TYPE_DOUBLE)
+        {
+            float value = (float)va_arg(args, double);
+
+            memcpy(&payload[length], &value, sizeof(value));
+            length += sizeof(value);
+        }
+        else
+        {
+            const char *string = va_arg(args, const char *);
+            uint32_t string_length = 0U;
+            uint32_t room = APP_LOG_PAYLOAD_SIZE - length - 1U;
+
+            if (string == NULL)
+            {
+                string = "(null)";
+            }
+            while ((string_length < APP_LOG_STRING_MAX) &&
+                   (string_length < room) &&
+                   (string[string_length] != '\0'))
+            {
+                string_length++;
+            }
+
+            payload[length++] = (uint8_t)string_length;
+            memcpy(&payload[length], string, string_length);
+            length += string_length;
+        }
+    }
+    va_end(args);
+
+    frame[0] = APP_LOG_FRAME_MARKER;
+    frame[1] = (uint8_t)length;
+
+#if defined(APP_UART_CM0P)
+    (void)ipc_console_send(frame);
+#else
+    (void)uart_tx_write(frame, APP_LOG_HEADER_SIZE + length);
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: app_log_text
+********************************************************************************
+* Summary:
+* This function queues a string without formatting it, on the path of the
+* log frames so that the two stay in order: the transmit ring of the debug
+* UART, or text records for the CM0+ with APP_UART_CM0P. The decoder passes
+* the text through unchanged.
+*
+* Parameters:
+*  text        String to send
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void app_log_text(const char *text)
+{
+#if defined(APP_UART_CM0P)
+    (void)ipc_console_write(text, strlen(text));
+#else
+    (void)uart_tx_write(text, strlen(text));
+#endif
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,224 @@
+/******************************************************************************
+* File Name:   app_log.h
+*
+* Description: This file contains the log macro layer of the application. Log
+*              calls either format text through printf or, in tokenized mode,
+*              emit only a token and the binary encoded arguments.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef APP_LOG_H
+#define APP_LOG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Define APP_LOG_TOKENIZED (for example "make build DEFINES=APP_LOG_TOKENIZED")
+ * to replace the printf based log output with the tokenized binary frames.
+ * The format strings then live only in the non-loaded .app_log_fmt section
+ * of the ELF file, see tools/app_log_decode.py. Only the GCC toolchain is
+ * supported. */
+#if defined(APP_LOG_TOKENIZED) && !defined(__GNUC__)
+#error "APP_LOG_TOKENIZED is only supported with the GCC_ARM toolchain"
+#endif
+
+/* With APP_UART_CM0P (see ipc_console.h) the same frames are queued for the
+ * CM0+, which formats them. Their format strings stay in the flash, where
+ * the CM0+ reads them. */
+#if defined(APP_LOG_TOKENIZED) && defined(APP_UART_CM0P)
+#error "APP_LOG_TOKENIZED and APP_UART_CM0P cannot be combined"
+#endif
+
+/* Size of one tokenized frame on the wire including the frame header.
+ * Arguments that do not fit are dropped and the decoder reports the log
+ * entry as truncated. */
+#define APP_LOG_FRAME_SIZE          (64U)
+
+/* Maximum number of bytes sent for a %s argument */
+#define APP_LOG_STRING_MAX          (24U)
+
+/* Marker byte that starts a frame. Text output never contains it, so text
+ * and frames can share the UART. */
+#define APP_LOG_FRAME_MARKER        (0x00U)
+
+/* Argument classes as encoded in the argument type word: bits 0-3 hold the
+ * argument count, then two bits per argument */
+#define APP_LOG_TYPE_INT            (0U)    /* zigzag varint, 32 bits */
+#define APP_LOG_TYPE_INT64          (1U)    /* zigzag varint, 64 bits */
+#define APP_LOG_TYPE_DOUBLE         (2U)    /* IEEE-754 single, 4 bytes */
+#define APP_LOG_TYPE_STRING         (3U)    /* varint length + bytes */
+
+/* Class of long, size_t and pointers, which have the width of the CPU: 32
+ * bits on the CM4 and the CM0+, 64 bits on the host build */
+#define APP_LOG_TYPE_WORD                                                     \
+    ((sizeof(void *) > sizeof(uint32_t)) ? APP_LOG_TYPE_INT64 : APP_LOG_TYPE_INT)
+
+#define APP_LOG_MAX_ARGS            (8U)
+
+#if defined(APP_LOG_TOKENIZED) || defined(APP_UART_CM0P)
+
+/* Selects the class of an argument from its type. Floating point arguments
+ * are narrowed to single precision on the wire, so a double keeps only
+ * about 7 significant digits in the log. Pointers other than void and char
+ * pointers must be cast to (void *) for %p, as printf requires anyway, or
+ * they are sent as 32-bit integers. */
+#define APP_LOG_ARG_TYPE(arg)                                                 \
+    _Generic((arg),                                                           \
+             char *: APP_LOG_TYPE_STRING,                                     \
+             const char *: APP_LOG_TYPE_STRING,                               \
+             void *: APP_LOG_TYPE_WORD,                                       \
+             const void *: APP_LOG_TYPE_WORD,                                 \
+             float: APP_LOG_TYPE_DOUBLE,                                      \
+             double: APP_LOG_TYPE_DOUBLE,                                     \
+             long: APP_LOG_TYPE_WORD,                                         \
+             unsigned long: APP_LOG_TYPE_WORD,                                \
+             long long: APP_LOG_TYPE_INT64,                                   \
+             unsigned long long: APP_LOG_TYPE_INT64,                          \
+             default: APP_LOG_TYPE_INT)
+
+#define APP_LOG_T(n, arg)   ((uint32_t)APP_LOG_ARG_TYPE(arg) << (4U + (2U * (n))))
+
+#define APP_LOG_TYPES_0()                       (0U)
+#define APP_LOG_TYPES_1(a)                      (1U | APP_LOG_T(0, a))
+#define APP_LOG_TYPES_2(a, b)                   (2U | APP_LOG_T(0, a) |       \
+                                                 APP_LOG_T(1, b))
+#define APP_LOG_TYPES_3(a, b, c)                (3U | APP_LOG_T(0, a) |       \
+                                                 APP_LOG_T(1, b) |            \
+                                                 APP_LOG_T(2, c))
+#define APP_LOG_TYPES_4(a, b, c, d)             (4U | APP_LOG_T(0, a) |       \
+                                                 APP_LOG_T(1, b) |            \
+                                                 APP_LOG_T(2, c) |            \
+                                                 APP_LOG_T(3, d))
+#define APP_LOG_TYPES_5(a, b, c, d, e)          (APP_LOG_TYPES_4(a, b, c, d) +\
+                                                 1U + APP_LOG_T(4, e))
+#define APP_LOG_TYPES_6(a, b, c, d, e, f)       (APP_LOG_TYPES_4(a, b, c, d) +\
+                                                 2U + APP_LOG_T(4, e) +       \
+                                                 APP_LOG_T(5, f))
+#define APP_LOG_TYPES_7(a, b, c, d, e, f, g)    (APP_LOG_TYPES_4(a, b, c, d) +\
+                                                 3U + APP_LOG_T(4, e) +       \
+                                                 APP_LOG_T(5, f) +            \
+                                                 APP_LOG_T(6, g))
+#define APP_LOG_TYPES_8(a, b, c, d, e, f, g, h) (APP_LOG_TYPES_4(a, b, c, d) +\
+                                                 4U + APP_LOG_T(4, e) +       \
+                                                 APP_LOG_T(5, f) +            \
+                                                 APP_LOG_T(6, g) +            \
+                                                 APP_LOG_T(7, h))
+
+#define APP_LOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...)  n
+#define APP_LOG_NARGS(...)                                                    \
+    APP_LOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+#define APP_LOG_CAT_(a, b)          a ## b
+#define APP_LOG_CAT(a, b)           APP_LOG_CAT_(a, b)
+#define APP_LOG_TYPES(...)                                                    \
+    APP_LOG_CAT(APP_LOG_TYPES_, APP_LOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+/* The token of a log call is the address of its format string in the
+ * .app_log_fmt section, which the linker places at address 0 */
+#if defined(APP_LOG_TOKENIZED)
+#define APP_LOG(fmt, ...)                                                     \
+    do                                                                        \
+    {                                                                         \
+        static const char app_log_fmt[]                                       \
+            __attribute__((section(".app_log_fmt"), used)) = fmt;             \
+        app_log_emit((uint32_t)(uintptr_t)app_log_fmt,                        \
+                     APP_LOG_TYPES(__VA_ARGS__), ##__VA_ARGS__);              \
+    } while (0)
+#else
+#define APP_LOG(fmt, ...)                                                     \
+    do                                                                        \
+    {                                                                         \
+        static const char app_log_fmt[] = fmt;                                \
+        app_log_emit((uint32_t)(uintptr_t)app_log_fmt,                        \
+                     APP_LOG_TYPES(__VA_ARGS__), ##__VA_ARGS__);              \
+    } while (0)
+#endif /* defined(APP_LOG_TOKENIZED) */
+
+#else
+
+#define APP_LOG(fmt, ...)           printf(fmt, ##__VA_ARGS__)
+
+#endif /* defined(APP_LOG_TOKENIZED) || defined(APP_UART_CM0P) */
+
+/* Writes a string as it is, in order with the APP_LOG() output. For run-time
+ * strings that may be longer than APP_LOG_STRING_MAX, such as command lines
+ * and help texts. */
+#if defined(APP_LOG_TOKENIZED) || defined(APP_UART_CM0P)
+#define APP_LOG_TEXT(text)          app_log_text(text)
+#else
+#define APP_LOG_TEXT(text)          ((void)fputs((text), stdout))
+#endif
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Output of app_log_format() */
+typedef void (*app_log_write_t)(const char *data, size_t length);
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* Encodes one tokenized log call and queues it on the debug UART. Called by
+ * the APP_LOG macro, not meant to be called directly. */
+void app_log_emit(uint32_t token, uint32_t types, ...);
+
+/* Queues text on the same path as the frames of app_log_emit(). Called by
+ * the APP_LOG_TEXT macro. */
+void app_log_text(const char *text);
+
+/* Formats a frame whose token is the address of its format string */
+void app_log_format(const uint8_t *frame, app_log_write_t write);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* APP_LOG_H */
+
+/* [] END OF FILE */
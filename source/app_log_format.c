@@ -0,0 +1,622 @@
+/******************************************************************************
+* File Name:   app_log_format.c
+*
+* Description: This file contains the formatter of the tokenized log frames
+*              whose token is the address of the format string. It runs on the
+*              CM0+ core, which formats the log calls of the CM4 when
+*              APP_UART_CM0P is defined, and in the host emulation of that mode.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define APP_LOG_HEADER_SIZE         (2U)
+#define APP_LOG_PAYLOAD_SIZE        (APP_LOG_FRAME_SIZE - APP_LOG_HEADER_SIZE)
+
+/* Longest conversion specification kept, longer flags and widths are cut */
+#define APP_LOG_SPEC_SIZE           (16U)
+
+/* Longest output of one conversion */
+#define APP_LOG_TEXT_SIZE           (48U)
+
+/* Digits after the point of a floating point value, at most */
+#define APP_LOG_FLOAT_DIGITS        (9U)
+
+/* Writes a string literal */
+#define APP_LOG_PUTS(write, text)   (write)((text), sizeof(text) - 1U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* A parsed conversion specification */
+typedef struct
+{
+    char spec[APP_LOG_SPEC_SIZE];   /* '%', flags, width and precision */
+    uint32_t length;                /* Characters in spec */
+    uint32_t precision;             /* Precision, or APP_LOG_NO_PRECISION */
+    bool is_64;                     /* 64-bit argument: ll, j, or l, z, t
+                                     * and p on the host build */
+    char conversion;
+} app_log_spec_t;
+
+#define APP_LOG_NO_PRECISION        (UINT32_MAX)
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool app_log_get_varint(const uint8_t **src, const uint8_t *end,
+                               uint64_t *value);
+static bool app_log_get_int(const uint8_t **src, const uint8_t *end,
+                            int64_t *value);
+static const char *app_log_parse(const char *fmt, app_log_spec_t *spec,
+                                 const uint8_t **src, const uint8_t *end);
+static void app_log_spec_put(app_log_spec_t *spec, char character);
+static uint32_t app_log_put_u64(char *text, uint64_t value);
+static uint32_t app_log_put_float(char *text, float value, uint32_t precision);
+
+
+/*******************************************************************************
+* Function Name: app_log_format
+********************************************************************************
+* Summary:
+* This function formats one frame built by app_log_emit(). The frame carries
+* no argument types: like tools/app_log_decode.py, the function takes them
+* from the conversions of the format string. Each conversion is formatted
+* with snprintf() and one argument, so the C library needs no support for
+* va_list built at run time. Floating point values are printed as fixed
+* point with the given precision, and 64 bit values outside the 32 bit range
+* without width or flags, as newlib-nano supports neither. A frame that ends
+* before its arguments is printed with "<truncated>" in their place.
+*
+* Parameters:
+*  frame       Frame of APP_LOG_FRAME_SIZE bytes
+*  write       Output of the text
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void app_log_format(const uint8_t *frame, app_log_write_t write)
+{
+    const uint8_t *src = &frame[APP_LOG_HEADER_SIZE];
+    const uint8_t *end;
+    const char *fmt;
+    const char *literal;
+    app_log_spec_t spec;
+    char text[APP_LOG_TEXT_SIZE];
+    char string[APP_LOG_STRING_MAX + 1U];
+    uint64_t token;
+    int64_t value;
+    uint32_t length;
+    float real;
+    int written;
+
+    end = src + ((frame[1] < APP_LOG_PAYLOAD_SIZE) ? frame[1] :
+                 APP_LOG_PAYLOAD_SIZE);
+
+    if (!app_log_get_varint(&src, end, &token))
+    {
+        APP_LOG_PUTS(write, "<bad frame>\r\n");
+        return;
+    }
+
+    fmt = (const char *)(uintptr_t)token;
+    literal = fmt;
+
+    while (*fmt != '\0')
+    {
+        if (*fmt != '%')
+        {
+            fmt++;
+            continue;
+        }
+        write(literal, (size_t)(fmt - literal));
+
+        fmt = app_log_parse(fmt, &spec, &src, end);
+        literal = fmt;
+        if (spec.conversion == '%')
+        {
+            APP_LOG_PUTS(write, "%");
+            continue;
+        }
+        if ((spec.conversion == '\0') || (src >= end))
+        {
+            APP_LOG_PUTS(write, "<truncated>");
+            break;
+        }
+
+        written = 0;
+        switch (spec.conversion)
+        {
+            case 's':
+                length = *src++;
+                if (length > (uint32_t)(end - src))
+                {
+                    length = (uint32_t)(end - src);
+                }
+                if (length > APP_LOG_STRING_MAX)
+                {
+                    length = APP_LOG_STRING_MAX;
+                }
+                (void)memcpy(string, src, length);
+                string[length] = '\0';
+                src += length;
+
+                app_log_spec_put(&spec, 's');
+                written = snprintf(text, sizeof(text), spec.spec, string);
+                break;
+
+            case 'f': case 'F': case 'e': case 'E':
+            case 'g': case 'G': case 'a': case 'A':
+                if ((uint32_t)(end - src) < sizeof(real))
+                {
+                    src = end;
+                    APP_LOG_PUTS(write, "<truncated>");
+                    break;
+                }
+                (void)memcpy(&real, src, sizeof(real));
+                src += sizeof(real);
+                written = (int)app_log_put_float(text, real, spec.precision);
+                break;
+
+            default:
+                if (!app_log_get_int(&src, end, &value))
+                {
+                    APP_LOG_PUTS(write, "<truncated>");
+                    break;
+                }
+
+                if (!spec.is_64)
+                {
+                    /* Sign or zero extend the 32 bit argument */
+                    value = (int64_t)(int32_t)value;
+                }
+
+                if (spec.conversion == 'c')
+                {
+                    app_log_spec_put(&spec, 'c');
+                    written = snprintf(text, sizeof(text), spec.spec,
+                                       (int)value);
+                }
+                else if ((spec.conversion == 'p') &&
+                         (((uint64_t)value >> 32) != 0U) && spec.is_64)
+                {
+                    written = snprintf(text, sizeof(text), "0x%lx%08lx",
+                                       (unsigned long)((uint64_t)value >> 32),
+                                       (unsigned long)(uint32_t)value);
+                }
+                else if (spec.conversion == 'p')
+                {
+                    written = snprintf(text, sizeof(text), "0x%08lx",
+                                       (unsigned long)(uint32_t)value);
+                }
+                else if ((spec.conversion == 'd') || (spec.conversion == 'i'))
+                {
+                    if ((value >= INT32_MIN) && (value <= INT32_MAX))
+                    {
+                        app_log_spec_put(&spec, 'l');
+                        app_log_spec_put(&spec, 'd');
+                        written = snprintf(text, sizeof(text), spec.spec,
+                                           (long)value);
+                    }
+                    else
+                    {
+                        text[0] = '-';
+                        written = (value < 0) ? 1 : 0;
+                        written += (int)app_log_put_u64(&text[written],
+                            (value < 0) ? (0U - (uint64_t)value) :
+                                          (uint64_t)value);
+                    }
+                }
+                else
+                {
+                    uint64_t bits = spec.is_64 ? (uint64_t)value :
+                                                 (uint64_t)(uint32_t)value;
+
+                    if (bits <= UINT32_MAX)
+                    {
+                        app_log_spec_put(&spec, 'l');
+                        app_log_spec_put(&spec, spec.conversion);
+                        written = snprintf(text, sizeof(text), spec.spec,
+                                           (unsigned long)bits);
+                    }
+                    else if ((spec.conversion == 'x') ||
+                             (spec.conversion == 'X'))
+                    {
+                        written = snprintf(text, sizeof(text),
+                                           (spec.conversion == 'x') ?
+                                           "%lx%08lx" : "%lX%08lX",
+                                           (unsigned long)(bits >> 32),
+                                           (unsigned long)(uint32_t)bits);
+                    }
+                    else
+                    {
+                        written = (int)app_log_put_u64(text, bits);
+                    }
+                }
+                break;
+        }
+
+        if (written > 0)
+        {
+            write(text, ((size_t)written < sizeof(text)) ? (size_t)written :
+                        (sizeof(text) - 1U));
+        }
+    }
+
+    write(literal, strlen(literal));
+}
+
+
+/*******************************************************************************
+* Function Name: app_log_get_varint
+********************************************************************************
+* Summary:
+* This function reads a little endian base-128 varint.
+*
+* Parameters:
+*  src         Position in the payload, advanced past the varint
+*  end         End of the payload
+*  value       Location to store the value
+*
+* Return:
+*  bool        false if the payload ends inside the varint
+*
+*******************************************************************************/
+static bool app_log_get_varint(const uint8_t **src, const uint8_t *end,
+                               uint64_t *value)
+{
+    const uint8_t *position = *src;
+    uint64_t result = 0U;
+    uint32_t shift = 0U;
+    uint8_t byte;
+
+    do
+    {
+        if ((position >= end) || (shift > 63U))
+        {
+            return false;
+        }
+        byte = *position++;
+        result |= (uint64_t)(byte & 0x7FU) << shift;
+        shift += 7U;
+    } while (byte >= 0x80U);
+
+    *src = position;
+    *value = result;
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: app_log_get_int
+********************************************************************************
+* Summary:
+* This function reads a zigzag encoded integer argument.
+*
+* Parameters:
+*  src         Position in the payload, advanced past the argument
+*  end         End of the payload
+*  value       Location to store the value
+*
+* Return:
+*  bool        false if the payload ends inside the argument
+*
+*******************************************************************************/
+static bool app_log_get_int(const uint8_t **src, const uint8_t *end,
+                            int64_t *value)
+{
+    uint64_t zigzag;
+
+    if (!app_log_get_varint(src, end, &zigzag))
+    {
+        return false;
+    }
+
+    *value = (int64_t)((zigzag >> 1) ^ (0U - (zigzag & 1U)));
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: app_log_parse
+********************************************************************************
+* Summary:
+* This function parses a conversion specification. Flags, width and
+* precision are kept for snprintf(), a '*' width or precision takes its value
+* from the next argument. Length modifiers are dropped: the formatter passes
+* every integer as a long.
+*
+* Parameters:
+*  fmt         The '%' that starts the specification
+*  spec        Location to store the specification
+*  src         Position in the payload, advanced past '*' arguments
+*  end         End of the payload
+*
+* Return:
+*  const char *    First character after the specification
+*
+*******************************************************************************/
+static const char *app_log_parse(const char *fmt, app_log_spec_t *spec,
+                                 const uint8_t **src, const uint8_t *end)
+{
+    int64_t value;
+    bool is_precision = false;
+    uint32_t precision = 0U;
+
+    spec->length = 0U;
+    spec->precision = APP_LOG_NO_PRECISION;
+    spec->is_64 = false;
+    app_log_spec_put(spec, *fmt++);
+
+    while ((*fmt != '\0') && (strchr("-+ #0", *fmt) != NULL))
+    {
+        app_log_spec_put(spec, *fmt++);
+    }
+
+    /* Width, then precision */
+    while (true)
+    {
+        if (*fmt == '*')
+        {
+            fmt++;
+            value = 0;
+            (void)app_log_get_int(src, end, &value);
+            if (value < 0)
+            {
+                value = 0;
+            }
+            precision = (uint32_t)value;
+            spec->length += (uint32_t)snprintf(&spec->spec[spec->length],
+                                               APP_LOG_SPEC_SIZE - 3U -
+                                               spec->length, "%lu",
+                                               (unsigned long)precision);
+            if (spec->length > (APP_LOG_SPEC_SIZE - 4U))
+            {
+                spec->length = APP_LOG_SPEC_SIZE - 4U;
+            }
+        }
+        else
+        {
+            precision = 0U;
+            while ((*fmt >= '0') && (*fmt <= '9'))
+            {
+                precision = (precision * 10U) + (uint32_t)(*fmt - '0');
+                app_log_spec_put(spec, *fmt++);
+            }
+        }
+
+        if (is_precision)
+        {
+            spec->precision = precision;
+            break;
+        }
+        if (*fmt != '.')
+        {
+            break;
+        }
+        app_log_spec_put(spec, *fmt++);
+        is_precision = true;
+    }
+
+    while ((*fmt != '\0') && (strchr("hljztL", *fmt) != NULL))
+    {
+        if ((*fmt == 'j') || ((fmt[0] == 'l') && (fmt[1] == 'l')))
+        {
+            spec->is_64 = true;
+        }
+        else if ((strchr("lzt", *fmt) != NULL) &&
+                 (sizeof(long) > sizeof(uint32_t)))
+        {
+            /* Sent as APP_LOG_TYPE_WORD, 64 bits on the host build */
+            spec->is_64 = true;
+        }
+        fmt++;
+    }
+
+    spec->conversion = *fmt;
+    if ((*fmt == 'p') && (sizeof(void *) > sizeof(uint32_t)))
+    {
+        spec->is_64 = true;
+    }
+    if (*fmt != '\0')
+    {
+        fmt++;
+    }
+
+    spec->spec[spec->length] = '\0';
+
+    return fmt;
+}
+
+
+/*******************************************************************************
+* Function Name: app_log_spec_put
+********************************************************************************
+* Summary:
+* This function appends a character to a conversion specification. Room is
+* kept for the length modifier, the conversion and the NUL, whatever comes
+* before them is cut.
+*
+* Parameters:
+*  spec        Specification
+*  character   Character to append
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void app_log_spec_put(app_log_spec_t *spec, char character)
+{
+    bool tail = ((character == 'l') || (strchr("diouxXcs", character) != NULL));
+
+    if ((tail && (spec->length < (APP_LOG_SPEC_SIZE - 1U))) ||
+        (spec->length < (APP_LOG_SPEC_SIZE - 4U)))
+    {
+        spec->spec[spec->length++] = character;
+    }
+    spec->spec[spec->length] = '\0';
+}
+
+
+/*******************************************************************************
+* Function Name: app_log_put_u64
+********************************************************************************
+* Summary:
+* This function writes a 64 bit value in decimal.
+*
+* Parameters:
+*  text        Destination, at least 21 bytes
+*  value       Value to write
+*
+* Return:
+*  uint32_t    Number of characters written, without the NUL
+*
+*******************************************************************************/
+static uint32_t app_log_put_u64(char *text, uint64_t value)
+{
+    char digits[20];
+    uint32_t count = 0U;
+    uint32_t index;
+
+    do
+    {
+        digits[count++] = (char)('0' + (value % 10U));
+        value /= 10U;
+    } while (value != 0U);
+
+    for (index = 0U; index < count; index++)
+    {
+        text[index] = digits[count - 1U - index];
+    }
+    text[count] = '\0';
+
+    return count;
+}
+
+
+/*******************************************************************************
+* Function Name: app_log_put_float
+********************************************************************************
+* Summary:
+* This function writes a floating point value as fixed point, rounded to the
+* precision. Width and flags are not applied.
+*
+* Parameters:
+*  text        Destination, at least APP_LOG_TEXT_SIZE bytes
+*  value       Value to write
+*  precision   Digits after the point, APP_LOG_NO_PRECISION for six
+*
+* Return:
+*  uint32_t    Number of characters written, without the NUL
+*
+*******************************************************************************/
+static uint32_t app_log_put_float(char *text, float value, uint32_t precision)
+{
+    uint32_t length = 0U;
+    uint32_t scale = 1U;
+    uint32_t index;
+    uint64_t whole;
+    uint32_t fraction;
+    double magnitude = (double)value;
+
+    if (value != value)
+    {
+        (void)memcpy(text, "nan", 4U);
+        return 3U;
+    }
+
+    if (magnitude < 0.0)
+    {
+        text[length++] = '-';
+        magnitude = -magnitude;
+    }
+    if (magnitude >= 1.0e19)
+    {
+        (void)memcpy(&text[length], "inf", 4U);
+        return length + 3U;
+    }
+
+    if (precision == APP_LOG_NO_PRECISION)
+    {
+        precision = 6U;
+    }
+    if (precision > APP_LOG_FLOAT_DIGITS)
+    {
+        precision = APP_LOG_FLOAT_DIGITS;
+    }
+    for (index = 0U; index < precision; index++)
+    {
+        scale *= 10U;
+    }
+
+    whole = (uint64_t)magnitude;
+    fraction = (uint32_t)(((magnitude - (double)whole) * scale) + 0.5);
+    if (fraction >= scale)
+    {
+        whole++;
+        fraction -= scale;
+    }
+
+    length += app_log_put_u64(&text[length], whole);
+    if (precision != 0U)
+    {
+        text[length++] = '.';
+        for (index = precision; index > 0U; index--)
+        {
+            text[length + index - 1U] = (char)('0' + (fraction % 10U));
+            fraction /= 10U;
+        }
+        length += precision;
+    }
+    text[length] = '\0';
+
+    return length;
+}
+
+/* [] END OF FILE */
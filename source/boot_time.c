@@ -0,0 +1,339 @@
+/******************************************************************************
+* File Name:   boot_time.c
+*
+* Description: This file contains the boot time profiler. The reset handler
+*              starts the DWT cycle counter through Cy_OnResetUser(), and each
+*              startup stage stores the cycle count and the CPU clock when it
+*              ends. The stages of the BSP are marked through its
+*              cybsp_boot_mark() hook. The stamps live in .noinit, so that the
+*              RAM initialization of the startup code does not clear them.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "cyhal.h"
+#include "cybsp.h"
+#include "boot_time.h"
+#include "cycle_counter.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define BOOT_TIME_US_PER_S          (1000000ULL)
+#define BOOT_TIME_HZ_PER_MHZ        (1000000UL)
+
+#define BOOT_TIME_BIT(stage)        (1UL << (uint32_t)(stage))
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* End of a stage */
+typedef struct
+{
+    uint32_t cycles;            /* Cycles since the reset handler */
+    uint32_t clock_hz;          /* Counter frequency from here on */
+} boot_time_entry_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Names printed by boot_time_print(), in the order of boot_time_stage_t */
+static const char *const boot_time_names[BOOT_TIME_STAGE_COUNT] =
+{
+    "reset",
+    "data init",
+    "SystemInit",
+    "C runtime",
+    "hwmgr init",
+    "syspm init",
+    "cycfg init",
+    "cybsp rest",
+    "retarget-io",
+    "GPIO",
+    "banner",
+    "timer",
+    "drivers"
+};
+
+/* Stage of each stage ID that the BSP passes to cybsp_boot_mark() */
+static const boot_time_stage_t boot_time_bsp_stages[] =
+{
+    [CYBSP_BOOT_DATA_INIT] = BOOT_TIME_DATA_INIT,
+    [CYBSP_BOOT_SYSTEM_INIT] = BOOT_TIME_SYSTEM_INIT,
+    [CYBSP_BOOT_HWMGR] = BOOT_TIME_HWMGR,
+    [CYBSP_BOOT_SYSPM] = BOOT_TIME_SYSPM,
+    [CYBSP_BOOT_CYCFG] = BOOT_TIME_CYCFG,
+    [CYBSP_BOOT_CYBSP] = BOOT_TIME_CYBSP
+};
+
+/* Written before .data and .bss are initialized, so not initialized by the
+ * startup code themselves. boot_time_mask has a bit for each stamped
+ * stage. */
+static CY_NOINIT boot_time_entry_t boot_time_stamps[BOOT_TIME_STAGE_COUNT];
+static CY_NOINIT uint32_t boot_time_mask;
+static CY_NOINIT uint32_t boot_time_base;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t boot_time_clock_hz(boot_time_stage_t stage);
+static uint32_t boot_time_stage_us(uint32_t stage, uint32_t *previous);
+
+
+#if !defined(APP_HOST_BUILD)
+/*******************************************************************************
+* Function Name: Cy_OnResetUser
+********************************************************************************
+* Summary:
+* This function overrides the empty hook that the reset handler calls first.
+* Nothing is initialized yet: it may only use the stack, the core registers
+* and .noinit.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void Cy_OnResetUser(void)
+{
+    boot_time_stamp(BOOT_TIME_RESET);
+}
+#endif /* !defined(APP_HOST_BUILD) */
+
+
+/*******************************************************************************
+* Function Name: cybsp_boot_mark
+********************************************************************************
+* Summary:
+* This function overrides the weak startup stage hook of the BSP and stamps
+* the matching stage.
+*
+* Parameters:
+*  stage       cybsp_boot_stage_t of the stage that has ended
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void cybsp_boot_mark(uint32_t stage)
+{
+    if (stage < (sizeof(boot_time_bsp_stages) /
+                 sizeof(boot_time_bsp_stages[0])))
+    {
+        boot_time_stamp(boot_time_bsp_stages[stage]);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: boot_time_stamp
+********************************************************************************
+* Summary:
+* This function marks the end of a startup stage. BOOT_TIME_RESET starts the
+* cycle counter and clears the earlier stamps; if it was not stamped, as in
+* the host build, the first stamp does so. A stage is stamped once.
+*
+* Parameters:
+*  stage       Stage that has ended
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void boot_time_stamp(boot_time_stage_t stage)
+{
+    if ((stage == BOOT_TIME_RESET) ||
+        ((boot_time_mask & BOOT_TIME_BIT(BOOT_TIME_RESET)) == 0U))
+    {
+        cycle_counter_init();
+        boot_time_base = cycle_counter_read();
+        boot_time_stamps[BOOT_TIME_RESET].cycles = 0U;
+        boot_time_stamps[BOOT_TIME_RESET].clock_hz =
+            boot_time_clock_hz(BOOT_TIME_RESET);
+        boot_time_mask = BOOT_TIME_BIT(BOOT_TIME_RESET);
+    }
+
+    boot_time_stamps[stage].cycles = cycle_counter_read() - boot_time_base;
+    boot_time_stamps[stage].clock_hz = boot_time_clock_hz(stage);
+    boot_time_mask |= BOOT_TIME_BIT(stage);
+}
+
+
+/*******************************************************************************
+* Function Name: boot_time_total_us
+********************************************************************************
+* Summary:
+* This function returns the time from reset to the last stamped stage.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    Time in microseconds
+*
+*******************************************************************************/
+uint32_t boot_time_total_us(void)
+{
+    uint32_t stage;
+    uint32_t previous = (uint32_t)BOOT_TIME_RESET;
+    uint32_t total = 0U;
+
+    for (stage = 1U; stage < (uint32_t)BOOT_TIME_STAGE_COUNT; stage++)
+    {
+        total += boot_time_stage_us(stage, &previous);
+    }
+
+    return total;
+}
+
+
+/*******************************************************************************
+* Function Name: boot_time_print
+********************************************************************************
+* Summary:
+* This function prints the cycles and time of every stamped stage, the time
+* from reset at its end and the CPU clock it started on. The cycle counts
+* are exact; the time of a stage that switches the CPU clock, cycfg init,
+* is computed with the clock it started on and is an upper bound.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void boot_time_print(void)
+{
+    uint32_t stage;
+    uint32_t previous = (uint32_t)BOOT_TIME_RESET;
+    uint32_t clock_hz;
+    uint32_t cycles;
+    uint32_t us;
+    uint32_t total = 0U;
+
+    APP_LOG("Boot time\r\n");
+    APP_LOG("  stage            cycles         us   total us    MHz\r\n");
+
+    for (stage = 1U; stage < (uint32_t)BOOT_TIME_STAGE_COUNT; stage++)
+    {
+        if ((boot_time_mask & BOOT_TIME_BIT(stage)) == 0U)
+        {
+            continue;
+        }
+
+        clock_hz = boot_time_stamps[previous].clock_hz;
+        cycles = boot_time_stamps[stage].cycles -
+                 boot_time_stamps[previous].cycles;
+        us = boot_time_stage_us(stage, &previous);
+        total += us;
+
+        APP_LOG("  %-12s %10lu %10lu %10lu %6lu\r\n", boot_time_names[stage],
+                (unsigned long)cycles, (unsigned long)us,
+                (unsigned long)total,
+                (unsigned long)(clock_hz / BOOT_TIME_HZ_PER_MHZ));
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: boot_time_clock_hz
+********************************************************************************
+* Summary:
+* This function returns the frequency of the cycle counter when a stage
+* ends. SystemCoreClock is only valid once SystemInit() has set it.
+*
+* Parameters:
+*  stage       Stage that has ended
+*
+* Return:
+*  uint32_t    Counter frequency: the CPU clock, 1 GHz in the host build
+*
+*******************************************************************************/
+static uint32_t boot_time_clock_hz(boot_time_stage_t stage)
+{
+#if defined(APP_HOST_BUILD)
+    (void) stage;
+
+    return (uint32_t)(cycle_counter_per_us() * BOOT_TIME_HZ_PER_MHZ);
+#else
+    return (stage <= BOOT_TIME_DATA_INIT) ? BOOT_TIME_RESET_CLOCK_HZ :
+                                            SystemCoreClock;
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: boot_time_stage_us
+********************************************************************************
+* Summary:
+* This function returns the time of a stage, from the previous stamp on, at
+* the clock of the previous stamp.
+*
+* Parameters:
+*  stage       Stage
+*  previous    Previous stamped stage, advanced to stage if it is stamped
+*
+* Return:
+*  uint32_t    Time in microseconds, 0 if the stage is not stamped
+*
+*******************************************************************************/
+static uint32_t boot_time_stage_us(uint32_t stage, uint32_t *previous)
+{
+    const boot_time_entry_t *from = &boot_time_stamps[*previous];
+    uint32_t cycles;
+
+    if ((boot_time_mask & BOOT_TIME_BIT(stage)) == 0U)
+    {
+        return 0U;
+    }
+
+    cycles = boot_time_stamps[stage].cycles - from->cycles;
+    *previous = stage;
+
+    return (uint32_t)(((uint64_t)cycles * BOOT_TIME_US_PER_S) /
+                      from->clock_hz);
+}
+
+/* [] END OF FILE */
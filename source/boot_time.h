@@ -0,0 +1,101 @@
+/******************************************************************************
+* File Name:   boot_time.h
+*
+* Description: This file contains the declarations of the boot time profiler.
+*              Each startup stage, from the reset handler to the event loop, is
+*              stamped with the DWT cycle counter, which is started in the reset
+*              handler before the RAM is initialized.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef BOOT_TIME_H
+#define BOOT_TIME_H
+
+#include "cy_device_headers.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* CPU clock until SystemInit() has set SystemCoreClock: the 8 MHz IMO */
+#define BOOT_TIME_RESET_CLOCK_HZ    (8000000UL)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Startup stages, in the order they end. Each stamp marks the end of the
+ * stage named in the comment; stages that are not stamped in a build are
+ * merged into the next one. */
+typedef enum
+{
+    BOOT_TIME_RESET = 0,        /* Reset handler entered, counter started */
+    BOOT_TIME_DATA_INIT,        /* .data copied and .bss cleared */
+    BOOT_TIME_SYSTEM_INIT,      /* SystemInit() */
+    BOOT_TIME_MAIN,             /* C library initialization, main() entered */
+    BOOT_TIME_HWMGR,            /* cyhal_hwmgr_init() */
+    BOOT_TIME_SYSPM,            /* cyhal_syspm_init() */
+    BOOT_TIME_CYCFG,            /* cycfg_config_init(): clocks, pins, ... */
+    BOOT_TIME_CYBSP,            /* Rest of cybsp_init() */
+    BOOT_TIME_RETARGET_IO,      /* cy_retarget_io_init_fc(), UART transmit */
+    BOOT_TIME_GPIO,             /* User LED GPIO */
+    BOOT_TIME_BANNER,           /* Banner printfs */
+    BOOT_TIME_TIMER,            /* Event queues and timer_init() */
+    BOOT_TIME_LOOP,             /* Other drivers, event loop about to start */
+    BOOT_TIME_STAGE_COUNT       /* Number of stages, not a valid stage */
+} boot_time_stage_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void boot_time_stamp(boot_time_stage_t stage);
+uint32_t boot_time_total_us(void);
+void boot_time_print(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* BOOT_TIME_H */
+
+/* [] END OF FILE */
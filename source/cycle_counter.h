@@ -0,0 +1,140 @@
+/******************************************************************************
+* File Name:   cycle_counter.h
+*
+* Description: This file contains inline accessors for the Cortex-M4 DWT cycle
+*              counter used to timestamp events.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#include "cy_device_headers.h"
+
+#if defined(APP_HOST_BUILD)
+#include <time.h>
+#endif
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Function Name: cycle_counter_init
+********************************************************************************
+* Summary:
+* This function enables the DWT cycle counter. The counter runs at the CPU
+* clock frequency and wraps every 2^32 cycles. It is not cleared, as the
+* boot time profiler counts from the reset handler on.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void cycle_counter_init(void)
+{
+#if defined(APP_HOST_BUILD)
+    /* The host build counts nanoseconds of the monotonic clock instead */
+#else
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: cycle_counter_read
+********************************************************************************
+* Summary:
+* This function returns the current value of the DWT cycle counter.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    Current cycle count
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t cycle_counter_read(void)
+{
+#if defined(APP_HOST_BUILD)
+    struct timespec now;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint32_t)now.tv_sec * 1000000000UL) + (uint32_t)now.tv_nsec;
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: cycle_counter_per_us
+********************************************************************************
+* Summary:
+* This function returns the number of counter ticks per microsecond: CPU
+* cycles on the device, nanoseconds in the host build.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    Ticks per microsecond
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t cycle_counter_per_us(void)
+{
+#if defined(APP_HOST_BUILD)
+    return 1000UL;
+#else
+    return SystemCoreClock / 1000000UL;
+#endif
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CYCLE_COUNTER_H */
+
+/* [] END OF FILE */
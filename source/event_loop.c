@@ -0,0 +1,326 @@
+/******************************************************************************
+* File Name:   event_loop.c
+*
+* Description: This file contains the event loop that dispatches interrupt-
+*              posted events from the main thread and sleeps the CPU when no
+*              work is pending.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "event_loop.h"
+#include "cycle_counter.h"
+#include "profile.h"
+#include "latency_hist.h"
+#include "idle.h"
+#include "trace.h"
+#include "power_gov.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Handlers indexed by event ID */
+static event_handler_t event_handlers[EVENT_COUNT];
+
+/* One single-producer, single-consumer queue per event ID */
+static event_queue_t event_queues[EVENT_COUNT];
+static event_t event_storage[EVENT_COUNT][EVENT_QUEUE_CAPACITY];
+
+static event_loop_stats_t event_loop_stats;
+
+/* Delay from event_post() to the start of the handler, per event ID */
+static latency_hist_t event_latency[EVENT_COUNT];
+
+
+/*******************************************************************************
+* Function Name: event_loop_init
+********************************************************************************
+* Summary:
+* This function initializes the event queues and starts the cycle counter used
+* to timestamp events. It must be called before any event is posted.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void event_loop_init(void)
+{
+    uint32_t id;
+
+    cycle_counter_init();
+
+    for (id = 0; id < (uint32_t)EVENT_COUNT; id++)
+    {
+        event_queue_init(&event_queues[id], event_storage[id],
+                         EVENT_QUEUE_CAPACITY);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: event_loop_is_pending
+********************************************************************************
+* Summary:
+* This function checks whether any event queue holds an event.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true if at least one event is waiting to be dispatched
+*
+*******************************************************************************/
+static bool event_loop_is_pending(void)
+{
+    uint32_t id;
+
+    for (id = 0; id < (uint32_t)EVENT_COUNT; id++)
+    {
+        if (event_queue_count(&event_queues[id]) != 0U)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/*******************************************************************************
+* Function Name: event_loop_register
+********************************************************************************
+* Summary:
+* This function assigns the handler that the main loop runs when the given
+* event is posted. Registering a NULL handler discards the event.
+*
+* Parameters:
+*  id          Event to handle
+*  handler     Function to run from the main loop
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void event_loop_register(event_id_t id, event_handler_t handler)
+{
+    CY_ASSERT(id < EVENT_COUNT);
+
+    event_handlers[id] = handler;
+}
+
+
+/*******************************************************************************
+* Function Name: event_post
+********************************************************************************
+* Summary:
+* This function timestamps an event and queues it for the main loop. It is
+* lock-free and safe to call from interrupt context, provided each event ID is
+* only posted from one producer. A post from thread context must be made with
+* interrupts masked, as the interrupt of the same event ID could otherwise
+* preempt it. Every post is delivered as a separate event
+* unless the queue of that event ID is full.
+*
+* Parameters:
+*  id          Event to post
+*  data        Event specific payload passed to the handler
+*
+* Return:
+*  bool        true if the event was queued, false if it overflowed
+*
+*******************************************************************************/
+bool event_post(event_id_t id, uint32_t data)
+{
+    event_t event;
+
+    event.id = (uint32_t)id;
+    event.data = data;
+    event.timestamp = cycle_counter_read();
+
+    return event_queue_push(&event_queues[id], &event);
+}
+
+
+/*******************************************************************************
+* Function Name: event_loop_run
+********************************************************************************
+* Summary:
+* This function is the application main loop. It waits for posted events,
+* runs their handlers and puts the system to sleep through idle_sleep()
+* whenever nothing is pending.
+* It never returns.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void event_loop_run(void)
+{
+    uint32_t state;
+    uint32_t id;
+    uint32_t count;
+    event_t event;
+
+    for (;;)
+    {
+        /* Check for work with interrupts masked. The CPU sleeps inside the
+         * critical section: a masked interrupt still wakes it from WFI, so an
+         * event posted after the check cannot be missed. The ISR then runs as
+         * soon as the critical section is exited. The idle manager picks
+         * Sleep or Deep Sleep, the power governor measures the time. */
+        state = cyhal_system_critical_section_enter();
+        if (!event_loop_is_pending())
+        {
+            event_loop_stats.sleeps++;
+            power_gov_idle_begin();
+            idle_sleep();
+            power_gov_idle_end();
+        }
+        cyhal_system_critical_section_exit(state);
+
+        for (id = 0; id < (uint32_t)EVENT_COUNT; id++)
+        {
+            /* Only drain what is queued now so that a flooding source cannot
+             * starve the others */
+            count = event_queue_count(&event_queues[id]);
+
+            while ((count > 0U) && event_queue_pop(&event_queues[id], &event))
+            {
+                if (NULL != event_handlers[id])
+                {
+                    latency_hist_record(&event_latency[id],
+                                        cycle_counter_read() - event.timestamp);
+
+                    PROFILE_BEGIN(PROFILE_EVENT_DISPATCH);
+                    TRACE_BEGIN("event", id);
+                    event_handlers[id](&event);
+                    TRACE_END("event", id);
+                    PROFILE_END(PROFILE_EVENT_DISPATCH);
+                    event_loop_stats.dispatched++;
+                }
+                count--;
+            }
+        }
+
+        /* A change of the operating point needs interrupts enabled. It
+         * comes after the dispatch, so that the events that woke the CPU do
+         * not wait for the clocks to settle. */
+        power_gov_poll();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: event_loop_get_stats
+********************************************************************************
+* Summary:
+* This function returns a snapshot of the event loop statistics. The ratio of
+* dispatched events to sleeps shows how often the CPU wakes to do work.
+*
+* Parameters:
+*  stats       Location to store the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void event_loop_get_stats(event_loop_stats_t *stats)
+{
+    uint32_t id;
+
+    *stats = event_loop_stats;
+    stats->overflows = 0;
+
+    for (id = 0; id < (uint32_t)EVENT_COUNT; id++)
+    {
+        stats->overflows += event_queues[id].overflows;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: event_loop_get_latency
+********************************************************************************
+* Summary:
+* This function returns a copy of the service latency histogram of an event:
+* the time from event_post() in the interrupt to the start of its handler in
+* the main loop, in cycle counter ticks. The time the interrupt itself waited
+* before it ran is not included.
+*
+* Parameters:
+*  id          Event to read
+*  hist        Location to store the histogram
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void event_loop_get_latency(event_id_t id, latency_hist_t *hist)
+{
+    *hist = event_latency[id];
+}
+
+
+/*******************************************************************************
+* Function Name: event_loop_reset_latency
+********************************************************************************
+* Summary:
+* This function clears the service latency histograms of all events.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void event_loop_reset_latency(void)
+{
+    uint32_t id;
+
+    for (id = 0; id < (uint32_t)EVENT_COUNT; id++)
+    {
+        latency_hist_reset(&event_latency[id]);
+    }
+}
+
+/* [] END OF FILE */
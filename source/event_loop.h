@@ -0,0 +1,110 @@
+/******************************************************************************
+* File Name:   event_loop.h
+*
+* Description: This file contains the declarations of the event loop that
+*              dispatches interrupt-posted events from the main thread and
+*              sleeps the CPU when no work is pending.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include "cyhal.h"
+#include "event_queue.h"
+#include "latency_hist.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of events each event ID can hold before posts overflow. Must be a
+ * power of two. */
+#define EVENT_QUEUE_CAPACITY        (8U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Events that can be posted to the main loop. Each event ID has its own queue
+ * and must be posted from a single interrupt, or from interrupts that cannot
+ * preempt each other. A post from thread context must mask interrupts. When
+ * several events are pending at once they are dispatched in ascending order of
+ * their value. */
+typedef enum
+{
+    EVENT_UART_RX = 0,          /* Debug UART receive FIFO is not empty */
+    EVENT_TIMER_TICK,           /* Soft timer hardware compare match */
+    EVENT_IPC_RING,             /* Doorbell of the ring from the CM0+ */
+    EVENT_COUNT                 /* Number of events, not a valid event */
+} event_id_t;
+
+/* Handler executed from the main loop for each posted event */
+typedef void (*event_handler_t)(const event_t *event);
+
+/* Event loop statistics used to estimate the CPU duty cycle */
+typedef struct
+{
+    uint32_t sleeps;            /* Number of times the CPU entered sleep */
+    uint32_t dispatched;        /* Number of handler invocations */
+    uint32_t overflows;         /* Events dropped because a queue was full */
+} event_loop_stats_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void event_loop_init(void);
+void event_loop_register(event_id_t id, event_handler_t handler);
+bool event_post(event_id_t id, uint32_t data);
+void event_loop_run(void);
+void event_loop_get_stats(event_loop_stats_t *stats);
+void event_loop_get_latency(event_id_t id, latency_hist_t *hist);
+void event_loop_reset_latency(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* EVENT_LOOP_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,181 @@
+/******************************************************************************
+* File Name:   event_queue.c
+*
+* Description: This file contains the lock-free single-producer, single-consumer
+*              queue used to pass events from interrupts to the main loop.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cyhal.h"
+#include "event_queue.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Barrier between the accesses of the producer and the consumer. A DMB
+ * orders them on the CM4; the host stress test runs the producer on a
+ * thread of its own and needs the barrier of the host CPU. */
+#if defined(APP_HOST_BUILD)
+#define EVENT_QUEUE_FENCE()         __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define EVENT_QUEUE_FENCE()         __DMB()
+#endif
+
+
+/*******************************************************************************
+* Function Name: event_queue_init
+********************************************************************************
+* Summary:
+* This function initializes an empty queue on top of caller-provided storage.
+*
+* Parameters:
+*  queue       Queue to initialize
+*  buffer      Storage for 'capacity' events
+*  capacity    Number of events the queue holds, must be a power of two
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void event_queue_init(event_queue_t *queue, event_t *buffer, uint32_t capacity)
+{
+    CY_ASSERT((capacity != 0U) && ((capacity & (capacity - 1U)) == 0U));
+
+    queue->buffer = buffer;
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->tail = 0;
+    queue->pushed = 0;
+    queue->overflows = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: event_queue_push
+********************************************************************************
+* Summary:
+* This function appends an event to the queue. It must only be called from the
+* producer context. When the queue is full the event is dropped and counted as
+* an overflow.
+*
+* Parameters:
+*  queue       Queue to write
+*  event       Event to copy into the queue
+*
+* Return:
+*  bool        true if the event was queued, false if the queue was full
+*
+*******************************************************************************/
+bool event_queue_push(event_queue_t *queue, const event_t *event)
+{
+    uint32_t head = queue->head;
+
+    if ((head - queue->tail) >= queue->capacity)
+    {
+        queue->overflows++;
+        return false;
+    }
+
+    queue->buffer[head & (queue->capacity - 1U)] = *event;
+
+    /* The event must be visible before the consumer sees the new head */
+    EVENT_QUEUE_FENCE();
+    queue->head = head + 1U;
+    queue->pushed++;
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: event_queue_pop
+********************************************************************************
+* Summary:
+* This function removes the oldest event from the queue. It must only be
+* called from the consumer context.
+*
+* Parameters:
+*  queue       Queue to read
+*  event       Location to copy the event to
+*
+* Return:
+*  bool        true if an event was returned, false if the queue was empty
+*
+*******************************************************************************/
+bool event_queue_pop(event_queue_t *queue, event_t *event)
+{
+    uint32_t tail = queue->tail;
+
+    if (tail == queue->head)
+    {
+        return false;
+    }
+
+    /* Read the event only after observing the head that published it */
+    EVENT_QUEUE_FENCE();
+    *event = queue->buffer[tail & (queue->capacity - 1U)];
+
+    /* The slot must be read before the producer may overwrite it */
+    EVENT_QUEUE_FENCE();
+    queue->tail = tail + 1U;
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: event_queue_count
+********************************************************************************
+* Summary:
+* This function returns the number of events waiting in the queue. Seen from
+* the consumer the count can only grow, seen from the producer it can only
+* shrink.
+*
+* Parameters:
+*  queue       Queue to inspect
+*
+* Return:
+*  uint32_t    Number of queued events
+*
+*******************************************************************************/
+uint32_t event_queue_count(const event_queue_t *queue)
+{
+    return queue->head - queue->tail;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,96 @@
+/******************************************************************************
+* File Name:   event_queue.h
+*
+* Description: This file contains the declarations of the lock-free single-
+*              producer, single-consumer queue used to pass events from
+*              interrupts to the main loop.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Event record carried from an interrupt to the main loop */
+typedef struct
+{
+    uint32_t id;                /* Event identifier */
+    uint32_t data;              /* Event specific payload */
+    uint32_t timestamp;         /* Cycle count when the event was posted */
+} event_t;
+
+/* Single-producer, single-consumer event queue. The producer only writes
+ * 'head' and the counters, the consumer only writes 'tail', so neither side
+ * needs a lock. Both indices run freely and are masked on access, which
+ * requires the capacity to be a power of two. */
+typedef struct
+{
+    event_t *buffer;            /* Storage for 'capacity' events */
+    uint32_t capacity;          /* Number of events, power of two */
+    volatile uint32_t head;     /* Next slot to write, producer owned */
+    volatile uint32_t tail;     /* Next slot to read, consumer owned */
+    volatile uint32_t pushed;   /* Events accepted, producer owned */
+    volatile uint32_t overflows;/* Events dropped while full, producer owned */
+} event_queue_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void event_queue_init(event_queue_t *queue, event_t *buffer, uint32_t capacity);
+bool event_queue_push(event_queue_t *queue, const event_t *event);
+bool event_queue_pop(event_queue_t *queue, event_t *event);
+uint32_t event_queue_count(const event_queue_t *queue);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* EVENT_QUEUE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,706 @@
+/******************************************************************************
+* File Name:   idle.c
+*
+* Description: This file contains the idle manager. The soft timer hardware is a
+*              TCPWM counter, which stops in Deep Sleep. Before a Deep Sleep the
+*              LPTimer, an MCWDT counter on the WCO, is set to wake the system
+*              one wakeup latency ahead of the next soft timer deadline. After
+*              the wakeup the time the LPTimer measured is added to the soft
+*              timer clock, and the TCPWM compare match catches the deadline
+*              itself from Sleep.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "cy_gpio.h"
+#include "cy_sysint.h"
+#include "idle.h"
+#include "soft_timer.h"
+#include "timebase.h"
+#include "trace.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define IDLE_US_PER_S               (1000000UL)
+#define IDLE_MS_PER_S               (1000UL)
+
+/* LPTimer ticks of margin on top of the wakeup latency estimate. The
+ * latency is measured in whole ticks, so the true latency can be almost one
+ * tick longer. */
+#define IDLE_WAKE_GUARD             (1UL)
+
+/* A shorter latency than the estimate moves the estimate 1/8 of the way */
+#define IDLE_LATENCY_DECAY_SHIFT    (3U)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static cyhal_lptimer_t idle_lptimer;
+
+/* LPTimer frequency, 0 until idle_init() has run, and the soft timer tick */
+static uint32_t idle_lf_hz = 0;
+static uint32_t idle_tick_hz;
+
+/* Shortest and longest Deep Sleep, in LPTimer ticks */
+static uint32_t idle_min_lf;
+static uint32_t idle_max_lf;
+
+/* Wakeup latency estimate in LPTimer ticks */
+static uint32_t idle_latency;
+static uint32_t idle_latency_max;
+
+/* Part of a soft timer tick slept but not yet added, in 1/idle_lf_hz */
+static uint32_t idle_remainder = 0;
+
+/* Number of reasons to stay out of Deep Sleep */
+static volatile uint32_t idle_locks = 0;
+
+/* Console wakeup pin and the lock held after console activity */
+static GPIO_PRT_Type *idle_wake_port = NULL;
+static uint32_t idle_wake_pin;
+static soft_timer_t idle_hold_timer;
+static uint32_t idle_hold_ticks;
+static bool idle_held = false;
+
+static idle_stats_t idle_stats;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t idle_us_to_lf(uint32_t us);
+static uint32_t idle_lf_to_us(uint32_t lf);
+static uint32_t idle_lf_to_ticks(uint32_t lf);
+static void idle_update_latency(uint32_t late);
+static void idle_wake_enable(bool enable);
+static bool idle_wake_pending(void);
+static void idle_hold_callback(void *callback_arg);
+static void isr_idle_lptimer(void *callback_arg, cyhal_lptimer_event_t event);
+static void isr_idle_wake(void);
+
+
+/*******************************************************************************
+* Function Name: idle_init
+********************************************************************************
+* Summary:
+* This function starts the LPTimer and arms Deep Sleep for the event loop.
+* A falling edge on the wake pin, normally the debug UART receive line, also
+* wakes the system. The UART does not receive in Deep Sleep, so the character
+* that woke it is lost; the console then keeps the system out of Deep Sleep
+* for hold_ticks after its last activity, see idle_hold(). The hold starts
+* right away. The soft timers must have been initialized.
+*
+* Parameters:
+*  tick_hz     Soft timer tick rate
+*  wake_pin    Pin whose falling edge wakes the system, or NC
+*  hold_ticks  Soft timer ticks to stay out of Deep Sleep after idle_hold(),
+*              0 for none
+*
+* Return:
+*  cy_rslt_t   Result of the LPTimer initialization
+*
+*******************************************************************************/
+cy_rslt_t idle_init(uint32_t tick_hz, cyhal_gpio_t wake_pin,
+                    uint32_t hold_ticks)
+{
+    cy_rslt_t result;
+    cyhal_lptimer_info_t info;
+    cy_stc_sysint_t wake_irq_config;
+
+    /* The LPTimer counts CLK_LF, which may still wait for the WCO */
+    cybsp_config_require(CYBSP_CONFIG_CLK_LF);
+
+    result = cyhal_lptimer_init(&idle_lptimer);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    cyhal_lptimer_get_info(&idle_lptimer, &info);
+    cyhal_lptimer_register_callback(&idle_lptimer, isr_idle_lptimer, NULL);
+
+    idle_tick_hz = tick_hz;
+    idle_lf_hz = info.frequency_hz;
+    idle_min_lf = idle_us_to_lf(IDLE_DEEPSLEEP_MIN_US);
+    if (idle_min_lf < info.min_set_delay)
+    {
+        idle_min_lf = info.min_set_delay;
+    }
+    idle_max_lf = (uint32_t)(((uint64_t)IDLE_DEEPSLEEP_MAX_MS * idle_lf_hz) /
+                             IDLE_MS_PER_S);
+    if (idle_max_lf > info.max_counter_value)
+    {
+        idle_max_lf = info.max_counter_value;
+    }
+    idle_latency = idle_us_to_lf(IDLE_WAKE_LATENCY_INIT_US);
+
+    if (wake_pin != NC)
+    {
+        /* The edge detector sees the pin whichever peripheral drives it, so
+         * the UART keeps the pin. The port interrupt is only unmasked during
+         * Deep Sleep, and no HAL GPIO callback may use this port. */
+        idle_wake_port = Cy_GPIO_PortToAddr(CYHAL_GET_PORT(wake_pin));
+        idle_wake_pin = CYHAL_GET_PIN(wake_pin);
+
+        Cy_GPIO_SetInterruptMask(idle_wake_port, idle_wake_pin, 0U);
+        Cy_GPIO_SetInterruptEdge(idle_wake_port, idle_wake_pin,
+                                 CY_GPIO_INTR_FALLING);
+
+        wake_irq_config.intrSrc =
+            (IRQn_Type)((uint32_t)ioss_interrupts_gpio_0_IRQn +
+                        CYHAL_GET_PORT(wake_pin));
+        wake_irq_config.intrPriority = IDLE_INTR_PRIORITY;
+        (void)Cy_SysInt_Init(&wake_irq_config, isr_idle_wake);
+        NVIC_EnableIRQ(wake_irq_config.intrSrc);
+    }
+
+    idle_hold_ticks = hold_ticks;
+    soft_timer_setup(&idle_hold_timer, idle_hold_callback, NULL);
+    idle_hold();
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: idle_sleep
+********************************************************************************
+* Summary:
+* This function puts the system to sleep until the next interrupt. It is
+* called by the event loop with interrupts masked and nothing pending. Deep
+* Sleep is used when nothing holds a lock and the next soft timer deadline is
+* more than the wakeup latency plus IDLE_DEEPSLEEP_MIN_US away; otherwise,
+* or when a driver refuses Deep Sleep, the CPU only sleeps.
+*
+* The LPTimer wakes the system early by the wakeup latency estimate. Every
+* wakeup by the LPTimer measures how long after the match the CPU got here;
+* a longer latency raises the estimate at once, a shorter one lowers it
+* slowly. The time slept is added to the soft timers and to the shared
+* timebase, whose counters stop in Deep Sleep, and traced as a span whose
+* arguments are the planned and the slept LPTimer ticks.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_sleep(void)
+{
+    cy_rslt_t result;
+    uint32_t delay;
+    uint32_t lf_delay;
+    uint32_t lf_start;
+    uint32_t lf_elapsed;
+    uint32_t start;
+    uint32_t counted;
+    uint32_t elapsed;
+    uint64_t tb_start;
+    bool console = false;
+
+    if ((idle_lf_hz == 0U) || (idle_locks != 0U))
+    {
+        cyhal_syspm_sleep();
+        return;
+    }
+
+    if (!soft_timer_next_delay(&delay))
+    {
+        delay = SOFT_TIMER_MAX_DELAY;
+    }
+
+    lf_delay = (uint32_t)(((uint64_t)delay * idle_lf_hz) / idle_tick_hz);
+    if (lf_delay <= (idle_latency + IDLE_WAKE_GUARD + idle_min_lf))
+    {
+        cyhal_syspm_sleep();
+        return;
+    }
+    lf_delay -= idle_latency + IDLE_WAKE_GUARD;
+    if (lf_delay > idle_max_lf)
+    {
+        lf_delay = idle_max_lf;
+    }
+
+    /* The clocks are read before the LPTimer is set up, which takes a few
+     * WCO cycles, so that the setup time is measured by all of them */
+    start = soft_timer_now();
+    tb_start = timebase_now();
+    lf_start = cyhal_lptimer_read(&idle_lptimer);
+    TRACE_BEGIN("deepsleep", lf_delay);
+
+    result = cyhal_lptimer_set_delay(&idle_lptimer, lf_delay);
+    if (result == CY_RSLT_SUCCESS)
+    {
+        cyhal_lptimer_enable_event(&idle_lptimer, CYHAL_LPTIMER_COMPARE_MATCH,
+                                   IDLE_INTR_PRIORITY, true);
+        idle_wake_enable(true);
+
+        result = cyhal_syspm_deepsleep();
+
+        /* Interrupts are masked, so the pin interrupt has not run yet */
+        console = idle_wake_pending();
+        idle_wake_enable(false);
+        cyhal_lptimer_enable_event(&idle_lptimer, CYHAL_LPTIMER_COMPARE_MATCH,
+                                   IDLE_INTR_PRIORITY, false);
+    }
+
+    if (result != CY_RSLT_SUCCESS)
+    {
+        idle_stats.refused++;
+        TRACE_END("deepsleep", 0U);
+        cyhal_syspm_sleep();
+        return;
+    }
+
+    lf_elapsed = cyhal_lptimer_read(&idle_lptimer) - lf_start;
+    counted = soft_timer_now() - start;
+    idle_stats.deepsleeps++;
+
+    /* The TCPWMs counted the time awake, the LPTimer the whole time */
+    timebase_advance(tb_start, ((uint64_t)lf_elapsed * timebase_frequency()) /
+                               idle_lf_hz);
+    TRACE_END("deepsleep", lf_elapsed);
+
+    elapsed = idle_lf_to_ticks(lf_elapsed);
+    if (elapsed > counted)
+    {
+        soft_timer_advance(elapsed - counted);
+    }
+    else
+    {
+        elapsed = counted;
+    }
+
+    if (lf_elapsed >= lf_delay)
+    {
+        idle_update_latency(lf_elapsed - lf_delay);
+    }
+    if (elapsed > delay)
+    {
+        idle_stats.late++;
+    }
+
+    if (console)
+    {
+        idle_hold();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: idle_lock
+********************************************************************************
+* Summary:
+* This function keeps the system out of Deep Sleep until the matching
+* idle_unlock(). Drivers of peripherals that stop in Deep Sleep, such as a
+* running PWM or DMA transfer, hold a lock while they are active. It may be
+* called from interrupts.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_lock(void)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+
+    idle_locks++;
+
+    cyhal_system_critical_section_exit(state);
+}
+
+
+/*******************************************************************************
+* Function Name: idle_unlock
+********************************************************************************
+* Summary:
+* This function releases a lock taken by idle_lock().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_unlock(void)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+
+    CY_ASSERT(idle_locks != 0U);
+    idle_locks--;
+
+    cyhal_system_critical_section_exit(state);
+}
+
+
+/*******************************************************************************
+* Function Name: idle_hold
+********************************************************************************
+* Summary:
+* This function keeps the system out of Deep Sleep for the hold time given
+* to idle_init(), counted from now. The application calls it on console
+* input so that typing is not lost. It must be called from the event loop.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_hold(void)
+{
+    if (idle_hold_ticks == 0U)
+    {
+        return;
+    }
+
+    if (!idle_held)
+    {
+        idle_held = true;
+        idle_lock();
+    }
+
+    soft_timer_start(&idle_hold_timer, idle_hold_ticks, 0U);
+}
+
+
+/*******************************************************************************
+* Function Name: idle_get_stats
+********************************************************************************
+* Summary:
+* This function returns a snapshot of the idle manager statistics.
+*
+* Parameters:
+*  stats       Location to store the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_get_stats(idle_stats_t *stats)
+{
+    *stats = idle_stats;
+    stats->wake_latency_us = idle_lf_to_us(idle_latency);
+    stats->wake_latency_max_us = idle_lf_to_us(idle_latency_max);
+}
+
+
+/*******************************************************************************
+* Function Name: idle_print_stats
+********************************************************************************
+* Summary:
+* This function prints the idle manager statistics and the number of locks
+* currently held.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void idle_print_stats(void)
+{
+    idle_stats_t stats;
+
+    idle_get_stats(&stats);
+
+    APP_LOG("Deep Sleep: %lu times, %lu refused, %lu late, %lu locks held\r\n",
+            (unsigned long)stats.deepsleeps, (unsigned long)stats.refused,
+            (unsigned long)stats.late, (unsigned long)idle_locks);
+    APP_LOG("Wakeup latency: %lu us, longest %lu us\r\n",
+            (unsigned long)stats.wake_latency_us,
+            (unsigned long)stats.wake_latency_max_us);
+}
+
+
+/*******************************************************************************
+* Function Name: idle_lf_read
+********************************************************************************
+* Summary:
+* This function reads the LPTimer, which counts in every power state.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    LPTimer count, 0 before idle_init()
+*
+*******************************************************************************/
+uint32_t idle_lf_read(void)
+{
+    return (idle_lf_hz == 0U) ? 0U : cyhal_lptimer_read(&idle_lptimer);
+}
+
+
+/*******************************************************************************
+* Function Name: idle_lf_frequency
+********************************************************************************
+* Summary:
+* This function returns the frequency of idle_lf_read().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    LPTimer frequency, 0 before idle_init()
+*
+*******************************************************************************/
+uint32_t idle_lf_frequency(void)
+{
+    return idle_lf_hz;
+}
+
+
+/*******************************************************************************
+* Function Name: idle_us_to_lf
+********************************************************************************
+* Summary:
+* This function converts microseconds to LPTimer ticks, rounded up.
+*
+* Parameters:
+*  us          Time in microseconds
+*
+* Return:
+*  uint32_t    Time in LPTimer ticks
+*
+*******************************************************************************/
+static uint32_t idle_us_to_lf(uint32_t us)
+{
+    return (uint32_t)((((uint64_t)us * idle_lf_hz) + IDLE_US_PER_S - 1U) /
+                      IDLE_US_PER_S);
+}
+
+
+/*******************************************************************************
+* Function Name: idle_lf_to_us
+********************************************************************************
+* Summary:
+* This function converts LPTimer ticks to microseconds.
+*
+* Parameters:
+*  lf          Time in LPTimer ticks
+*
+* Return:
+*  uint32_t    Time in microseconds
+*
+*******************************************************************************/
+static uint32_t idle_lf_to_us(uint32_t lf)
+{
+    return (idle_lf_hz == 0U) ? 0U :
+           (uint32_t)(((uint64_t)lf * IDLE_US_PER_S) / idle_lf_hz);
+}
+
+
+/*******************************************************************************
+* Function Name: idle_lf_to_ticks
+********************************************************************************
+* Summary:
+* This function converts a slept time from LPTimer ticks to soft timer
+* ticks. The fraction of a tick is carried to the next call, so the soft
+* timer clock does not drift against the WCO over many sleeps.
+*
+* Parameters:
+*  lf          Time in LPTimer ticks
+*
+* Return:
+*  uint32_t    Time in soft timer ticks
+*
+*******************************************************************************/
+static uint32_t idle_lf_to_ticks(uint32_t lf)
+{
+    uint64_t total = ((uint64_t)lf * idle_tick_hz) + idle_remainder;
+
+    idle_remainder = (uint32_t)(total % idle_lf_hz);
+
+    return (uint32_t)(total / idle_lf_hz);
+}
+
+
+/*******************************************************************************
+* Function Name: idle_update_latency
+********************************************************************************
+* Summary:
+* This function updates the wakeup latency estimate with a measurement.
+*
+* Parameters:
+*  late        LPTimer ticks from the match to the end of the Deep Sleep
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void idle_update_latency(uint32_t late)
+{
+    if (late >= idle_latency)
+    {
+        idle_latency = late;
+    }
+    else
+    {
+        /* Rounded up, so that the estimate reaches the measurement */
+        idle_latency -= ((idle_latency - late) +
+                         (1UL << IDLE_LATENCY_DECAY_SHIFT) - 1UL) >>
+                        IDLE_LATENCY_DECAY_SHIFT;
+    }
+
+    if (late > idle_latency_max)
+    {
+        idle_latency_max = late;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: idle_wake_enable
+********************************************************************************
+* Summary:
+* This function unmasks or masks the wakeup interrupt of the wake pin. An
+* edge seen while it was masked is discarded.
+*
+* Parameters:
+*  enable      true while in Deep Sleep
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void idle_wake_enable(bool enable)
+{
+    if (idle_wake_port != NULL)
+    {
+        Cy_GPIO_ClearInterrupt(idle_wake_port, idle_wake_pin);
+        Cy_GPIO_SetInterruptMask(idle_wake_port, idle_wake_pin,
+                                 enable ? 1U : 0U);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: idle_wake_pending
+********************************************************************************
+* Summary:
+* This function checks whether the wake pin has seen a falling edge.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true if the wake pin interrupt is pending
+*
+*******************************************************************************/
+static bool idle_wake_pending(void)
+{
+    return (idle_wake_port != NULL) &&
+           (Cy_GPIO_GetInterruptStatus(idle_wake_port, idle_wake_pin) != 0U);
+}
+
+
+/*******************************************************************************
+* Function Name: idle_hold_callback
+********************************************************************************
+* Summary:
+* This function runs when the console has been quiet for the hold time and
+* releases its lock.
+*
+* Parameters:
+*  callback_arg    Not used
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void idle_hold_callback(void *callback_arg)
+{
+    (void) callback_arg;
+
+    idle_held = false;
+    idle_unlock();
+}
+
+
+/*******************************************************************************
+* Function Name: isr_idle_lptimer
+********************************************************************************
+* Summary:
+* This is the LPTimer compare match interrupt. It only wakes the system; the
+* HAL clears the interrupt.
+*
+* Parameters:
+*  callback_arg    Not used
+*  event           Compare match event
+*
+* Return:
+*  void
+*******************************************************************************/
+static void isr_idle_lptimer(void *callback_arg, cyhal_lptimer_event_t event)
+{
+    (void) callback_arg;
+    (void) event;
+}
+
+
+/*******************************************************************************
+* Function Name: isr_idle_wake
+********************************************************************************
+* Summary:
+* This is the wake pin interrupt, unmasked only during Deep Sleep. It runs
+* after idle_sleep() has returned and found the edge, and has nothing left to
+* do but clear the interrupt.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*******************************************************************************/
+static void isr_idle_wake(void)
+{
+    Cy_GPIO_ClearInterrupt(idle_wake_port, idle_wake_pin);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,110 @@
+/******************************************************************************
+* File Name:   idle.h
+*
+* Description: This file contains the declarations of the idle manager. When the
+*              event loop has nothing to do and the next soft timer deadline is
+*              far enough away, the system enters Deep Sleep and an LPTimer on
+*              the WCO wakes it ahead of the deadline by the measured wakeup
+*              latency.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IDLE_H
+#define IDLE_H
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* LPTimer and console wakeup interrupt priority */
+#define IDLE_INTR_PRIORITY          (7U)
+
+/* Shortest idle time worth a Deep Sleep on top of the wakeup latency. It
+ * covers the LPTimer setup, which waits for the WCO domain, and the Deep
+ * Sleep callbacks. */
+#define IDLE_DEEPSLEEP_MIN_US       (2000UL)
+
+/* Wakeup latency assumed until the first wakeup has been measured */
+#define IDLE_WAKE_LATENCY_INIT_US   (1000UL)
+
+/* Longest single Deep Sleep. Without soft timers the system still wakes
+ * this often. */
+#define IDLE_DEEPSLEEP_MAX_MS       (8000UL)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Idle manager statistics */
+typedef struct
+{
+    uint32_t deepsleeps;        /* Idle periods spent in Deep Sleep */
+    uint32_t refused;           /* Deep Sleep refused by a driver, Sleep used */
+    uint32_t late;              /* Wakeups after the soft timer deadline */
+    uint32_t wake_latency_us;   /* Current wakeup latency estimate */
+    uint32_t wake_latency_max_us;   /* Longest wakeup latency measured */
+} idle_stats_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t idle_init(uint32_t tick_hz, cyhal_gpio_t wake_pin,
+                    uint32_t hold_ticks);
+void idle_sleep(void);
+void idle_lock(void);
+void idle_unlock(void);
+void idle_hold(void);
+void idle_get_stats(idle_stats_t *stats);
+void idle_print_stats(void);
+uint32_t idle_lf_read(void);
+uint32_t idle_lf_frequency(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IDLE_H */
+
+/* [] END OF FILE */
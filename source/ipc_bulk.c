@@ -0,0 +1,285 @@
+/******************************************************************************
+* File Name:   ipc_bulk.c
+*
+* Description: This file contains the CM4 end of the message rings to and from
+*              the CM0+ core. The doorbell of the CM0+ only posts an event; the
+*              messages are handled in batches from the event loop.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_ipc_drv.h"
+#include "cy_sysint.h"
+#include "event_loop.h"
+#include "ipc_rpc.h"
+#include "ipc_bulk.h"
+#include "trace.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static ipc_bulk_handler_t ipc_bulk_handler = NULL;
+
+/* Set by ipc_bulk_init() if the CM0+ image serves the rings */
+static bool ipc_bulk_active = false;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void ipc_bulk_handle_event(const event_t *event);
+static void ipc_bulk_isr(void);
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_init
+********************************************************************************
+* Summary:
+* This function enables the doorbell of the CM0+. The rings are only used if
+* the CM0+ image initialized them and answers RPC calls, so ipc_rpc_init()
+* must run first. Without them the channel stays off and nothing is sent.
+*
+* Parameters:
+*  handler     Handler of the messages from the CM0+
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, also if the channel stays off
+*
+*******************************************************************************/
+cy_rslt_t ipc_bulk_init(ipc_bulk_handler_t handler)
+{
+    static const cy_stc_sysint_t irq_cfg =
+    {
+        .intrSrc = (IRQn_Type)((uint32_t)cpuss_interrupts_ipc_0_IRQn +
+                               IPC_RING_INTR_CM4),
+        .intrPriority = IPC_BULK_INTR_PRIORITY
+    };
+
+    if (!ipc_rpc_ready() || !ipc_shared_valid())
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    ipc_bulk_handler = handler;
+    event_loop_register(EVENT_IPC_RING, ipc_bulk_handle_event);
+
+    Cy_IPC_Drv_SetInterruptMask(Cy_IPC_Drv_GetIntrBaseAddr(IPC_RING_INTR_CM4),
+                                CY_IPC_NO_NOTIFICATION, (1UL << IPC_RING_CHAN));
+    (void)Cy_SysInt_Init(&irq_cfg, ipc_bulk_isr);
+
+    /* Take the messages the CM0+ may have written before, in the loop. The
+     * interrupt posts the same event, so post before it is enabled. */
+    (void)event_post(EVENT_IPC_RING, 0U);
+
+    NVIC_EnableIRQ(irq_cfg.intrSrc);
+
+    ipc_bulk_active = true;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_ready
+********************************************************************************
+* Summary:
+* This function tells whether the channel is on.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true if the CM0+ serves the rings
+*
+*******************************************************************************/
+bool ipc_bulk_ready(void)
+{
+    return ipc_bulk_active;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_send
+********************************************************************************
+* Summary:
+* This function writes messages to the CM0+ and rings its doorbell if the
+* ring was empty. It must only be called from the main loop, the single
+* producer of the ring. Messages that do not fit are refused, the caller
+* decides whether to retry.
+*
+* Parameters:
+*  msgs        'count' messages of IPC_SHARED_MSG_SIZE bytes
+*  count       Number of messages
+*
+* Return:
+*  uint32_t    Number of messages written, from the first
+*
+*******************************************************************************/
+uint32_t ipc_bulk_send(const void *msgs, uint32_t count)
+{
+    uint32_t written;
+    bool doorbell;
+
+    if (!ipc_bulk_active)
+    {
+        return 0U;
+    }
+
+    written = ipc_ring_write(&ipc_shared.to_cm0p, msgs, count, &doorbell);
+    TRACE_MARK("ring.send", written);
+    if (doorbell)
+    {
+        Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(IPC_RING_CHAN),
+                                 (1UL << IPC_RING_INTR_CM0P));
+    }
+
+    return written;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_poll
+********************************************************************************
+* Summary:
+* This function passes the messages from the CM0+ to the handler, in batches
+* of the messages that follow each other in the ring, until it is empty. It
+* runs on the doorbell event and may also be called from the main loop to
+* wait for messages.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    Number of messages handled
+*
+*******************************************************************************/
+uint32_t ipc_bulk_poll(void)
+{
+    const void *msgs;
+    uint32_t count;
+    uint32_t total = 0U;
+
+    if (!ipc_bulk_active)
+    {
+        return 0U;
+    }
+
+    while ((count = ipc_ring_peek(&ipc_shared.to_cm4, &msgs)) != 0U)
+    {
+        if (ipc_bulk_handler != NULL)
+        {
+            ipc_bulk_handler(msgs, count);
+        }
+        ipc_ring_release(&ipc_shared.to_cm4, count);
+        total += count;
+    }
+
+    return total;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_get_stats
+********************************************************************************
+* Summary:
+* This function reads the counters of both rings. They are kept in the rings
+* by the side that owns them.
+*
+* Parameters:
+*  stats       Location to store the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_bulk_get_stats(ipc_bulk_stats_t *stats)
+{
+    stats->sent = ipc_shared.to_cm0p.head;
+    stats->full = ipc_shared.to_cm0p.full;
+    stats->doorbells_sent = ipc_shared.to_cm0p.doorbells;
+    stats->received = ipc_shared.to_cm4.tail;
+    stats->batches = ipc_shared.to_cm4.batches;
+    stats->doorbells_received = ipc_shared.to_cm4.doorbells;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_handle_event
+********************************************************************************
+* Summary:
+* This function handles the doorbell event in the main loop.
+*
+* Parameters:
+*  event       Doorbell event, no payload
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_bulk_handle_event(const event_t *event)
+{
+    (void)event;
+
+    (void)ipc_bulk_poll();
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_bulk_isr
+********************************************************************************
+* Summary:
+* This is the doorbell interrupt of the CM0+.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_bulk_isr(void)
+{
+    IPC_INTR_STRUCT_Type *intr = Cy_IPC_Drv_GetIntrBaseAddr(IPC_RING_INTR_CM4);
+
+    Cy_IPC_Drv_ClearInterrupt(intr, CY_IPC_NO_NOTIFICATION,
+                              Cy_IPC_Drv_ExtractAcquireMask(
+                                  Cy_IPC_Drv_GetInterruptStatusMasked(intr)));
+
+    (void)event_post(EVENT_IPC_RING, 0U);
+}
+
+/* [] END OF FILE */
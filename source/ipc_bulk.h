@@ -0,0 +1,96 @@
+/******************************************************************************
+* File Name:   ipc_bulk.h
+*
+* Description: This file contains the declarations of the CM4 end of the message
+*              rings to and from the CM0+ core, the bulk data channel between
+*              the cores.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_BULK_H
+#define IPC_BULK_H
+
+#include "cyhal.h"
+#include "ipc_shared.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define IPC_BULK_INTR_PRIORITY      (7U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Handler of the messages from the CM0+, called from the event loop with a
+ * batch of 'count' messages of IPC_SHARED_MSG_SIZE bytes */
+typedef void (*ipc_bulk_handler_t)(const void *msgs, uint32_t count);
+
+/* Counters of both rings since reset */
+typedef struct
+{
+    uint32_t sent;              /* Messages written to the CM0+ */
+    uint32_t full;              /* Messages refused, ring to the CM0+ full */
+    uint32_t doorbells_sent;    /* Doorbells rung on the CM0+ */
+    uint32_t received;          /* Messages read from the CM0+ */
+    uint32_t batches;           /* Batches they were read in */
+    uint32_t doorbells_received; /* Doorbells rung by the CM0+ */
+} ipc_bulk_stats_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t ipc_bulk_init(ipc_bulk_handler_t handler);
+bool ipc_bulk_ready(void);
+uint32_t ipc_bulk_send(const void *msgs, uint32_t count);
+uint32_t ipc_bulk_poll(void);
+void ipc_bulk_get_stats(ipc_bulk_stats_t *stats);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_BULK_H */
+
+/* [] END OF FILE */
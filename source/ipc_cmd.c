@@ -0,0 +1,431 @@
+/******************************************************************************
+* File Name:   ipc_cmd.c
+*
+* Description: This file contains the shell commands of the communication with
+*              the CM0+: the RPC server, the message rings and the console of
+*              APP_UART_CM0P.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "shell.h"
+#include "app_log.h"
+#include "cycle_counter.h"
+#include "ipc_rpc.h"
+#include "ipc_bulk.h"
+#include "ipc_console.h"
+#include "ipc_cmd.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Calls of the 'rpc bench' command and the time each may take */
+#define RPC_BENCH_CALLS                   (1000UL)
+#define RPC_BENCH_TIMEOUT_US              (1000UL)
+
+/* Messages of the 'ring bench' command, how many are written at once, and
+ * the time all of them may take to come back */
+#define RING_BENCH_MSGS                   (10000UL)
+#define RING_BENCH_BATCH                  (8U)
+#define RING_BENCH_TIMEOUT_US             (1000000UL)
+
+/* Log lines of the 'console bench' command */
+#define CONSOLE_BENCH_LINES               (100UL)
+#define CONSOLE_BENCH_LINE_SIZE           (80U)
+#define CONSOLE_BENCH_FMT                 "console bench %lu of %lu, tick %lu\r\n"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Messages returned by the CM0+ ring loopback, the sequence number expected
+ * next, and the messages out of sequence */
+static uint32_t ring_bench_received = 0;
+static uint32_t ring_bench_next = 0;
+static uint32_t ring_bench_errors = 0;
+
+
+/*******************************************************************************
+* Function Name: command_rpc
+********************************************************************************
+* Summary:
+* This function is the 'rpc' command. It prints whether the CM0+ serves calls
+* and the call counters, or with 'bench' measures the round trip of a number
+* of pings, from the send on the CM4 to the release of the channel by the
+* CM0+, in CM4 cycles.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument or a call count that is not a
+*              positive number
+*
+*******************************************************************************/
+int command_rpc(int argc, char *argv[])
+{
+    uint32_t args[IPC_RPC_ARGS] = { 0U };
+    ipc_rpc_stats_t stats;
+    unsigned long calls = RPC_BENCH_CALLS;
+    char *end;
+    uint32_t index;
+    uint32_t result;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t min_cycles = UINT32_MAX;
+    uint32_t max_cycles = 0U;
+    uint64_t total_cycles = 0U;
+    uint32_t avg_ns;
+
+    if (argc == 1)
+    {
+        ipc_rpc_get_stats(&stats);
+        APP_LOG("CM0+ RPC server %s, %lu calls, %lu timeouts, %lu errors\r\n",
+                ipc_rpc_ready() ? "ready" : "not answering",
+                (unsigned long)stats.calls, (unsigned long)stats.timeouts,
+                (unsigned long)stats.errors);
+        return 0;
+    }
+
+    if ((argc > 3) || (strcmp(argv[1], "bench") != 0))
+    {
+        return 1;
+    }
+    if (argc == 3)
+    {
+        calls = strtoul(argv[2], &end, 10);
+        if ((end == argv[2]) || (*end != '\0') || (calls == 0U))
+        {
+            return 1;
+        }
+    }
+
+    for (index = 0U; index < calls; index++)
+    {
+        args[0] = index;
+        start = cycle_counter_read();
+        if ((ipc_rpc_call(IPC_RPC_FUNC_PING, args, &result,
+                          RPC_BENCH_TIMEOUT_US) != CY_RSLT_SUCCESS) ||
+            (result != (index + 1U)))
+        {
+            APP_LOG("rpc: call %lu failed\r\n", (unsigned long)index);
+            return 0;
+        }
+        cycles = cycle_counter_read() - start;
+
+        total_cycles += cycles;
+        if (cycles < min_cycles)
+        {
+            min_cycles = cycles;
+        }
+        if (cycles > max_cycles)
+        {
+            max_cycles = cycles;
+        }
+    }
+
+    avg_ns = (uint32_t)((total_cycles * 1000U) /
+                        ((uint64_t)calls * cycle_counter_per_us()));
+    APP_LOG("%lu calls, round trip min %lu avg %lu max %lu cycles, "
+            "avg %lu.%03lu us\r\n", calls, (unsigned long)min_cycles,
+            (unsigned long)(total_cycles / calls), (unsigned long)max_cycles,
+            (unsigned long)(avg_ns / 1000U), (unsigned long)(avg_ns % 1000U));
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: ring_bench_receive
+********************************************************************************
+* Summary:
+* This function runs from the event loop with a batch of messages from the
+* CM0+. The CM0+ image returns the messages of the CM4 unchanged, so the
+* first word is the sequence number given by 'ring bench'.
+*
+* Parameters:
+*  msgs        'count' messages of IPC_SHARED_MSG_SIZE bytes
+*  count       Number of messages
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ring_bench_receive(const void *msgs, uint32_t count)
+{
+    const uint8_t *msg = (const uint8_t *)msgs;
+    uint32_t sequence;
+    uint32_t index;
+
+    for (index = 0U; index < count; index++)
+    {
+        (void)memcpy(&sequence, &msg[index * IPC_SHARED_MSG_SIZE],
+                     sizeof(sequence));
+        if (sequence != ring_bench_next)
+        {
+            ring_bench_errors++;
+        }
+        ring_bench_next = sequence + 1U;
+    }
+    ring_bench_received += count;
+}
+
+
+/*******************************************************************************
+* Function Name: command_ring
+********************************************************************************
+* Summary:
+* This function is the 'ring' command. It prints the counters of the message
+* rings to and from the CM0+, or with 'bench' sends a number of messages
+* through the CM0+ loopback as fast as the rings take them and measures the
+* throughput. The rings are polled during the measurement; the doorbells and
+* batches show how often the other side had to be notified.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument or a message count that is not
+*              a positive number
+*
+*******************************************************************************/
+int command_ring(int argc, char *argv[])
+{
+    static uint8_t batch[RING_BENCH_BATCH][IPC_SHARED_MSG_SIZE];
+    ipc_bulk_stats_t before;
+    ipc_bulk_stats_t after;
+    unsigned long count = RING_BENCH_MSGS;
+    char *end;
+    uint32_t sent = 0U;
+    uint32_t fill;
+    uint32_t index;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t timeout = RING_BENCH_TIMEOUT_US * cycle_counter_per_us();
+
+    if ((argc > 3) || ((argc > 1) && (strcmp(argv[1], "bench") != 0)))
+    {
+        return 1;
+    }
+    if (argc == 3)
+    {
+        count = strtoul(argv[2], &end, 10);
+        if ((end == argv[2]) || (*end != '\0') || (count == 0U))
+        {
+            return 1;
+        }
+    }
+
+    ipc_bulk_get_stats(&before);
+    if (argc == 1)
+    {
+        APP_LOG("CM0+ rings %s, %u messages of %u bytes each way\r\n",
+                ipc_bulk_ready() ? "ready" : "not served",
+                IPC_SHARED_SLOTS, IPC_SHARED_MSG_SIZE);
+        APP_LOG("  sent %lu, refused %lu, doorbells %lu\r\n",
+                (unsigned long)before.sent, (unsigned long)before.full,
+                (unsigned long)before.doorbells_sent);
+        APP_LOG("  received %lu in %lu batches, doorbells %lu\r\n",
+                (unsigned long)before.received, (unsigned long)before.batches,
+                (unsigned long)before.doorbells_received);
+        return 0;
+    }
+    if (!ipc_bulk_ready())
+    {
+        APP_LOG("ring: the CM0+ image does not serve the rings\r\n");
+        return 0;
+    }
+
+    (void)ipc_bulk_poll();
+    ring_bench_received = 0U;
+    ring_bench_next = 0U;
+    ring_bench_errors = 0U;
+
+    start = cycle_counter_read();
+    while (ring_bench_received < count)
+    {
+        for (fill = 0U; (fill < RING_BENCH_BATCH) && ((sent + fill) < count);
+             fill++)
+        {
+            index = sent + fill;
+            (void)memcpy(batch[fill], &index, sizeof(index));
+        }
+        sent += ipc_bulk_send(batch, fill);
+        (void)ipc_bulk_poll();
+
+        if ((cycle_counter_read() - start) > timeout)
+        {
+            APP_LOG("ring: %lu of %lu messages back\r\n",
+                    (unsigned long)ring_bench_received, count);
+            return 0;
+        }
+    }
+    cycles = cycle_counter_read() - start;
+    ipc_bulk_get_stats(&after);
+
+    APP_LOG("%lu messages of %u bytes, %lu cycles each, %lu msgs/s, "
+            "%lu out of sequence\r\n", count, IPC_SHARED_MSG_SIZE,
+            (unsigned long)(cycles / count),
+            (unsigned long)(((uint64_t)count * cycle_counter_per_us() *
+                             1000000U) / cycles),
+            (unsigned long)ring_bench_errors);
+    APP_LOG("  doorbells %lu to the CM0+, %lu back, %lu batches received\r\n",
+            (unsigned long)(after.doorbells_sent - before.doorbells_sent),
+            (unsigned long)(after.doorbells_received -
+                            before.doorbells_received),
+            (unsigned long)(after.batches - before.batches));
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: command_console
+********************************************************************************
+* Summary:
+* This function is the 'console' command. It prints the counters of the
+* console the CM0+ runs with APP_UART_CM0P, or with 'bench' logs a number of
+* lines and measures what each log call costs the CM4: queuing the record
+* for the CM0+, against formatting the same line with snprintf(). The
+* fastest enqueue is the cost without waiting for room; the CM4 saves the
+* difference to the local formatting on every line, and waits only while
+* the ring is full.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument or a line count that is not a
+*              positive number
+*
+*******************************************************************************/
+int command_console(int argc, char *argv[])
+{
+    char line[CONSOLE_BENCH_LINE_SIZE];
+    ipc_console_stats_t stats;
+    unsigned long lines = CONSOLE_BENCH_LINES;
+    char *end;
+    uint32_t index;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t min_cycles = UINT32_MAX;
+    uint32_t max_cycles = 0U;
+    uint64_t total_cycles = 0U;
+    uint64_t local_cycles = 0U;
+    uint32_t avg_cycles;
+    uint32_t local_avg;
+
+    if ((argc > 3) || ((argc > 1) && (strcmp(argv[1], "bench") != 0)))
+    {
+        return 1;
+    }
+    if (argc == 3)
+    {
+        lines = strtoul(argv[2], &end, 10);
+        if ((end == argv[2]) || (*end != '\0') || (lines == 0U))
+        {
+            return 1;
+        }
+    }
+
+    if (!ipc_console_ready())
+    {
+        APP_LOG("console: the CM4 drives the debug UART, build with "
+                "DEFINES=APP_UART_CM0P to move it to the CM0+\r\n");
+        return 0;
+    }
+
+    if (argc == 1)
+    {
+        ipc_console_get_stats(&stats);
+        APP_LOG("CM0+ console, %lu records, %lu text bytes, %lu dropped\r\n",
+                (unsigned long)stats.records, (unsigned long)stats.text_bytes,
+                (unsigned long)stats.dropped);
+        APP_LOG("  %lu waits for room, longest %lu cycles, %lu lines in\r\n",
+                (unsigned long)stats.waits,
+                (unsigned long)stats.max_stall_cycles,
+                (unsigned long)stats.lines);
+        return 0;
+    }
+
+    for (index = 0U; index < lines; index++)
+    {
+        start = cycle_counter_read();
+        APP_LOG(CONSOLE_BENCH_FMT, (unsigned long)index, lines,
+                (unsigned long)start);
+        cycles = cycle_counter_read() - start;
+
+        total_cycles += cycles;
+        if (cycles < min_cycles)
+        {
+            min_cycles = cycles;
+        }
+        if (cycles > max_cycles)
+        {
+            max_cycles = cycles;
+        }
+
+        start = cycle_counter_read();
+        (void)snprintf(line, sizeof(line), CONSOLE_BENCH_FMT,
+                       (unsigned long)index, lines, (unsigned long)start);
+        local_cycles += cycle_counter_read() - start;
+    }
+
+    avg_cycles = (uint32_t)(total_cycles / lines);
+    local_avg = (uint32_t)(local_cycles / lines);
+    ipc_console_get_stats(&stats);
+
+    APP_LOG("%lu lines, enqueue min %lu avg %lu max %lu cycles, "
+            "snprintf avg %lu cycles\r\n", lines, (unsigned long)min_cycles,
+            (unsigned long)avg_cycles, (unsigned long)max_cycles,
+            (unsigned long)local_avg);
+    APP_LOG("  %ld cycles saved per line without waits, longest wait %lu "
+            "cycles (%lu us)\r\n",
+            (long)local_avg - (long)min_cycles,
+            (unsigned long)stats.max_stall_cycles,
+            (unsigned long)(stats.max_stall_cycles / cycle_counter_per_us()));
+
+    return 0;
+}
+
+/* [] END OF FILE */
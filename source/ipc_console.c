@@ -0,0 +1,659 @@
+/******************************************************************************
+* File Name:   ipc_console.c
+*
+* Description: This file contains the CM4 end of the console that runs on the
+*              CM0+ core when APP_UART_CM0P is defined. The CM4 sets up the
+*              clock of the debug UART, hands the SCB to the CM0+ and then only
+*              copies records into shared memory; the CM0+ formats them and
+*              sends them, and returns the command lines it has edited.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "cybsp.h"
+#include "cy_ipc_drv.h"
+#include "cy_sysint.h"
+#include "cycle_counter.h"
+#include "event_loop.h"
+#include "ipc_rpc.h"
+#include "ipc_console.h"
+#include "power_gov.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* SCB of the debug UART of the kit, which the CM0+ drives */
+#define IPC_CONSOLE_SCB_BLOCK       (5U)
+#define IPC_CONSOLE_SCB_CLOCK       (PCLK_SCB5_CLOCK)
+#define IPC_CONSOLE_SCB             (SCB5)
+
+/* Bits of a character on the line: start, 8 data, stop */
+#define IPC_CONSOLE_CHAR_BITS       (10UL)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static ipc_console_handler_t ipc_console_handler = NULL;
+
+/* Set once the CM0+ runs the UART */
+static bool ipc_console_started = false;
+
+/* Divider of the SCB clock, owned by the CM4 HAL. It is set again when the
+ * power governor changes CLK_PERI. */
+static cyhal_clock_t ipc_console_clock;
+static uint32_t ipc_console_baudrate;
+static power_gov_notifier_t ipc_console_notifier;
+
+static ipc_console_stats_t ipc_console_stats;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static cy_rslt_t ipc_console_reserve(void);
+static bool ipc_console_put(uint8_t kind, const void *payload, uint32_t length);
+static void ipc_console_handle_event(const event_t *event);
+static void ipc_console_isr(void);
+static bool ipc_console_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                     void *arg);
+
+
+/*******************************************************************************
+* Function Name: ipc_console_init
+********************************************************************************
+* Summary:
+* This function hands the debug UART to the CM0+. The SCB and its pins are
+* reserved in the HAL so that no CM4 driver takes them, and the SCB clock is
+* set to the baud rate times IPC_CONSOLE_OVERSAMPLE on a divider the HAL
+* allocates. The CM0+ then configures the SCB and the pins and starts
+* formatting records. ipc_rpc_init() must run first. Output written before is
+* lost.
+*
+* Parameters:
+*  baudrate    Baud rate of the debug UART
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, IPC_CONSOLE_RSLT_ERR_NO_SERVER if the CM0+
+*              image does not serve the console, or the HAL or RPC error
+*
+*******************************************************************************/
+cy_rslt_t ipc_console_init(uint32_t baudrate)
+{
+    uint32_t args[IPC_RPC_ARGS] = { 0U };
+    cy_rslt_t result;
+
+    if (!ipc_rpc_ready() || !ipc_shared_valid())
+    {
+        return IPC_CONSOLE_RSLT_ERR_NO_SERVER;
+    }
+
+    /* The console takes a divider and the UART pins after the design has
+     * set up its own, as in the eager configuration */
+    cybsp_config_require(CYBSP_CONFIG_CLOCKS);
+    cybsp_config_require(CYBSP_CONFIG_PINS);
+
+    result = ipc_console_reserve();
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_clock_allocate(&ipc_console_clock,
+                                      CYHAL_CLOCK_BLOCK_PERIPHERAL_16_5BIT);
+    }
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_clock_set_frequency(&ipc_console_clock,
+                                           baudrate * IPC_CONSOLE_OVERSAMPLE,
+                                           NULL);
+    }
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_clock_set_enabled(&ipc_console_clock, true, true);
+    }
+    if (result == CY_RSLT_SUCCESS)
+    {
+        if (Cy_SysClk_PeriphAssignDivider(IPC_CONSOLE_SCB_CLOCK,
+                (cy_en_divider_types_t)ipc_console_clock.block,
+                ipc_console_clock.channel) != CY_SYSCLK_SUCCESS)
+        {
+            result = IPC_CONSOLE_RSLT_ERR_NO_SERVER;
+        }
+    }
+    if (result == CY_RSLT_SUCCESS)
+    {
+        args[0] = baudrate;
+        result = ipc_rpc_call(IPC_RPC_FUNC_CONSOLE_START, args, NULL,
+                              IPC_CONSOLE_START_US);
+        if (result == IPC_RPC_RSLT_ERR_STATUS)
+        {
+            result = IPC_CONSOLE_RSLT_ERR_NO_SERVER;
+        }
+    }
+
+    ipc_console_started = (result == CY_RSLT_SUCCESS);
+
+    if (ipc_console_started)
+    {
+        ipc_console_baudrate = baudrate;
+        ipc_console_notifier.name = "ipc_console";
+        ipc_console_notifier.callback = ipc_console_clock_notify;
+        power_gov_register(&ipc_console_notifier);
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_input_init
+********************************************************************************
+* Summary:
+* This function enables the command line doorbell of the CM0+. The lines are
+* passed to the handler from the event loop, on the EVENT_UART_RX event the
+* local UART driver would post.
+*
+* Parameters:
+*  handler     Handler of the command lines
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, or IPC_CONSOLE_RSLT_ERR_NO_SERVER if
+*              ipc_console_init() failed
+*
+*******************************************************************************/
+cy_rslt_t ipc_console_input_init(ipc_console_handler_t handler)
+{
+    static const cy_stc_sysint_t irq_cfg =
+    {
+        .intrSrc = (IRQn_Type)((uint32_t)cpuss_interrupts_ipc_0_IRQn +
+                               IPC_CONSOLE_INTR_CM4),
+        .intrPriority = IPC_CONSOLE_INTR_PRIORITY
+    };
+
+    if (!ipc_console_started)
+    {
+        return IPC_CONSOLE_RSLT_ERR_NO_SERVER;
+    }
+
+    ipc_console_handler = handler;
+    event_loop_register(EVENT_UART_RX, ipc_console_handle_event);
+
+    Cy_IPC_Drv_SetInterruptMask(
+        Cy_IPC_Drv_GetIntrBaseAddr(IPC_CONSOLE_INTR_CM4),
+        CY_IPC_NO_NOTIFICATION, (1UL << IPC_RING_CHAN));
+    (void)Cy_SysInt_Init(&irq_cfg, ipc_console_isr);
+
+    /* Take the lines typed during the boot, in the loop. The interrupt posts
+     * the same event, so post before it is enabled. */
+    (void)event_post(EVENT_UART_RX, 0U);
+
+    NVIC_EnableIRQ(irq_cfg.intrSrc);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_ready
+********************************************************************************
+* Summary:
+* This function tells whether the CM0+ runs the console.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true once ipc_console_init() succeeded
+*
+*******************************************************************************/
+bool ipc_console_ready(void)
+{
+    return ipc_console_started;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_send
+********************************************************************************
+* Summary:
+* This function queues a record for the CM0+ and rings its doorbell if the
+* ring was empty. A tokenized log frame is a record of kind
+* IPC_CONSOLE_RECORD_LOG as it is. When the ring is full the function waits
+* for the CM0+ to take a record, as the local UART driver waits with
+* UART_TX_POLICY_BLOCK, but drops the record after IPC_CONSOLE_TIMEOUT_US.
+* The ring is written in a critical section, so the function may also be
+* called from interrupt handlers.
+*
+* Parameters:
+*  record      Record of IPC_CONSOLE_RECORD_SIZE bytes
+*
+* Return:
+*  bool        true if the record was queued
+*
+*******************************************************************************/
+bool ipc_console_send(const void *record)
+{
+    uint32_t start = 0U;
+    uint32_t stall;
+    uint32_t written;
+    uint32_t state;
+    bool doorbell = false;
+    bool waited = false;
+
+    if (!ipc_console_started)
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        state = cyhal_system_critical_section_enter();
+        written = ipc_ring_write(&ipc_shared.records, record, 1U, &doorbell);
+        if (written != 0U)
+        {
+            ipc_console_stats.records++;
+        }
+        cyhal_system_critical_section_exit(state);
+
+        if (written != 0U)
+        {
+            break;
+        }
+
+        if (!waited)
+        {
+            waited = true;
+            start = cycle_counter_read();
+            ipc_console_stats.waits++;
+        }
+        else if ((cycle_counter_read() - start) >
+                 (IPC_CONSOLE_TIMEOUT_US * cycle_counter_per_us()))
+        {
+            ipc_console_stats.dropped++;
+            return false;
+        }
+    }
+
+    if (waited)
+    {
+        stall = cycle_counter_read() - start;
+        if (stall > ipc_console_stats.max_stall_cycles)
+        {
+            ipc_console_stats.max_stall_cycles = stall;
+        }
+    }
+
+    if (doorbell)
+    {
+        Cy_IPC_Drv_AcquireNotify(Cy_IPC_Drv_GetIpcBaseAddress(IPC_RING_CHAN),
+                                 (1UL << IPC_RING_INTR_CM0P));
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_write
+********************************************************************************
+* Summary:
+* This function queues text for the CM0+, in records of up to
+* IPC_CONSOLE_PAYLOAD_SIZE bytes.
+*
+* Parameters:
+*  data        Text to send
+*  length      Number of bytes
+*
+* Return:
+*  size_t      Number of bytes queued, less than length if records were
+*              dropped
+*
+*******************************************************************************/
+size_t ipc_console_write(const char *data, size_t length)
+{
+    size_t queued = 0U;
+    uint32_t chunk;
+
+    while (queued < length)
+    {
+        chunk = ((length - queued) < IPC_CONSOLE_PAYLOAD_SIZE) ?
+                (uint32_t)(length - queued) : IPC_CONSOLE_PAYLOAD_SIZE;
+
+        if (!ipc_console_put((uint8_t)IPC_CONSOLE_RECORD_TEXT, &data[queued],
+                             chunk))
+        {
+            break;
+        }
+        queued += chunk;
+    }
+
+    ipc_console_stats.text_bytes += (uint32_t)queued;
+
+    return queued;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_prompt
+********************************************************************************
+* Summary:
+* This function has the CM0+ print the prompt and the line being edited,
+* after the output queued before.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_console_prompt(void)
+{
+    (void)fflush(stdout);
+    (void)ipc_console_put((uint8_t)IPC_CONSOLE_RECORD_PROMPT, NULL, 0U);
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_history
+********************************************************************************
+* Summary:
+* This function has the CM0+ list the command line history, which it keeps.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_console_history(void)
+{
+    (void)fflush(stdout);
+    (void)ipc_console_put((uint8_t)IPC_CONSOLE_RECORD_HISTORY, NULL, 0U);
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_get_stats
+********************************************************************************
+* Summary:
+* This function copies the counters.
+*
+* Parameters:
+*  stats       Location to store the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_console_get_stats(ipc_console_stats_t *stats)
+{
+    *stats = ipc_console_stats;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_reserve
+********************************************************************************
+* Summary:
+* This function reserves the SCB and the pins of the debug UART in the HAL.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS or the error of the HAL
+*
+*******************************************************************************/
+static cy_rslt_t ipc_console_reserve(void)
+{
+    static const cyhal_gpio_t pins[] =
+    {
+        CYBSP_DEBUG_UART_RX, CYBSP_DEBUG_UART_TX,
+        CYBSP_DEBUG_UART_RTS, CYBSP_DEBUG_UART_CTS
+    };
+    cyhal_resource_inst_t resource =
+    {
+        .type = CYHAL_RSC_SCB,
+        .block_num = IPC_CONSOLE_SCB_BLOCK,
+        .channel_num = 0U
+    };
+    cy_rslt_t result;
+    uint32_t index;
+
+    result = cyhal_hwmgr_reserve(&resource);
+
+    for (index = 0U; (index < (sizeof(pins) / sizeof(pins[0]))) &&
+                     (result == CY_RSLT_SUCCESS); index++)
+    {
+        resource.type = CYHAL_RSC_GPIO;
+        resource.block_num = CYHAL_GET_PORT(pins[index]);
+        resource.channel_num = CYHAL_GET_PIN(pins[index]);
+        result = cyhal_hwmgr_reserve(&resource);
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_put
+********************************************************************************
+* Summary:
+* This function builds a record and queues it.
+*
+* Parameters:
+*  kind        Kind of the record
+*  payload     Payload, may be NULL if length is 0
+*  length      Bytes of payload, at most IPC_CONSOLE_PAYLOAD_SIZE
+*
+* Return:
+*  bool        true if the record was queued
+*
+*******************************************************************************/
+static bool ipc_console_put(uint8_t kind, const void *payload, uint32_t length)
+{
+    ipc_console_record_t record;
+
+    record.kind = kind;
+    record.length = (uint8_t)length;
+    if (length != 0U)
+    {
+        (void)memcpy(record.payload, payload, length);
+    }
+
+    return ipc_console_send(&record);
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_handle_event
+********************************************************************************
+* Summary:
+* This function passes the command lines from the CM0+ to the handler.
+*
+* Parameters:
+*  event       Doorbell event, no payload
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_console_handle_event(const event_t *event)
+{
+    char line[IPC_CONSOLE_LINE_SIZE];
+
+    (void)event;
+
+    while (ipc_ring_read(&ipc_shared.lines, line, 1U) != 0U)
+    {
+        line[IPC_CONSOLE_LINE_SIZE - 1U] = '\0';
+        ipc_console_stats.lines++;
+
+        if (ipc_console_handler != NULL)
+        {
+            ipc_console_handler(line);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_isr
+********************************************************************************
+* Summary:
+* This is the command line doorbell of the CM0+.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void ipc_console_isr(void)
+{
+    IPC_INTR_STRUCT_Type *intr =
+        Cy_IPC_Drv_GetIntrBaseAddr(IPC_CONSOLE_INTR_CM4);
+
+    Cy_IPC_Drv_ClearInterrupt(intr, CY_IPC_NO_NOTIFICATION,
+                              Cy_IPC_Drv_ExtractAcquireMask(
+                                  Cy_IPC_Drv_GetInterruptStatusMasked(intr)));
+
+    (void)event_post(EVENT_UART_RX, 0U);
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_console_clock_notify
+********************************************************************************
+* Summary:
+* This function is the notifier of the power governor. Before the change it
+* waits for the CM0+ to have formatted every record and shifted out the last
+* byte, and for the line to stay idle for a character: the CM0+ releases a
+* record just before it refills the FIFO. A console still busy after
+* IPC_CONSOLE_DRAIN_US refuses the change. After it, the divider of the SCB
+* clock is set again.
+*
+* Parameters:
+*  phase       POWER_GOV_CHECK or POWER_GOV_CHANGED
+*  peri_hz     CLK_PERI of the new operating point, not used
+*  arg         Not used
+*
+* Return:
+*  bool        false to refuse the operating point
+*
+*******************************************************************************/
+static bool ipc_console_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                     void *arg)
+{
+    uint32_t per_us = cycle_counter_per_us();
+    uint32_t char_us = ((IPC_CONSOLE_CHAR_BITS * 1000000UL) /
+                        ipc_console_baudrate) + 1UL;
+    uint32_t start;
+    uint32_t idle_since;
+    uint32_t now;
+
+    (void)peri_hz;
+    (void)arg;
+
+    if (phase == POWER_GOV_CHANGED)
+    {
+        return cyhal_clock_set_frequency(&ipc_console_clock,
+                                         ipc_console_baudrate *
+                                         IPC_CONSOLE_OVERSAMPLE,
+                                         NULL) == CY_RSLT_SUCCESS;
+    }
+
+    start = cycle_counter_read();
+    idle_since = start;
+    do
+    {
+        now = cycle_counter_read();
+        if ((ipc_ring_count(&ipc_shared.records) != 0U) ||
+            !Cy_SCB_UART_IsTxComplete(IPC_CONSOLE_SCB))
+        {
+            idle_since = now;
+        }
+        else if ((now - idle_since) >= (char_us * per_us))
+        {
+            return true;
+        }
+    } while ((now - start) < (IPC_CONSOLE_DRAIN_US * per_us));
+
+    return false;
+}
+
+
+#if defined(APP_UART_CM0P) && defined(__GNUC__) && !defined(__ARMCC_VERSION)
+/*******************************************************************************
+* Function Name: _write
+********************************************************************************
+* Summary:
+* This function overrides the weak retarget-io implementation used by the GCC
+* C library for stdout, in place of the one of uart_tx.c. Output is queued
+* for the CM0+ as text records.
+*
+* Parameters:
+*  fd          File descriptor, not used
+*  ptr         Characters to write
+*  len         Number of characters
+*
+* Return:
+*  int         Number of characters consumed
+*
+*******************************************************************************/
+int _write(int fd, const char *ptr, int len)
+{
+    (void) fd;
+
+    if ((ptr == NULL) || (len <= 0))
+    {
+        return 0;
+    }
+
+    /* Dropped records are counted, not reported as an error */
+    (void)ipc_console_write(ptr, (size_t)len);
+
+    return len;
+}
+#endif /* defined(APP_UART_CM0P) && defined(__GNUC__) &&
+        * !defined(__ARMCC_VERSION) */
+
+/* [] END OF FILE */
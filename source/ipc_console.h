@@ -0,0 +1,121 @@
+/******************************************************************************
+* File Name:   ipc_console.h
+*
+* Description: This file contains the declarations of the CM4 end of the console
+*              that runs on the CM0+ core when APP_UART_CM0P is defined. The CM4
+*              queues the log frames and the text of printf() as records for the
+*              CM0+, which formats them, drives the debug UART and edits the
+*              command lines.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_CONSOLE_H
+#define IPC_CONSOLE_H
+
+#include "cyhal.h"
+#include "ipc_shared.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Define APP_UART_CM0P (for example "make build DEFINES=APP_UART_CM0P") to
+ * hand the debug UART to the CM0+. Requires CM0P_IMAGE=RPC. */
+
+/* The CM0+ image does not serve the console */
+#define IPC_CONSOLE_RSLT_ERR_NO_SERVER \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x16U)
+
+/* Longest wait for room in the record ring. A record takes about 6 ms at
+ * 115200 baud, so only a CM0+ that stopped formatting makes it expire; the
+ * record is then dropped. */
+#define IPC_CONSOLE_TIMEOUT_US      (100000UL)
+
+/* Time ipc_console_init() waits for the CM0+ to start the UART */
+#define IPC_CONSOLE_START_US        (10000UL)
+
+/* Longest wait for the console to fall silent before the power governor
+ * changes the clock of the UART; it refuses the change after that */
+#define IPC_CONSOLE_DRAIN_US        (100000UL)
+
+/* Command line doorbell priority */
+#define IPC_CONSOLE_INTR_PRIORITY   (7U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Handler of the command lines, called from the event loop with a NUL
+ * terminated line the CM0+ has edited */
+typedef void (*ipc_console_handler_t)(char *line);
+
+/* Counters since reset */
+typedef struct
+{
+    uint32_t records;           /* Records written to the CM0+ */
+    uint32_t text_bytes;        /* Bytes of text among them */
+    uint32_t dropped;           /* Records dropped after IPC_CONSOLE_TIMEOUT_US */
+    uint32_t waits;             /* Records that found the ring full */
+    uint32_t max_stall_cycles;  /* Longest wait for room, in CPU cycles */
+    uint32_t lines;             /* Command lines received */
+} ipc_console_stats_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t ipc_console_init(uint32_t baudrate);
+cy_rslt_t ipc_console_input_init(ipc_console_handler_t handler);
+bool ipc_console_ready(void);
+bool ipc_console_send(const void *record);
+size_t ipc_console_write(const char *data, size_t length);
+void ipc_console_prompt(void);
+void ipc_console_history(void);
+void ipc_console_get_stats(ipc_console_stats_t *stats);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_CONSOLE_H */
+
+/* [] END OF FILE */
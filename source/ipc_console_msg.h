@@ -0,0 +1,113 @@
+/******************************************************************************
+* File Name:   ipc_console_msg.h
+*
+* Description: This file contains the protocol of the console that the CM0+ core
+*              runs on the debug UART for the CM4: the records the CM4 queues
+*              for output and the command lines it gets back. It is shared by
+*              both images.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_CONSOLE_MSG_H
+#define IPC_CONSOLE_MSG_H
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of a record, the same as a tokenized log frame, and number of records
+ * the ring to the CM0+ holds */
+#define IPC_CONSOLE_RECORD_SIZE     (64U)
+#define IPC_CONSOLE_RECORD_SLOTS    (32U)
+
+/* Header of a record: kind and payload length */
+#define IPC_CONSOLE_HEADER_SIZE     (2U)
+#define IPC_CONSOLE_PAYLOAD_SIZE    (IPC_CONSOLE_RECORD_SIZE - \
+                                     IPC_CONSOLE_HEADER_SIZE)
+
+/* Size of a command line including the terminating NUL, the same as the line
+ * of the shell, and number of lines the ring to the CM4 holds */
+#define IPC_CONSOLE_LINE_SIZE       (64U)
+#define IPC_CONSOLE_LINE_SLOTS      (4U)
+
+/* Oversampling of the UART. The CM4 sets the clock divider of the SCB to the
+ * baud rate times this before it starts the console. */
+#define IPC_CONSOLE_OVERSAMPLE      (8U)
+
+/* IPC interrupt structure of the command line doorbell, routed to the CM4.
+ * The doorbell is a notify event of IPC_RING_CHAN like those of the message
+ * rings. */
+#define IPC_CONSOLE_INTR_CM4        (CY_IPC_INTR_USER + 3U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Kinds of records, in the first byte */
+typedef enum
+{
+    IPC_CONSOLE_RECORD_LOG = 0,     /* Tokenized log frame, see app_log.c. The
+                                     * token is the address of the format
+                                     * string in the flash of the CM4 image. */
+    IPC_CONSOLE_RECORD_TEXT,        /* Text to send as is */
+    IPC_CONSOLE_RECORD_PROMPT,      /* Print the prompt and the edited line */
+    IPC_CONSOLE_RECORD_HISTORY      /* List the line history */
+} ipc_console_kind_t;
+
+/* A record, written by the CM4 and formatted by the CM0+ in the order of the
+ * ring */
+typedef struct
+{
+    uint8_t kind;
+    uint8_t length;             /* Bytes used of payload */
+    uint8_t payload[IPC_CONSOLE_PAYLOAD_SIZE];
+} ipc_console_record_t;
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_CONSOLE_MSG_H */
+
+/* [] END OF FILE */
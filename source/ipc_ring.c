@@ -0,0 +1,290 @@
+/******************************************************************************
+* File Name:   ipc_ring.c
+*
+* Description: This file contains the lock-free single-producer, single-consumer
+*              message rings between the CM4 and the CM0+ core. The producer
+*              rings the doorbell of the consumer only when a write finds the
+*              ring empty, and the consumer takes all the messages that are
+*              waiting in one batch.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "cy_device_headers.h"
+#include "ipc_ring.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Full barrier between the accesses of the two sides. A DMB orders the
+ * accesses of the CPU to the shared SRAM; the host simulation runs the sides
+ * on two threads and needs the barrier of the host CPU. */
+#if defined(APP_HOST_BUILD)
+#define IPC_RING_FENCE()            __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#define IPC_RING_FENCE()            __DMB()
+#endif
+
+
+/*******************************************************************************
+* Function Name: ipc_ring_init
+********************************************************************************
+* Summary:
+* This function initializes an empty ring on top of caller-provided storage.
+* It must run before either side uses the ring, on one of the cores.
+*
+* Parameters:
+*  ring        Ring to initialize
+*  slots       Storage for 'slot_count' messages, IPC_RING_LINE aligned
+*  slot_size   Bytes per message, a multiple of 4
+*  slot_count  Number of messages the ring holds, a power of two
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_ring_init(ipc_ring_t *ring, void *slots, uint32_t slot_size,
+                   uint32_t slot_count)
+{
+    ring->slots = (uint8_t *)slots;
+    ring->slot_size = slot_size;
+    ring->mask = slot_count - 1U;
+    ring->head = 0U;
+    ring->full = 0U;
+    ring->doorbells = 0U;
+    ring->tail = 0U;
+    ring->batches = 0U;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_ring_write
+********************************************************************************
+* Summary:
+* This function appends messages to the ring. It must only be called from the
+* producer context. The messages that do not fit are refused and counted.
+*
+* The doorbell is needed when the ring was empty before the write: the
+* consumer may have found it empty and be waiting. The new head is published
+* before the tail is read, and the consumer publishes its tail before it
+* reads the head again, so with a full barrier on both sides at least one of
+* them sees the other's update. Either the doorbell is rung or the consumer
+* finds the messages without it. A doorbell can arrive after the consumer
+* has taken the messages; the consumer then finds the ring empty.
+*
+* Parameters:
+*  ring        Ring to write
+*  msgs        'count' messages of the slot size, one after the other
+*  count       Number of messages
+*  doorbell    Set to true if the consumer must be notified
+*
+* Return:
+*  uint32_t    Number of messages written, from the first
+*
+*******************************************************************************/
+uint32_t ipc_ring_write(ipc_ring_t *ring, const void *msgs, uint32_t count,
+                        bool *doorbell)
+{
+    const uint8_t *src = (const uint8_t *)msgs;
+    uint32_t head = ring->head;
+    uint32_t space = (ring->mask + 1U) - (head - ring->tail);
+    uint32_t index;
+
+    *doorbell = false;
+
+    if (count > space)
+    {
+        ring->full += count - space;
+        count = space;
+    }
+    if (count == 0U)
+    {
+        return 0U;
+    }
+
+    for (index = 0U; index < count; index++)
+    {
+        (void)memcpy(&ring->slots[((head + index) & ring->mask) *
+                                  ring->slot_size],
+                     &src[index * ring->slot_size], ring->slot_size);
+    }
+
+    /* The messages must be visible before the consumer sees the new head */
+    IPC_RING_FENCE();
+    ring->head = head + count;
+
+    /* Publish the head before reading the tail, see above */
+    IPC_RING_FENCE();
+    if (ring->tail == head)
+    {
+        ring->doorbells++;
+        *doorbell = true;
+    }
+
+    return count;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_ring_peek
+********************************************************************************
+* Summary:
+* This function returns the waiting messages in place, as many as follow each
+* other in the slots. It must only be called from the consumer context. The
+* consumer handles them and hands them back with ipc_ring_release(), then
+* peeks again; it may wait for the doorbell once a peek after its last
+* release returns 0.
+*
+* Parameters:
+*  ring        Ring to read
+*  msgs        Location to store the address of the first message
+*
+* Return:
+*  uint32_t    Number of messages at 'msgs'
+*
+*******************************************************************************/
+uint32_t ipc_ring_peek(const ipc_ring_t *ring, const void **msgs)
+{
+    uint32_t tail = ring->tail;
+    uint32_t count = ring->head - tail;
+    uint32_t contiguous = (ring->mask + 1U) - (tail & ring->mask);
+
+    /* Read the messages only after observing the head that published them */
+    IPC_RING_FENCE();
+
+    *msgs = &ring->slots[(tail & ring->mask) * ring->slot_size];
+
+    return (count < contiguous) ? count : contiguous;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_ring_release
+********************************************************************************
+* Summary:
+* This function hands messages returned by ipc_ring_peek() back to the
+* producer, as one batch.
+*
+* Parameters:
+*  ring        Ring read
+*  count       Number of messages, at most the peeked count
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_ring_release(ipc_ring_t *ring, uint32_t count)
+{
+    /* The messages must be read before the producer may overwrite them */
+    IPC_RING_FENCE();
+    ring->tail = ring->tail + count;
+    ring->batches++;
+
+    /* Publish the tail before the next peek reads the head, see
+     * ipc_ring_write() */
+    IPC_RING_FENCE();
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_ring_read
+********************************************************************************
+* Summary:
+* This function copies waiting messages out of the ring and releases them. It
+* must only be called from the consumer context.
+*
+* Parameters:
+*  ring        Ring to read
+*  msgs        Location to copy up to 'max' messages to
+*  max         Number of messages 'msgs' holds
+*
+* Return:
+*  uint32_t    Number of messages copied
+*
+*******************************************************************************/
+uint32_t ipc_ring_read(ipc_ring_t *ring, void *msgs, uint32_t max)
+{
+    uint8_t *dst = (uint8_t *)msgs;
+    const void *src;
+    uint32_t total = 0U;
+    uint32_t count;
+
+    /* Twice at most: up to the end of the slots, then from their start */
+    while (total < max)
+    {
+        count = ipc_ring_peek(ring, &src);
+        if (count == 0U)
+        {
+            break;
+        }
+        if (count > (max - total))
+        {
+            count = max - total;
+        }
+
+        (void)memcpy(&dst[total * ring->slot_size], src,
+                     count * ring->slot_size);
+        ipc_ring_release(ring, count);
+        total += count;
+    }
+
+    return total;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_ring_count
+********************************************************************************
+* Summary:
+* This function returns the number of messages waiting in the ring. Seen from
+* the consumer the count can only grow, seen from the producer it can only
+* shrink.
+*
+* Parameters:
+*  ring        Ring to inspect
+*
+* Return:
+*  uint32_t    Number of waiting messages
+*
+*******************************************************************************/
+uint32_t ipc_ring_count(const ipc_ring_t *ring)
+{
+    return ring->head - ring->tail;
+}
+
+/* [] END OF FILE */
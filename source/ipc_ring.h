@@ -0,0 +1,113 @@
+/******************************************************************************
+* File Name:   ipc_ring.h
+*
+* Description: This file contains the declarations of the lock-free single-
+*              producer, single-consumer message rings between the CM4 and the
+*              CM0+ core. The module does not depend on the core it runs on, and
+*              the host simulation in host/sim uses it as is.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_RING_H
+#define IPC_RING_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Alignment of the producer and the consumer fields of a ring and of its
+ * slots. The PSoC 6 SRAM is not cached, but keeping the fields each side
+ * writes apart avoids false sharing in the host simulation and on parts with
+ * a data cache. */
+#define IPC_RING_LINE               (32U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Ring of fixed-size messages. The producer only writes the fields of the
+ * producer line, the consumer only those of the consumer line, so neither
+ * side needs a lock. Both indices run freely and are masked on access, which
+ * requires the slot count to be a power of two. The ring and its slots may be
+ * placed in memory both cores access at the same address. */
+typedef struct
+{
+    /* Set by ipc_ring_init(), read only afterwards */
+    uint8_t *slots;             /* Storage of 'mask + 1' messages */
+    uint32_t slot_size;         /* Bytes per message, multiple of 4 */
+    uint32_t mask;              /* Slot count minus one */
+
+    /* Producer line */
+    volatile uint32_t head __attribute__((aligned(IPC_RING_LINE)));
+                                /* Messages written */
+    volatile uint32_t full;     /* Messages refused while the ring was full */
+    volatile uint32_t doorbells;/* Writes that found the ring empty */
+
+    /* Consumer line */
+    volatile uint32_t tail __attribute__((aligned(IPC_RING_LINE)));
+                                /* Messages released */
+    volatile uint32_t batches;  /* Releases, each of one or more messages */
+} ipc_ring_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void ipc_ring_init(ipc_ring_t *ring, void *slots, uint32_t slot_size,
+                   uint32_t slot_count);
+uint32_t ipc_ring_write(ipc_ring_t *ring, const void *msgs, uint32_t count,
+                        bool *doorbell);
+uint32_t ipc_ring_peek(const ipc_ring_t *ring, const void **msgs);
+void ipc_ring_release(ipc_ring_t *ring, uint32_t count);
+uint32_t ipc_ring_read(ipc_ring_t *ring, void *msgs, uint32_t max);
+uint32_t ipc_ring_count(const ipc_ring_t *ring);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_RING_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,324 @@
+/******************************************************************************
+* File Name:   ipc_rpc.c
+*
+* Description: This file contains the CM4 side of the remote procedure calls to
+*              the CM0+ core. The message of a call stays in the CM4 SRAM; the
+*              IPC channel carries its address and its lock tells that the call
+*              is in progress.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_ipc_drv.h"
+#include "cycle_counter.h"
+#include "ipc_rpc.h"
+#include "trace.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Message of the current or last call, read by the CM0+ while the channel is
+ * locked */
+static volatile ipc_rpc_msg_t ipc_rpc_msg;
+
+/* Cleared when the server did not answer, calls then fail at once */
+static bool ipc_rpc_server_ready = false;
+
+/* The message belongs to a posted call, whose status nobody has checked */
+static bool ipc_rpc_posted = false;
+
+static ipc_rpc_stats_t ipc_rpc_stats;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static bool ipc_rpc_wait(IPC_STRUCT_Type *ipc, uint32_t timeout_us);
+static cy_rslt_t ipc_rpc_send(ipc_rpc_func_t func,
+                              const uint32_t args[IPC_RPC_ARGS],
+                              uint32_t timeout_us);
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_init
+********************************************************************************
+* Summary:
+* This function probes the RPC server with a ping. The application also runs
+* with the CM0P_SLEEP image, which does not serve calls: the probe then times
+* out, the calls fail with IPC_RPC_RSLT_ERR_TIMEOUT and ipc_rpc_ready()
+* returns false.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, also without a server
+*
+*******************************************************************************/
+cy_rslt_t ipc_rpc_init(void)
+{
+    uint32_t args[IPC_RPC_ARGS] = { 0U };
+    uint32_t result = 0U;
+
+    cycle_counter_init();
+
+    ipc_rpc_server_ready = true;
+    if ((ipc_rpc_call(IPC_RPC_FUNC_PING, args, &result,
+                      IPC_RPC_PROBE_US) != CY_RSLT_SUCCESS) || (result != 1U))
+    {
+        ipc_rpc_server_ready = false;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_ready
+********************************************************************************
+* Summary:
+* This function tells whether the RPC server answered.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true if calls are served
+*
+*******************************************************************************/
+bool ipc_rpc_ready(void)
+{
+    return ipc_rpc_server_ready;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_call
+********************************************************************************
+* Summary:
+* This function runs a function on the CM0+ and waits for its result. It
+* waits for a posted call to finish first. On a timeout the channel is taken
+* back and the server is considered gone, since its state is unknown. Not to
+* be called from interrupt handlers.
+*
+* Parameters:
+*  func        Function of the server
+*  args        IPC_RPC_ARGS arguments
+*  result      Location to store the result, may be NULL
+*  timeout_us  Time to wait for the server, in microseconds
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, IPC_RPC_RSLT_ERR_TIMEOUT, or
+*              IPC_RPC_RSLT_ERR_STATUS if the function failed on the server
+*
+*******************************************************************************/
+cy_rslt_t ipc_rpc_call(ipc_rpc_func_t func, const uint32_t args[IPC_RPC_ARGS],
+                       uint32_t *result, uint32_t timeout_us)
+{
+    IPC_STRUCT_Type *ipc = Cy_IPC_Drv_GetIpcBaseAddress(IPC_RPC_CHAN);
+    cy_rslt_t rslt;
+
+    TRACE_BEGIN("rpc.call", (uint32_t)func);
+
+    rslt = ipc_rpc_send(func, args, timeout_us);
+    if (rslt == CY_RSLT_SUCCESS)
+    {
+        if (!ipc_rpc_wait(ipc, timeout_us))
+        {
+            Cy_IPC_Drv_LockRelease(ipc, CY_IPC_NO_NOTIFICATION);
+            ipc_rpc_server_ready = false;
+            ipc_rpc_stats.timeouts++;
+            rslt = IPC_RPC_RSLT_ERR_TIMEOUT;
+        }
+        else if (ipc_rpc_msg.status != (uint32_t)IPC_RPC_STATUS_OK)
+        {
+            ipc_rpc_stats.errors++;
+            rslt = IPC_RPC_RSLT_ERR_STATUS;
+        }
+    }
+
+    if (result != NULL)
+    {
+        *result = ipc_rpc_msg.result;
+    }
+
+    TRACE_END("rpc.call", (uint32_t)func);
+
+    return rslt;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_post
+********************************************************************************
+* Summary:
+* This function starts a function on the CM0+ without waiting for it, for
+* housekeeping the CM4 need not wait for. Its result is lost; a failure only
+* shows in the error count, taken by the next call.
+*
+* Parameters:
+*  func        Function of the server
+*  args        IPC_RPC_ARGS arguments
+*  timeout_us  Time to wait for the previous call to finish, in microseconds
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS or IPC_RPC_RSLT_ERR_TIMEOUT
+*
+*******************************************************************************/
+cy_rslt_t ipc_rpc_post(ipc_rpc_func_t func, const uint32_t args[IPC_RPC_ARGS],
+                       uint32_t timeout_us)
+{
+    cy_rslt_t rslt = ipc_rpc_send(func, args, timeout_us);
+
+    ipc_rpc_posted = (rslt == CY_RSLT_SUCCESS);
+
+    return rslt;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_get_stats
+********************************************************************************
+* Summary:
+* This function copies the call counters.
+*
+* Parameters:
+*  stats       Location to store the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_rpc_get_stats(ipc_rpc_stats_t *stats)
+{
+    *stats = ipc_rpc_stats;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_wait
+********************************************************************************
+* Summary:
+* This function waits for the server to release the channel.
+*
+* Parameters:
+*  ipc         IPC channel of the calls
+*  timeout_us  Time to wait, in microseconds
+*
+* Return:
+*  bool        true if the channel is free
+*
+*******************************************************************************/
+static bool ipc_rpc_wait(IPC_STRUCT_Type *ipc, uint32_t timeout_us)
+{
+    uint32_t start = cycle_counter_read();
+    uint32_t timeout = timeout_us * cycle_counter_per_us();
+
+    while (Cy_IPC_Drv_IsLockAcquired(ipc))
+    {
+        if ((cycle_counter_read() - start) > timeout)
+        {
+            return false;
+        }
+    }
+
+    /* The result was written by the other core before it released the lock */
+    __DMB();
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_rpc_send
+********************************************************************************
+* Summary:
+* This function waits for the previous call to finish, fills in the message
+* and sends its address to the server, which is notified on
+* IPC_RPC_INTR_SERVER.
+*
+* Parameters:
+*  func        Function of the server
+*  args        IPC_RPC_ARGS arguments
+*  timeout_us  Time to wait for the previous call, in microseconds
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS or IPC_RPC_RSLT_ERR_TIMEOUT
+*
+*******************************************************************************/
+static cy_rslt_t ipc_rpc_send(ipc_rpc_func_t func,
+                              const uint32_t args[IPC_RPC_ARGS],
+                              uint32_t timeout_us)
+{
+    IPC_STRUCT_Type *ipc = Cy_IPC_Drv_GetIpcBaseAddress(IPC_RPC_CHAN);
+    uint32_t index;
+
+    if (!ipc_rpc_server_ready || !ipc_rpc_wait(ipc, timeout_us))
+    {
+        ipc_rpc_stats.timeouts++;
+        return IPC_RPC_RSLT_ERR_TIMEOUT;
+    }
+
+    if (ipc_rpc_posted && (ipc_rpc_msg.status != (uint32_t)IPC_RPC_STATUS_OK))
+    {
+        ipc_rpc_stats.errors++;
+    }
+    ipc_rpc_posted = false;
+
+    ipc_rpc_msg.func = (uint32_t)func;
+    for (index = 0U; index < IPC_RPC_ARGS; index++)
+    {
+        ipc_rpc_msg.args[index] = args[index];
+    }
+    ipc_rpc_msg.result = 0U;
+    ipc_rpc_msg.status = (uint32_t)IPC_RPC_STATUS_NO_FUNC;
+    __DMB();
+
+    /* Fails only if the channel was taken since the wait */
+    if (Cy_IPC_Drv_SendMsgWord(ipc, (1UL << IPC_RPC_INTR_SERVER),
+                               (uint32_t)&ipc_rpc_msg) != CY_IPC_DRV_SUCCESS)
+    {
+        ipc_rpc_stats.timeouts++;
+        return IPC_RPC_RSLT_ERR_TIMEOUT;
+    }
+
+    ipc_rpc_stats.calls++;
+
+    return CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,101 @@
+/******************************************************************************
+* File Name:   ipc_rpc.h
+*
+* Description: This file contains the declarations of the CM4 side of the remote
+*              procedure calls to the CM0+ core. Calls run one at a time:
+*              ipc_rpc_call() waits for the result, ipc_rpc_post() only for the
+*              previous call to finish.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_RPC_H
+#define IPC_RPC_H
+
+#include "cyhal.h"
+#include "ipc_rpc_msg.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* The CM0+ did not take or finish a call in time */
+#define IPC_RPC_RSLT_ERR_TIMEOUT \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x14U)
+
+/* The server returned a status other than IPC_RPC_STATUS_OK */
+#define IPC_RPC_RSLT_ERR_STATUS \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x15U)
+
+/* Time ipc_rpc_init() waits for the server to answer */
+#define IPC_RPC_PROBE_US            (1000U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Call counters since reset */
+typedef struct
+{
+    uint32_t calls;             /* Calls and posts sent to the CM0+ */
+    uint32_t timeouts;          /* Calls that timed out */
+    uint32_t errors;            /* Calls the server failed */
+} ipc_rpc_stats_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t ipc_rpc_init(void);
+bool ipc_rpc_ready(void);
+cy_rslt_t ipc_rpc_call(ipc_rpc_func_t func, const uint32_t args[IPC_RPC_ARGS],
+                       uint32_t *result, uint32_t timeout_us);
+cy_rslt_t ipc_rpc_post(ipc_rpc_func_t func, const uint32_t args[IPC_RPC_ARGS],
+                       uint32_t timeout_us);
+void ipc_rpc_get_stats(ipc_rpc_stats_t *stats);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_RPC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,116 @@
+/******************************************************************************
+* File Name:   ipc_rpc_msg.h
+*
+* Description: This file contains the protocol of the remote procedure calls
+*              from the CM4 to the RPC server on the CM0+ core, shared by both
+*              firmware images. A call is a message in the SRAM of the caller
+*              whose address is sent over an IPC channel; the server releases
+*              the channel when the result is in the message.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_RPC_MSG_H
+#define IPC_RPC_MSG_H
+
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* IPC channel of the calls, the first one free for the application */
+#define IPC_RPC_CHAN                (CY_IPC_CHAN_USER)
+
+/* IPC interrupt structure notified of a call, routed to the CM0+ */
+#define IPC_RPC_INTR_SERVER         (CY_IPC_INTR_USER)
+
+/* Number of 32 bit arguments of a call */
+#define IPC_RPC_ARGS                (4U)
+
+/* Size of a flash row written by IPC_RPC_FUNC_FLASH_WRITE_ROW */
+#define IPC_RPC_FLASH_ROW_SIZE      (512U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Functions of the RPC server */
+typedef enum
+{
+    IPC_RPC_FUNC_PING = 0,      /* Returns args[0] + 1, for the benchmark */
+    IPC_RPC_FUNC_GPIO_WRITE,    /* Drives port args[0] pin args[1] to args[2];
+                                 * the CM4 configures the pin */
+    IPC_RPC_FUNC_FLASH_WRITE_ROW, /* Writes the IPC_RPC_FLASH_ROW_SIZE bytes at
+                                   * address args[1] to the row at address
+                                   * args[0] of the emulated EEPROM flash */
+    IPC_RPC_FUNC_CONSOLE_START, /* Takes over the debug UART SCB, whose clock
+                                 * the CM4 has set up, and runs the console of
+                                 * ipc_console_msg.h on it */
+    IPC_RPC_FUNC_COUNT          /* Number of functions, not a valid function */
+} ipc_rpc_func_t;
+
+/* Outcome of a call, set by the server */
+typedef enum
+{
+    IPC_RPC_STATUS_OK = 0,
+    IPC_RPC_STATUS_NO_FUNC,     /* Unknown function */
+    IPC_RPC_STATUS_BAD_ARGS,    /* Arguments out of range */
+    IPC_RPC_STATUS_FAILED       /* The function failed, result has the cause */
+} ipc_rpc_status_t;
+
+/* A call. The caller fills in func and args, the server result and status
+ * before it releases the channel. */
+typedef struct
+{
+    uint32_t func;
+    uint32_t args[IPC_RPC_ARGS];
+    uint32_t result;
+    uint32_t status;
+} ipc_rpc_msg_t;
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_RPC_MSG_H */
+
+/* [] END OF FILE */
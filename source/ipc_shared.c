@@ -0,0 +1,118 @@
+/******************************************************************************
+* File Name:   ipc_shared.c
+*
+* Description: This file contains the memory shared by the CM4 and the CM0+
+*              core. It is built into both images.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_device_headers.h"
+#include "ipc_shared.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Not initialized by the startup code of either core: the CM0+ sets it up
+ * with ipc_shared_init() before it starts the CM4. The host build has only
+ * one image and no such section. */
+#if defined(APP_HOST_BUILD)
+ipc_shared_t ipc_shared;
+#else
+ipc_shared_t ipc_shared __attribute__((section(".cy_sharedmem")));
+#endif
+
+
+/*******************************************************************************
+* Function Name: ipc_shared_init
+********************************************************************************
+* Summary:
+* This function initializes the rings and the CM0+ trace buffer, stops the
+* timebase readers until the CM4 starts it again, and marks the shared memory
+* valid. It runs on the CM0+ before the CM4 is started, so no barrier is
+* needed beyond the one that orders the marker after the rings.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void ipc_shared_init(void)
+{
+    ipc_shared.magic = 0U;
+
+    ipc_ring_init(&ipc_shared.to_cm0p, ipc_shared.to_cm0p_slots,
+                  IPC_SHARED_MSG_SIZE, IPC_SHARED_SLOTS);
+    ipc_ring_init(&ipc_shared.to_cm4, ipc_shared.to_cm4_slots,
+                  IPC_SHARED_MSG_SIZE, IPC_SHARED_SLOTS);
+    ipc_ring_init(&ipc_shared.records, ipc_shared.record_slots,
+                  IPC_CONSOLE_RECORD_SIZE, IPC_CONSOLE_RECORD_SLOTS);
+    ipc_ring_init(&ipc_shared.lines, ipc_shared.line_slots,
+                  IPC_CONSOLE_LINE_SIZE, IPC_CONSOLE_LINE_SLOTS);
+
+    ipc_shared.timebase.base = NULL;
+    trace_buf_init(&ipc_shared.trace, ipc_shared.trace_records,
+                   TRACE_CM0P_RECORDS);
+
+    __DMB();
+    ipc_shared.magic = IPC_SHARED_MAGIC;
+}
+
+
+/*******************************************************************************
+* Function Name: ipc_shared_valid
+********************************************************************************
+* Summary:
+* This function tells whether the CM0+ has initialized the shared memory. The
+* SRAM keeps its content over a reset, so the marker may be left from an
+* earlier image; the CM4 also checks that the RPC server answers.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true if the marker is set
+*
+*******************************************************************************/
+bool ipc_shared_valid(void)
+{
+    return (ipc_shared.magic == IPC_SHARED_MAGIC);
+}
+
+/* [] END OF FILE */
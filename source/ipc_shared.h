@@ -0,0 +1,121 @@
+/******************************************************************************
+* File Name:   ipc_shared.h
+*
+* Description: This file contains the layout of the memory shared by the CM4 and
+*              the CM0+ core: the message rings between them, the rings of
+*              the console and the IPC resources of their doorbells. Both images place ipc_shared alone
+*              at the start of the .cy_sharedmem section, so it has the same
+*              address on both cores.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef IPC_SHARED_H
+#define IPC_SHARED_H
+
+#include "ipc_ring.h"
+#include "ipc_console_msg.h"
+#include "timebase.h"
+#include "trace.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set by the CM0+ once the rings are ready, before it starts the CM4 */
+#define IPC_SHARED_MAGIC            (0x49504352UL)
+
+/* Size of a message and number of messages of each ring */
+#define IPC_SHARED_MSG_SIZE         (32U)
+#define IPC_SHARED_SLOTS            (64U)
+
+/* IPC channel whose notify events are the doorbells. Its lock is not used. */
+#define IPC_RING_CHAN               (CY_IPC_CHAN_USER + 1U)
+
+/* IPC interrupt structures of the doorbells, routed to the CM0+ and the CM4 */
+#define IPC_RING_INTR_CM0P          (CY_IPC_INTR_USER + 1U)
+#define IPC_RING_INTR_CM4           (CY_IPC_INTR_USER + 2U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t magic;             /* IPC_SHARED_MAGIC once initialized */
+    ipc_ring_t to_cm0p;         /* Written by the CM4, read by the CM0+ */
+    ipc_ring_t to_cm4;          /* Written by the CM0+, read by the CM4 */
+    ipc_ring_t records;         /* Console output records, from the CM4 */
+    ipc_ring_t lines;           /* Console command lines, to the CM4 */
+    timebase_t timebase;        /* Written by the CM4, read by both */
+    trace_buf_t trace;          /* Trace buffer of the CM0+ */
+    uint8_t to_cm0p_slots[IPC_SHARED_SLOTS * IPC_SHARED_MSG_SIZE]
+        __attribute__((aligned(IPC_RING_LINE)));
+    uint8_t to_cm4_slots[IPC_SHARED_SLOTS * IPC_SHARED_MSG_SIZE]
+        __attribute__((aligned(IPC_RING_LINE)));
+    uint8_t record_slots[IPC_CONSOLE_RECORD_SLOTS * IPC_CONSOLE_RECORD_SIZE]
+        __attribute__((aligned(IPC_RING_LINE)));
+    uint8_t line_slots[IPC_CONSOLE_LINE_SLOTS * IPC_CONSOLE_LINE_SIZE]
+        __attribute__((aligned(IPC_RING_LINE)));
+    trace_record_t trace_records[TRACE_CM0P_RECORDS]
+        __attribute__((aligned(IPC_RING_LINE)));
+} ipc_shared_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+extern ipc_shared_t ipc_shared;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void ipc_shared_init(void);
+bool ipc_shared_valid(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* IPC_SHARED_H */
+
+/* [] END OF FILE */
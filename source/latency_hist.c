@@ -0,0 +1,158 @@
+/******************************************************************************
+* File Name:   latency_hist.c
+*
+* Description: This file contains the percentile estimate and the printout of
+*              the log2 bucketed latency histogram.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "cycle_counter.h"
+#include "latency_hist.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Function Name: latency_hist_reset
+********************************************************************************
+* Summary:
+* This function clears a histogram.
+*
+* Parameters:
+*  hist        Histogram to clear
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void latency_hist_reset(latency_hist_t *hist)
+{
+    memset(hist, 0, sizeof(*hist));
+}
+
+
+/*******************************************************************************
+* Function Name: latency_hist_percentile
+********************************************************************************
+* Summary:
+* This function returns an upper bound of a percentile: the upper edge of the
+* bucket that holds it, capped to the exact maximum. The estimate is at most
+* twice the real value.
+*
+* Parameters:
+*  hist        Histogram to evaluate
+*  permille    Percentile in tenths of a percent, 500 for p50, 990 for p99
+*
+* Return:
+*  uint32_t    Latency in cycle counter ticks, 0 if the histogram is empty
+*
+*******************************************************************************/
+uint32_t latency_hist_percentile(const latency_hist_t *hist, uint32_t permille)
+{
+    uint64_t rank;
+    uint64_t seen = 0U;
+    uint32_t bucket;
+    uint32_t upper;
+
+    if (hist->count == 0U)
+    {
+        return 0U;
+    }
+
+    /* Rank of the sample at the percentile, rounded up, at least 1 */
+    rank = (((uint64_t)hist->count * permille) + 999U) / 1000U;
+    if (rank == 0U)
+    {
+        rank = 1U;
+    }
+
+    for (bucket = 0U; bucket < LATENCY_HIST_BUCKETS; bucket++)
+    {
+        seen += hist->buckets[bucket];
+        if (seen >= rank)
+        {
+            break;
+        }
+    }
+
+    upper = (bucket >= 31U) ? UINT32_MAX : ((2UL << bucket) - 1UL);
+
+    return (upper < hist->max) ? upper : hist->max;
+}
+
+
+/*******************************************************************************
+* Function Name: latency_hist_print
+********************************************************************************
+* Summary:
+* This function prints the percentiles and the non-empty buckets of a
+* histogram to the debug UART.
+*
+* Parameters:
+*  hist        Histogram to print
+*  name        Label of the histogram
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void latency_hist_print(const latency_hist_t *hist, const char *name)
+{
+    uint32_t ticks_per_us = cycle_counter_per_us();
+    uint32_t bucket;
+
+    APP_LOG("%s: %lu samples, p50 <= %lu, p99 <= %lu, max %lu cycles "
+            "(%lu us)\r\n", name, (unsigned long)hist->count,
+            (unsigned long)latency_hist_percentile(hist, 500U),
+            (unsigned long)latency_hist_percentile(hist, 990U),
+            (unsigned long)hist->max,
+            (unsigned long)(hist->max / ticks_per_us));
+
+    for (bucket = 0U; bucket < LATENCY_HIST_BUCKETS; bucket++)
+    {
+        if (hist->buckets[bucket] != 0U)
+        {
+            APP_LOG("  < %10lu: %lu\r\n",
+                    (unsigned long)((bucket >= 31U) ? UINT32_MAX :
+                                    (2UL << bucket)),
+                    (unsigned long)hist->buckets[bucket]);
+        }
+    }
+}
+
+/* [] END OF FILE */
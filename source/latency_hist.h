@@ -0,0 +1,113 @@
+/******************************************************************************
+* File Name:   latency_hist.h
+*
+* Description: This file contains the declarations of the log2 bucketed latency
+*              histogram used to record how long events wait before they are
+*              serviced.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef LATENCY_HIST_H
+#define LATENCY_HIST_H
+
+#include <stdint.h>
+#include "cy_device_headers.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Bucket n holds latencies in [2^n, 2^(n+1)), bucket 0 also holds 0 */
+#define LATENCY_HIST_BUCKETS        (32U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t buckets[LATENCY_HIST_BUCKETS];
+    uint32_t count;             /* Number of recorded latencies */
+    uint32_t max;               /* Exact largest latency */
+} latency_hist_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void latency_hist_reset(latency_hist_t *hist);
+uint32_t latency_hist_percentile(const latency_hist_t *hist, uint32_t permille);
+void latency_hist_print(const latency_hist_t *hist, const char *name);
+
+
+/*******************************************************************************
+* Function Name: latency_hist_record
+********************************************************************************
+* Summary:
+* This function adds one latency to a histogram. The bucket is found with a
+* single CLZ instruction.
+*
+* Parameters:
+*  hist        Histogram to update
+*  latency     Latency in cycle counter ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void latency_hist_record(latency_hist_t *hist, uint32_t latency)
+{
+    hist->buckets[31U - __CLZ(latency | 1U)]++;
+    hist->count++;
+    if (latency > hist->max)
+    {
+        hist->max = latency;
+    }
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* LATENCY_HIST_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,578 @@
+/******************************************************************************
+* File Name:   led_blink.c
+*
+* Description: This file contains the user LED blink. A periodic soft timer
+*              toggles the GPIO, or in hardware mode a TCPWM PWM drives the pin
+*              without any CPU wakeups. The blink frequency and the LED on time
+*              can be changed while the LED keeps blinking.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "cybsp.h"
+#include "event_loop.h"
+#include "soft_timer.h"
+#include "pwm_tune.h"
+#include "timer_tune.h"
+#include "power_gov.h"
+#include "app_log.h"
+#include "led_blink.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Initial share of the PWM period the LED is on */
+#define LED_BLINK_PWM_ON_PERCENT          (50U)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static bool led_blink_active_flag = true;
+
+/* Soft timer object used for blinking the LED, and its tick rate */
+static soft_timer_t led_blink_timer;
+static uint32_t led_blink_tick_hz;
+
+/* PWM object and LED on time of the hardware blink mode */
+static led_blink_mode_t led_blink_mode = LED_BLINK_MODE_SOFTWARE;
+static cyhal_pwm_t led_blink_pwm;
+static pwm_tune_group_t led_blink_pwm_group;
+static uint32_t led_blink_on_percent = LED_BLINK_PWM_ON_PERCENT;
+
+/* Blink frequency, and the timer setting that produces it in the current
+ * mode. The soft timer period is half a blink. */
+static uint32_t led_blink_freq_mhz;
+static uint32_t led_blink_ticks;
+static timer_tune_t led_blink_tune;
+
+/* The blink PWM follows the changes of CLK_PERI by the power governor */
+static power_gov_notifier_t led_blink_notifier;
+
+/* Sleep count and time of the last wakeup report */
+static uint32_t wakeup_report_sleeps = 0;
+static uint32_t wakeup_report_ticks = 0;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void led_blink_callback(void *callback_arg);
+static void led_blink_start(void);
+static void led_blink_stop(void);
+static bool led_blink_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                   void *arg);
+
+
+/*******************************************************************************
+* Function Name: led_blink_init
+********************************************************************************
+* Summary:
+* This function creates the periodic soft timer that toggles the LED and
+* starts it, and registers the notifier that keeps the PWM blink in tune when
+* the power governor changes CLK_PERI. The soft timer service must have been
+* started.
+*
+* Parameters:
+*  tick_hz        Tick rate of the soft timers
+*  toggle_ticks   Initial time between two LED toggles, in ticks
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void led_blink_init(uint32_t tick_hz, uint32_t toggle_ticks)
+{
+    led_blink_tick_hz = tick_hz;
+
+    /* One blink spans the on and the off phase, two soft timer periods */
+    led_blink_freq_mhz = (uint32_t)((1000ULL * tick_hz) /
+                                    (2ULL * toggle_ticks));
+    led_blink_ticks = toggle_ticks;
+
+    /* Assign the function to execute on every LED blink period */
+    soft_timer_setup(&led_blink_timer, led_blink_callback, NULL);
+
+    /* Start the periodic LED blink timer */
+    (void)led_blink_set_frequency(led_blink_freq_mhz);
+    soft_timer_start(&led_blink_timer, led_blink_ticks, led_blink_ticks);
+
+    led_blink_notifier.name = "led_blink";
+    led_blink_notifier.callback = led_blink_clock_notify;
+    power_gov_register(&led_blink_notifier);
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_toggle
+********************************************************************************
+* Summary:
+* This function pauses or resumes the LED blinking. The shell calls it for
+* an empty line.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void led_blink_toggle(void)
+{
+    /* Pause LED blinking by stopping the timer or PWM */
+    if (led_blink_active_flag)
+    {
+        led_blink_stop();
+
+        APP_LOG("LED blinking paused \r\n");
+    }
+    else /* Resume LED blinking by starting the timer or PWM */
+    {
+        led_blink_start();
+
+        APP_LOG("LED blinking resumed\r\n");
+    }
+
+    led_blink_active_flag ^= 1;
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_is_active
+********************************************************************************
+* Summary:
+* This function tells whether the LED blinks or is paused.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true while the LED blinks
+*
+*******************************************************************************/
+bool led_blink_is_active(void)
+{
+    return led_blink_active_flag;
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_get_mode
+********************************************************************************
+* Summary:
+* This function returns how the LED blink is generated.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  led_blink_mode_t  Current blink mode
+*
+*******************************************************************************/
+led_blink_mode_t led_blink_get_mode(void)
+{
+    return led_blink_mode;
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_set_mode
+********************************************************************************
+* Summary:
+* This function switches the LED pin between the GPIO toggled by the soft
+* timer and the TCPWM PWM output. In hardware mode the blink needs no
+* interrupt at all, so the CPU only wakes for user input and housekeeping.
+* The wakeup rate of the mode being left is printed. If the PWM cannot be
+* set up, the software mode is restored.
+*
+* Parameters:
+*  mode        New blink mode
+*
+* Return:
+*  cy_rslt_t   Result of the PWM or GPIO initialization
+*
+*******************************************************************************/
+cy_rslt_t led_blink_set_mode(led_blink_mode_t mode)
+{
+    static cyhal_pwm_t *const pwms[] = { &led_blink_pwm };
+    static const cyhal_gpio_t pins[] = { CYBSP_USER_LED };
+    cy_rslt_t result;
+    cy_rslt_t gpio_result;
+
+    if (mode == led_blink_mode)
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    led_blink_print_wakeups();
+
+    if (led_blink_active_flag)
+    {
+        led_blink_stop();
+    }
+
+    if (mode == LED_BLINK_MODE_HARDWARE)
+    {
+        cyhal_gpio_free(CYBSP_USER_LED);
+
+        result = pwm_tune_init(&led_blink_pwm_group, pwms, pins, 1U);
+        if (result == CY_RSLT_SUCCESS)
+        {
+            led_blink_mode = LED_BLINK_MODE_HARDWARE;
+            result = led_blink_set_frequency(led_blink_freq_mhz);
+            if (result != CY_RSLT_SUCCESS)
+            {
+                pwm_tune_free(&led_blink_pwm_group);
+                led_blink_mode = LED_BLINK_MODE_SOFTWARE;
+            }
+        }
+    }
+    else
+    {
+        pwm_tune_free(&led_blink_pwm_group);
+        led_blink_mode = LED_BLINK_MODE_SOFTWARE;
+        result = CY_RSLT_SUCCESS;
+    }
+
+    /* Drive the pin from the GPIO again, as requested or after a PWM failure */
+    if (led_blink_mode == LED_BLINK_MODE_SOFTWARE)
+    {
+        gpio_result = cyhal_gpio_init(CYBSP_USER_LED, CYHAL_GPIO_DIR_OUTPUT,
+                                      CYHAL_GPIO_DRIVE_STRONG,
+                                      CYBSP_LED_STATE_OFF);
+        if (result == CY_RSLT_SUCCESS)
+        {
+            result = gpio_result;
+        }
+
+        (void)led_blink_set_frequency(led_blink_freq_mhz);
+    }
+
+    if (led_blink_active_flag)
+    {
+        led_blink_start();
+    }
+
+    APP_LOG("%s LED blink\r\n", (led_blink_mode == LED_BLINK_MODE_HARDWARE) ?
+            "Hardware (PWM)" : "Software (timer)");
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_set_on_percent
+********************************************************************************
+* Summary:
+* This function sets the share of the PWM period during which the LED is on.
+* The LED is active low, so the PWM pulse is the off phase.
+*
+* Parameters:
+*  on_percent  LED on time in percent of the period, 0 to 100
+*
+* Return:
+*  cy_rslt_t   Result of the PWM update, CY_RSLT_SUCCESS in software mode
+*
+*******************************************************************************/
+cy_rslt_t led_blink_set_on_percent(uint32_t on_percent)
+{
+    uint32_t pulse_permille;
+
+    led_blink_on_percent = (on_percent > 100U) ? 100U : on_percent;
+
+    if (led_blink_mode == LED_BLINK_MODE_HARDWARE)
+    {
+        pulse_permille = PWM_TUNE_PERMILLE - (led_blink_on_percent * 10U);
+        pwm_tune_apply(&led_blink_pwm_group, &led_blink_tune, &pulse_permille);
+
+        APP_LOG("LED on %lu%% of the time\r\n",
+                (unsigned long)led_blink_on_percent);
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_set_frequency
+********************************************************************************
+* Summary:
+* This function changes the LED blink frequency while the LED keeps blinking.
+* The best divider and period for the frequency are searched and the achieved
+* frequency is printed. The soft timer takes the new period at its next
+* expiry, the PWM at its next terminal count, so no blink is cut short or
+* stretched.
+*
+* Parameters:
+*  freq_mhz    Blink frequency in millihertz
+*
+* Return:
+*  cy_rslt_t   TIMER_TUNE_RSLT_ERR_RANGE if the frequency cannot be reached
+*
+*******************************************************************************/
+cy_rslt_t led_blink_set_frequency(uint32_t freq_mhz)
+{
+    cy_rslt_t result;
+    timer_tune_t tune;
+    uint32_t pulse_permille;
+
+    if (led_blink_mode == LED_BLINK_MODE_HARDWARE)
+    {
+        result = pwm_tune_solve(&led_blink_pwm_group, freq_mhz, &tune);
+    }
+    else
+    {
+        /* The soft timers share one clock, only the period is free */
+        result = timer_tune_solve(led_blink_tick_hz, 2U * freq_mhz, 1U,
+                                  SOFT_TIMER_MAX_DELAY, &tune);
+    }
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    led_blink_freq_mhz = freq_mhz;
+    led_blink_tune = tune;
+
+    if (led_blink_mode == LED_BLINK_MODE_HARDWARE)
+    {
+        pulse_permille = PWM_TUNE_PERMILLE - (led_blink_on_percent * 10U);
+        pwm_tune_apply(&led_blink_pwm_group, &tune, &pulse_permille);
+        timer_tune_print(&tune, "LED blink");
+    }
+    else
+    {
+        led_blink_ticks = tune.period;
+        soft_timer_set_period(&led_blink_timer, tune.period);
+        timer_tune_print(&tune, "LED toggle");
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_print_frequency
+********************************************************************************
+* Summary:
+* This function prints the divider and period of the current blink frequency
+* and the frequency they achieve.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void led_blink_print_frequency(void)
+{
+    timer_tune_print(&led_blink_tune,
+                     (led_blink_mode == LED_BLINK_MODE_HARDWARE) ?
+                     "LED blink" : "LED toggle");
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_print_wakeups
+********************************************************************************
+* Summary:
+* This function prints how often the CPU woke from sleep since the last report
+* and starts a new measurement. Printing itself causes a few wakeups for the
+* UART transmit DMA.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void led_blink_print_wakeups(void)
+{
+    event_loop_stats_t stats;
+    uint32_t now = soft_timer_now();
+    uint32_t ticks = now - wakeup_report_ticks;
+    uint32_t wakeups;
+    uint32_t rate;
+
+    event_loop_get_stats(&stats);
+    wakeups = stats.sleeps - wakeup_report_sleeps;
+
+    if (ticks != 0U)
+    {
+        /* Wakeups per 1000 s */
+        rate = (uint32_t)(((uint64_t)wakeups * led_blink_tick_hz *
+                           1000U) / ticks);
+
+        APP_LOG("%s blink: %lu wakeups in %lu ms, %lu.%03lu per second\r\n",
+                (led_blink_mode == LED_BLINK_MODE_HARDWARE) ? "Hardware" :
+                "Software", (unsigned long)wakeups,
+                (unsigned long)(((uint64_t)ticks * 1000U) /
+                                led_blink_tick_hz),
+                (unsigned long)(rate / 1000U), (unsigned long)(rate % 1000U));
+    }
+
+    wakeup_report_sleeps = stats.sleeps;
+    wakeup_report_ticks = now;
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_callback
+********************************************************************************
+* Summary:
+* This function runs from the event loop every time the LED blink soft timer
+* expires and toggles the LED.
+*
+* Parameters:
+*  callback_arg    Argument registered with the soft timer, not used
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void led_blink_callback(void *callback_arg)
+{
+    (void) callback_arg;
+
+    /* Invert the USER LED state */
+    cyhal_gpio_toggle(CYBSP_USER_LED);
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_start
+********************************************************************************
+* Summary:
+* This function starts the LED blink in the current mode.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void led_blink_start(void)
+{
+    if (led_blink_mode == LED_BLINK_MODE_HARDWARE)
+    {
+        (void)pwm_tune_start(&led_blink_pwm_group);
+    }
+    else
+    {
+        soft_timer_start(&led_blink_timer, led_blink_ticks, led_blink_ticks);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_stop
+********************************************************************************
+* Summary:
+* This function stops the LED blink in the current mode.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void led_blink_stop(void)
+{
+    if (led_blink_mode == LED_BLINK_MODE_HARDWARE)
+    {
+        (void)pwm_tune_stop(&led_blink_pwm_group);
+    }
+    else
+    {
+        soft_timer_stop(&led_blink_timer);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: led_blink_clock_notify
+********************************************************************************
+* Summary:
+* This function is the notifier of the power governor. The PWM of the
+* hardware blink mode is tuned again for the new CLK_PERI, without the print
+* of led_blink_set_frequency(); it takes the new divider and period at its
+* next terminal count. The soft timer blink needs nothing, the soft timers
+* keep their tick rate.
+*
+* Parameters:
+*  phase       POWER_GOV_CHECK or POWER_GOV_CHANGED
+*  peri_hz     CLK_PERI of the new operating point, not used
+*  arg         Not used
+*
+* Return:
+*  bool        true, or false if the blink frequency is out of reach
+*
+*******************************************************************************/
+static bool led_blink_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                   void *arg)
+{
+    timer_tune_t tune;
+    uint32_t pulse_permille;
+
+    (void)peri_hz;
+    (void)arg;
+
+    if ((phase == POWER_GOV_CHECK) ||
+        (led_blink_mode != LED_BLINK_MODE_HARDWARE))
+    {
+        return true;
+    }
+
+    if (pwm_tune_solve(&led_blink_pwm_group, led_blink_freq_mhz, &tune) !=
+        CY_RSLT_SUCCESS)
+    {
+        return false;
+    }
+
+    led_blink_tune = tune;
+    pulse_permille = PWM_TUNE_PERMILLE - (led_blink_on_percent * 10U);
+    pwm_tune_apply(&led_blink_pwm_group, &tune, &pulse_permille);
+
+    return true;
+}
+
+/* [] END OF FILE */
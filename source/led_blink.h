@@ -0,0 +1,86 @@
+/******************************************************************************
+* File Name:   led_blink.h
+*
+* Description: This file contains the interface of the user LED blink, toggled
+*              by a soft timer or driven by a TCPWM PWM.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef LED_BLINK_H
+#define LED_BLINK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* How the LED blink is generated */
+typedef enum
+{
+    LED_BLINK_MODE_SOFTWARE,    /* Soft timer callback toggles the GPIO */
+    LED_BLINK_MODE_HARDWARE     /* TCPWM PWM drives the pin, no CPU wakeups */
+} led_blink_mode_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void led_blink_init(uint32_t tick_hz, uint32_t toggle_ticks);
+void led_blink_toggle(void);
+bool led_blink_is_active(void);
+led_blink_mode_t led_blink_get_mode(void);
+cy_rslt_t led_blink_set_mode(led_blink_mode_t mode);
+cy_rslt_t led_blink_set_on_percent(uint32_t on_percent);
+cy_rslt_t led_blink_set_frequency(uint32_t freq_mhz);
+void led_blink_print_frequency(void);
+void led_blink_print_wakeups(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* LED_BLINK_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,265 @@
+/******************************************************************************
+* File Name:   led_blink_cmd.c
+*
+* Description: This file contains the shell commands of the user LED blink.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "shell.h"
+#include "led_blink.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Function Name: command_blink
+********************************************************************************
+* Summary:
+* This function is the 'blink' command: 'on' resumes and 'off' pauses the LED
+* blinking, no argument toggles it.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument
+*
+*******************************************************************************/
+int command_blink(int argc, char *argv[])
+{
+    if (argc == 1)
+    {
+        led_blink_toggle();
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "on") == 0))
+    {
+        if (!led_blink_is_active())
+        {
+            led_blink_toggle();
+        }
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "off") == 0))
+    {
+        if (led_blink_is_active())
+        {
+            led_blink_toggle();
+        }
+    }
+    else
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: command_mode
+********************************************************************************
+* Summary:
+* This function is the 'mode' command: 'sw' blinks the LED from the soft
+* timer and 'hw' from the PWM, no argument switches the mode.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument
+*
+*******************************************************************************/
+int command_mode(int argc, char *argv[])
+{
+    led_blink_mode_t mode;
+
+    if (argc == 1)
+    {
+        mode = (led_blink_get_mode() == LED_BLINK_MODE_SOFTWARE) ?
+               LED_BLINK_MODE_HARDWARE : LED_BLINK_MODE_SOFTWARE;
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "sw") == 0))
+    {
+        mode = LED_BLINK_MODE_SOFTWARE;
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "hw") == 0))
+    {
+        mode = LED_BLINK_MODE_HARDWARE;
+    }
+    else
+    {
+        return 1;
+    }
+
+    if (led_blink_set_mode(mode) != CY_RSLT_SUCCESS)
+    {
+        APP_LOG("LED PWM not available\r\n");
+    }
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: command_duty
+********************************************************************************
+* Summary:
+* This function is the 'duty' command. It sets the share of the PWM period
+* during which the LED is on, in percent.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 if the argument is not a number from 0 to 100
+*
+*******************************************************************************/
+int command_duty(int argc, char *argv[])
+{
+    unsigned long on_percent;
+    char *end;
+
+    if (argc != 2)
+    {
+        return 1;
+    }
+
+    on_percent = strtoul(argv[1], &end, 10);
+    if ((end == argv[1]) || (*end != '\0') || (on_percent > 100U))
+    {
+        return 1;
+    }
+
+    (void)led_blink_set_on_percent((uint32_t)on_percent);
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: command_freq
+********************************************************************************
+* Summary:
+* This function is the 'freq' command. It sets the LED blink frequency in Hz,
+* with up to three decimals, and prints the frequency the timer achieves.
+* Without an argument it prints the current setting.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 if the argument is not a positive number
+*
+*******************************************************************************/
+int command_freq(int argc, char *argv[])
+{
+    unsigned long freq_mhz;
+    unsigned long scale = 1000U;
+    char *end;
+
+    if (argc == 1)
+    {
+        led_blink_print_frequency();
+        return 0;
+    }
+    if (argc != 2)
+    {
+        return 1;
+    }
+
+    freq_mhz = strtoul(argv[1], &end, 10);
+    if ((end == argv[1]) || (freq_mhz > (UINT32_MAX / 2000U)))
+    {
+        return 1;
+    }
+    freq_mhz *= 1000U;
+
+    if (*end == '.')
+    {
+        end++;
+        while ((*end >= '0') && (*end <= '9') && (scale > 1U))
+        {
+            scale /= 10U;
+            freq_mhz += (unsigned long)(*end - '0') * scale;
+            end++;
+        }
+    }
+    if ((*end != '\0') || (freq_mhz == 0U))
+    {
+        return 1;
+    }
+
+    if (led_blink_set_frequency((uint32_t)freq_mhz) != CY_RSLT_SUCCESS)
+    {
+        APP_LOG("Frequency out of range\r\n");
+    }
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: command_wakeups
+********************************************************************************
+* Summary:
+* This function is the 'wakeups' command. It prints the wakeup rate since the
+* last report.
+*
+* Parameters:
+*  argc        Number of arguments, not used
+*  argv        Arguments, not used
+*
+* Return:
+*  int         0
+*
+*******************************************************************************/
+int command_wakeups(int argc, char *argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    led_blink_print_wakeups();
+
+    return 0;
+}
+
+/* [] END OF FILE */
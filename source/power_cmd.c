@@ -0,0 +1,233 @@
+/******************************************************************************
+* File Name:   power_cmd.c
+*
+* Description: This file contains the shell commands of the idle manager, of the
+*              power state accounting and of the SysPm handler timing of the
+*              BSP.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "cybsp.h"
+#include "shell.h"
+#include "idle.h"
+#include "power_stats.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void print_pm_us(uint32_t ns);
+
+
+/*******************************************************************************
+* Function Name: command_idle
+********************************************************************************
+* Summary:
+* This function is the 'idle' command. It prints how often the system
+* entered Deep Sleep and the measured wakeup latency.
+*
+* Parameters:
+*  argc        Number of arguments, not used
+*  argv        Arguments, not used
+*
+* Return:
+*  int         0
+*
+*******************************************************************************/
+int command_idle(int argc, char *argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    idle_print_stats();
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: command_power
+********************************************************************************
+* Summary:
+* This function is the 'power' command. It prints the time spent in each
+* power state and the wakeups by source, clears them with 'reset', or
+* prints them as a hex encoded binary record for tools/power_model.py with
+* 'record'.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument
+*
+*******************************************************************************/
+int command_power(int argc, char *argv[])
+{
+    power_stats_t stats;
+    uint8_t record[POWER_STATS_RECORD_SIZE];
+    uint32_t index;
+
+    if (argc == 1)
+    {
+        power_stats_print();
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "reset") == 0))
+    {
+        power_stats_reset();
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "record") == 0))
+    {
+        power_stats_get(&stats);
+        power_stats_record(&stats, record);
+
+        APP_LOG("power record: ");
+        /* The record is made of 32 bit words */
+        for (index = 0U; index < POWER_STATS_RECORD_SIZE; index += 4U)
+        {
+            APP_LOG("%02x%02x%02x%02x", record[index], record[index + 1U],
+                    record[index + 2U], record[index + 3U]);
+        }
+        APP_LOG("\r\n");
+    }
+    else
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: print_pm_us
+********************************************************************************
+* Summary:
+* This function prints a run time of the 'pm' table in us.
+*
+* Parameters:
+*  ns          Run time in ns
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void print_pm_us(uint32_t ns)
+{
+    APP_LOG(" %6lu.%03lu", (unsigned long)(ns / 1000U),
+            (unsigned long)(ns % 1000U));
+}
+
+
+/*******************************************************************************
+* Function Name: command_pm
+********************************************************************************
+* Summary:
+* This function is the 'pm' command. It prints the longest run time of each
+* SysPm handler registered with the BSP in every phase of a transition, and
+* the worst-case time of the Sleep and Deep Sleep entry and exit paths, or
+* clears them with 'reset'.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument
+*
+*******************************************************************************/
+int command_pm(int argc, char *argv[])
+{
+    static const cy_en_syspm_callback_type_t types[] =
+    {
+        CY_SYSPM_SLEEP, CY_SYSPM_DEEPSLEEP
+    };
+    static const char *const type_names[] = { "Sleep", "Deep Sleep" };
+    const cybsp_pm_handler_t *handler;
+    uint32_t entry_ns;
+    uint32_t exit_ns;
+    uint32_t index;
+
+    if ((argc == 2) && (strcmp(argv[1], "reset") == 0))
+    {
+        cybsp_pm_reset();
+        return 0;
+    }
+    else if (argc != 1)
+    {
+        return 1;
+    }
+
+    APP_LOG("SysPm handlers, longest run time in us\r\n");
+    APP_LOG("  handler  mode          calls      check      entry       exit"
+            "\r\n");
+    for (index = 0U; index < (sizeof(types) / sizeof(types[0])); index++)
+    {
+        for (handler = cybsp_pm_next(NULL); handler != NULL;
+             handler = cybsp_pm_next(handler))
+        {
+            if (handler->type != types[index])
+            {
+                continue;
+            }
+
+            APP_LOG("  %-8s %-10s %8lu", handler->name, type_names[index],
+                    (unsigned long)handler->timing[CYBSP_PM_PHASE_ENTRY].count);
+            print_pm_us(handler->timing[CYBSP_PM_PHASE_CHECK].max_ns);
+            print_pm_us(handler->timing[CYBSP_PM_PHASE_ENTRY].max_ns);
+            print_pm_us(handler->timing[CYBSP_PM_PHASE_EXIT].max_ns);
+            APP_LOG("\r\n");
+        }
+    }
+
+    for (index = 0U; index < (sizeof(types) / sizeof(types[0])); index++)
+    {
+        cybsp_pm_budget(types[index], &entry_ns, &exit_ns);
+        APP_LOG("%s budget: entry %lu.%03lu us, exit %lu.%03lu us\r\n",
+                type_names[index], (unsigned long)(entry_ns / 1000U),
+                (unsigned long)(entry_ns % 1000U),
+                (unsigned long)(exit_ns / 1000U),
+                (unsigned long)(exit_ns % 1000U));
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
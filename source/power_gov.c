@@ -0,0 +1,740 @@
+/******************************************************************************
+* File Name:   power_gov.c
+*
+* Description: This file contains the power governor. The event loop reports the
+*              time it spends idle; over a sliding window of POWER_GOV_SLOTS
+*              slots the governor drops from LP to a ULP operating point when
+*              the system is nearly idle and returns to LP as soon as a slot is
+*              busy. Each change is approved by the registered notifiers,
+*              applied by power_gov_clk.c and followed by the notifiers, and its
+*              cost is measured.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "power_gov.h"
+#include "timebase.h"
+#include "timer_cfg.h"
+#include "cycle_counter.h"
+#include "trace.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Percentages are computed and printed with one decimal */
+#define POWER_GOV_PERMILLE          (1000ULL)
+
+#define POWER_GOV_MS_PER_S          (1000UL)
+#define POWER_GOV_NS_PER_US         (1000UL)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Operating points. ULP runs the FLL at 50 MHz rather than 100 MHz with a
+ * divided CLK_HF0: the FLL output itself is limited in ULP, and a slower FLL
+ * draws less. */
+static const power_gov_cfg_t power_gov_cfgs[POWER_GOV_POINT_COUNT] =
+{
+    { "lp",    false, 100000000UL, 1U, 1U },
+    { "ulp50", true,   50000000UL, 1U, 2U },
+    { "ulp25", true,   50000000UL, 2U, 1U },
+    { "ulp12", true,   50000000UL, 4U, 1U }
+};
+
+/* Registered notifiers, in registration order */
+static power_gov_notifier_t *power_gov_first = NULL;
+static power_gov_notifier_t *power_gov_last = NULL;
+
+/* Set by power_gov_init(), the idle hooks do nothing before */
+static bool power_gov_started = false;
+
+/* Point the governor drops to when idle */
+static power_gov_point_t power_gov_idle_point = POWER_GOV_ULP50;
+
+/* Utilization window, in ticks of the timebase. The slot being filled starts
+ * at 'slot_start'; the time up to 'mark' has been accounted, as busy unless
+ * the event loop was idle. */
+static uint32_t power_gov_busy[POWER_GOV_SLOTS];
+static uint32_t power_gov_slot;
+static uint32_t power_gov_filled;
+static uint64_t power_gov_slot_start;
+static uint64_t power_gov_mark;
+static uint32_t power_gov_slot_busy;
+static bool power_gov_idle = false;
+
+/* Set when a slot has been closed since the last power_gov_poll() */
+static volatile bool power_gov_slot_closed = false;
+
+/* Start of the residency in the current point */
+static uint64_t power_gov_since;
+
+static power_gov_stats_t power_gov_stats;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t power_gov_slot_ticks(void);
+static void power_gov_advance(uint64_t now, bool idle);
+static void power_gov_restart_window(void);
+static cy_rslt_t power_gov_change(power_gov_point_t point);
+
+
+/*******************************************************************************
+* Function Name: power_gov_init
+********************************************************************************
+* Summary:
+* This function saves the boot clock configuration and starts measuring the
+* utilization. The system stays in LP until the first window is complete.
+* The timebase must be running.
+*
+* Parameters:
+*  idle_point  ULP point to drop to when idle
+*
+* Return:
+*  cy_rslt_t   Result of power_gov_clk_init()
+*
+*******************************************************************************/
+cy_rslt_t power_gov_init(power_gov_point_t idle_point)
+{
+    cy_rslt_t result;
+
+    CY_ASSERT((idle_point > POWER_GOV_LP) &&
+              (idle_point < POWER_GOV_POINT_COUNT));
+
+    result = power_gov_clk_init();
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        (void)memset(&power_gov_stats, 0, sizeof(power_gov_stats));
+        power_gov_stats.point = POWER_GOV_LP;
+        power_gov_idle_point = idle_point;
+        power_gov_since = timebase_now();
+        power_gov_restart_window();
+        power_gov_started = true;
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_register
+********************************************************************************
+* Summary:
+* This function adds the notifier of a driver. It may be called before
+* power_gov_init(), from the init function of the driver. Notifiers are
+* called in registration order in both phases.
+*
+* Parameters:
+*  notifier    Notifier with name, callback and arg filled in
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_gov_register(power_gov_notifier_t *notifier)
+{
+    notifier->next = NULL;
+
+    if (power_gov_last == NULL)
+    {
+        power_gov_first = notifier;
+    }
+    else
+    {
+        power_gov_last->next = notifier;
+    }
+    power_gov_last = notifier;
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_idle_begin
+********************************************************************************
+* Summary:
+* This function is called by the event loop, in its critical section, right
+* before the CPU goes to sleep. The time up to now was busy.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_gov_idle_begin(void)
+{
+    if (power_gov_started)
+    {
+        power_gov_advance(timebase_now(), false);
+        power_gov_idle = true;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_idle_end
+********************************************************************************
+* Summary:
+* This function is called by the event loop, in its critical section, right
+* after the CPU has woken up. The time up to now was idle.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_gov_idle_end(void)
+{
+    if (power_gov_started)
+    {
+        power_gov_advance(timebase_now(), true);
+        power_gov_idle = false;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_poll
+********************************************************************************
+* Summary:
+* This function is called by the event loop on every pass, with interrupts
+* enabled. Once a slot is complete it applies the rule: from LP, drop to the
+* idle point when the whole window was busy for less than
+* POWER_GOV_ULP_PERCENT; from ULP, return to LP when the last slot was busy
+* for more than POWER_GOV_LP_PERCENT. After a change, or a refused one, the
+* window starts over.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_gov_poll(void)
+{
+    uint32_t state;
+    uint32_t slot_ticks;
+    uint64_t busy = 0U;
+    uint32_t last;
+    uint32_t index;
+
+    if (!power_gov_started || !power_gov_slot_closed)
+    {
+        return;
+    }
+
+    state = cyhal_system_critical_section_enter();
+    power_gov_slot_closed = false;
+    power_gov_advance(timebase_now(), false);
+    slot_ticks = power_gov_slot_ticks();
+    for (index = 0U; index < POWER_GOV_SLOTS; index++)
+    {
+        busy += power_gov_busy[index];
+    }
+    last = power_gov_busy[(power_gov_slot + POWER_GOV_SLOTS - 1U) %
+                          POWER_GOV_SLOTS];
+    power_gov_stats.busy_permille =
+        (uint32_t)((busy * POWER_GOV_PERMILLE) /
+                   ((uint64_t)slot_ticks * POWER_GOV_SLOTS));
+    cyhal_system_critical_section_exit(state);
+
+    if (power_gov_stats.pinned)
+    {
+        return;
+    }
+
+    if (power_gov_stats.point == POWER_GOV_LP)
+    {
+        if ((power_gov_filled >= POWER_GOV_SLOTS) &&
+            (power_gov_stats.busy_permille < (POWER_GOV_ULP_PERCENT * 10U)))
+        {
+            (void)power_gov_change(power_gov_idle_point);
+            power_gov_restart_window();
+        }
+    }
+    else if (((uint64_t)last * POWER_GOV_PERMILLE) >
+             ((uint64_t)slot_ticks * POWER_GOV_LP_PERCENT * 10U))
+    {
+        (void)power_gov_change(POWER_GOV_LP);
+        power_gov_restart_window();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_pin
+********************************************************************************
+* Summary:
+* This function changes to an operating point and keeps it until
+* power_gov_release(). It must not be called from an interrupt.
+*
+* Parameters:
+*  point       Operating point
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, POWER_GOV_RSLT_ERR_REFUSED or
+*              POWER_GOV_RSLT_ERR_CLOCK; the point is pinned either way
+*
+*******************************************************************************/
+cy_rslt_t power_gov_pin(power_gov_point_t point)
+{
+    CY_ASSERT(point < POWER_GOV_POINT_COUNT);
+
+    power_gov_stats.pinned = true;
+
+    return power_gov_change(point);
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_release
+********************************************************************************
+* Summary:
+* This function hands the operating point back to the governor, which
+* decides again once a window is complete.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_gov_release(void)
+{
+    power_gov_stats.pinned = false;
+    power_gov_restart_window();
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_cfg
+********************************************************************************
+* Summary:
+* This function returns the clock tree of an operating point.
+*
+* Parameters:
+*  point       Operating point
+*
+* Return:
+*  const power_gov_cfg_t *   Clock tree
+*
+*******************************************************************************/
+const power_gov_cfg_t *power_gov_cfg(power_gov_point_t point)
+{
+    CY_ASSERT(point < POWER_GOV_POINT_COUNT);
+
+    return &power_gov_cfgs[point];
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_find
+********************************************************************************
+* Summary:
+* This function looks up an operating point by name.
+*
+* Parameters:
+*  name        Name of the point, e.g. "ulp25"
+*
+* Return:
+*  power_gov_point_t   The point, POWER_GOV_POINT_COUNT if none has the name
+*
+*******************************************************************************/
+power_gov_point_t power_gov_find(const char *name)
+{
+    uint32_t index;
+
+    for (index = 0U; index < (uint32_t)POWER_GOV_POINT_COUNT; index++)
+    {
+        if (strcmp(power_gov_cfgs[index].name, name) == 0)
+        {
+            break;
+        }
+    }
+
+    return (power_gov_point_t)index;
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_peri_hz
+********************************************************************************
+* Summary:
+* This function returns CLK_PERI of an operating point, the clock of the
+* peripheral dividers.
+*
+* Parameters:
+*  cfg         Clock tree
+*
+* Return:
+*  uint32_t    Frequency in Hz
+*
+*******************************************************************************/
+uint32_t power_gov_peri_hz(const power_gov_cfg_t *cfg)
+{
+    return cfg->fll_hz / (cfg->hf0_div * cfg->peri_div);
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_get_stats
+********************************************************************************
+* Summary:
+* This function returns a snapshot of the governor state. The residency of
+* the current point includes the time up to now.
+*
+* Parameters:
+*  stats       Location to store the state
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_gov_get_stats(power_gov_stats_t *stats)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+
+    *stats = power_gov_stats;
+    if (power_gov_started)
+    {
+        stats->points[stats->point].time_ticks += timebase_now() -
+                                                   power_gov_since;
+    }
+
+    cyhal_system_critical_section_exit(state);
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_print_stats
+********************************************************************************
+* Summary:
+* This function prints the current point, the utilization of the window and
+* the residency and change cost of each point.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_gov_print_stats(void)
+{
+    power_gov_stats_t stats;
+    const power_gov_cfg_t *cfg;
+    const power_gov_point_stats_t *point;
+    uint64_t total = 0U;
+    uint32_t hz = timebase_frequency();
+    uint32_t ms;
+    uint32_t permille;
+    uint32_t index;
+
+    if (!power_gov_started)
+    {
+        APP_LOG("Power governor: not running\r\n");
+        return;
+    }
+
+    power_gov_get_stats(&stats);
+
+    APP_LOG("Point %s (%s), window busy %lu.%lu %%, ",
+            power_gov_cfgs[stats.point].name,
+            stats.pinned ? "pinned" : "auto",
+            (unsigned long)(stats.busy_permille / 10U),
+            (unsigned long)(stats.busy_permille % 10U));
+    APP_LOG("refused %lu%s%s, failed %lu\r\n",
+            (unsigned long)stats.refused,
+            (stats.refused_by != NULL) ? " by " : "",
+            (stats.refused_by != NULL) ? stats.refused_by : "",
+            (unsigned long)stats.failed);
+
+    for (index = 0U; index < (uint32_t)POWER_GOV_POINT_COUNT; index++)
+    {
+        total += stats.points[index].time_ticks;
+    }
+
+    APP_LOG("Point      CLK_HF0    time s   share  entries   last us    max us"
+            "  clock us\r\n");
+    for (index = 0U; index < (uint32_t)POWER_GOV_POINT_COUNT; index++)
+    {
+        cfg = &power_gov_cfgs[index];
+        point = &stats.points[index];
+        ms = (hz == 0U) ? 0U :
+             (uint32_t)((point->time_ticks * POWER_GOV_MS_PER_S) / hz);
+        permille = (total == 0U) ? 0U :
+                   (uint32_t)((point->time_ticks * POWER_GOV_PERMILLE) /
+                              total);
+        /* Two log calls, as one takes at most APP_LOG_MAX_ARGS arguments */
+        APP_LOG("%-6s %5lu.%lu MHz %5lu.%03lu %3lu.%lu %% ",
+                cfg->name,
+                (unsigned long)(cfg->fll_hz / cfg->hf0_div / 1000000UL),
+                (unsigned long)((cfg->fll_hz / cfg->hf0_div / 100000UL) % 10UL),
+                (unsigned long)(ms / POWER_GOV_MS_PER_S),
+                (unsigned long)(ms % POWER_GOV_MS_PER_S),
+                (unsigned long)(permille / 10U),
+                (unsigned long)(permille % 10U));
+        APP_LOG("%8lu %9lu %9lu %9lu\r\n",
+                (unsigned long)point->entries,
+                (unsigned long)(point->last_ns / POWER_GOV_NS_PER_US),
+                (unsigned long)(point->max_ns / POWER_GOV_NS_PER_US),
+                (unsigned long)(point->clock_ns / POWER_GOV_NS_PER_US));
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_slot_ticks
+********************************************************************************
+* Summary:
+* This function returns the length of a slot in ticks of the timebase.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    Ticks per slot
+*
+*******************************************************************************/
+static uint32_t power_gov_slot_ticks(void)
+{
+    return (uint32_t)(((uint64_t)timebase_frequency() * POWER_GOV_SLOT_MS) /
+                      POWER_GOV_MS_PER_S);
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_advance
+********************************************************************************
+* Summary:
+* This function accounts the time from the mark up to now, closing the
+* slots that end on the way. A whole window or more in one piece, a long
+* Deep Sleep, fills every slot at once. It runs with interrupts disabled.
+*
+* Parameters:
+*  now         Count of the timebase
+*  idle        true if the event loop was idle since the mark
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void power_gov_advance(uint64_t now, bool idle)
+{
+    uint32_t slot_ticks = power_gov_slot_ticks();
+    uint64_t slot_end;
+    uint32_t index;
+
+    if ((now - power_gov_slot_start) >=
+        ((uint64_t)slot_ticks * (POWER_GOV_SLOTS + 1U)))
+    {
+        for (index = 0U; index < POWER_GOV_SLOTS; index++)
+        {
+            power_gov_busy[index] = idle ? 0U : slot_ticks;
+        }
+        power_gov_filled = POWER_GOV_SLOTS;
+        power_gov_slot_start = now -
+                               ((now - power_gov_slot_start) % slot_ticks);
+        power_gov_mark = power_gov_slot_start;
+        power_gov_slot_busy = 0U;
+        power_gov_slot_closed = true;
+    }
+
+    while (now >= (slot_end = power_gov_slot_start + slot_ticks))
+    {
+        if (!idle)
+        {
+            power_gov_slot_busy += (uint32_t)(slot_end - power_gov_mark);
+        }
+        power_gov_busy[power_gov_slot] = power_gov_slot_busy;
+        power_gov_slot = (power_gov_slot + 1U) % POWER_GOV_SLOTS;
+        if (power_gov_filled < POWER_GOV_SLOTS)
+        {
+            power_gov_filled++;
+        }
+        power_gov_slot_start = slot_end;
+        power_gov_mark = slot_end;
+        power_gov_slot_busy = 0U;
+        power_gov_slot_closed = true;
+    }
+
+    if (!idle)
+    {
+        power_gov_slot_busy += (uint32_t)(now - power_gov_mark);
+    }
+    power_gov_mark = now;
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_restart_window
+********************************************************************************
+* Summary:
+* This function empties the window. The next decision to drop to ULP waits
+* for a complete one.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void power_gov_restart_window(void)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+
+    (void)memset(power_gov_busy, 0, sizeof(power_gov_busy));
+    power_gov_slot = 0U;
+    power_gov_filled = 0U;
+    power_gov_slot_start = timebase_now();
+    power_gov_mark = power_gov_slot_start;
+    power_gov_slot_busy = 0U;
+
+    cyhal_system_critical_section_exit(state);
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_change
+********************************************************************************
+* Summary:
+* This function changes the operating point. The notifiers approve it first,
+* with interrupts enabled, so that a driver can wait for its transfer to
+* end. The clocks are then changed and the notifiers called again in one
+* critical section, so that no interrupt sees a peripheral clocked for the
+* old point. The cost is the clock change, measured by power_gov_clk_apply(),
+* plus the notifiers, measured on the cycle counter at the new clock.
+*
+* The timebase counts at the wrong rate from the clock change until its
+* notifier has run. The time it lost is added from the measured cost; time
+* it gained, when CLK_PERI got faster, is kept, as the timebase never goes
+* back.
+*
+* Parameters:
+*  point       Operating point
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, POWER_GOV_RSLT_ERR_REFUSED or
+*              POWER_GOV_RSLT_ERR_CLOCK
+*
+*******************************************************************************/
+static cy_rslt_t power_gov_change(power_gov_point_t point)
+{
+    const power_gov_cfg_t *from = &power_gov_cfgs[power_gov_stats.point];
+    const power_gov_cfg_t *to = &power_gov_cfgs[point];
+    uint32_t peri_hz = power_gov_peri_hz(to);
+    power_gov_point_stats_t *stats = &power_gov_stats.points[point];
+    power_gov_notifier_t *notifier;
+    cy_rslt_t result;
+    uint32_t state;
+    uint32_t start;
+    uint32_t clock_ns;
+    uint32_t total_ns;
+    uint64_t now;
+
+    if (!power_gov_started || (point == power_gov_stats.point))
+    {
+        return CY_RSLT_SUCCESS;
+    }
+
+    for (notifier = power_gov_first; notifier != NULL;
+         notifier = notifier->next)
+    {
+        if (!notifier->callback(POWER_GOV_CHECK, peri_hz, notifier->arg))
+        {
+            power_gov_stats.refused++;
+            power_gov_stats.refused_by = notifier->name;
+            return POWER_GOV_RSLT_ERR_REFUSED;
+        }
+    }
+
+    state = cyhal_system_critical_section_enter();
+    now = timebase_now();
+    result = power_gov_clk_apply(from, to, &clock_ns);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        start = cycle_counter_read();
+        for (notifier = power_gov_first; notifier != NULL;
+             notifier = notifier->next)
+        {
+            (void)notifier->callback(POWER_GOV_CHANGED, peri_hz, notifier->arg);
+        }
+        total_ns = clock_ns +
+                   (uint32_t)(((uint64_t)(cycle_counter_read() - start) *
+                               POWER_GOV_NS_PER_US) / cycle_counter_per_us());
+
+        timebase_advance(now, ((uint64_t)total_ns * timebase_frequency()) /
+                              TIMER_CFG_NS_PER_S);
+
+        power_gov_stats.points[power_gov_stats.point].time_ticks +=
+            now - power_gov_since;
+        power_gov_since = now;
+        power_gov_stats.point = point;
+
+        stats->entries++;
+        stats->last_ns = total_ns;
+        stats->clock_ns = clock_ns;
+        if (total_ns > stats->max_ns)
+        {
+            stats->max_ns = total_ns;
+        }
+    }
+    else
+    {
+        power_gov_stats.failed++;
+    }
+
+    cyhal_system_critical_section_exit(state);
+
+    TRACE_MARK("power_gov", power_gov_stats.point);
+
+    return result;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,184 @@
+/******************************************************************************
+* File Name:   power_gov.h
+*
+* Description: This file contains the public interface of the power governor,
+*              which measures the utilization of the main loop and moves the
+*              system between the LP and the ULP power mode with a reduced
+*              CLK_HF0. Drivers whose settings depend on CLK_PERI register a
+*              notifier to approve and follow each change.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef POWER_GOV_H
+#define POWER_GOV_H
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Utilization window: POWER_GOV_SLOTS slots of POWER_GOV_SLOT_MS each */
+#define POWER_GOV_SLOT_MS           (100U)
+#define POWER_GOV_SLOTS             (10U)
+
+/* The governor drops to its ULP point when the whole window was busy for
+ * less than this share, in percent */
+#define POWER_GOV_ULP_PERCENT       (10U)
+
+/* It returns to LP as soon as one slot was busy for more than this share.
+ * Halving the clock at most doubles the load, so the two do not chase each
+ * other. */
+#define POWER_GOV_LP_PERCENT        (50U)
+
+/* A driver refused the operating point in its POWER_GOV_CHECK call */
+#define POWER_GOV_RSLT_ERR_REFUSED  \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x18U)
+
+/* The FLL did not lock or the system power mode could not be changed; the
+ * previous operating point is restored */
+#define POWER_GOV_RSLT_ERR_CLOCK    \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x19U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Operating points, fastest first */
+typedef enum
+{
+    POWER_GOV_LP,               /* LP, CLK_HF0 100 MHz, CLK_PERI 100 MHz */
+    POWER_GOV_ULP50,            /* ULP, CLK_HF0 50 MHz, CLK_PERI 25 MHz */
+    POWER_GOV_ULP25,            /* ULP, CLK_HF0 25 MHz, CLK_PERI 25 MHz */
+    POWER_GOV_ULP12,            /* ULP, CLK_HF0 12.5 MHz, CLK_PERI 12.5 MHz */
+    POWER_GOV_POINT_COUNT
+} power_gov_point_t;
+
+/* Clock tree of an operating point. CLK_PATH0 is the FLL on the IMO, CLK_FAST
+ * and CLK_SLOW are not divided, so the CM4 runs at CLK_HF0 and the CM0+ at
+ * CLK_PERI. ULP limits CLK_HF0 to 50 MHz and CLK_PERI to 25 MHz. */
+typedef struct
+{
+    const char *name;
+    bool ulp;                   /* ULP system power mode, LP otherwise */
+    uint32_t fll_hz;            /* Output of the FLL */
+    uint32_t hf0_div;           /* CLK_HF0 = FLL / hf0_div: 1, 2, 4 or 8 */
+    uint32_t peri_div;          /* CLK_PERI = CLK_HF0 / peri_div */
+} power_gov_cfg_t;
+
+/* Phases of a change of the operating point */
+typedef enum
+{
+    POWER_GOV_CHECK,            /* Before, with interrupts enabled: the driver
+                                 * may wait for its hardware to go idle, or
+                                 * return false to keep the current point */
+    POWER_GOV_CHANGED           /* After, in the critical section of the change:
+                                 * the driver derives its settings again */
+} power_gov_phase_t;
+
+/* Notifier callback. peri_hz is CLK_PERI of the new point in both phases. */
+typedef bool (*power_gov_callback_t)(power_gov_phase_t phase, uint32_t peri_hz,
+                                     void *arg);
+
+/* Notifier of a driver, registered with power_gov_register(). The driver
+ * fills in the first three fields; the object must stay valid. */
+typedef struct power_gov_notifier
+{
+    const char *name;
+    power_gov_callback_t callback;
+    void *arg;
+    struct power_gov_notifier *next;    /* Registration order */
+} power_gov_notifier_t;
+
+/* Counters of an operating point */
+typedef struct
+{
+    uint64_t time_ticks;        /* Residency, in ticks of the timebase */
+    uint32_t entries;           /* Changes into the point */
+    uint32_t last_ns;           /* Time of the last change into the point */
+    uint32_t max_ns;            /* Longest change into the point */
+    uint32_t clock_ns;          /* Clock part of the last change: FLL, dividers
+                                 * and system power mode */
+} power_gov_point_stats_t;
+
+/* Governor state and counters */
+typedef struct
+{
+    power_gov_point_t point;    /* Current operating point */
+    bool pinned;                /* Set by power_gov_pin(), no auto change */
+    uint32_t busy_permille;     /* Utilization of the window */
+    uint32_t refused;           /* Changes a notifier refused */
+    const char *refused_by;     /* Name of the last one that refused, or NULL */
+    uint32_t failed;            /* Changes the clock system failed */
+    power_gov_point_stats_t points[POWER_GOV_POINT_COUNT];
+} power_gov_stats_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* Clock system, power_gov_clk.c */
+cy_rslt_t power_gov_clk_init(void);
+cy_rslt_t power_gov_clk_apply(const power_gov_cfg_t *from,
+                              const power_gov_cfg_t *to, uint32_t *clock_ns);
+
+/* Governor, power_gov.c */
+cy_rslt_t power_gov_init(power_gov_point_t idle_point);
+void power_gov_register(power_gov_notifier_t *notifier);
+void power_gov_idle_begin(void);
+void power_gov_idle_end(void);
+void power_gov_poll(void);
+cy_rslt_t power_gov_pin(power_gov_point_t point);
+void power_gov_release(void);
+const power_gov_cfg_t *power_gov_cfg(power_gov_point_t point);
+power_gov_point_t power_gov_find(const char *name);
+uint32_t power_gov_peri_hz(const power_gov_cfg_t *cfg);
+void power_gov_get_stats(power_gov_stats_t *stats);
+void power_gov_print_stats(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* POWER_GOV_H */
+
+/* [] END OF FILE */
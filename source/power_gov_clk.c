@@ -0,0 +1,374 @@
+/******************************************************************************
+* File Name:   power_gov_clk.c
+*
+* Description: This file contains the clock side of the power governor: it moves
+*              CLK_PATH0, CLK_HF0, CLK_PERI, the flash wait states and the
+*              system power mode between the operating points of power_gov.c, in
+*              the order the ULP limits require, and measures how long that
+*              takes.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_sysclk.h"
+#include "cy_syslib.h"
+#include "cy_syspm.h"
+#include "power_gov.h"
+#include "timer_cfg.h"
+#include "cycle_counter.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* FLL lock timeout, as in cycfg_system.c */
+#define POWER_GOV_CLK_FLL_TIMEOUT_US    (200000UL)
+
+#define POWER_GOV_CLK_HZ_PER_MHZ        (1000000UL)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* FLL settings of design.modus, and the output they give. Only
+ * cycfg_system.c has them, so they are read back at boot. */
+static cy_stc_fll_manual_config_t power_gov_clk_boot;
+static uint32_t power_gov_clk_boot_hz;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static cy_rslt_t power_gov_clk_set(const power_gov_cfg_t *from,
+                                   const power_gov_cfg_t *to,
+                                   uint32_t *clock_ns);
+static void power_gov_clk_dividers(const power_gov_cfg_t *from,
+                                   const power_gov_cfg_t *to);
+static cy_en_clkhf_dividers_t power_gov_clk_hf_divider(uint32_t div);
+static uint32_t power_gov_clk_ns(uint32_t cycles, uint32_t hz);
+static uint32_t power_gov_clk_mhz(uint32_t hz);
+
+
+/*******************************************************************************
+* Function Name: power_gov_clk_init
+********************************************************************************
+* Summary:
+* This function saves the FLL settings of design.modus and checks that the
+* clocks it has set up are the ones of the LP point.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, or POWER_GOV_RSLT_ERR_CLOCK if the boot
+*              clocks differ from the LP point
+*
+*******************************************************************************/
+cy_rslt_t power_gov_clk_init(void)
+{
+    const power_gov_cfg_t *lp = power_gov_cfg(POWER_GOV_LP);
+
+    Cy_SysClk_FllGetConfiguration(&power_gov_clk_boot);
+    power_gov_clk_boot_hz = Cy_SysClk_ClkPathGetFrequency(0UL);
+
+    if (Cy_SysPm_IsSystemUlp() || (power_gov_clk_boot_hz != lp->fll_hz) ||
+        (Cy_SysClk_ClkHfGetFrequency(0UL) != (lp->fll_hz / lp->hf0_div)) ||
+        (Cy_SysClk_ClkPeriGetFrequency() != power_gov_peri_hz(lp)))
+    {
+        return POWER_GOV_RSLT_ERR_CLOCK;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_clk_apply
+********************************************************************************
+* Summary:
+* This function changes from one operating point to another. ULP caps the
+* clocks, so on the way up the system enters LP before the clocks rise, and
+* on the way down it enters ULP after they have dropped. If the FLL does not
+* lock, or ULP cannot be entered, the clocks and the mode of 'from' are
+* restored. It runs with interrupts disabled.
+*
+* Parameters:
+*  from        Current operating point
+*  to          New operating point
+*  clock_ns    Location to store the time the change took
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS or POWER_GOV_RSLT_ERR_CLOCK
+*
+*******************************************************************************/
+cy_rslt_t power_gov_clk_apply(const power_gov_cfg_t *from,
+                              const power_gov_cfg_t *to, uint32_t *clock_ns)
+{
+    uint32_t start = cycle_counter_read();
+    uint32_t set_ns = 0UL;
+    uint32_t undo_ns = 0UL;
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+
+    if (from->ulp && !to->ulp &&
+        (Cy_SysPm_SystemEnterLp() != CY_SYSPM_SUCCESS))
+    {
+        result = POWER_GOV_RSLT_ERR_CLOCK;
+    }
+    *clock_ns = power_gov_clk_ns(cycle_counter_read() - start,
+                                 from->fll_hz / from->hf0_div);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = power_gov_clk_set(from, to, &set_ns);
+        *clock_ns += set_ns;
+
+        if ((result == CY_RSLT_SUCCESS) && to->ulp && !from->ulp)
+        {
+            start = cycle_counter_read();
+            if (Cy_SysPm_SystemEnterUlp() != CY_SYSPM_SUCCESS)
+            {
+                result = POWER_GOV_RSLT_ERR_CLOCK;
+            }
+            *clock_ns += power_gov_clk_ns(cycle_counter_read() - start,
+                                          to->fll_hz / to->hf0_div);
+        }
+
+        if (result != CY_RSLT_SUCCESS)
+        {
+            (void)power_gov_clk_set(to, from, &undo_ns);
+            *clock_ns += undo_ns;
+
+            if (from->ulp && !to->ulp)
+            {
+                (void)Cy_SysPm_SystemEnterUlp();
+            }
+        }
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_clk_set
+********************************************************************************
+* Summary:
+* This function moves the clock tree and the flash wait states, in LP or in
+* ULP. The wait states cover the faster clock and the stricter mode of both
+* points until the change is done. A new FLL frequency is locked with the
+* CPU on the IMO. The cycle counter runs at the CPU clock, so its count is
+* converted at the clock of each step.
+*
+* Parameters:
+*  from        Current operating point
+*  to          New operating point
+*  clock_ns    Location to store the time the change took
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, or POWER_GOV_RSLT_ERR_CLOCK if the FLL did
+*              not lock
+*
+*******************************************************************************/
+static cy_rslt_t power_gov_clk_set(const power_gov_cfg_t *from,
+                                   const power_gov_cfg_t *to,
+                                   uint32_t *clock_ns)
+{
+    uint32_t from_hz = from->fll_hz / from->hf0_div;
+    uint32_t to_hz = to->fll_hz / to->hf0_div;
+    bool relock = (from->fll_hz != to->fll_hz);
+    cy_en_sysclk_status_t status = CY_SYSCLK_SUCCESS;
+    uint32_t mark = cycle_counter_read();
+    uint32_t now;
+
+    *clock_ns = 0UL;
+
+    Cy_SysLib_SetWaitStates(from->ulp || to->ulp,
+                            power_gov_clk_mhz((from_hz > to_hz) ? from_hz :
+                                                                  to_hz));
+
+    if (relock)
+    {
+        Cy_SysClk_FllDisable();
+        now = cycle_counter_read();
+        *clock_ns += power_gov_clk_ns(now - mark, from_hz);
+        mark = now;
+    }
+
+    power_gov_clk_dividers(from, to);
+
+    if (relock)
+    {
+        if (to->fll_hz == power_gov_clk_boot_hz)
+        {
+            status = Cy_SysClk_FllManualConfigure(&power_gov_clk_boot);
+        }
+        else
+        {
+            status = Cy_SysClk_FllConfigure(CY_SYSCLK_IMO_FREQ, to->fll_hz,
+                                            CY_SYSCLK_FLLPLL_OUTPUT_AUTO);
+        }
+        if (status == CY_SYSCLK_SUCCESS)
+        {
+            status = Cy_SysClk_FllEnable(POWER_GOV_CLK_FLL_TIMEOUT_US);
+        }
+        now = cycle_counter_read();
+        *clock_ns += power_gov_clk_ns(now - mark,
+                                      CY_SYSCLK_IMO_FREQ / to->hf0_div);
+        mark = now;
+    }
+
+    SystemCoreClockUpdate();
+    Cy_SysLib_SetWaitStates(to->ulp, power_gov_clk_mhz(to_hz));
+
+    *clock_ns += power_gov_clk_ns(cycle_counter_read() - mark,
+                                  (status == CY_SYSCLK_SUCCESS) ?
+                                  to_hz : (CY_SYSCLK_IMO_FREQ / to->hf0_div));
+
+    return (status == CY_SYSCLK_SUCCESS) ? CY_RSLT_SUCCESS :
+                                           POWER_GOV_RSLT_ERR_CLOCK;
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_clk_dividers
+********************************************************************************
+* Summary:
+* This function sets the CLK_HF0 and CLK_PERI dividers. CLK_PERI is derived
+* from CLK_HF0, so when its divider grows it is set first, and otherwise
+* last: in between, CLK_PERI is never faster than at either point.
+*
+* Parameters:
+*  from        Current operating point
+*  to          New operating point
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void power_gov_clk_dividers(const power_gov_cfg_t *from,
+                                   const power_gov_cfg_t *to)
+{
+    if (to->peri_div > from->peri_div)
+    {
+        Cy_SysClk_ClkPeriSetDivider((uint8_t)(to->peri_div - 1U));
+        (void)Cy_SysClk_ClkHfSetDivider(0UL,
+                                        power_gov_clk_hf_divider(to->hf0_div));
+    }
+    else
+    {
+        (void)Cy_SysClk_ClkHfSetDivider(0UL,
+                                        power_gov_clk_hf_divider(to->hf0_div));
+        Cy_SysClk_ClkPeriSetDivider((uint8_t)(to->peri_div - 1U));
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_clk_hf_divider
+********************************************************************************
+* Summary:
+* This function returns the PDL value of a CLK_HF divider.
+*
+* Parameters:
+*  div         1, 2, 4 or 8
+*
+* Return:
+*  cy_en_clkhf_dividers_t  PDL value
+*
+*******************************************************************************/
+static cy_en_clkhf_dividers_t power_gov_clk_hf_divider(uint32_t div)
+{
+    cy_en_clkhf_dividers_t divider;
+
+    switch (div)
+    {
+        case 2U:
+            divider = CY_SYSCLK_CLKHF_DIVIDE_BY_2;
+            break;
+        case 4U:
+            divider = CY_SYSCLK_CLKHF_DIVIDE_BY_4;
+            break;
+        case 8U:
+            divider = CY_SYSCLK_CLKHF_DIVIDE_BY_8;
+            break;
+        default:
+            divider = CY_SYSCLK_CLKHF_NO_DIVIDE;
+            break;
+    }
+
+    return divider;
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_clk_ns
+********************************************************************************
+* Summary:
+* This function converts CPU cycles at a clock to nanoseconds.
+*
+* Parameters:
+*  cycles      Cycles of the cycle counter
+*  hz          CPU clock while they were counted
+*
+* Return:
+*  uint32_t    Nanoseconds
+*
+*******************************************************************************/
+static uint32_t power_gov_clk_ns(uint32_t cycles, uint32_t hz)
+{
+    return (uint32_t)(((uint64_t)cycles * TIMER_CFG_NS_PER_S) / hz);
+}
+
+
+/*******************************************************************************
+* Function Name: power_gov_clk_mhz
+********************************************************************************
+* Summary:
+* This function rounds a clock up to whole MHz, as the wait states need.
+*
+* Parameters:
+*  hz          Clock in Hz
+*
+* Return:
+*  uint32_t    Clock in MHz
+*
+*******************************************************************************/
+static uint32_t power_gov_clk_mhz(uint32_t hz)
+{
+    return (hz + POWER_GOV_CLK_HZ_PER_MHZ - 1UL) / POWER_GOV_CLK_HZ_PER_MHZ;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,255 @@
+/******************************************************************************
+* File Name:   power_gov_cmd.c
+*
+* Description: This file contains the shell command of the power governor.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "shell.h"
+#include "power_gov.h"
+#include "timebase.h"
+#include "timer_cfg.h"
+#include "timer_tune.h"
+#include "ipc_rpc.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Work unit of the 'gov curve' command: a divider search of the timer tuner
+ * for a frequency no divider meets exactly, so it tries TIMER_TUNE_SEARCH
+ * dividers. It runs GOV_CURVE_RUNS times at each operating point, and
+ * GOV_CURVE_PINGS calls go to the CM0+, each within
+ * GOV_CURVE_PING_TIMEOUT_US. */
+#define GOV_CURVE_WORK_MHZ                (1000003UL)
+#define GOV_CURVE_RUNS                    (100UL)
+#define GOV_CURVE_PINGS                   (100UL)
+#define GOV_CURVE_PING_TIMEOUT_US         (1000UL)
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void gov_curve(void);
+
+
+/*******************************************************************************
+* Function Name: gov_curve
+********************************************************************************
+* Summary:
+* This function measures each operating point of the power governor: the
+* change into it from LP and back, the time of the work unit and of a call
+* to the CM0+, all on the timebase, whose rate does not depend on the point.
+* One line per point is printed for tools/power_gov_curve.py:
+*
+*   gov curve: <name> <CLK_HF0 Hz> <ulp> <enter ns> <exit ns> <work ns>
+*              <call ns>
+*
+* The call time is 0 without the RPC server. The governor is left as it was.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void gov_curve(void)
+{
+    uint32_t args[IPC_RPC_ARGS] = { 0U };
+    power_gov_stats_t before;
+    power_gov_stats_t stats;
+    const power_gov_cfg_t *cfg;
+    timer_tune_t tune;
+    uint32_t hz = timebase_frequency();
+    uint32_t point;
+    uint32_t index;
+    uint32_t result;
+    uint32_t enter_ns;
+    uint32_t exit_ns;
+    uint64_t start;
+    uint64_t work_ticks;
+    uint64_t call_ticks;
+
+    power_gov_get_stats(&before);
+
+    for (point = 0U; point < (uint32_t)POWER_GOV_POINT_COUNT; point++)
+    {
+        cfg = power_gov_cfg((power_gov_point_t)point);
+        enter_ns = 0U;
+        exit_ns = 0U;
+
+        if (power_gov_pin((power_gov_point_t)point) != CY_RSLT_SUCCESS)
+        {
+            power_gov_get_stats(&stats);
+            APP_LOG("gov curve: %s not reached%s%s\r\n", cfg->name,
+                    (stats.refused_by != NULL) ? ", refused by " : "",
+                    (stats.refused_by != NULL) ? stats.refused_by : "");
+            continue;
+        }
+        if (point != (uint32_t)POWER_GOV_LP)
+        {
+            power_gov_get_stats(&stats);
+            enter_ns = stats.points[point].last_ns;
+        }
+
+        start = timebase_now();
+        for (index = 0U; index < GOV_CURVE_RUNS; index++)
+        {
+            (void)timer_tune_solve(TIMER_CFG_CLK_PERI_HZ, GOV_CURVE_WORK_MHZ,
+                                   TIMER_CFG_MAX_DIVIDER, UINT16_MAX, &tune);
+        }
+        work_ticks = timebase_now() - start;
+
+        call_ticks = 0U;
+        if (ipc_rpc_ready())
+        {
+            start = timebase_now();
+            for (index = 0U; index < GOV_CURVE_PINGS; index++)
+            {
+                args[0] = index;
+                if (ipc_rpc_call(IPC_RPC_FUNC_PING, args, &result,
+                                 GOV_CURVE_PING_TIMEOUT_US) !=
+                    CY_RSLT_SUCCESS)
+                {
+                    break;
+                }
+            }
+            if (index == GOV_CURVE_PINGS)
+            {
+                call_ticks = timebase_now() - start;
+            }
+        }
+
+        if (point != (uint32_t)POWER_GOV_LP)
+        {
+            (void)power_gov_pin(POWER_GOV_LP);
+            power_gov_get_stats(&stats);
+            exit_ns = stats.points[POWER_GOV_LP].last_ns;
+        }
+
+        APP_LOG("gov curve: %s %lu %u %lu %lu %lu %lu\r\n", cfg->name,
+                (unsigned long)(cfg->fll_hz / cfg->hf0_div),
+                cfg->ulp ? 1U : 0U, (unsigned long)enter_ns,
+                (unsigned long)exit_ns,
+                (unsigned long)((work_ticks * TIMER_CFG_NS_PER_S) /
+                                ((uint64_t)hz * GOV_CURVE_RUNS)),
+                (unsigned long)((call_ticks * TIMER_CFG_NS_PER_S) /
+                                ((uint64_t)hz * GOV_CURVE_PINGS)));
+    }
+
+    if (before.pinned)
+    {
+        (void)power_gov_pin(before.point);
+    }
+    else
+    {
+        power_gov_release();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: command_gov
+********************************************************************************
+* Summary:
+* This function is the 'gov' command. It prints the operating point of the
+* power governor, the utilization and the residency and change cost of each
+* point; pins a point given by name; hands the choice back to the governor
+* with 'auto'; or measures every point with 'curve', see gov_curve().
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument
+*
+*******************************************************************************/
+int command_gov(int argc, char *argv[])
+{
+    power_gov_stats_t stats;
+    power_gov_point_t point;
+    cy_rslt_t result;
+
+    if (argc > 2)
+    {
+        return 1;
+    }
+
+    if (argc == 2)
+    {
+        if (strcmp(argv[1], "auto") == 0)
+        {
+            power_gov_release();
+        }
+        else if (strcmp(argv[1], "curve") == 0)
+        {
+            gov_curve();
+            return 0;
+        }
+        else
+        {
+            point = power_gov_find(argv[1]);
+            if (point == POWER_GOV_POINT_COUNT)
+            {
+                return 1;
+            }
+
+            result = power_gov_pin(point);
+            if (result == POWER_GOV_RSLT_ERR_REFUSED)
+            {
+                power_gov_get_stats(&stats);
+                APP_LOG("gov: %s refused by %s\r\n", argv[1],
+                        stats.refused_by);
+            }
+            else if (result != CY_RSLT_SUCCESS)
+            {
+                APP_LOG("gov: %s failed, clocks restored\r\n", argv[1]);
+            }
+        }
+    }
+
+    power_gov_print_stats();
+
+    return 0;
+}
+
+/* [] END OF FILE */
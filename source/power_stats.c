@@ -0,0 +1,384 @@
+/******************************************************************************
+* File Name:   power_stats.c
+*
+* Description: This file contains the power state residency tracker. The power
+*              state hooks call power_stats_enter() on every transition, with
+*              the time read from a clock that keeps running in Deep Sleep, and
+*              power_stats_wake() with the interrupt that ended the sleep. The
+*              tracker itself does not touch the hardware and also runs in the
+*              host build.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "power_stats.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define POWER_MS_PER_S              (1000UL)
+
+/* Percentages are printed with one decimal */
+#define POWER_PERMILLE              (1000ULL)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const char *const power_state_names[POWER_STATE_COUNT] =
+{
+    "Active", "Sleep", "Deep Sleep"
+};
+
+static const char *const power_wake_names[POWER_WAKE_COUNT] =
+{
+    "timer", "UART", "GPIO", "CapSense", "other"
+};
+
+/* Clock of the time stamps, NULL until power_stats_start() has run */
+static power_stats_clock_t power_clock = NULL;
+static uint32_t power_clock_hz;
+
+/* Current state and the clock reading when it was entered */
+static power_state_t power_state = POWER_STATE_ACTIVE;
+static uint32_t power_since;
+
+/* Clock ticks spent in each state. 64 bit, so that the 32 bit clock may wrap
+ * any number of times between two reports. */
+static uint64_t power_ticks[POWER_STATE_COUNT];
+static uint32_t power_entries[POWER_STATE_COUNT];
+static uint32_t power_wakeups[POWER_WAKE_COUNT];
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t power_ticks_to_ms(uint64_t ticks);
+static void power_put32(uint8_t *buffer, uint32_t value);
+
+
+/*******************************************************************************
+* Function Name: power_stats_start
+********************************************************************************
+* Summary:
+* This function starts the residency tracker in the Active state and clears
+* the counters. It is called by power_stats_init().
+*
+* Parameters:
+*  clock       Free-running 32 bit clock that also counts in Deep Sleep
+*  clock_hz    Frequency of the clock
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_stats_start(power_stats_clock_t clock, uint32_t clock_hz)
+{
+    power_clock = clock;
+    power_clock_hz = clock_hz;
+
+    power_stats_reset();
+}
+
+
+/*******************************************************************************
+* Function Name: power_stats_enter
+********************************************************************************
+* Summary:
+* This function charges the time since the last transition to the state that
+* is being left and counts the entry into the new one. The power state hooks
+* call it right before the CPU stops and right after it wakes up, with
+* interrupts masked.
+*
+* Parameters:
+*  state       State that is being entered
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_stats_enter(power_state_t state)
+{
+    uint32_t now;
+
+    if (power_clock == NULL)
+    {
+        return;
+    }
+
+    now = power_clock();
+    power_ticks[power_state] += now - power_since;
+    power_since = now;
+    power_state = state;
+    power_entries[state]++;
+}
+
+
+/*******************************************************************************
+* Function Name: power_stats_wake
+********************************************************************************
+* Summary:
+* This function counts a wakeup by a source.
+*
+* Parameters:
+*  source      Source of the interrupt that ended the sleep
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_stats_wake(power_wake_t source)
+{
+    power_wakeups[source]++;
+}
+
+
+/*******************************************************************************
+* Function Name: power_stats_reset
+********************************************************************************
+* Summary:
+* This function clears the counters and starts a new measurement from now.
+* It must be called from the event loop.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_stats_reset(void)
+{
+    (void)memset(power_ticks, 0, sizeof(power_ticks));
+    (void)memset(power_entries, 0, sizeof(power_entries));
+    (void)memset(power_wakeups, 0, sizeof(power_wakeups));
+
+    if (power_clock != NULL)
+    {
+        power_since = power_clock();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: power_stats_get
+********************************************************************************
+* Summary:
+* This function returns a snapshot of the counters. The time since the last
+* transition is included in the current state, which is Active when it is
+* called from the event loop.
+*
+* Parameters:
+*  stats       Location to store the counters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_stats_get(power_stats_t *stats)
+{
+    uint32_t state;
+    uint64_t ticks;
+
+    for (state = 0U; state < (uint32_t)POWER_STATE_COUNT; state++)
+    {
+        ticks = power_ticks[state];
+        if ((power_clock != NULL) && (state == (uint32_t)power_state))
+        {
+            ticks += power_clock() - power_since;
+        }
+        stats->time_ms[state] = power_ticks_to_ms(ticks);
+        stats->entries[state] = power_entries[state];
+    }
+
+    (void)memcpy(stats->wakeups, power_wakeups, sizeof(stats->wakeups));
+}
+
+
+/*******************************************************************************
+* Function Name: power_stats_record
+********************************************************************************
+* Summary:
+* This function packs the counters into the binary record read by
+* tools/power_model.py:
+*  byte 0      POWER_STATS_RECORD_VERSION
+*  byte 1      POWER_STATS_RECORD_SIZE
+*  byte 2      POWER_STATE_COUNT
+*  byte 3      POWER_WAKE_COUNT
+*  then        time_ms[], entries[] and wakeups[], 32 bit little endian
+*
+* Parameters:
+*  stats       Counters from power_stats_get()
+*  record      Location to store the record
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_stats_record(const power_stats_t *stats,
+                        uint8_t record[POWER_STATS_RECORD_SIZE])
+{
+    uint8_t *next = &record[4];
+    uint32_t index;
+
+    record[0] = (uint8_t)POWER_STATS_RECORD_VERSION;
+    record[1] = (uint8_t)POWER_STATS_RECORD_SIZE;
+    record[2] = (uint8_t)POWER_STATE_COUNT;
+    record[3] = (uint8_t)POWER_WAKE_COUNT;
+
+    for (index = 0U; index < (uint32_t)POWER_STATE_COUNT; index++)
+    {
+        power_put32(next, stats->time_ms[index]);
+        next += 4;
+    }
+    for (index = 0U; index < (uint32_t)POWER_STATE_COUNT; index++)
+    {
+        power_put32(next, stats->entries[index]);
+        next += 4;
+    }
+    for (index = 0U; index < (uint32_t)POWER_WAKE_COUNT; index++)
+    {
+        power_put32(next, stats->wakeups[index]);
+        next += 4;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: power_stats_print
+********************************************************************************
+* Summary:
+* This function prints the time, share and number of entries of each power
+* state and the wakeups by source.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void power_stats_print(void)
+{
+    power_stats_t stats;
+    uint32_t total = 0U;
+    uint32_t permille;
+    uint32_t index;
+
+    if (power_clock == NULL)
+    {
+        APP_LOG("Power states: not tracked\r\n");
+        return;
+    }
+
+    power_stats_get(&stats);
+
+    for (index = 0U; index < (uint32_t)POWER_STATE_COUNT; index++)
+    {
+        total += stats.time_ms[index];
+    }
+
+    for (index = 0U; index < (uint32_t)POWER_STATE_COUNT; index++)
+    {
+        permille = (total == 0U) ? 0U :
+                   (uint32_t)(((uint64_t)stats.time_ms[index] *
+                               POWER_PERMILLE) / total);
+        APP_LOG("%-10s %7lu.%03lu s %3lu.%lu %% %8lu entries\r\n",
+                power_state_names[index],
+                (unsigned long)(stats.time_ms[index] / POWER_MS_PER_S),
+                (unsigned long)(stats.time_ms[index] % POWER_MS_PER_S),
+                (unsigned long)(permille / 10U),
+                (unsigned long)(permille % 10U),
+                (unsigned long)stats.entries[index]);
+    }
+
+    APP_LOG("Wakeups:");
+    for (index = 0U; index < (uint32_t)POWER_WAKE_COUNT; index++)
+    {
+        APP_LOG(" %s %lu", power_wake_names[index],
+                (unsigned long)stats.wakeups[index]);
+    }
+    APP_LOG("\r\n");
+}
+
+
+/*******************************************************************************
+* Function Name: power_ticks_to_ms
+********************************************************************************
+* Summary:
+* This function converts clock ticks to milliseconds.
+*
+* Parameters:
+*  ticks       Time in clock ticks
+*
+* Return:
+*  uint32_t    Time in ms
+*
+*******************************************************************************/
+static uint32_t power_ticks_to_ms(uint64_t ticks)
+{
+    return (power_clock_hz == 0U) ? 0U :
+           (uint32_t)((ticks * POWER_MS_PER_S) / power_clock_hz);
+}
+
+
+/*******************************************************************************
+* Function Name: power_put32
+********************************************************************************
+* Summary:
+* This function stores a 32 bit value little endian.
+*
+* Parameters:
+*  buffer      Location of the 4 bytes
+*  value       Value to store
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void power_put32(uint8_t *buffer, uint32_t value)
+{
+    buffer[0] = (uint8_t)value;
+    buffer[1] = (uint8_t)(value >> 8);
+    buffer[2] = (uint8_t)(value >> 16);
+    buffer[3] = (uint8_t)(value >> 24);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,131 @@
+/******************************************************************************
+* File Name:   power_stats.h
+*
+* Description: This file contains the declarations of the power state residency
+*              tracker. It accumulates the time spent in Active, Sleep and Deep
+*              Sleep, counts the transitions into each state and what woke the
+*              CPU, and packs the counters into a compact binary record for
+*              tools/power_model.py.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef POWER_STATS_H
+#define POWER_STATS_H
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Version of the binary record, incremented when its layout changes */
+#define POWER_STATS_RECORD_VERSION  (1U)
+
+/* Size of the binary record: a 4 byte header, then the residency in ms, the
+ * entries of each state and the wakeups of each source, all 32 bit little
+ * endian */
+#define POWER_STATS_RECORD_SIZE     (4U + (4U * ((2U * POWER_STATE_COUNT) + \
+                                                 POWER_WAKE_COUNT)))
+
+/* A SysPm callback could not be registered */
+#define POWER_STATS_RSLT_ERR_CALLBACK \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x12U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Power states of the CPU. The order is part of the binary record. */
+typedef enum
+{
+    POWER_STATE_ACTIVE,
+    POWER_STATE_SLEEP,
+    POWER_STATE_DEEPSLEEP,
+    POWER_STATE_COUNT
+} power_state_t;
+
+/* Wakeup sources. The order is part of the binary record. */
+typedef enum
+{
+    POWER_WAKE_TIMER,           /* TCPWM, MCWDT (LPTimer) or RTC */
+    POWER_WAKE_UART,            /* Serial block or UART DMA channel */
+    POWER_WAKE_GPIO,            /* Port interrupt, e.g. the console wake pin */
+    POWER_WAKE_CAPSENSE,        /* CSD block */
+    POWER_WAKE_OTHER,           /* Any other or no pending interrupt */
+    POWER_WAKE_COUNT
+} power_wake_t;
+
+/* Clock that keeps running in every power state */
+typedef uint32_t (*power_stats_clock_t)(void);
+
+/* Residency counters since the start or the last reset */
+typedef struct
+{
+    uint32_t time_ms[POWER_STATE_COUNT];    /* Time in each state */
+    uint32_t entries[POWER_STATE_COUNT];    /* Transitions into each state */
+    uint32_t wakeups[POWER_WAKE_COUNT];     /* Wakeups by each source */
+} power_stats_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* Power state hooks, power_stats_pm.c */
+cy_rslt_t power_stats_init(void);
+
+/* Residency tracker, power_stats.c */
+void power_stats_start(power_stats_clock_t clock, uint32_t clock_hz);
+void power_stats_enter(power_state_t state);
+void power_stats_wake(power_wake_t source);
+void power_stats_reset(void);
+void power_stats_get(power_stats_t *stats);
+void power_stats_record(const power_stats_t *stats,
+                        uint8_t record[POWER_STATS_RECORD_SIZE]);
+void power_stats_print(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* POWER_STATS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,262 @@
+/******************************************************************************
+* File Name:   power_stats_pm.c
+*
+* Description: This file contains the power state hooks of the residency
+*              tracker. SysPm callbacks for Sleep and Deep Sleep time stamp
+*              every transition on the LPTimer, and after each wakeup the
+*              pending interrupts in the NVIC tell which source ended the sleep.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cybsp.h"
+#include "cy_syspm.h"
+#include "idle.h"
+#include "power_stats.h"
+#include "uart_rx.h"
+#include "uart_tx.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Same order as the BSP system clock handler, and declared to run after it:
+ * the time stamp before a transition is taken by the last callback to run,
+ * and the one after the wakeup by the first, before the FLL has locked
+ * again */
+#define POWER_PM_CALLBACK_ORDER     (255U)
+
+/* Number of 32 bit interrupt set-pending registers */
+#define POWER_PM_IRQ_WORDS          (sizeof(((NVIC_Type *)0)->ISPR) / \
+                                     sizeof(uint32_t))
+
+#define POWER_PM_IRQ_WORD(irqn)     ((uint32_t)(irqn) >> 5U)
+#define POWER_PM_IRQ_BIT(irqn)      (1UL << ((uint32_t)(irqn) & 0x1FU))
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Interrupts first to last of a wakeup source */
+typedef struct
+{
+    IRQn_Type first;
+    IRQn_Type last;
+    power_wake_t source;
+} power_pm_irqs_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static cy_en_syspm_status_t power_stats_pm_callback(
+    cy_stc_syspm_callback_params_t *callback_params,
+    cy_en_syspm_callback_mode_t mode);
+static power_wake_t power_stats_pm_source(void);
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Interrupts of each wakeup source. The sources are checked in the order of
+ * power_wake_t, so a timer wins when several interrupts are pending. */
+static const power_pm_irqs_t power_pm_irqs[] =
+{
+    { tcpwm_0_interrupts_0_IRQn, tcpwm_0_interrupts_7_IRQn, POWER_WAKE_TIMER },
+    { tcpwm_1_interrupts_0_IRQn, tcpwm_1_interrupts_23_IRQn, POWER_WAKE_TIMER },
+    { srss_interrupt_mcwdt_0_IRQn, srss_interrupt_mcwdt_1_IRQn,
+      POWER_WAKE_TIMER },
+    { srss_interrupt_backup_IRQn, srss_interrupt_backup_IRQn,
+      POWER_WAKE_TIMER },
+    /* The debug UART is SCB5 on this kit */
+    { scb_5_interrupt_IRQn, scb_5_interrupt_IRQn, POWER_WAKE_UART },
+    { UART_RX_DMA_IRQ, UART_RX_DMA_IRQ, POWER_WAKE_UART },
+    { UART_TX_DMA_IRQ, UART_TX_DMA_IRQ, POWER_WAKE_UART },
+    { ioss_interrupts_gpio_0_IRQn, ioss_interrupts_gpio_14_IRQn,
+      POWER_WAKE_GPIO },
+    { ioss_interrupt_gpio_IRQn, ioss_interrupt_gpio_IRQn, POWER_WAKE_GPIO },
+    { csd_interrupt_IRQn, csd_interrupt_IRQn, POWER_WAKE_CAPSENSE }
+};
+
+/* power_pm_irqs as one bit mask per source over the pending registers */
+static uint32_t power_pm_masks[POWER_WAKE_OTHER][POWER_PM_IRQ_WORDS];
+
+/* States entered by the callbacks */
+static power_state_t power_pm_sleep = POWER_STATE_SLEEP;
+static power_state_t power_pm_deepsleep = POWER_STATE_DEEPSLEEP;
+
+/* Only the transitions are of interest, not the checks */
+static cybsp_pm_handler_t power_pm_sleep_handler =
+{
+    .name       = "power",
+    .callback   = &power_stats_pm_callback,
+    .type       = CY_SYSPM_SLEEP,
+    .skip_mode  = CY_SYSPM_SKIP_CHECK_READY | CY_SYSPM_SKIP_CHECK_FAIL,
+    .params     = { NULL, &power_pm_sleep },
+    .order      = POWER_PM_CALLBACK_ORDER
+};
+
+static cybsp_pm_handler_t power_pm_deepsleep_handler =
+{
+    .name       = "power",
+    .callback   = &power_stats_pm_callback,
+    .type       = CY_SYSPM_DEEPSLEEP,
+    .skip_mode  = CY_SYSPM_SKIP_CHECK_READY | CY_SYSPM_SKIP_CHECK_FAIL,
+    .params     = { NULL, &power_pm_deepsleep },
+    .order      = POWER_PM_CALLBACK_ORDER,
+    .after      = "sysclk"
+};
+
+
+/*******************************************************************************
+* Function Name: power_stats_init
+********************************************************************************
+* Summary:
+* This function starts the residency tracker on the LPTimer and registers
+* the SysPm callbacks that report the transitions. It must be called after
+* cybsp_init(), which registers the system clock handler that the Deep
+* Sleep callback is declared to follow, and after idle_init().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, or POWER_STATS_RSLT_ERR_CALLBACK if a
+*              callback could not be registered
+*
+*******************************************************************************/
+cy_rslt_t power_stats_init(void)
+{
+    uint32_t index;
+    uint32_t irqn;
+    const power_pm_irqs_t *irqs;
+
+    for (index = 0U; index < (sizeof(power_pm_irqs) / sizeof(power_pm_irqs[0]));
+         index++)
+    {
+        irqs = &power_pm_irqs[index];
+        for (irqn = (uint32_t)irqs->first; irqn <= (uint32_t)irqs->last;
+             irqn++)
+        {
+            power_pm_masks[irqs->source][POWER_PM_IRQ_WORD(irqn)] |=
+                POWER_PM_IRQ_BIT(irqn);
+        }
+    }
+
+    power_stats_start(idle_lf_read, idle_lf_frequency());
+
+    if ((cybsp_pm_register(&power_pm_sleep_handler) != CY_RSLT_SUCCESS) ||
+        (cybsp_pm_register(&power_pm_deepsleep_handler) != CY_RSLT_SUCCESS))
+    {
+        return POWER_STATS_RSLT_ERR_CALLBACK;
+    }
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: power_stats_pm_callback
+********************************************************************************
+* Summary:
+* This is the SysPm callback of Sleep and Deep Sleep. It runs with
+* interrupts masked, so after a wakeup the interrupt that ended the sleep is
+* still pending.
+*
+* Parameters:
+*  callback_params Context is the state the callback was registered for
+*  mode            Transition mode
+*
+* Return:
+*  cy_en_syspm_status_t    CY_SYSPM_SUCCESS
+*
+*******************************************************************************/
+static cy_en_syspm_status_t power_stats_pm_callback(
+    cy_stc_syspm_callback_params_t *callback_params,
+    cy_en_syspm_callback_mode_t mode)
+{
+    if (mode == CY_SYSPM_BEFORE_TRANSITION)
+    {
+        power_stats_enter(*(const power_state_t *)callback_params->context);
+    }
+    else if (mode == CY_SYSPM_AFTER_TRANSITION)
+    {
+        power_stats_enter(POWER_STATE_ACTIVE);
+        power_stats_wake(power_stats_pm_source());
+    }
+    else
+    {
+        /* Checks are skipped */
+    }
+
+    return CY_SYSPM_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: power_stats_pm_source
+********************************************************************************
+* Summary:
+* This function finds the source of the pending interrupts.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  power_wake_t    First source with a pending interrupt, POWER_WAKE_OTHER
+*                  if there is none
+*
+*******************************************************************************/
+static power_wake_t power_stats_pm_source(void)
+{
+    uint32_t source;
+    uint32_t word;
+
+    for (source = 0U; source < (uint32_t)POWER_WAKE_OTHER; source++)
+    {
+        for (word = 0U; word < POWER_PM_IRQ_WORDS; word++)
+        {
+            if ((NVIC->ISPR[word] & power_pm_masks[source][word]) != 0U)
+            {
+                return (power_wake_t)source;
+            }
+        }
+    }
+
+    return POWER_WAKE_OTHER;
+}
+
+/* [] END OF FILE */
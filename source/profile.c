@@ -0,0 +1,345 @@
+/******************************************************************************
+* File Name:   profile.c
+*
+* Description: This file contains the cycle count profiler: the table of scope
+*              aggregates, its reset and dump over the debug UART, and the
+*              optional export of every run on the SWO pin through the ITM.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "cyhal.h"
+#include "cybsp.h"
+#include "profile.h"
+#include "power_gov.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of empty scopes timed to measure the overhead of a scope */
+#define PROFILE_CALIBRATION_RUNS    (8U)
+
+#if defined(PROFILE_ITM)
+/* Unlocks the ITM registers for writing */
+#define PROFILE_ITM_UNLOCK          (0xC5ACCE55UL)
+
+/* TPIU output protocol and formatter settings for SWO: NRZ (UART) encoding,
+ * formatter bypassed so that the port carries the ITM packets only */
+#define PROFILE_TPIU_SPPR_NRZ       (2UL)
+#define PROFILE_TPIU_FFCR_BYPASS    (0x100UL)
+#endif /* PROFILE_ITM */
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+profile_stats_t profile_table[PROFILE_SCOPE_COUNT];
+
+/* Names printed by profile_dump(), in the order of profile_scope_t */
+static const char *const profile_names[PROFILE_SCOPE_COUNT] =
+{
+    "cybsp_init",
+    "event dispatch",
+    "isr_soft_timer",
+    "rgb frame"
+};
+
+/* Cycles measured by an empty scope, included in every measurement */
+static uint32_t profile_overhead = 0;
+
+#if defined(PROFILE_ITM)
+/* The SWO baud rate follows the changes of CLK_PERI by the power governor */
+static power_gov_notifier_t profile_itm_notifier;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void profile_itm_set_baud(uint32_t peri_hz);
+static bool profile_itm_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                     void *arg);
+#endif /* PROFILE_ITM */
+
+
+/*******************************************************************************
+* Function Name: profile_init
+********************************************************************************
+* Summary:
+* This function enables the cycle counter, clears the table and measures the
+* overhead of an empty scope. Call it first in main() so that the
+* initialization can be profiled.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void profile_init(void)
+{
+    uint32_t run;
+
+    cycle_counter_init();
+    profile_reset();
+
+    for (run = 0U; run < PROFILE_CALIBRATION_RUNS; run++)
+    {
+        PROFILE_BEGIN(PROFILE_CYBSP_INIT);
+        PROFILE_END(PROFILE_CYBSP_INIT);
+    }
+
+    profile_overhead = profile_table[PROFILE_CYBSP_INIT].min;
+    profile_reset();
+}
+
+
+/*******************************************************************************
+* Function Name: profile_reset
+********************************************************************************
+* Summary:
+* This function clears the aggregates of all scopes.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void profile_reset(void)
+{
+    uint32_t id;
+    uint32_t state = cyhal_system_critical_section_enter();
+
+    for (id = 0U; id < (uint32_t)PROFILE_SCOPE_COUNT; id++)
+    {
+        profile_table[id].count = 0U;
+        profile_table[id].min = UINT32_MAX;
+        profile_table[id].max = 0U;
+        profile_table[id].total = 0U;
+#if defined(PROFILE_ITM)
+        profile_table[id].itm_dropped = 0U;
+#endif
+    }
+
+    cyhal_system_critical_section_exit(state);
+}
+
+
+/*******************************************************************************
+* Function Name: profile_get_stats
+********************************************************************************
+* Summary:
+* This function returns a consistent snapshot of the aggregates of a scope,
+* also for scopes recorded from an interrupt.
+*
+* Parameters:
+*  id          Scope to read
+*  stats       Location to store the aggregates
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void profile_get_stats(profile_scope_t id, profile_stats_t *stats)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+
+    *stats = profile_table[id];
+
+    cyhal_system_critical_section_exit(state);
+}
+
+
+/*******************************************************************************
+* Function Name: profile_dump
+********************************************************************************
+* Summary:
+* This function prints the aggregates of every scope that has run to the
+* debug UART, in cycles and microseconds. With PROFILE_ITM it adds the runs
+* that were not exported.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void profile_dump(void)
+{
+    profile_stats_t stats;
+    uint32_t ticks_per_us = cycle_counter_per_us();
+    uint32_t mean;
+    uint32_t id;
+#if defined(PROFILE_ITM)
+    uint32_t dropped = 0U;
+#endif
+
+    APP_LOG("Profile (cycles, %lu per us, scope overhead %lu)\r\n",
+            (unsigned long)ticks_per_us, (unsigned long)profile_overhead);
+    APP_LOG("  scope                 count        min       mean        max"
+            "     max us\r\n");
+
+    for (id = 0U; id < (uint32_t)PROFILE_SCOPE_COUNT; id++)
+    {
+        profile_get_stats((profile_scope_t)id, &stats);
+        if (stats.count == 0U)
+        {
+            continue;
+        }
+
+        mean = (uint32_t)(stats.total / stats.count);
+        APP_LOG("  %-16s %10lu %10lu %10lu %10lu %10lu\r\n", profile_names[id],
+                (unsigned long)stats.count, (unsigned long)stats.min,
+                (unsigned long)mean, (unsigned long)stats.max,
+                (unsigned long)(stats.max / ticks_per_us));
+#if defined(PROFILE_ITM)
+        dropped += stats.itm_dropped;
+#endif
+    }
+
+#if defined(PROFILE_ITM)
+    APP_LOG("  ITM port %u at %lu baud, %lu runs dropped\r\n",
+            (unsigned int)PROFILE_ITM_PORT, (unsigned long)PROFILE_ITM_BAUD,
+            (unsigned long)dropped);
+#endif
+}
+
+
+#if defined(PROFILE_ITM)
+/*******************************************************************************
+* Function Name: profile_itm_init
+********************************************************************************
+* Summary:
+* This function starts the export of every closed scope on ITM stimulus port
+* PROFILE_ITM_PORT. It applies the trace clock divider and the SWO pin of the
+* design, sets the TPIU to NRZ at PROFILE_ITM_BAUD, enables the ITM and the
+* port, and registers the notifier that keeps the baud rate when the power
+* governor changes CLK_PERI. Call it after cybsp_init().
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void profile_itm_init(void)
+{
+    /* The trace clock is a divider of CLK_PERI, the SWO pin is P6.4 */
+    cybsp_config_require(CYBSP_CONFIG_CLOCKS);
+    cybsp_config_require(CYBSP_CONFIG_PINS);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+
+    TPI->CSPSR = 1UL;
+    TPI->SPPR = PROFILE_TPIU_SPPR_NRZ;
+    TPI->FFCR = PROFILE_TPIU_FFCR_BYPASS;
+    profile_itm_set_baud(Cy_SysClk_ClkPeriGetFrequency());
+
+    ITM->LAR = PROFILE_ITM_UNLOCK;
+    ITM->TCR = (1UL << ITM_TCR_TraceBusID_Pos) | ITM_TCR_ITMENA_Msk;
+    ITM->TER |= 1UL << PROFILE_ITM_PORT;
+
+    profile_itm_notifier.name = "profile_itm";
+    profile_itm_notifier.callback = profile_itm_clock_notify;
+    power_gov_register(&profile_itm_notifier);
+}
+
+
+/*******************************************************************************
+* Function Name: profile_itm_set_baud
+********************************************************************************
+* Summary:
+* This function sets the TPIU prescaler for PROFILE_ITM_BAUD, rounded to the
+* nearest rate the trace clock allows.
+*
+* Parameters:
+*  peri_hz     Frequency of CLK_PERI
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void profile_itm_set_baud(uint32_t peri_hz)
+{
+    uint32_t trace_hz = peri_hz /
+        (Cy_SysClk_PeriphGetDivider(CYBSP_TRACE_CLK_DIV_HW,
+                                    CYBSP_TRACE_CLK_DIV_NUM) + 1UL);
+    uint32_t prescaler = (trace_hz + (PROFILE_ITM_BAUD / 2UL)) /
+                         PROFILE_ITM_BAUD;
+
+    TPI->ACPR = (prescaler > 0UL) ? (prescaler - 1UL) : 0UL;
+}
+
+
+/*******************************************************************************
+* Function Name: profile_itm_clock_notify
+********************************************************************************
+* Summary:
+* This function is the notifier of the power governor. It sets the SWO baud
+* rate again for the new CLK_PERI. Bytes in flight during the change are
+* received at the wrong rate by the probe.
+*
+* Parameters:
+*  phase       POWER_GOV_CHECK or POWER_GOV_CHANGED
+*  peri_hz     CLK_PERI of the new operating point
+*  arg         Not used
+*
+* Return:
+*  bool        true, the change is never refused
+*
+*******************************************************************************/
+static bool profile_itm_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                     void *arg)
+{
+    (void)arg;
+
+    if (phase == POWER_GOV_CHANGED)
+    {
+        profile_itm_set_baud(peri_hz);
+    }
+
+    return true;
+}
+#endif /* PROFILE_ITM */
+
+/* [] END OF FILE */
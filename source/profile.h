@@ -0,0 +1,211 @@
+/******************************************************************************
+* File Name:   profile.h
+*
+* Description: This file contains the declarations of the cycle count profiler.
+*              Named scopes measure code sections with the DWT cycle counter and
+*              keep count, minimum, maximum and mean in a static table.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "cy_device_headers.h"
+#include "cycle_counter.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Set to 0 to compile all scope markers out */
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED             (1)
+#endif
+
+/* The host build has no ITM to export the scopes on */
+#if defined(PROFILE_ITM) && defined(APP_HOST_BUILD)
+#undef PROFILE_ITM
+#endif
+
+#if defined(PROFILE_ITM)
+
+/* ITM stimulus port that carries one 32-bit record per closed scope */
+#ifndef PROFILE_ITM_PORT
+#define PROFILE_ITM_PORT            (1U)
+#endif
+
+/* SWO baud rate, set to the same value in the trace probe. It divides the
+ * CLK_PERI of every operating point, 100 MHz down to 12.5 MHz, exactly. A
+ * record takes 5 bytes, 100 us at this rate. */
+#ifndef PROFILE_ITM_BAUD
+#define PROFILE_ITM_BAUD            (500000UL)
+#endif
+
+/* A record holds the scope ID in the top byte and the cycles in the lower
+ * 24 bits, saturated at this value */
+#define PROFILE_ITM_ID_POS          (24U)
+#define PROFILE_ITM_CYCLES_MAX      (0x00FFFFFFUL)
+
+#endif /* PROFILE_ITM */
+
+#if PROFILE_ENABLED
+
+/* Opens a scope. Must be closed by PROFILE_END() with the same ID in the
+ * same block. */
+#define PROFILE_BEGIN(id)           uint32_t profile_start_##id = cycle_counter_read()
+
+/* Closes a scope and records the cycles spent since PROFILE_BEGIN() */
+#define PROFILE_END(id)             profile_record((id), profile_start_##id)
+
+#else
+
+#define PROFILE_BEGIN(id)           do { } while (0)
+#define PROFILE_END(id)             do { } while (0)
+
+#endif /* PROFILE_ENABLED */
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Profiled scopes. Each scope must only be recorded from one context, the
+ * main loop or a single interrupt, so that its entry has a single writer. */
+typedef enum
+{
+    PROFILE_CYBSP_INIT = 0,     /* Device and board initialization */
+    PROFILE_EVENT_DISPATCH,     /* One event handler run by the main loop */
+    PROFILE_ISR_SOFT_TIMER,     /* Soft timer hardware compare interrupt */
+    PROFILE_RGB_FRAME,          /* RGB LED frame written by the CPU */
+    PROFILE_SCOPE_COUNT         /* Number of scopes, not a valid scope */
+} profile_scope_t;
+
+/* Aggregates of one scope, in cycles */
+typedef struct
+{
+    uint32_t count;             /* Number of times the scope was closed */
+    uint32_t min;               /* Shortest run */
+    uint32_t max;               /* Longest run */
+    uint64_t total;             /* Sum of all runs, for the mean */
+#if defined(PROFILE_ITM)
+    uint32_t itm_dropped;       /* Runs not exported, the ITM was busy */
+#endif
+} profile_stats_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Written by profile_record(), read through profile_get_stats() */
+extern profile_stats_t profile_table[PROFILE_SCOPE_COUNT];
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void profile_init(void);
+void profile_reset(void);
+void profile_get_stats(profile_scope_t id, profile_stats_t *stats);
+void profile_dump(void);
+#if defined(PROFILE_ITM)
+void profile_itm_init(void);
+#endif
+
+
+/*******************************************************************************
+* Function Name: profile_record
+********************************************************************************
+* Summary:
+* This function adds one run of a scope to its aggregates. It is inline so
+* that a scope costs two counter reads and a few compares, about 15 cycles.
+* With PROFILE_ITM it also writes the run to the ITM stimulus port if the port
+* is enabled and its FIFO has room, and counts it as dropped otherwise. It
+* never waits for the SWO output.
+*
+* Parameters:
+*  id          Scope that was closed
+*  start       Cycle count when the scope was opened
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+__STATIC_INLINE void profile_record(profile_scope_t id, uint32_t start)
+{
+    uint32_t cycles = cycle_counter_read() - start;
+    profile_stats_t *entry = &profile_table[id];
+
+    entry->count++;
+    entry->total += cycles;
+    if (cycles < entry->min)
+    {
+        entry->min = cycles;
+    }
+    if (cycles > entry->max)
+    {
+        entry->max = cycles;
+    }
+
+#if defined(PROFILE_ITM)
+    if (((ITM->TER & (1UL << PROFILE_ITM_PORT)) != 0UL) &&
+        (ITM->PORT[PROFILE_ITM_PORT].u32 != 0UL))
+    {
+        if (cycles > PROFILE_ITM_CYCLES_MAX)
+        {
+            cycles = PROFILE_ITM_CYCLES_MAX;
+        }
+        ITM->PORT[PROFILE_ITM_PORT].u32 =
+            ((uint32_t)id << PROFILE_ITM_ID_POS) | cycles;
+    }
+    else
+    {
+        entry->itm_dropped++;
+    }
+#endif
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PROFILE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,178 @@
+/******************************************************************************
+* File Name:   profile_cmd.c
+*
+* Description: This file contains the shell commands of the cycle profiler, of
+*              the event latency histograms and of the boot time profiler.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "shell.h"
+#include "boot_time.h"
+#include "event_loop.h"
+#include "latency_hist.h"
+#include "profile.h"
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void print_event_latency(void);
+
+
+/*******************************************************************************
+* Function Name: print_event_latency
+********************************************************************************
+* Summary:
+* This function prints the service latency histograms of the timer and UART
+* events: how long each event posted by an interrupt waited before the main
+* loop started its handler.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void print_event_latency(void)
+{
+    latency_hist_t hist;
+
+    event_loop_get_latency(EVENT_TIMER_TICK, &hist);
+    latency_hist_print(&hist, "Timer tick latency");
+
+    event_loop_get_latency(EVENT_UART_RX, &hist);
+    latency_hist_print(&hist, "UART receive latency");
+}
+
+
+/*******************************************************************************
+* Function Name: command_profile
+********************************************************************************
+* Summary:
+* This function is the 'profile' command. It prints the cycle counts of the
+* profiled scopes, or clears them with 'reset'.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument
+*
+*******************************************************************************/
+int command_profile(int argc, char *argv[])
+{
+    if (argc == 1)
+    {
+        profile_dump();
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "reset") == 0))
+    {
+        profile_reset();
+    }
+    else
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: command_latency
+********************************************************************************
+* Summary:
+* This function is the 'latency' command. It prints how long events waited
+* for the main loop, or clears the histograms with 'reset'.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument
+*
+*******************************************************************************/
+int command_latency(int argc, char *argv[])
+{
+    if (argc == 1)
+    {
+        print_event_latency();
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "reset") == 0))
+    {
+        event_loop_reset_latency();
+    }
+    else
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: command_boot
+********************************************************************************
+* Summary:
+* This function is the 'boot' command. It prints the time of each startup
+* stage from reset to the event loop.
+*
+* Parameters:
+*  argc        Number of arguments, not used
+*  argv        Arguments, not used
+*
+* Return:
+*  int         0
+*
+*******************************************************************************/
+int command_boot(int argc, char *argv[])
+{
+    (void) argc;
+    (void) argv;
+
+    boot_time_print();
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,481 @@
+/******************************************************************************
+* File Name:   pwm_tune.c
+*
+* Description: This file contains the PWM retuning module. New period and
+*              compare values are written to the buffer registers of the
+*              counters and swapped in by the hardware at the next terminal
+*              count. A new clock divider is loaded from the terminal count
+*              interrupt right after the swap, when all counters of the group
+*              have just started a period together.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_sysclk.h"
+#include "cy_tcpwm_pwm.h"
+#include "cybsp.h"
+#include "pwm_tune.h"
+#include "idle.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Counter width of each TCPWM block */
+static const uint32_t pwm_tune_counter_width[] =
+{
+    TCPWM0_CNT_CNT_WIDTH,
+    TCPWM1_CNT_CNT_WIDTH
+};
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void isr_pwm_tune(void *callback_arg, cyhal_pwm_event_t event);
+static void pwm_tune_load(pwm_tune_group_t *group);
+
+
+/*******************************************************************************
+* Function Name: pwm_tune_init
+********************************************************************************
+* Summary:
+* This function allocates a clock divider and initializes the PWMs of a group
+* on it. Set a frequency with pwm_tune_apply() before pwm_tune_start().
+*
+* Parameters:
+*  group       Group object to initialize
+*  pwms        PWM objects, initialized by this function
+*  pins        Output pin of each PWM
+*  count       Number of PWMs, at most PWM_TUNE_MAX_CHANNELS
+*
+* Return:
+*  cy_rslt_t   Result of the clock or PWM initialization
+*
+*******************************************************************************/
+cy_rslt_t pwm_tune_init(pwm_tune_group_t *group, cyhal_pwm_t *const pwms[],
+                        const cyhal_gpio_t pins[], uint32_t count)
+{
+    cy_rslt_t result;
+    uint32_t width;
+    uint32_t index;
+
+    CY_ASSERT((count > 0U) && (count <= PWM_TUNE_MAX_CHANNELS));
+
+    group->count = 0U;
+    group->running = false;
+    group->pending_divider = 0U;
+    group->max_period = UINT32_MAX;
+    group->tune.divider = 1U;
+    group->loaded_divider = 1U;
+
+    /* The group takes a 16-bit divider and drives its pins after the design
+     * has set up its own */
+    cybsp_config_require(CYBSP_CONFIG_CLOCKS);
+    cybsp_config_require(CYBSP_CONFIG_PINS);
+
+    result = cyhal_clock_allocate(&group->clock,
+                                  CYHAL_CLOCK_BLOCK_PERIPHERAL_16BIT);
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_clock_set_divider(&group->clock, group->tune.divider);
+    }
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_clock_set_enabled(&group->clock, true, true);
+    }
+
+    for (index = 0U; (index < count) && (result == CY_RSLT_SUCCESS); index++)
+    {
+        result = cyhal_pwm_init(pwms[index], pins[index], &group->clock);
+        if (result == CY_RSLT_SUCCESS)
+        {
+            group->pwm[index] = pwms[index];
+            group->count++;
+
+            width = pwm_tune_counter_width[pwms[index]->tcpwm.resource.block_num];
+            if ((width < 32U) && (group->max_period > (1UL << width)))
+            {
+                group->max_period = 1UL << width;
+            }
+        }
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        /* The first counter reports the terminal count of the group */
+        cyhal_pwm_register_callback(group->pwm[0], isr_pwm_tune, group);
+    }
+    else
+    {
+        pwm_tune_free(group);
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: pwm_tune_free
+********************************************************************************
+* Summary:
+* This function releases the PWMs and the clock divider of a group.
+*
+* Parameters:
+*  group       Group to release
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pwm_tune_free(pwm_tune_group_t *group)
+{
+    uint32_t index;
+
+    if (group->running)
+    {
+        idle_unlock();
+    }
+
+    for (index = 0U; index < group->count; index++)
+    {
+        cyhal_pwm_free(group->pwm[index]);
+    }
+    group->count = 0U;
+    group->running = false;
+
+    cyhal_clock_free(&group->clock);
+}
+
+
+/*******************************************************************************
+* Function Name: pwm_tune_solve
+********************************************************************************
+* Summary:
+* This function finds the divider of the peripheral clock and the period that
+* come closest to a frequency within the limits of the group.
+*
+* Parameters:
+*  group       Group the solution is for
+*  freq_mhz    Requested PWM frequency in millihertz
+*  tune        Location to store the solution
+*
+* Return:
+*  cy_rslt_t   Result of timer_tune_solve()
+*
+*******************************************************************************/
+cy_rslt_t pwm_tune_solve(const pwm_tune_group_t *group, uint32_t freq_mhz,
+                         timer_tune_t *tune)
+{
+    return timer_tune_solve(Cy_SysClk_ClkPeriGetFrequency(), freq_mhz,
+                            PWM_TUNE_MAX_DIVIDER, group->max_period, tune);
+}
+
+
+/*******************************************************************************
+* Function Name: pwm_tune_apply
+********************************************************************************
+* Summary:
+* This function sets the divider, the period and the duty cycle of every PWM
+* of the group. While the counters are stopped the values are loaded right
+* away. While they run, the period and compare values go to the buffer
+* registers and a switch event makes every counter swap them in at its next
+* terminal count; the terminal count interrupt then loads the divider. The
+* counters are never stopped, so the PWMs keep their phase to each other.
+*
+* Parameters:
+*  group           Group to change
+*  tune            Divider and period, from pwm_tune_solve()
+*  pulse_permille  High time of each PWM in 1/1000 of the period
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void pwm_tune_apply(pwm_tune_group_t *group, const timer_tune_t *tune,
+                    const uint32_t pulse_permille[])
+{
+    TCPWM_Type *base;
+    uint32_t counter;
+    uint32_t index;
+    uint32_t state;
+
+    for (index = 0U; index < group->count; index++)
+    {
+        group->compare[index] = (uint32_t)(((uint64_t)tune->period *
+                                            pulse_permille[index]) /
+                                           PWM_TUNE_PERMILLE);
+    }
+
+    if (!group->running)
+    {
+        group->tune = *tune;
+        pwm_tune_load(group);
+        return;
+    }
+
+    state = cyhal_system_critical_section_enter();
+
+    for (index = 0U; index < group->count; index++)
+    {
+        base = group->pwm[index]->tcpwm.base;
+        counter = group->pwm[index]->tcpwm.resource.channel_num;
+
+        Cy_TCPWM_PWM_SetPeriod1(base, counter, tune->period - 1U);
+        Cy_TCPWM_PWM_SetCompare1(base, counter, group->compare[index]);
+        Cy_TCPWM_PWM_EnablePeriodSwap(base, counter, true);
+        Cy_TCPWM_PWM_EnableCompareSwap(base, counter, true);
+        Cy_TCPWM_TriggerCaptureOrSwap(base, 1UL << counter);
+    }
+
+    /* An earlier change may still be pending, so compare with the divider
+     * in the hardware rather than with the previous tune */
+    group->pending_divider = (tune->divider != group->loaded_divider) ?
+                             tune->divider : 0U;
+    group->tune = *tune;
+
+    cyhal_system_critical_section_exit(state);
+
+    /* The interrupt also turns the swaps off again, so it is needed even
+     * when the divider stays */
+    cyhal_pwm_enable_event(group->pwm[0], CYHAL_PWM_IRQ_TERMINAL_COUNT,
+                           PWM_TUNE_INTR_PRIORITY, true);
+}
+
+
+/*******************************************************************************
+* Function Name: pwm_tune_start
+********************************************************************************
+* Summary:
+* This function starts the PWMs of the group in phase: after they are
+* enabled, one reload trigger restarts all counters of a TCPWM block on the
+* same clock edge. The counters stop in Deep Sleep, so the group keeps the
+* system out of it while running.
+*
+* Parameters:
+*  group       Group to start
+*
+* Return:
+*  cy_rslt_t   Result of cyhal_pwm_start()
+*
+*******************************************************************************/
+cy_rslt_t pwm_tune_start(pwm_tune_group_t *group)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    TCPWM_Type *base;
+    uint32_t mask;
+    uint32_t index;
+    uint32_t other;
+    uint32_t state;
+
+    for (index = 0U; (index < group->count) && (result == CY_RSLT_SUCCESS);
+         index++)
+    {
+        result = cyhal_pwm_start(group->pwm[index]);
+    }
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    state = cyhal_system_critical_section_enter();
+
+    for (index = 0U; index < group->count; index++)
+    {
+        base = group->pwm[index]->tcpwm.base;
+
+        /* Skip blocks already triggered for an earlier PWM */
+        for (other = 0U; other < index; other++)
+        {
+            if (group->pwm[other]->tcpwm.base == base)
+            {
+                break;
+            }
+        }
+        if (other < index)
+        {
+            continue;
+        }
+
+        mask = 0U;
+        for (other = index; other < group->count; other++)
+        {
+            if (group->pwm[other]->tcpwm.base == base)
+            {
+                mask |= 1UL << group->pwm[other]->tcpwm.resource.channel_num;
+            }
+        }
+        Cy_TCPWM_TriggerReloadOrIndex(base, mask);
+    }
+
+    if (!group->running)
+    {
+        idle_lock();
+    }
+    group->running = true;
+
+    cyhal_system_critical_section_exit(state);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: pwm_tune_stop
+********************************************************************************
+* Summary:
+* This function stops the PWMs of the group. A change still waiting for the
+* terminal count is loaded right away.
+*
+* Parameters:
+*  group       Group to stop
+*
+* Return:
+*  cy_rslt_t   Result of cyhal_pwm_stop()
+*
+*******************************************************************************/
+cy_rslt_t pwm_tune_stop(pwm_tune_group_t *group)
+{
+    cy_rslt_t result = CY_RSLT_SUCCESS;
+    uint32_t index;
+
+    cyhal_pwm_enable_event(group->pwm[0], CYHAL_PWM_IRQ_TERMINAL_COUNT,
+                           PWM_TUNE_INTR_PRIORITY, false);
+
+    for (index = 0U; index < group->count; index++)
+    {
+        cy_rslt_t stopped = cyhal_pwm_stop(group->pwm[index]);
+        if (stopped != CY_RSLT_SUCCESS)
+        {
+            result = stopped;
+        }
+    }
+
+    if (group->running)
+    {
+        idle_unlock();
+    }
+    group->running = false;
+    group->pending_divider = 0U;
+    pwm_tune_load(group);
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: pwm_tune_load
+********************************************************************************
+* Summary:
+* This function writes the divider, period and compare values of the group
+* directly, with the buffer swaps off. The counters must be stopped.
+*
+* Parameters:
+*  group       Group to load
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void pwm_tune_load(pwm_tune_group_t *group)
+{
+    TCPWM_Type *base;
+    uint32_t counter;
+    uint32_t index;
+
+    (void)cyhal_clock_set_divider(&group->clock, group->tune.divider);
+    group->loaded_divider = group->tune.divider;
+
+    for (index = 0U; index < group->count; index++)
+    {
+        base = group->pwm[index]->tcpwm.base;
+        counter = group->pwm[index]->tcpwm.resource.channel_num;
+
+        Cy_TCPWM_PWM_EnablePeriodSwap(base, counter, false);
+        Cy_TCPWM_PWM_EnableCompareSwap(base, counter, false);
+        Cy_TCPWM_PWM_SetPeriod0(base, counter, group->tune.period - 1U);
+        Cy_TCPWM_PWM_SetCompare0(base, counter, group->compare[index]);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: isr_pwm_tune
+********************************************************************************
+* Summary:
+* This is the terminal count interrupt of the first PWM of a group, enabled
+* while a change is pending. The counters have just swapped in the new period
+* and compare values. The swaps are turned off so that the buffers are not
+* swapped back, and a new divider is loaded while the period has just begun,
+* which shifts the phase by the interrupt latency at most.
+*
+* Parameters:
+*  callback_arg    Group of the PWM
+*  event           Terminal count event
+*
+* Return:
+*  void
+*******************************************************************************/
+static void isr_pwm_tune(void *callback_arg, cyhal_pwm_event_t event)
+{
+    pwm_tune_group_t *group = (pwm_tune_group_t *)callback_arg;
+    TCPWM_Type *base;
+    uint32_t counter;
+    uint32_t index;
+
+    (void) event;
+
+    if (group->pending_divider != 0U)
+    {
+        (void)cyhal_clock_set_divider(&group->clock, group->pending_divider);
+        group->loaded_divider = group->pending_divider;
+        group->pending_divider = 0U;
+    }
+
+    for (index = 0U; index < group->count; index++)
+    {
+        base = group->pwm[index]->tcpwm.base;
+        counter = group->pwm[index]->tcpwm.resource.channel_num;
+
+        Cy_TCPWM_PWM_EnablePeriodSwap(base, counter, false);
+        Cy_TCPWM_PWM_EnableCompareSwap(base, counter, false);
+    }
+
+    cyhal_pwm_enable_event(group->pwm[0], CYHAL_PWM_IRQ_TERMINAL_COUNT,
+                           PWM_TUNE_INTR_PRIORITY, false);
+}
+
+/* [] END OF FILE */
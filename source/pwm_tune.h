@@ -0,0 +1,111 @@
+/******************************************************************************
+* File Name:   pwm_tune.h
+*
+* Description: This file contains the declarations of the PWM retuning module. A
+*              group of PWMs shares one clock divider and can change frequency
+*              and duty cycle at runtime. A change takes effect at the next
+*              terminal count, without stopping the counters and without a short
+*              or long period in between.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef PWM_TUNE_H
+#define PWM_TUNE_H
+
+#include "cyhal.h"
+#include "timer_tune.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Most PWMs in one group */
+#define PWM_TUNE_MAX_CHANNELS       (3U)
+
+/* Largest value of the 16-bit integer clock dividers */
+#define PWM_TUNE_MAX_DIVIDER        (65536UL)
+
+/* Terminal count interrupt priority, used while a change is pending */
+#define PWM_TUNE_INTR_PRIORITY      (7U)
+
+/* Duty cycles are given as the share of the period the output is high */
+#define PWM_TUNE_PERMILLE           (1000U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* PWMs driven from one divider. All members are private to pwm_tune.c. */
+typedef struct
+{
+    cyhal_pwm_t *pwm[PWM_TUNE_MAX_CHANNELS];
+    uint32_t count;
+    cyhal_clock_t clock;        /* Divider shared by the group */
+    uint32_t max_period;        /* Period limit of the narrowest counter */
+    bool running;
+    timer_tune_t tune;          /* Divider and period, in effect or pending */
+    uint32_t compare[PWM_TUNE_MAX_CHANNELS];
+    volatile uint32_t pending_divider;  /* Loaded at terminal count, 0 if none */
+    volatile uint32_t loaded_divider;   /* Divider the clock runs with now */
+} pwm_tune_group_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t pwm_tune_init(pwm_tune_group_t *group, cyhal_pwm_t *const pwms[],
+                        const cyhal_gpio_t pins[], uint32_t count);
+void pwm_tune_free(pwm_tune_group_t *group);
+cy_rslt_t pwm_tune_solve(const pwm_tune_group_t *group, uint32_t freq_mhz,
+                         timer_tune_t *tune);
+void pwm_tune_apply(pwm_tune_group_t *group, const timer_tune_t *tune,
+                    const uint32_t pulse_permille[]);
+cy_rslt_t pwm_tune_start(pwm_tune_group_t *group);
+cy_rslt_t pwm_tune_stop(pwm_tune_group_t *group);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* PWM_TUNE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,824 @@
+/******************************************************************************
+* File Name:   rgb_pattern.c
+*
+* Description: This file contains the RGB LED pattern engine. Patterns are built
+*              once into gamma-corrected compare tables, one value per color and
+*              frame, and then played by DMA without any CPU time per frame. For
+*              comparison the same tables can be fed by the CPU from a 1 kHz
+*              soft timer, which is profiled to measure the CPU load DMA saves.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "cybsp.h"
+#include "soft_timer.h"
+#include "profile.h"
+#include "idle.h"
+#include "rgb_pattern_dma.h"
+#include "power_gov.h"
+#include "timer_cfg.h"
+#include "rgb_pattern.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Blink code of rgb_pattern_status(): code blinks, then a pause */
+#define RGB_PATTERN_STATUS_ON_MS    (150U)
+#define RGB_PATTERN_STATUS_OFF_MS   (250U)
+#define RGB_PATTERN_STATUS_PAUSE_MS (1000U)
+
+#define RGB_PATTERN_MS_TO_FRAMES(ms)    (((ms) * RGB_PATTERN_FRAME_HZ) / 1000U)
+
+/* Counter clock of the PWMs: the fastest one every operating point of the
+ * power governor divides down to, 12500 ticks per frame */
+#define RGB_PATTERN_CLOCK_HZ        (12500000UL)
+
+TIMER_CFG_ASSERT_TICK(RGB_PATTERN_CLOCK_HZ);
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static const cyhal_gpio_t rgb_pattern_pins[RGB_PATTERN_CHANNELS] =
+{
+    CYBSP_LED_RGB_RED,
+    CYBSP_LED_RGB_GREEN,
+    CYBSP_LED_RGB_BLUE
+};
+
+/* Gamma 2.2: light output in 1/65535 for perceived brightness 0 to 255 */
+static const uint16_t rgb_pattern_gamma[256] =
+{
+        0,     0,     2,     4,     7,    11,    17,    24,
+       32,    42,    53,    65,    79,    94,   111,   129,
+      148,   169,   192,   216,   242,   270,   299,   330,
+      362,   396,   432,   469,   508,   549,   591,   635,
+      681,   729,   779,   830,   883,   938,   995,  1053,
+     1113,  1175,  1239,  1305,  1373,  1443,  1514,  1587,
+     1663,  1740,  1819,  1900,  1983,  2068,  2155,  2243,
+     2334,  2427,  2521,  2618,  2717,  2817,  2920,  3024,
+     3131,  3240,  3350,  3463,  3578,  3694,  3813,  3934,
+     4057,  4182,  4309,  4438,  4570,  4703,  4838,  4976,
+     5115,  5257,  5401,  5547,  5695,  5845,  5998,  6152,
+     6309,  6468,  6629,  6792,  6957,  7124,  7294,  7466,
+     7640,  7816,  7994,  8175,  8358,  8543,  8730,  8919,
+     9111,  9305,  9501,  9699,  9900, 10102, 10307, 10515,
+    10724, 10936, 11150, 11366, 11585, 11806, 12029, 12254,
+    12482, 12712, 12944, 13179, 13416, 13655, 13896, 14140,
+    14386, 14635, 14885, 15138, 15394, 15652, 15912, 16174,
+    16439, 16706, 16975, 17247, 17521, 17798, 18077, 18358,
+    18642, 18928, 19216, 19507, 19800, 20095, 20393, 20694,
+    20996, 21301, 21609, 21919, 22231, 22546, 22863, 23182,
+    23504, 23829, 24156, 24485, 24817, 25151, 25487, 25826,
+    26168, 26512, 26858, 27207, 27558, 27912, 28268, 28627,
+    28988, 29351, 29717, 30086, 30457, 30830, 31206, 31585,
+    31966, 32349, 32735, 33124, 33514, 33908, 34304, 34702,
+    35103, 35507, 35913, 36321, 36732, 37146, 37562, 37981,
+    38402, 38825, 39252, 39680, 40112, 40546, 40982, 41421,
+    41862, 42306, 42753, 43202, 43654, 44108, 44565, 45025,
+    45487, 45951, 46418, 46888, 47360, 47835, 48313, 48793,
+    49275, 49761, 50249, 50739, 51232, 51728, 52226, 52727,
+    53230, 53736, 54245, 54756, 55270, 55787, 56306, 56828,
+    57352, 57879, 58409, 58941, 59476, 60014, 60554, 61097,
+    61642, 62190, 62741, 63295, 63851, 64410, 64971, 65535
+};
+
+static cyhal_pwm_t rgb_pattern_pwm[RGB_PATTERN_CHANNELS];
+
+/* Shared by the three PWMs, set again when the power governor changes
+ * CLK_PERI */
+static cyhal_clock_t rgb_pattern_clock;
+static power_gov_notifier_t rgb_pattern_notifier;
+
+/* Counter ticks per frame of each PWM */
+static uint32_t rgb_pattern_period_ticks[RGB_PATTERN_CHANNELS];
+
+/* Compare values of the current pattern. The LEDs are active low, so the
+ * compare value is the off time of a frame. */
+static uint16_t rgb_pattern_table[RGB_PATTERN_CHANNELS][RGB_PATTERN_MAX_FRAMES];
+static uint32_t rgb_pattern_length = 0;
+static bool rgb_pattern_loop = false;
+
+/* The PWMs stop in Deep Sleep with their output frozen, so the LED holds an
+ * idle lock whenever it is not dark */
+static bool rgb_pattern_lit = false;
+
+/* CPU-fed mode: a soft timer writes one frame per period */
+static bool rgb_pattern_cpu_fed = false;
+static soft_timer_t rgb_pattern_frame_timer;
+static uint32_t rgb_pattern_frame_ticks;
+static uint32_t rgb_pattern_frame;
+
+/* Frame scope aggregates when the CPU-fed mode was entered */
+static profile_stats_t rgb_pattern_bench_start;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static uint32_t rgb_pattern_frames(uint32_t duration_ms);
+static void rgb_pattern_set_frame(uint32_t frame, rgb_color_t color);
+static rgb_color_t rgb_pattern_scale(rgb_color_t color, uint32_t level);
+static void rgb_pattern_halt(void);
+static void rgb_pattern_play(uint32_t length, bool loop);
+static void rgb_pattern_write(uint32_t frame);
+static void rgb_pattern_frame_callback(void *callback_arg);
+static void rgb_pattern_print_load(void);
+static bool rgb_pattern_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                     void *arg);
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_init
+********************************************************************************
+* Summary:
+* This function starts the PWM of the three colors of the RGB LED at one
+* frame per period with the LED off, and attaches a DMA channel to each.
+* The PWMs count on a clock of their own at RGB_PATTERN_CLOCK_HZ.
+* The soft timer service must be initialized, it clocks the CPU-fed mode.
+*
+* Parameters:
+*  tick_hz     Soft timer tick rate, at least RGB_PATTERN_FRAME_HZ
+*
+* Return:
+*  cy_rslt_t   Result of the PWM or DMA initialization
+*
+*******************************************************************************/
+cy_rslt_t rgb_pattern_init(uint32_t tick_hz)
+{
+    cy_rslt_t result;
+    uint32_t channel;
+
+    CY_ASSERT(tick_hz >= RGB_PATTERN_FRAME_HZ);
+
+    /* Dividers and pin settings of the design come before the PWM clock and
+     * the LED pins */
+    cybsp_config_require(CYBSP_CONFIG_CLOCKS);
+    cybsp_config_require(CYBSP_CONFIG_PINS);
+
+    result = cyhal_clock_allocate(&rgb_pattern_clock,
+                                  CYHAL_CLOCK_BLOCK_PERIPHERAL_16BIT);
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_clock_set_frequency(&rgb_pattern_clock,
+                                           RGB_PATTERN_CLOCK_HZ, NULL);
+    }
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_clock_set_enabled(&rgb_pattern_clock, true, true);
+    }
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    for (channel = 0U; channel < RGB_PATTERN_CHANNELS; channel++)
+    {
+        result = cyhal_pwm_init(&rgb_pattern_pwm[channel],
+                                rgb_pattern_pins[channel], &rgb_pattern_clock);
+        if (result != CY_RSLT_SUCCESS)
+        {
+            return result;
+        }
+
+        /* A pulse of the whole period keeps the LED off */
+        result = cyhal_pwm_set_period(&rgb_pattern_pwm[channel],
+                                      RGB_PATTERN_FRAME_US, RGB_PATTERN_FRAME_US);
+        if (result == CY_RSLT_SUCCESS)
+        {
+            result = cyhal_pwm_start(&rgb_pattern_pwm[channel]);
+        }
+        if (result == CY_RSLT_SUCCESS)
+        {
+            result = rgb_pattern_dma_init(channel, &rgb_pattern_pwm[channel],
+                                          &rgb_pattern_period_ticks[channel]);
+        }
+        if (result != CY_RSLT_SUCCESS)
+        {
+            return result;
+        }
+    }
+
+    rgb_pattern_frame_ticks = tick_hz / RGB_PATTERN_FRAME_HZ;
+    soft_timer_setup(&rgb_pattern_frame_timer, rgb_pattern_frame_callback, NULL);
+
+    rgb_pattern_notifier.name = "rgb_pattern";
+    rgb_pattern_notifier.callback = rgb_pattern_clock_notify;
+    power_gov_register(&rgb_pattern_notifier);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_off
+********************************************************************************
+* Summary:
+* This function stops the current pattern and turns the LED off.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rgb_pattern_off(void)
+{
+    const rgb_color_t black = { 0U, 0U, 0U };
+
+    rgb_pattern_solid(black);
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_solid
+********************************************************************************
+* Summary:
+* This function stops the current pattern and shows a constant color.
+*
+* Parameters:
+*  color       Color to show
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rgb_pattern_solid(rgb_color_t color)
+{
+    rgb_pattern_halt();
+
+    rgb_pattern_set_frame(0U, color);
+
+    rgb_pattern_play(1U, false);
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_breathe
+********************************************************************************
+* Summary:
+* This function starts a repeating breathing pattern: the brightness ramps up
+* and down linearly in perceived brightness over one period, which the gamma
+* table turns into the slow start and fast swell of a breathing light.
+*
+* Parameters:
+*  color       Color at full brightness
+*  period_ms   Length of one breath, at most RGB_PATTERN_MAX_FRAMES frames
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rgb_pattern_breathe(rgb_color_t color, uint32_t period_ms)
+{
+    uint32_t length;
+    uint32_t half;
+    uint32_t frame;
+    uint32_t level;
+
+    rgb_pattern_halt();
+
+    length = rgb_pattern_frames(period_ms);
+    half = (length + 1U) / 2U;
+
+    for (frame = 0U; frame < length; frame++)
+    {
+        level = (frame < half) ? frame : (length - frame);
+        rgb_pattern_set_frame(frame,
+                              rgb_pattern_scale(color, (level * 255U) / half));
+    }
+
+    rgb_pattern_play(length, true);
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_fade
+********************************************************************************
+* Summary:
+* This function starts a one-shot fade between two colors, interpolated in
+* perceived brightness. The LED holds the target color at the end.
+*
+* Parameters:
+*  from         Start color
+*  to           Target color
+*  duration_ms  Length of the fade, at most RGB_PATTERN_MAX_FRAMES frames
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rgb_pattern_fade(rgb_color_t from, rgb_color_t to, uint32_t duration_ms)
+{
+    uint32_t length;
+    uint32_t last;
+    uint32_t frame;
+    rgb_color_t color;
+
+    rgb_pattern_halt();
+
+    length = rgb_pattern_frames(duration_ms);
+    last = (length > 1U) ? (length - 1U) : 1U;
+
+    for (frame = 0U; frame < length; frame++)
+    {
+        color.red = (uint8_t)((int32_t)from.red +
+                    (((int32_t)to.red - (int32_t)from.red) * (int32_t)frame) /
+                    (int32_t)last);
+        color.green = (uint8_t)((int32_t)from.green +
+                      (((int32_t)to.green - (int32_t)from.green) * (int32_t)frame) /
+                      (int32_t)last);
+        color.blue = (uint8_t)((int32_t)from.blue +
+                     (((int32_t)to.blue - (int32_t)from.blue) * (int32_t)frame) /
+                     (int32_t)last);
+        rgb_pattern_set_frame(frame, color);
+    }
+
+    rgb_pattern_play(length, false);
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_status
+********************************************************************************
+* Summary:
+* This function starts a repeating blink code: the LED blinks 'code' times,
+* RGB_PATTERN_STATUS_ON_MS on and RGB_PATTERN_STATUS_OFF_MS off, followed by
+* a pause of RGB_PATTERN_STATUS_PAUSE_MS.
+*
+* Parameters:
+*  color       Color of the blinks
+*  code        Number of blinks, 1 to RGB_PATTERN_MAX_CODE
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rgb_pattern_status(rgb_color_t color, uint32_t code)
+{
+    const rgb_color_t black = { 0U, 0U, 0U };
+    const uint32_t blink = RGB_PATTERN_MS_TO_FRAMES(RGB_PATTERN_STATUS_ON_MS +
+                                                    RGB_PATTERN_STATUS_OFF_MS);
+    const uint32_t on = RGB_PATTERN_MS_TO_FRAMES(RGB_PATTERN_STATUS_ON_MS);
+    uint32_t length;
+    uint32_t frame;
+
+    rgb_pattern_halt();
+
+    if (code == 0U)
+    {
+        code = 1U;
+    }
+    else if (code > RGB_PATTERN_MAX_CODE)
+    {
+        code = RGB_PATTERN_MAX_CODE;
+    }
+
+    length = rgb_pattern_frames((code * (RGB_PATTERN_STATUS_ON_MS +
+                                         RGB_PATTERN_STATUS_OFF_MS)) +
+                                RGB_PATTERN_STATUS_PAUSE_MS);
+
+    for (frame = 0U; frame < length; frame++)
+    {
+        rgb_pattern_set_frame(frame, ((frame < (code * blink)) &&
+                                      ((frame % blink) < on)) ? color : black);
+    }
+
+    rgb_pattern_play(length, true);
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_set_cpu_fed
+********************************************************************************
+* Summary:
+* This function switches between playing the tables by DMA and writing each
+* frame from a soft timer callback, the way an animation is driven without
+* DMA. The current pattern restarts in the new mode. When the CPU-fed mode
+* is left, the CPU time it spent per frame and the resulting load at the
+* frame rate are printed.
+*
+* Parameters:
+*  cpu_fed     true to feed the frames by the CPU, false to use DMA
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rgb_pattern_set_cpu_fed(bool cpu_fed)
+{
+    if (cpu_fed == rgb_pattern_cpu_fed)
+    {
+        return;
+    }
+
+    rgb_pattern_halt();
+
+    if (cpu_fed)
+    {
+        profile_get_stats(PROFILE_RGB_FRAME, &rgb_pattern_bench_start);
+    }
+    else
+    {
+        rgb_pattern_print_load();
+    }
+
+    rgb_pattern_cpu_fed = cpu_fed;
+
+    if (rgb_pattern_length > 0U)
+    {
+        rgb_pattern_play(rgb_pattern_length, rgb_pattern_loop);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_is_cpu_fed
+********************************************************************************
+* Summary:
+* This function returns whether the frames are fed by the CPU.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  bool        true in CPU-fed mode, false in DMA mode
+*
+*******************************************************************************/
+bool rgb_pattern_is_cpu_fed(void)
+{
+    return rgb_pattern_cpu_fed;
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_frames
+********************************************************************************
+* Summary:
+* This function converts a duration to a table length the DMA can play:
+* at least one frame, at most RGB_PATTERN_MAX_FRAMES, and a multiple of
+* RGB_PATTERN_DMA_ROW above one DataWire X loop.
+*
+* Parameters:
+*  duration_ms Duration in milliseconds
+*
+* Return:
+*  uint32_t    Number of frames
+*
+*******************************************************************************/
+static uint32_t rgb_pattern_frames(uint32_t duration_ms)
+{
+    uint32_t length = RGB_PATTERN_MS_TO_FRAMES(duration_ms);
+
+    if (length == 0U)
+    {
+        length = 1U;
+    }
+    else if (length > RGB_PATTERN_DMA_MAX_X)
+    {
+        length = (length + RGB_PATTERN_DMA_ROW - 1U) &
+                 ~(RGB_PATTERN_DMA_ROW - 1U);
+    }
+
+    return (length > RGB_PATTERN_MAX_FRAMES) ? RGB_PATTERN_MAX_FRAMES : length;
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_set_frame
+********************************************************************************
+* Summary:
+* This function stores the compare values of one frame. Each color is gamma
+* corrected and scaled to the period of its PWM.
+*
+* Parameters:
+*  frame       Frame index
+*  color       Color of the frame
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void rgb_pattern_set_frame(uint32_t frame, rgb_color_t color)
+{
+    const uint8_t levels[RGB_PATTERN_CHANNELS] =
+    {
+        color.red,
+        color.green,
+        color.blue
+    };
+    uint32_t channel;
+    uint32_t ticks;
+    uint32_t on_ticks;
+
+    for (channel = 0U; channel < RGB_PATTERN_CHANNELS; channel++)
+    {
+        ticks = rgb_pattern_period_ticks[channel];
+        on_ticks = (uint32_t)(((uint64_t)rgb_pattern_gamma[levels[channel]] *
+                               ticks + 32767U) / 65535U);
+        rgb_pattern_table[channel][frame] = (uint16_t)(ticks - on_ticks);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_scale
+********************************************************************************
+* Summary:
+* This function scales a color to a perceived brightness level.
+*
+* Parameters:
+*  color       Color at full brightness
+*  level       Brightness, 0 to 255
+*
+* Return:
+*  rgb_color_t Scaled color
+*
+*******************************************************************************/
+static rgb_color_t rgb_pattern_scale(rgb_color_t color, uint32_t level)
+{
+    rgb_color_t scaled;
+
+    scaled.red = (uint8_t)((color.red * level) / 255U);
+    scaled.green = (uint8_t)((color.green * level) / 255U);
+    scaled.blue = (uint8_t)((color.blue * level) / 255U);
+
+    return scaled;
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_halt
+********************************************************************************
+* Summary:
+* This function stops whatever feeds the frames, so that the tables can be
+* rewritten. The LED keeps the last frame.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void rgb_pattern_halt(void)
+{
+    uint32_t channel;
+
+    soft_timer_stop(&rgb_pattern_frame_timer);
+
+    for (channel = 0U; channel < RGB_PATTERN_CHANNELS; channel++)
+    {
+        rgb_pattern_dma_stop(channel);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_play
+********************************************************************************
+* Summary:
+* This function starts playing the tables from the first frame, by DMA or
+* by the frame timer. Deep Sleep stays locked unless the pattern is a single
+* dark frame.
+*
+* Parameters:
+*  length      Number of frames
+*  loop        true to repeat the pattern, false to hold the last frame
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void rgb_pattern_play(uint32_t length, bool loop)
+{
+    uint32_t channel;
+    bool lit = (length > 1U);
+
+    rgb_pattern_length = length;
+    rgb_pattern_loop = loop;
+
+    for (channel = 0U; channel < RGB_PATTERN_CHANNELS; channel++)
+    {
+        if (rgb_pattern_table[channel][0] != rgb_pattern_period_ticks[channel])
+        {
+            lit = true;
+        }
+    }
+    if (lit != rgb_pattern_lit)
+    {
+        if (lit)
+        {
+            idle_lock();
+        }
+        else
+        {
+            idle_unlock();
+        }
+        rgb_pattern_lit = lit;
+    }
+
+    if (rgb_pattern_cpu_fed)
+    {
+        rgb_pattern_frame = 0U;
+        rgb_pattern_write(0U);
+
+        if (length > 1U)
+        {
+            soft_timer_start(&rgb_pattern_frame_timer, rgb_pattern_frame_ticks,
+                             rgb_pattern_frame_ticks);
+        }
+    }
+    else
+    {
+        for (channel = 0U; channel < RGB_PATTERN_CHANNELS; channel++)
+        {
+            rgb_pattern_dma_play(channel, rgb_pattern_table[channel], length,
+                                 loop);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_write
+********************************************************************************
+* Summary:
+* This function writes one frame to the PWM of each color through the HAL,
+* the work the DMA does in hardware.
+*
+* Parameters:
+*  frame       Frame index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void rgb_pattern_write(uint32_t frame)
+{
+    uint32_t channel;
+    uint32_t pulse_us;
+
+    for (channel = 0U; channel < RGB_PATTERN_CHANNELS; channel++)
+    {
+        pulse_us = ((uint32_t)rgb_pattern_table[channel][frame] *
+                    RGB_PATTERN_FRAME_US) / rgb_pattern_period_ticks[channel];
+        (void)cyhal_pwm_set_period(&rgb_pattern_pwm[channel],
+                                   RGB_PATTERN_FRAME_US, pulse_us);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_frame_callback
+********************************************************************************
+* Summary:
+* This function runs from the event loop once per frame in CPU-fed mode and
+* writes the next frame. A one-shot pattern stops its timer on the last
+* frame. The run time is recorded in the PROFILE_RGB_FRAME scope.
+*
+* Parameters:
+*  callback_arg    Argument registered with the soft timer, not used
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void rgb_pattern_frame_callback(void *callback_arg)
+{
+    (void) callback_arg;
+
+    PROFILE_BEGIN(PROFILE_RGB_FRAME);
+
+    rgb_pattern_frame++;
+    if (rgb_pattern_frame >= rgb_pattern_length)
+    {
+        rgb_pattern_frame = 0U;
+    }
+
+    rgb_pattern_write(rgb_pattern_frame);
+
+    if ((!rgb_pattern_loop) && (rgb_pattern_frame == (rgb_pattern_length - 1U)))
+    {
+        soft_timer_stop(&rgb_pattern_frame_timer);
+    }
+
+    PROFILE_END(PROFILE_RGB_FRAME);
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_print_load
+********************************************************************************
+* Summary:
+* This function prints the frames written by the CPU since the CPU-fed mode
+* was entered, their mean cost and the CPU load at the frame rate. The load
+* of the DMA mode is zero per frame. The timer interrupt and the event
+* dispatch of every frame come on top, see the profile and the wakeup rate.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void rgb_pattern_print_load(void)
+{
+    profile_stats_t stats;
+    uint32_t frames;
+    uint32_t mean;
+    uint32_t load_ppm;
+
+    profile_get_stats(PROFILE_RGB_FRAME, &stats);
+
+    frames = stats.count - rgb_pattern_bench_start.count;
+    if (frames == 0U)
+    {
+        APP_LOG("No RGB frames written by the CPU\r\n");
+        return;
+    }
+
+    mean = (uint32_t)((stats.total - rgb_pattern_bench_start.total) / frames);
+
+    /* Cycles per second over cycles per second available, in ppm */
+    load_ppm = (mean * RGB_PATTERN_FRAME_HZ) / cycle_counter_per_us();
+
+    APP_LOG("RGB frames by CPU: %lu, %lu cycles each, %lu.%02lu%% CPU at "
+            "%u Hz (DMA: 0%%)\r\n", (unsigned long)frames, (unsigned long)mean,
+            (unsigned long)(load_ppm / 10000U),
+            (unsigned long)((load_ppm / 100U) % 100U),
+            (unsigned)RGB_PATTERN_FRAME_HZ);
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_clock_notify
+********************************************************************************
+* Summary:
+* This function is the notifier of the power governor. A CLK_PERI that no
+* integer divider brings to RGB_PATTERN_CLOCK_HZ is refused; after the change
+* the divider is set again, so the periods and compare tables stay valid.
+*
+* Parameters:
+*  phase       POWER_GOV_CHECK or POWER_GOV_CHANGED
+*  peri_hz     CLK_PERI of the new operating point
+*  arg         Not used
+*
+* Return:
+*  bool        false to refuse the operating point
+*
+*******************************************************************************/
+static bool rgb_pattern_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                     void *arg)
+{
+    (void)arg;
+
+    if (phase == POWER_GOV_CHECK)
+    {
+        return ((peri_hz % RGB_PATTERN_CLOCK_HZ) == 0U) &&
+               ((peri_hz / RGB_PATTERN_CLOCK_HZ) <= TIMER_CFG_MAX_DIVIDER);
+    }
+
+    return cyhal_clock_set_frequency(&rgb_pattern_clock, RGB_PATTERN_CLOCK_HZ,
+                                     NULL) == CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,101 @@
+/******************************************************************************
+* File Name:   rgb_pattern.h
+*
+* Description: This file contains the declarations of the RGB LED pattern
+*              engine. Breathing, fades and blink codes are precomputed into
+*              gamma-corrected compare tables that DMA streams into the PWM of
+*              each color, one value per PWM period.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef RGB_PATTERN_H
+#define RGB_PATTERN_H
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Animation frame rate. One frame is one PWM period. */
+#define RGB_PATTERN_FRAME_HZ        (1000U)
+#define RGB_PATTERN_FRAME_US        (1000000UL / RGB_PATTERN_FRAME_HZ)
+
+/* Longest pattern in frames, 4.096 s at the default frame rate */
+#define RGB_PATTERN_MAX_FRAMES      (4096U)
+
+/* Longest blink code of rgb_pattern_status() */
+#define RGB_PATTERN_MAX_CODE        (7U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Color in perceived brightness, 0 to 255 per channel. Gamma correction is
+ * applied when the tables are built. */
+typedef struct
+{
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+} rgb_color_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t rgb_pattern_init(uint32_t tick_hz);
+void rgb_pattern_off(void);
+void rgb_pattern_solid(rgb_color_t color);
+void rgb_pattern_breathe(rgb_color_t color, uint32_t period_ms);
+void rgb_pattern_fade(rgb_color_t from, rgb_color_t to, uint32_t duration_ms);
+void rgb_pattern_status(rgb_color_t color, uint32_t code);
+void rgb_pattern_set_cpu_fed(bool cpu_fed);
+bool rgb_pattern_is_cpu_fed(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* RGB_PATTERN_H */
+
+/* [] END OF FILE */
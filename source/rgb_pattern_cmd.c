@@ -0,0 +1,221 @@
+/******************************************************************************
+* File Name:   rgb_pattern_cmd.c
+*
+* Description: This file contains the shell commands of the RGB LED pattern
+*              engine: demo patterns and the choice of DMA or CPU fed frames.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "shell.h"
+#include "rgb_pattern.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* RGB LED demo patterns of the 'rgb' command */
+#define RGB_DEMO_BREATHE_MS               (4000U)
+#define RGB_DEMO_FADE_MS                  (2000U)
+#define RGB_DEMO_STATUS_CODE              (3U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* RGB LED demo patterns, in the order of the 'rgb' command */
+typedef enum
+{
+    RGB_DEMO_OFF,
+    RGB_DEMO_BREATHE,
+    RGB_DEMO_FADE,
+    RGB_DEMO_STATUS,
+    RGB_DEMO_COUNT
+} rgb_demo_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Pattern shown on the RGB LED, and the names the 'rgb' command takes */
+static rgb_demo_t rgb_demo = RGB_DEMO_OFF;
+static const char *const rgb_demo_names[RGB_DEMO_COUNT] =
+{
+    "off",
+    "breathe",
+    "fade",
+    "status"
+};
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void rgb_demo_show(rgb_demo_t demo);
+
+
+/*******************************************************************************
+* Function Name: rgb_demo_show
+********************************************************************************
+* Summary:
+* This function shows one of the RGB LED demo patterns: off, a cyan breathing
+* light, a fade from red to blue or blink code 3 in amber.
+*
+* Parameters:
+*  demo        Pattern to show
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void rgb_demo_show(rgb_demo_t demo)
+{
+    const rgb_color_t cyan = { 0U, 255U, 255U };
+    const rgb_color_t red = { 255U, 0U, 0U };
+    const rgb_color_t blue = { 0U, 0U, 255U };
+    const rgb_color_t amber = { 255U, 120U, 0U };
+
+    rgb_demo = demo;
+
+    switch (rgb_demo)
+    {
+        case RGB_DEMO_BREATHE:
+            rgb_pattern_breathe(cyan, RGB_DEMO_BREATHE_MS);
+            break;
+
+        case RGB_DEMO_FADE:
+            rgb_pattern_fade(red, blue, RGB_DEMO_FADE_MS);
+            break;
+
+        case RGB_DEMO_STATUS:
+            rgb_pattern_status(amber, RGB_DEMO_STATUS_CODE);
+            break;
+
+        default:
+            rgb_pattern_off();
+            break;
+    }
+
+    APP_LOG("RGB LED: %s\r\n", rgb_demo_names[rgb_demo]);
+}
+
+
+/*******************************************************************************
+* Function Name: command_rgb
+********************************************************************************
+* Summary:
+* This function is the 'rgb' command. It shows the named RGB LED demo
+* pattern, or the next one without an argument.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown pattern
+*
+*******************************************************************************/
+int command_rgb(int argc, char *argv[])
+{
+    uint32_t demo;
+
+    if (argc == 1)
+    {
+        rgb_demo_show((rgb_demo_t)((rgb_demo + 1U) % RGB_DEMO_COUNT));
+        return 0;
+    }
+
+    if (argc == 2)
+    {
+        for (demo = 0U; demo < (uint32_t)RGB_DEMO_COUNT; demo++)
+        {
+            if (strcmp(argv[1], rgb_demo_names[demo]) == 0)
+            {
+                rgb_demo_show((rgb_demo_t)demo);
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+
+/*******************************************************************************
+* Function Name: command_feed
+********************************************************************************
+* Summary:
+* This function is the 'feed' command. It selects whether DMA or the CPU
+* writes the RGB LED frames, no argument switches. Leaving the CPU-fed mode
+* prints its CPU load.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument
+*
+*******************************************************************************/
+int command_feed(int argc, char *argv[])
+{
+    if (argc == 1)
+    {
+        rgb_pattern_set_cpu_fed(!rgb_pattern_is_cpu_fed());
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "cpu") == 0))
+    {
+        rgb_pattern_set_cpu_fed(true);
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "dma") == 0))
+    {
+        rgb_pattern_set_cpu_fed(false);
+    }
+    else
+    {
+        return 1;
+    }
+
+    APP_LOG("RGB frames fed by %s\r\n",
+            rgb_pattern_is_cpu_fed() ? "CPU" : "DMA");
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,257 @@
+/******************************************************************************
+* File Name:   rgb_pattern_dma.c
+*
+* Description: This file contains the DMA player of the RGB LED pattern engine.
+*              A DataWire channel per color copies one compare value per PWM
+*              period into the compare buffer of the counter, which the counter
+*              swaps in at the next terminal count. An animation therefore costs
+*              no CPU time once it is started.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_dma.h"
+#include "cy_trigmux.h"
+#include "cy_tcpwm_pwm.h"
+#include "cyhal_hwmgr.h"
+#include "rgb_pattern_dma.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Trigger multiplexer input of the overflow of counter 0 of each TCPWM
+ * block. The inputs of the other counters follow in counter order. */
+static const uint32_t rgb_pattern_dma_overflow[] =
+{
+    TRIG_IN_MUX_0_TCPWM0_TR_OVERFLOW0,
+    TRIG_IN_MUX_0_TCPWM1_TR_OVERFLOW0
+};
+
+/* Counter driving the PWM of each color */
+static TCPWM_Type *rgb_pattern_dma_tcpwm[RGB_PATTERN_CHANNELS];
+static uint32_t rgb_pattern_dma_counter[RGB_PATTERN_CHANNELS];
+
+/* The table descriptor plays the frames. A one-shot table chains to the
+ * hold descriptor, which repeats the last frame. */
+static cy_stc_dma_descriptor_t rgb_pattern_dma_table_descriptor[RGB_PATTERN_CHANNELS];
+static cy_stc_dma_descriptor_t rgb_pattern_dma_hold_descriptor[RGB_PATTERN_CHANNELS];
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_dma_init
+********************************************************************************
+* Summary:
+* This function reserves the DMA channel of one color and routes the overflow
+* of its PWM counter to the channel trigger. The PWM must be initialized and
+* its period set, the period is not changed while tables are played.
+*
+* Parameters:
+*  channel       Color index, 0 to RGB_PATTERN_CHANNELS - 1
+*  pwm           PWM object of the color
+*  period_ticks  Location to store the number of counter ticks per period
+*
+* Return:
+*  cy_rslt_t     Result of the DMA channel reservation and trigger routing
+*
+*******************************************************************************/
+cy_rslt_t rgb_pattern_dma_init(uint32_t channel, cyhal_pwm_t *pwm,
+                               uint32_t *period_ticks)
+{
+    cy_rslt_t result;
+    cy_en_trigmux_status_t trigmux_status;
+    cy_stc_dma_channel_config_t channel_config;
+    const uint32_t dma_channel = RGB_PATTERN_DMA_CHANNEL + channel;
+    const cyhal_resource_inst_t dma_resource =
+    {
+        .type = CYHAL_RSC_DW,
+        .block_num = RGB_PATTERN_DMA_BLOCK,
+        .channel_num = (uint8_t)dma_channel
+    };
+
+    CY_ASSERT(channel < RGB_PATTERN_CHANNELS);
+
+    /* Keep the HAL from handing the channel to another driver */
+    result = cyhal_hwmgr_reserve(&dma_resource);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    rgb_pattern_dma_tcpwm[channel] = pwm->tcpwm.base;
+    rgb_pattern_dma_counter[channel] = pwm->tcpwm.resource.channel_num;
+
+    trigmux_status = Cy_TrigMux_Connect(
+        rgb_pattern_dma_overflow[pwm->tcpwm.resource.block_num] +
+        rgb_pattern_dma_counter[channel],
+        RGB_PATTERN_DMA_TRIGGER + dma_channel, false, TRIGGER_TYPE_EDGE);
+    if (trigmux_status != CY_TRIGMUX_SUCCESS)
+    {
+        cyhal_hwmgr_free(&dma_resource);
+        return RGB_PATTERN_DMA_RSLT_ERR_TRIGGER;
+    }
+
+    *period_ticks = Cy_TCPWM_PWM_GetPeriod0(rgb_pattern_dma_tcpwm[channel],
+                                            rgb_pattern_dma_counter[channel]) + 1U;
+
+    /* The descriptor is set up by rgb_pattern_dma_play(). A frame transfer
+     * is a single word and may wait behind the UART channels. */
+    channel_config.descriptor = &rgb_pattern_dma_table_descriptor[channel];
+    channel_config.preemptable = true;
+    channel_config.priority = 3;
+    channel_config.enable = false;
+    channel_config.bufferable = false;
+    (void)Cy_DMA_Channel_Init(RGB_PATTERN_DMA_HW, dma_channel, &channel_config);
+    Cy_DMA_Enable(RGB_PATTERN_DMA_HW);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_dma_play
+********************************************************************************
+* Summary:
+* This function starts streaming a compare table into the PWM of one color,
+* one value per period. Tables of up to RGB_PATTERN_DMA_MAX_X frames are a
+* 1D transfer, longer ones a 2D transfer of RGB_PATTERN_DMA_ROW frame rows.
+* The table must stay valid and unchanged while it is played.
+*
+* Parameters:
+*  channel     Color index
+*  table       Compare values, one per frame
+*  length      Number of frames, a multiple of RGB_PATTERN_DMA_ROW above
+*              RGB_PATTERN_DMA_MAX_X
+*  loop        true to repeat the table, false to hold the last frame
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rgb_pattern_dma_play(uint32_t channel, const uint16_t *table,
+                          uint32_t length, bool loop)
+{
+    const uint32_t dma_channel = RGB_PATTERN_DMA_CHANNEL + channel;
+    TCPWM_Type *base = rgb_pattern_dma_tcpwm[channel];
+    uint32_t counter = rgb_pattern_dma_counter[channel];
+    cy_stc_dma_descriptor_t *table_descriptor =
+        &rgb_pattern_dma_table_descriptor[channel];
+    cy_stc_dma_descriptor_t *hold_descriptor =
+        &rgb_pattern_dma_hold_descriptor[channel];
+    cy_stc_dma_descriptor_config_t descriptor_config =
+    {
+        /* The trigger is a pulse of two peripheral clocks, wait for it to
+         * end before accepting the next one */
+        .retrigger = CY_DMA_RETRIG_4CYC,
+        .interruptType = CY_DMA_DESCR,
+        .triggerOutType = CY_DMA_1ELEMENT,
+        .channelState = CY_DMA_CHANNEL_ENABLED,
+        .triggerInType = CY_DMA_1ELEMENT,
+        .dataSize = CY_DMA_HALFWORD,
+        .srcTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+        .dstTransferSize = CY_DMA_TRANSFER_SIZE_WORD,
+        .descriptorType = CY_DMA_1D_TRANSFER,
+        .srcAddress = (void *)table,
+        .dstAddress = (void *)&TCPWM_CNT_CC_BUFF(base, counter),
+        .srcXincrement = 1,
+        .dstXincrement = 0,
+        .xCount = length,
+        .srcYincrement = 0,
+        .dstYincrement = 0,
+        .yCount = 1,
+        .nextDescriptor = NULL
+    };
+
+    CY_ASSERT((length > 0U) && ((length <= RGB_PATTERN_DMA_MAX_X) ||
+              ((length % RGB_PATTERN_DMA_ROW) == 0U)));
+
+    rgb_pattern_dma_stop(channel);
+
+    if (length > RGB_PATTERN_DMA_MAX_X)
+    {
+        descriptor_config.descriptorType = CY_DMA_2D_TRANSFER;
+        descriptor_config.xCount = RGB_PATTERN_DMA_ROW;
+        descriptor_config.srcYincrement = RGB_PATTERN_DMA_ROW;
+        descriptor_config.yCount = length / RGB_PATTERN_DMA_ROW;
+    }
+    descriptor_config.nextDescriptor = loop ? table_descriptor : hold_descriptor;
+    (void)Cy_DMA_Descriptor_Init(table_descriptor, &descriptor_config);
+
+    /* The hold descriptor writes the last frame every period, so that the
+     * compare swap keeps a stable value */
+    descriptor_config.descriptorType = CY_DMA_SINGLE_TRANSFER;
+    descriptor_config.srcAddress = (void *)&table[length - 1U];
+    descriptor_config.xCount = 1;
+    descriptor_config.srcYincrement = 0;
+    descriptor_config.yCount = 1;
+    descriptor_config.nextDescriptor = hold_descriptor;
+    (void)Cy_DMA_Descriptor_Init(hold_descriptor, &descriptor_config);
+
+    /* The counter swaps compare and buffer at every terminal count. Load the
+     * first frame so that the first swap does not bring back a stale
+     * value. */
+    TCPWM_CNT_CC_BUFF(base, counter) = table[0];
+    Cy_TCPWM_PWM_EnableCompareSwap(base, counter, true);
+
+    Cy_DMA_Channel_SetDescriptor(RGB_PATTERN_DMA_HW, dma_channel,
+                                 table_descriptor);
+    Cy_DMA_Channel_Enable(RGB_PATTERN_DMA_HW, dma_channel);
+}
+
+
+/*******************************************************************************
+* Function Name: rgb_pattern_dma_stop
+********************************************************************************
+* Summary:
+* This function stops the table of one color. The compare swap is turned off
+* so that the PWM keeps the compare value written last, by the DMA or by
+* cyhal_pwm_set_period().
+*
+* Parameters:
+*  channel     Color index
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void rgb_pattern_dma_stop(uint32_t channel)
+{
+    Cy_DMA_Channel_Disable(RGB_PATTERN_DMA_HW, RGB_PATTERN_DMA_CHANNEL + channel);
+    Cy_TCPWM_PWM_EnableCompareSwap(rgb_pattern_dma_tcpwm[channel],
+                                   rgb_pattern_dma_counter[channel], false);
+}
+
+/* [] END OF FILE */
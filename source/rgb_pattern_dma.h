@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name:   rgb_pattern_dma.h
+*
+* Description: This file contains the declarations of the DMA player of the RGB
+*              LED pattern engine. Each color has a DataWire channel that the
+*              overflow of its PWM counter triggers once per period to copy the
+*              next compare value from the table.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef RGB_PATTERN_DMA_H
+#define RGB_PATTERN_DMA_H
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of PWM channels, one per color */
+#define RGB_PATTERN_CHANNELS        (3U)
+
+/* DataWire channels RGB_PATTERN_DMA_CHANNEL to RGB_PATTERN_DMA_CHANNEL + 2
+ * feed the red, green and blue PWM. Their trigger inputs are reached from
+ * the TCPWM overflow outputs through trigger multiplexer group 0. */
+#ifndef RGB_PATTERN_DMA_HW
+#define RGB_PATTERN_DMA_HW          DW0
+#define RGB_PATTERN_DMA_BLOCK       (0U)
+#define RGB_PATTERN_DMA_CHANNEL     (0U)
+#define RGB_PATTERN_DMA_TRIGGER     TRIG_OUT_MUX_0_PDMA0_TR_IN0
+#endif
+
+/* Tables longer than one DataWire X loop must be a multiple of this many
+ * frames, so that they can be played as a 2D transfer */
+#define RGB_PATTERN_DMA_ROW         (16U)
+#define RGB_PATTERN_DMA_MAX_X       (256U)
+
+/* The trigger multiplexer could not route the PWM overflow to the DMA */
+#define RGB_PATTERN_DMA_RSLT_ERR_TRIGGER \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x11U)
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t rgb_pattern_dma_init(uint32_t channel, cyhal_pwm_t *pwm,
+                               uint32_t *period_ticks);
+void rgb_pattern_dma_play(uint32_t channel, const uint16_t *table,
+                          uint32_t length, bool loop);
+void rgb_pattern_dma_stop(uint32_t channel);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* RGB_PATTERN_DMA_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,434 @@
+/******************************************************************************
+* File Name:   shell.c
+*
+* Description: This file contains the line-oriented command shell on the debug
+*              UART. Received bytes are edited into a line buffer as they
+*              arrive by shell_edit.c, so the shell never waits for input. A
+*              completed line is split into arguments in place and its command
+*              is found with one hash and one compare in the table generated
+*              from shell_commands.def.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "shell.h"
+#include "app_log.h"
+#if defined(APP_UART_CM0P)
+#include "ipc_console.h"
+#endif
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static void (*shell_empty_line)(void) = NULL;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static int shell_split(char *line, char *argv[]);
+#if !defined(APP_UART_CM0P)
+static void shell_write(const char *data, size_t length);
+static void shell_line(char *line, uint32_t length);
+#endif
+
+
+/*******************************************************************************
+* Function Name: shell_init
+********************************************************************************
+* Summary:
+* This function clears the line buffer and registers the action of an empty
+* line. With APP_UART_CM0P the line editor runs on the CM0+, which passes the
+* completed lines to shell_execute().
+*
+* Parameters:
+*  empty_line  Function called when Enter is pressed on an empty line, or
+*              NULL
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void shell_init(void (*empty_line)(void))
+{
+    shell_empty_line = empty_line;
+#if !defined(APP_UART_CM0P)
+    shell_edit_init(shell_write, shell_line);
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: shell_input
+********************************************************************************
+* Summary:
+* This function processes received characters: it edits the line, echoes
+* it and runs the command when Enter is received. It returns when all
+* characters are consumed, a partial line is kept for the next call.
+*
+* Parameters:
+*  data        Received characters
+*  length      Number of characters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void shell_input(const uint8_t *data, size_t length)
+{
+#if defined(APP_UART_CM0P)
+    (void) data;
+    (void) length;
+#else
+    shell_edit_input(data, length);
+
+    /* Echo must appear even without a line end */
+    (void)fflush(stdout);
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: shell_prompt
+********************************************************************************
+* Summary:
+* This function prints the prompt and the line edited so far, for example
+* after other output has been printed.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void shell_prompt(void)
+{
+#if defined(APP_UART_CM0P)
+    ipc_console_prompt();
+#else
+    shell_edit_prompt();
+    (void)fflush(stdout);
+#endif
+}
+
+
+/*******************************************************************************
+* Function Name: shell_execute
+********************************************************************************
+* Summary:
+* This function runs a completed line. It is split into arguments and passed
+* to its command. A command that returns an error gets its help line printed
+* as usage. The prompt follows the output of the command.
+*
+* Parameters:
+*  line        NUL terminated line, modified
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void shell_execute(char *line)
+{
+    char *argv[SHELL_MAX_ARGS + 1U];
+    const shell_command_t *command;
+    int argc;
+
+    if (line[0] == '\0')
+    {
+        if (shell_empty_line != NULL)
+        {
+            shell_empty_line();
+        }
+    }
+    else
+    {
+        argc = shell_split(line, argv);
+        if (argc < 0)
+        {
+            APP_LOG("Too many arguments or unterminated quote\r\n");
+        }
+        else if (argc > 0)
+        {
+            command = shell_lookup(argv[0], strlen(argv[0]));
+            if (command == NULL)
+            {
+                APP_LOG("Unknown command '");
+                APP_LOG_TEXT(argv[0]);
+                APP_LOG("', try 'help'\r\n");
+            }
+            else if (command->handler(argc, argv) != 0)
+            {
+                APP_LOG("Usage: ");
+                APP_LOG_TEXT(command->help);
+                APP_LOG("\r\n");
+            }
+        }
+    }
+
+    shell_prompt();
+}
+
+
+/*******************************************************************************
+* Function Name: shell_lookup
+********************************************************************************
+* Summary:
+* This function finds a command. The hash selects the only command the word
+* can be, one compare confirms it.
+*
+* Parameters:
+*  name        Command word, not necessarily NUL terminated
+*  length      Number of characters
+*
+* Return:
+*  const shell_command_t *  Command, NULL if there is none of that name
+*
+*******************************************************************************/
+const shell_command_t *shell_lookup(const char *name, size_t length)
+{
+    const shell_command_t *command =
+        &shell_command_table[shell_hash(name, length) >> SHELL_HASH_SHIFT];
+
+    if ((command->length != length) ||
+        (memcmp(command->name, name, length) != 0))
+    {
+        return NULL;
+    }
+
+    return command;
+}
+
+
+/*******************************************************************************
+* Function Name: shell_command_help
+********************************************************************************
+* Summary:
+* This function is the 'help' command. It lists the commands in the order of
+* shell_commands.def.
+*
+* Parameters:
+*  argc        Number of arguments, not used
+*  argv        Arguments, not used
+*
+* Return:
+*  int         0
+*
+*******************************************************************************/
+int shell_command_help(int argc, char *argv[])
+{
+    const shell_command_t *command;
+    uint32_t index;
+
+    (void) argc;
+    (void) argv;
+
+    for (index = 0U; index < SHELL_COMMAND_COUNT; index++)
+    {
+        command = &shell_command_table[shell_command_order[index]];
+        APP_LOG("  %-8s ", command->name);
+        APP_LOG_TEXT(command->help);
+        APP_LOG("\r\n");
+    }
+    APP_LOG("  Up and down arrows recall earlier lines, Ctrl-U clears the "
+            "line\r\n");
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: shell_command_history
+********************************************************************************
+* Summary:
+* This function is the 'history' command. It lists the stored command lines,
+* oldest first.
+*
+* Parameters:
+*  argc        Number of arguments, not used
+*  argv        Arguments, not used
+*
+* Return:
+*  int         0
+*
+*******************************************************************************/
+int shell_command_history(int argc, char *argv[])
+{
+#if !defined(APP_UART_CM0P)
+    uint32_t age;
+#endif
+
+    (void) argc;
+    (void) argv;
+
+#if defined(APP_UART_CM0P)
+    /* The history is kept by the editor on the CM0+ */
+    ipc_console_history();
+#else
+    for (age = shell_edit_history_count(); age > 0U; age--)
+    {
+        APP_LOG("  ");
+        APP_LOG_TEXT(shell_edit_history_line(age));
+        APP_LOG("\r\n");
+    }
+#endif
+
+    return 0;
+}
+
+
+/*******************************************************************************
+* Function Name: shell_split
+********************************************************************************
+* Summary:
+* This function splits a line into arguments in place. Arguments are
+* separated by spaces, double quotes group spaces into one argument.
+*
+* Parameters:
+*  line        NUL terminated line, modified
+*  argv        Array of SHELL_MAX_ARGS + 1 pointers, NULL terminated on
+*              return
+*
+* Return:
+*  int         Number of arguments, -1 for too many arguments or an
+*              unterminated quote
+*
+*******************************************************************************/
+static int shell_split(char *line, char *argv[])
+{
+    char *read = line;
+    char *write;
+    bool quoted;
+    int argc = 0;
+
+    while (true)
+    {
+        while (*read == ' ')
+        {
+            read++;
+        }
+        if (*read == '\0')
+        {
+            break;
+        }
+        if (argc == (int)SHELL_MAX_ARGS)
+        {
+            return -1;
+        }
+
+        /* Copy the argument onto itself without its quotes */
+        argv[argc++] = read;
+        write = read;
+        quoted = false;
+        while ((*read != '\0') && (quoted || (*read != ' ')))
+        {
+            if (*read == '"')
+            {
+                quoted = !quoted;
+            }
+            else
+            {
+                *write++ = *read;
+            }
+            read++;
+        }
+        if (quoted)
+        {
+            return -1;
+        }
+        if (*read != '\0')
+        {
+            read++;
+        }
+        *write = '\0';
+    }
+
+    argv[argc] = NULL;
+
+    return argc;
+}
+
+
+#if !defined(APP_UART_CM0P)
+/*******************************************************************************
+* Function Name: shell_write
+********************************************************************************
+* Summary:
+* This function is the output of the line editor. It goes through the stdio
+* buffer of standard output, so that it stays in order with printf output.
+*
+* Parameters:
+*  data        Characters to write
+*  length      Number of characters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_write(const char *data, size_t length)
+{
+    (void)fwrite(data, 1U, length, stdout);
+}
+
+
+/*******************************************************************************
+* Function Name: shell_line
+********************************************************************************
+* Summary:
+* This function receives the lines completed by the line editor and runs
+* them.
+*
+* Parameters:
+*  line        NUL terminated line
+*  length      Number of characters, not used
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_line(char *line, uint32_t length)
+{
+    (void) length;
+
+    shell_execute(line);
+}
+#endif /* !defined(APP_UART_CM0P) */
+
+/* [] END OF FILE */
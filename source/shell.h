@@ -0,0 +1,140 @@
+/******************************************************************************
+* File Name:   shell.h
+*
+* Description: This file contains the declarations of the line-oriented command
+*              shell on the debug UART. Input is edited in a fixed line buffer
+*              with a short history, and commands are found through a perfect
+*              hash table generated from shell_commands.def.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SHELL_H
+#define SHELL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "cy_device_headers.h"
+#include "shell_commands.h"
+#include "shell_edit.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Most arguments of a command line, the command word included */
+#define SHELL_MAX_ARGS              (8U)
+
+/* Seeded 32-bit FNV-1a, see tools/shell_gen.py */
+#define SHELL_HASH_BASIS            (2166136261UL)
+#define SHELL_HASH_PRIME            (16777619UL)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Handler of a command. argv[0] is the command word. Returns 0 on success,
+ * the shell reports any other value. */
+typedef int (*shell_handler_t)(int argc, char *argv[]);
+
+typedef struct
+{
+    const char *name;
+    uint8_t length;             /* Length of name, 0 for an empty slot */
+    shell_handler_t handler;
+    const char *help;
+} shell_command_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Generated by tools/shell_gen.py in shell_commands.c */
+extern const shell_command_t shell_command_table[SHELL_TABLE_SIZE];
+extern const uint8_t shell_command_order[SHELL_COMMAND_COUNT];
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void shell_init(void (*empty_line)(void));
+void shell_input(const uint8_t *data, size_t length);
+void shell_prompt(void);
+void shell_execute(char *line);
+const shell_command_t *shell_lookup(const char *name, size_t length);
+
+
+/*******************************************************************************
+* Function Name: shell_hash
+********************************************************************************
+* Summary:
+* This function hashes a command word. The generator picks the seed so that
+* the top bits of the hash give every command of the table its own slot.
+*
+* Parameters:
+*  name        Command word, not necessarily NUL terminated
+*  length      Number of characters
+*
+* Return:
+*  uint32_t    Hash value
+*
+*******************************************************************************/
+__STATIC_INLINE uint32_t shell_hash(const char *name, size_t length)
+{
+    uint32_t hash = SHELL_HASH_BASIS ^ SHELL_HASH_SEED;
+    size_t index;
+
+    for (index = 0; index < length; index++)
+    {
+        hash ^= (uint8_t)name[index];
+        hash *= SHELL_HASH_PRIME;
+    }
+
+    return hash;
+}
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SHELL_H */
+
+/* [] END OF FILE */
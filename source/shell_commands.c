@@ -0,0 +1,160 @@
+/******************************************************************************
+* File Name:   shell_commands.c
+*
+* Description: This file is generated by tools/shell_gen.py from
+*              shell_commands.def. Do not edit.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "shell.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Commands by hash slot, empty slots are zero and have a length of 0 */
+const shell_command_t shell_command_table[SHELL_TABLE_SIZE] =
+{
+    [0] =
+    {
+        "mode", 4U, command_mode,
+        "mode [sw|hw]: blink from the soft timer or the PWM"
+    },
+    [1] =
+    {
+        "feed", 4U, command_feed,
+        "feed [cpu|dma]: who writes the RGB LED frames"
+    },
+    [2] =
+    {
+        "gov", 3U, command_gov,
+        "gov [auto|lp|ulp50|ulp25|ulp12|curve]: power governor, pin a point or measure all"
+    },
+    [4] =
+    {
+        "history", 7U, shell_command_history,
+        "List the recent command lines"
+    },
+    [5] =
+    {
+        "pm", 2U, command_pm,
+        "pm [reset]: SysPm handler run times and the Sleep/Deep Sleep latency budget"
+    },
+    [7] =
+    {
+        "idle", 4U, command_idle,
+        "Print the Deep Sleep statistics"
+    },
+    [8] =
+    {
+        "console", 7U, command_console,
+        "console [bench [<lines>]]: CM0+ console counters or log call cost"
+    },
+    [11] =
+    {
+        "profile", 7U, command_profile,
+        "profile [reset]: print or clear the cycle profile"
+    },
+    [12] =
+    {
+        "power", 5U, command_power,
+        "power [reset|record]: time in each power state and wakeup sources"
+    },
+    [13] =
+    {
+        "trace", 5U, command_trace,
+        "trace [dump|clear|cal]: cross-core trace, merged records or timebase check"
+    },
+    [15] =
+    {
+        "freq", 4U, command_freq,
+        "freq [<Hz>]: LED blink frequency, up to 3 decimals"
+    },
+    [16] =
+    {
+        "rpc", 3U, command_rpc,
+        "rpc [bench [<calls>]]: CM0+ RPC server status or call round trip"
+    },
+    [17] =
+    {
+        "rgb", 3U, command_rgb,
+        "rgb [off|breathe|fade|status]: RGB LED pattern, next without argument"
+    },
+    [18] =
+    {
+        "boot", 4U, command_boot,
+        "Print the time of each startup stage"
+    },
+    [20] =
+    {
+        "latency", 7U, command_latency,
+        "latency [reset]: print or clear the event latency"
+    },
+    [23] =
+    {
+        "help", 4U, shell_command_help,
+        "List the commands"
+    },
+    [25] =
+    {
+        "blink", 5U, command_blink,
+        "blink [on|off]: pause or resume the LED blink, also an empty line"
+    },
+    [26] =
+    {
+        "duty", 4U, command_duty,
+        "duty <percent>: LED on time of the PWM blink"
+    },
+    [28] =
+    {
+        "ring", 4U, command_ring,
+        "ring [bench [<count>]]: CM0+ message ring counters or loopback throughput"
+    },
+    [31] =
+    {
+        "wakeups", 7U, command_wakeups,
+        "Print the CPU wakeups per second since the last report"
+    },
+};
+
+/* Slots in the order of shell_commands.def, for the help listing */
+const uint8_t shell_command_order[SHELL_COMMAND_COUNT] =
+{
+    23U, 4U, 25U, 0U, 26U, 15U, 31U, 7U, 12U, 5U, 2U, 16U, 28U, 8U, 18U, 11U, 20U, 13U, 17U, 1U
+};
+
+/* [] END OF FILE */
@@ -0,0 +1,92 @@
+/******************************************************************************
+* File Name:   shell_commands.h
+*
+* Description: This file is generated by tools/shell_gen.py from
+*              shell_commands.def. Do not edit.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SHELL_COMMANDS_H
+#define SHELL_COMMANDS_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Perfect hash of the command names: slot = shell_hash() >> shift */
+#define SHELL_HASH_SEED             (0x00000906UL)
+#define SHELL_HASH_SHIFT            (27U)
+#define SHELL_TABLE_SIZE            (32U)
+#define SHELL_COMMAND_COUNT         (20U)
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+int shell_command_help(int argc, char *argv[]);
+int shell_command_history(int argc, char *argv[]);
+int command_blink(int argc, char *argv[]);
+int command_mode(int argc, char *argv[]);
+int command_duty(int argc, char *argv[]);
+int command_freq(int argc, char *argv[]);
+int command_wakeups(int argc, char *argv[]);
+int command_idle(int argc, char *argv[]);
+int command_power(int argc, char *argv[]);
+int command_pm(int argc, char *argv[]);
+int command_gov(int argc, char *argv[]);
+int command_rpc(int argc, char *argv[]);
+int command_ring(int argc, char *argv[]);
+int command_console(int argc, char *argv[]);
+int command_boot(int argc, char *argv[]);
+int command_profile(int argc, char *argv[]);
+int command_latency(int argc, char *argv[]);
+int command_trace(int argc, char *argv[]);
+int command_rgb(int argc, char *argv[]);
+int command_feed(int argc, char *argv[]);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SHELL_COMMANDS_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,410 @@
+/******************************************************************************
+* File Name:   shell_edit.c
+*
+* Description: This file contains the line editor of the command shell. Received
+*              characters are edited into a line buffer as they arrive, with
+*              backspace, Ctrl-U, Ctrl-C and a history recalled with the arrow
+*              keys of an ANSI terminal. A completed line is handed to the
+*              shell, which may run on the other core.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdbool.h>
+#include <string.h>
+#include "shell_edit.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define SHELL_KEY_CTRL_C            (0x03U)
+#define SHELL_KEY_BACKSPACE         (0x08U)
+#define SHELL_KEY_CTRL_U            (0x15U)
+#define SHELL_KEY_ESCAPE            (0x1BU)
+#define SHELL_KEY_DELETE            (0x7FU)
+
+/* Writes a string literal */
+#define SHELL_EDIT_PUTS(text)       shell_edit_write((text), sizeof(text) - 1U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Progress through an arrow key sequence, ESC [ A or ESC O A */
+typedef enum
+{
+    SHELL_ESCAPE_NONE,
+    SHELL_ESCAPE_START,         /* ESC received */
+    SHELL_ESCAPE_SEQUENCE       /* ESC [ or ESC O received */
+} shell_escape_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static shell_edit_write_t shell_edit_write = NULL;
+static shell_edit_line_t shell_edit_line = NULL;
+
+/* Line being edited */
+static char shell_line[SHELL_LINE_SIZE];
+static uint32_t shell_line_length = 0;
+static shell_escape_t shell_escape = SHELL_ESCAPE_NONE;
+
+/* Ring of the last command lines. shell_history_recall is 0 while a new line
+ * is edited, n while the n-th newest line is shown. */
+static char shell_history[SHELL_HISTORY_DEPTH][SHELL_LINE_SIZE];
+static uint32_t shell_history_count = 0;
+static uint32_t shell_history_newest = 0;
+static uint32_t shell_history_recall = 0;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void shell_key(uint8_t key);
+static void shell_enter(void);
+static void shell_history_add(void);
+static void shell_history_show(uint32_t recall);
+
+
+/*******************************************************************************
+* Function Name: shell_edit_init
+********************************************************************************
+* Summary:
+* This function clears the line buffer and connects the editor to its output
+* and to the receiver of the completed lines.
+*
+* Parameters:
+*  write       Output of the echo and the prompt
+*  line        Function called with each completed line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void shell_edit_init(shell_edit_write_t write, shell_edit_line_t line)
+{
+    shell_edit_write = write;
+    shell_edit_line = line;
+    shell_line_length = 0U;
+    shell_escape = SHELL_ESCAPE_NONE;
+    shell_history_recall = 0U;
+}
+
+
+/*******************************************************************************
+* Function Name: shell_edit_input
+********************************************************************************
+* Summary:
+* This function processes received characters: it edits the line, echoes it
+* and hands it on when Enter is received. It returns when all characters are
+* consumed, a partial line is kept for the next call.
+*
+* Parameters:
+*  data        Received characters
+*  length      Number of characters
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void shell_edit_input(const uint8_t *data, size_t length)
+{
+    size_t index;
+
+    for (index = 0; index < length; index++)
+    {
+        shell_key(data[index]);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: shell_edit_prompt
+********************************************************************************
+* Summary:
+* This function prints the prompt and the line edited so far, for example
+* after other output has been printed.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void shell_edit_prompt(void)
+{
+    SHELL_EDIT_PUTS("\r\x1b[K" SHELL_PROMPT);
+    shell_edit_write(shell_line, shell_line_length);
+}
+
+
+/*******************************************************************************
+* Function Name: shell_edit_history_count
+********************************************************************************
+* Summary:
+* This function returns the number of lines in the history.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    Number of lines, at most SHELL_HISTORY_DEPTH
+*
+*******************************************************************************/
+uint32_t shell_edit_history_count(void)
+{
+    return shell_history_count;
+}
+
+
+/*******************************************************************************
+* Function Name: shell_edit_history_line
+********************************************************************************
+* Summary:
+* This function returns a history entry by age.
+*
+* Parameters:
+*  age         1 for the newest entry, up to shell_edit_history_count()
+*
+* Return:
+*  const char *    NUL terminated line
+*
+*******************************************************************************/
+const char *shell_edit_history_line(uint32_t age)
+{
+    return shell_history[(shell_history_newest + SHELL_HISTORY_DEPTH + 1U - age) %
+                         SHELL_HISTORY_DEPTH];
+}
+
+
+/*******************************************************************************
+* Function Name: shell_key
+********************************************************************************
+* Summary:
+* This function processes one received character.
+*
+* Parameters:
+*  key         Character
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_key(uint8_t key)
+{
+    char echo = (char)key;
+
+    if (shell_escape == SHELL_ESCAPE_START)
+    {
+        shell_escape = ((key == '[') || (key == 'O')) ?
+                       SHELL_ESCAPE_SEQUENCE : SHELL_ESCAPE_NONE;
+        return;
+    }
+
+    if (shell_escape == SHELL_ESCAPE_SEQUENCE)
+    {
+        shell_escape = SHELL_ESCAPE_NONE;
+
+        if ((key == 'A') && (shell_history_recall < shell_history_count))
+        {
+            shell_history_show(shell_history_recall + 1U);
+        }
+        else if ((key == 'B') && (shell_history_recall > 0U))
+        {
+            shell_history_show(shell_history_recall - 1U);
+        }
+        return;
+    }
+
+    switch (key)
+    {
+        case '\r':
+            shell_enter();
+            break;
+
+        case SHELL_KEY_BACKSPACE:
+        case SHELL_KEY_DELETE:
+            if (shell_line_length > 0U)
+            {
+                shell_line_length--;
+                SHELL_EDIT_PUTS("\b \b");
+            }
+            break;
+
+        case SHELL_KEY_CTRL_U:
+            shell_line_length = 0U;
+            shell_edit_prompt();
+            break;
+
+        case SHELL_KEY_CTRL_C:
+            shell_line_length = 0U;
+            shell_history_recall = 0U;
+            SHELL_EDIT_PUTS("^C\r\n");
+            shell_edit_prompt();
+            break;
+
+        case SHELL_KEY_ESCAPE:
+            shell_escape = SHELL_ESCAPE_START;
+            break;
+
+        default:
+            /* '\n' of terminals sending CR LF and other control characters
+             * are ignored */
+            if ((key >= ' ') && (key < SHELL_KEY_DELETE))
+            {
+                if (shell_line_length < (SHELL_LINE_SIZE - 1U))
+                {
+                    shell_line[shell_line_length++] = echo;
+                    shell_edit_write(&echo, 1U);
+                }
+                else
+                {
+                    /* Line full, ring the bell */
+                    SHELL_EDIT_PUTS("\a");
+                }
+            }
+            break;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: shell_enter
+********************************************************************************
+* Summary:
+* This function completes the line. It is stored in the history unless it is
+* empty, and handed on after the editor has started a new line, so that a
+* prompt printed by the receiver shows an empty line. The prompt itself is
+* left to the receiver, which prints it after the output of the command.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_enter(void)
+{
+    uint32_t length = shell_line_length;
+
+    shell_line[length] = '\0';
+    SHELL_EDIT_PUTS("\r\n");
+
+    if (length != 0U)
+    {
+        shell_history_add();
+    }
+
+    shell_line_length = 0U;
+    shell_history_recall = 0U;
+
+    if (shell_edit_line != NULL)
+    {
+        shell_edit_line(shell_line, length);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: shell_history_add
+********************************************************************************
+* Summary:
+* This function stores the line in the history, unless it repeats the newest
+* entry. The oldest entry is overwritten when the history is full.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_history_add(void)
+{
+    if ((shell_history_count > 0U) &&
+        (strcmp(shell_history[shell_history_newest], shell_line) == 0))
+    {
+        return;
+    }
+
+    shell_history_newest = (shell_history_newest + 1U) % SHELL_HISTORY_DEPTH;
+    (void)memcpy(shell_history[shell_history_newest], shell_line,
+                 shell_line_length + 1U);
+
+    if (shell_history_count < SHELL_HISTORY_DEPTH)
+    {
+        shell_history_count++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: shell_history_show
+********************************************************************************
+* Summary:
+* This function replaces the edited line with a history entry, or clears it
+* when going down past the newest entry.
+*
+* Parameters:
+*  recall      1 for the newest entry, 0 for an empty line
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void shell_history_show(uint32_t recall)
+{
+    shell_history_recall = recall;
+
+    if (recall == 0U)
+    {
+        shell_line_length = 0U;
+    }
+    else
+    {
+        shell_line_length = (uint32_t)strlen(shell_edit_history_line(recall));
+        (void)memcpy(shell_line, shell_edit_history_line(recall),
+                     shell_line_length);
+    }
+
+    shell_edit_prompt();
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/******************************************************************************
+* File Name:   shell_edit.h
+*
+* Description: This file contains the declarations of the line editor of the
+*              command shell. It is built into the CM4 image, and into the CM0+
+*              image when that core runs the console.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SHELL_EDIT_H
+#define SHELL_EDIT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Longest command line including the terminating NUL */
+#ifndef SHELL_LINE_SIZE
+#define SHELL_LINE_SIZE             (64U)
+#endif
+
+/* Number of command lines kept for the up and down arrow keys */
+#ifndef SHELL_HISTORY_DEPTH
+#define SHELL_HISTORY_DEPTH         (3U)
+#endif
+
+#define SHELL_PROMPT                "> "
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Output of the editor: echo, prompt and terminal control sequences */
+typedef void (*shell_edit_write_t)(const char *data, size_t length);
+
+/* Receives a completed line. The line is NUL terminated and may be modified;
+ * the editor starts a new line before it calls this function. */
+typedef void (*shell_edit_line_t)(char *line, uint32_t length);
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void shell_edit_init(shell_edit_write_t write, shell_edit_line_t line);
+void shell_edit_input(const uint8_t *data, size_t length);
+void shell_edit_prompt(void);
+uint32_t shell_edit_history_count(void);
+const char *shell_edit_history_line(uint32_t age);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SHELL_EDIT_H */
+
+/* [] END OF FILE */
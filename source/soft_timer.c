@@ -0,0 +1,885 @@
+/******************************************************************************
+* File Name:   soft_timer.c
+*
+* Description: This file contains the software timers that are multiplexed onto
+*              a single hardware timer. Timers are kept in a hierarchical timer
+*              wheel and the hardware compare value is reprogrammed to the next
+*              due deadline.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_tcpwm_counter.h"
+#include "soft_timer.h"
+#include "event_loop.h"
+#include "profile.h"
+#include "power_gov.h"
+#include "timer_cfg.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Each wheel level has 64 slots. A timer is placed on the lowest level whose
+ * span covers its remaining delay and moves down one level each time the
+ * level below wraps, so insert and cancel are O(1). */
+#define WHEEL_LEVEL_BITS            (6U)
+#define WHEEL_LEVEL_SLOTS           (1UL << WHEEL_LEVEL_BITS)
+#define WHEEL_LEVEL_MASK            (WHEEL_LEVEL_SLOTS - 1UL)
+#define WHEEL_LEVELS                (4U)
+
+/* Delays beyond the span of the wheel are parked on the top level and
+ * re-placed every time that slot is cascaded */
+#define WHEEL_SPAN                  (1UL << (WHEEL_LEVEL_BITS * WHEEL_LEVELS))
+
+/* The hardware counter wraps at this period. It fits both the 16-bit and the
+ * 32-bit TCPWM counters. */
+#define HW_TIMER_PERIOD             (0xFFFFUL)
+
+/* Upper bound on the compare distance. The counter is read at least twice
+ * per wrap, which keeps the 32-bit tick extension unambiguous. */
+#define HW_TIMER_MAX_SLEEP          ((HW_TIMER_PERIOD + 1UL) / 2UL)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* The only hardware timer used by the soft timers */
+static cyhal_timer_t soft_timer_hw;
+
+/* Tick rate, kept when the power governor changes CLK_PERI */
+static uint32_t soft_timer_tick_hz;
+static power_gov_notifier_t soft_timer_notifier;
+
+/* Wheel slots and the occupancy bitmap of each level */
+static soft_timer_t *wheel[WHEEL_LEVELS][WHEEL_LEVEL_SLOTS];
+static uint64_t wheel_occupied[WHEEL_LEVELS];
+
+/* Time up to which the wheel has been processed */
+static uint32_t wheel_now = 0;
+
+/* Last raw counter value and the 32-bit extended tick count */
+static uint32_t hw_last_count = 0;
+static uint32_t hw_ticks = 0;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void isr_soft_timer(void *callback_arg, cyhal_timer_event_t event);
+static void soft_timer_handle_event(const event_t *event);
+static void soft_timer_post_tick(void);
+static bool soft_timer_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                    void *arg);
+
+
+/*******************************************************************************
+* Function Name: hw_timer_update
+********************************************************************************
+* Summary:
+* This function reads the hardware counter and extends it to 32 bits.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    Current time in ticks
+*
+*******************************************************************************/
+static uint32_t hw_timer_update(void)
+{
+    uint32_t count = cyhal_timer_read(&soft_timer_hw);
+
+    hw_ticks += (count - hw_last_count) & HW_TIMER_PERIOD;
+    hw_last_count = count;
+
+    return hw_ticks;
+}
+
+
+/*******************************************************************************
+* Function Name: ctz64
+********************************************************************************
+* Summary:
+* This function returns the number of trailing zero bits of a non-zero value.
+*
+* Parameters:
+*  value       Value to scan, must not be zero
+*
+* Return:
+*  uint32_t    Index of the least significant set bit
+*
+*******************************************************************************/
+static uint32_t ctz64(uint64_t value)
+{
+    uint32_t low = (uint32_t)value;
+
+    if (low != 0U)
+    {
+        return __CLZ(__RBIT(low));
+    }
+
+    return 32U + __CLZ(__RBIT((uint32_t)(value >> 32U)));
+}
+
+
+/*******************************************************************************
+* Function Name: wheel_slot_distance
+********************************************************************************
+* Summary:
+* This function returns the distance from 'start' to the first occupied slot
+* of a level, wrapping around the end of the level.
+*
+* Parameters:
+*  level       Wheel level to scan
+*  start       Slot index to start from
+*
+* Return:
+*  uint32_t    Distance in slots, WHEEL_LEVEL_SLOTS if the level is empty
+*
+*******************************************************************************/
+static uint32_t wheel_slot_distance(uint32_t level, uint32_t start)
+{
+    uint64_t occupied = wheel_occupied[level];
+
+    if (occupied == 0U)
+    {
+        return WHEEL_LEVEL_SLOTS;
+    }
+
+    if (start != 0U)
+    {
+        occupied = (occupied >> start) | (occupied << (WHEEL_LEVEL_SLOTS - start));
+    }
+
+    return ctz64(occupied);
+}
+
+
+/*******************************************************************************
+* Function Name: wheel_link
+********************************************************************************
+* Summary:
+* This function places a timer in the wheel slot that matches its expiry time
+* relative to the current wheel time. A timer that is already due is placed
+* in the current slot of the lowest level.
+*
+* Parameters:
+*  timer       Timer to place, must not be linked
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void wheel_link(soft_timer_t *timer)
+{
+    uint32_t delta = timer->expires - wheel_now;
+    uint32_t when = timer->expires;
+    uint32_t level = 0;
+    uint32_t slot;
+    soft_timer_t **head;
+
+    if (delta > SOFT_TIMER_MAX_DELAY)
+    {
+        /* Overdue */
+        delta = 0;
+        when = wheel_now;
+    }
+    else if (delta >= WHEEL_SPAN)
+    {
+        delta = WHEEL_SPAN - 1UL;
+        when = wheel_now + delta;
+    }
+
+    while (delta >= (1UL << (WHEEL_LEVEL_BITS * (level + 1U))))
+    {
+        level++;
+    }
+
+    slot = (when >> (WHEEL_LEVEL_BITS * level)) & WHEEL_LEVEL_MASK;
+    head = &wheel[level][slot];
+
+    timer->next = *head;
+    if (timer->next != NULL)
+    {
+        timer->next->pprev = &timer->next;
+    }
+    timer->pprev = head;
+    timer->slot = (level * WHEEL_LEVEL_SLOTS) + slot;
+    *head = timer;
+
+    wheel_occupied[level] |= (1ULL << slot);
+}
+
+
+/*******************************************************************************
+* Function Name: wheel_unlink
+********************************************************************************
+* Summary:
+* This function removes a timer from its wheel slot.
+*
+* Parameters:
+*  timer       Timer to remove, must be linked
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void wheel_unlink(soft_timer_t *timer)
+{
+    uint32_t level = timer->slot / WHEEL_LEVEL_SLOTS;
+    uint32_t slot = timer->slot % WHEEL_LEVEL_SLOTS;
+
+    *timer->pprev = timer->next;
+    if (timer->next != NULL)
+    {
+        timer->next->pprev = timer->pprev;
+    }
+
+    if (wheel[level][slot] == NULL)
+    {
+        wheel_occupied[level] &= ~(1ULL << slot);
+    }
+
+    timer->next = NULL;
+    timer->pprev = NULL;
+}
+
+
+/*******************************************************************************
+* Function Name: wheel_next_deadline
+********************************************************************************
+* Summary:
+* This function finds the earliest time at which the wheel has work to do,
+* either because a timer on the lowest level expires or because a slot of a
+* higher level has to be cascaded down.
+*
+* Parameters:
+*  deadline    Location to store the deadline in ticks
+*
+* Return:
+*  bool        true if any timer is running
+*
+*******************************************************************************/
+static bool wheel_next_deadline(uint32_t *deadline)
+{
+    bool found = false;
+    uint32_t best = 0;
+    uint32_t level;
+    uint32_t shift;
+    uint32_t block;
+    uint32_t distance;
+    uint32_t candidate;
+
+    for (level = 0; level < WHEEL_LEVELS; level++)
+    {
+        shift = WHEEL_LEVEL_BITS * level;
+        block = wheel_now >> shift;
+
+        /* The current slot of each level has already been handled, so the
+         * search starts at the next one */
+        distance = wheel_slot_distance(level, (block + 1UL) & WHEEL_LEVEL_MASK);
+        if (distance == WHEEL_LEVEL_SLOTS)
+        {
+            continue;
+        }
+
+        candidate = (block + distance + 1UL) << shift;
+        if ((!found) || ((candidate - wheel_now) < (best - wheel_now)))
+        {
+            best = candidate;
+            found = true;
+        }
+    }
+
+    *deadline = best;
+    return found;
+}
+
+
+/*******************************************************************************
+* Function Name: wheel_process_tick
+********************************************************************************
+* Summary:
+* This function moves the wheel to the given time. It cascades every higher
+* level slot that starts at that time and then expires the timers of the
+* current lowest level slot. Periodic timers are reloaded before their
+* callback runs, so a callback may stop or restart its own timer.
+*
+* Parameters:
+*  now         New wheel time, must not skip any deadline
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void wheel_process_tick(uint32_t now)
+{
+    uint32_t level;
+    uint32_t slot;
+    soft_timer_t *timer;
+
+    wheel_now = now;
+
+    for (level = WHEEL_LEVELS - 1U; level > 0U; level--)
+    {
+        if ((now & ((1UL << (WHEEL_LEVEL_BITS * level)) - 1UL)) == 0U)
+        {
+            slot = (now >> (WHEEL_LEVEL_BITS * level)) & WHEEL_LEVEL_MASK;
+            while (wheel[level][slot] != NULL)
+            {
+                timer = wheel[level][slot];
+                wheel_unlink(timer);
+                wheel_link(timer);
+            }
+        }
+    }
+
+    slot = now & WHEEL_LEVEL_MASK;
+    while (wheel[0][slot] != NULL)
+    {
+        timer = wheel[0][slot];
+        wheel_unlink(timer);
+
+        if (timer->period != 0U)
+        {
+            timer->expires += timer->period;
+            wheel_link(timer);
+        }
+
+        timer->callback(timer->callback_arg);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_reprogram
+********************************************************************************
+* Summary:
+* This function programs the hardware compare value to the next wheel
+* deadline. If the deadline has already passed, the timer event is posted
+* directly so that the event loop processes it without waiting for a wrap.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void soft_timer_reprogram(void)
+{
+    uint32_t deadline;
+    uint32_t now;
+    uint32_t delta = HW_TIMER_MAX_SLEEP;
+
+    now = hw_timer_update();
+
+    if (wheel_next_deadline(&deadline))
+    {
+        delta = deadline - now;
+        if ((delta == 0U) || (delta > SOFT_TIMER_MAX_DELAY))
+        {
+            soft_timer_post_tick();
+            return;
+        }
+        if (delta > HW_TIMER_MAX_SLEEP)
+        {
+            delta = HW_TIMER_MAX_SLEEP;
+        }
+    }
+
+    Cy_TCPWM_Counter_SetCompare0(soft_timer_hw.tcpwm.base,
+                                 soft_timer_hw.tcpwm.resource.channel_num,
+                                 (hw_last_count + delta) & HW_TIMER_PERIOD);
+
+    /* The counter may have passed the compare value while it was written */
+    if ((hw_timer_update() - now) >= delta)
+    {
+        soft_timer_post_tick();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_post_tick
+********************************************************************************
+* Summary:
+* This function posts the timer event from thread context. The compare
+* interrupt posts the same event ID, so the post is made with interrupts
+* masked to keep the queue single producer.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void soft_timer_post_tick(void)
+{
+    uint32_t state = cyhal_system_critical_section_enter();
+
+    (void)event_post(EVENT_TIMER_TICK, 0);
+
+    cyhal_system_critical_section_exit(state);
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_handle_event
+********************************************************************************
+* Summary:
+* This function runs from the event loop after the hardware compare interrupt.
+* It processes every wheel deadline up to the current time and reprograms the
+* hardware for the next one.
+*
+* Parameters:
+*  event       Timer event, payload not used
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void soft_timer_handle_event(const event_t *event)
+{
+    uint32_t now;
+    uint32_t deadline;
+
+    (void) event;
+
+    now = hw_timer_update();
+
+    while (wheel_next_deadline(&deadline) &&
+           ((now - wheel_now) >= (deadline - wheel_now)))
+    {
+        wheel_process_tick(deadline);
+    }
+
+    wheel_now = now;
+
+    soft_timer_reprogram();
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_init
+********************************************************************************
+* Summary:
+* This function reserves the hardware timer and starts it as a free running
+* counter in compare mode. The soft timers are serviced from the event loop,
+* so event_loop_init() must have been called before. The tick rate is kept
+* across changes of the power governor.
+*
+* Parameters:
+*  cfg         Timer configuration of TIMER_CFG_INIT(). The soft timers tick
+*              at its rate; the counter always runs free in compare mode.
+*
+* Return:
+*  cy_rslt_t   Result of the hardware timer initialization
+*
+*******************************************************************************/
+cy_rslt_t soft_timer_init(const timer_cfg_t *cfg)
+{
+    cy_rslt_t result;
+    cyhal_timer_cfg_t soft_timer_hw_cfg = cfg->timer;
+
+    /* Free running counter, the first wakeup is reprogrammed on start */
+    soft_timer_hw_cfg.is_continuous = true;
+    soft_timer_hw_cfg.is_compare = true;
+    soft_timer_hw_cfg.period = HW_TIMER_PERIOD;
+    soft_timer_hw_cfg.compare_value = HW_TIMER_MAX_SLEEP;
+    soft_timer_hw_cfg.value = 0U;
+
+    result = cyhal_timer_init(&soft_timer_hw, NC, NULL);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_configure(&soft_timer_hw, &soft_timer_hw_cfg);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_set_frequency(&soft_timer_hw, cfg->tick_hz);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        soft_timer_tick_hz = cfg->tick_hz;
+        soft_timer_notifier.name = "soft_timer";
+        soft_timer_notifier.callback = soft_timer_clock_notify;
+        power_gov_register(&soft_timer_notifier);
+        event_loop_register(EVENT_TIMER_TICK, soft_timer_handle_event);
+
+        cyhal_timer_register_callback(&soft_timer_hw, isr_soft_timer, NULL);
+        cyhal_timer_enable_event(&soft_timer_hw, CYHAL_TIMER_IRQ_CAPTURE_COMPARE,
+                                 SOFT_TIMER_INTR_PRIORITY, true);
+
+        result = cyhal_timer_start(&soft_timer_hw);
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_setup
+********************************************************************************
+* Summary:
+* This function initializes a soft timer object. It must be called once before
+* the timer is started.
+*
+* Parameters:
+*  timer           Timer to initialize
+*  callback        Function called from the event loop on expiry
+*  callback_arg    Argument passed to the callback
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void soft_timer_setup(soft_timer_t *timer, soft_timer_callback_t callback,
+                      void *callback_arg)
+{
+    timer->next = NULL;
+    timer->pprev = NULL;
+    timer->slot = 0;
+    timer->expires = 0;
+    timer->period = 0;
+    timer->callback = callback;
+    timer->callback_arg = callback_arg;
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_start
+********************************************************************************
+* Summary:
+* This function starts or restarts a soft timer. Soft timers must only be
+* started and stopped from the event loop context.
+*
+* Parameters:
+*  timer       Timer to start
+*  delay       Ticks until the first expiry, at least 1 and at most
+*              SOFT_TIMER_MAX_DELAY
+*  period      Ticks between subsequent expiries, 0 for a one-shot timer
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void soft_timer_start(soft_timer_t *timer, uint32_t delay, uint32_t period)
+{
+    CY_ASSERT(delay <= SOFT_TIMER_MAX_DELAY);
+    CY_ASSERT(period <= SOFT_TIMER_MAX_DELAY);
+
+    if (timer->pprev != NULL)
+    {
+        wheel_unlink(timer);
+    }
+
+    if (delay == 0U)
+    {
+        delay = 1;
+    }
+
+    timer->expires = hw_timer_update() + delay;
+    timer->period = period;
+    wheel_link(timer);
+
+    soft_timer_reprogram();
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_stop
+********************************************************************************
+* Summary:
+* This function stops a soft timer. Stopping a timer that is not running has
+* no effect.
+*
+* Parameters:
+*  timer       Timer to stop
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void soft_timer_stop(soft_timer_t *timer)
+{
+    if (timer->pprev != NULL)
+    {
+        wheel_unlink(timer);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_set_period
+********************************************************************************
+* Summary:
+* This function changes the period of a timer from its next expiry on. The
+* pending expiry is kept, so a running periodic timer changes its rate
+* without a gap or a phase jump.
+*
+* Parameters:
+*  timer       Timer to change
+*  period      New ticks between expiries, 0 to make the pending expiry the
+*              last one
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void soft_timer_set_period(soft_timer_t *timer, uint32_t period)
+{
+    CY_ASSERT(period <= SOFT_TIMER_MAX_DELAY);
+
+    timer->period = period;
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_align
+********************************************************************************
+* Summary:
+* This function changes the period of several timers in phase. All of them
+* expire together at the pending expiry of the first timer, or one period
+* from now if it is not running, and continue with their new periods from
+* that common edge.
+*
+* Parameters:
+*  timers      Timers to change, the first one is the phase reference
+*  periods     New period of each timer, at least 1
+*  count       Number of timers
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void soft_timer_align(soft_timer_t *const timers[], const uint32_t periods[],
+                      uint32_t count)
+{
+    uint32_t expires;
+    uint32_t index;
+
+    if (count == 0U)
+    {
+        return;
+    }
+
+    expires = soft_timer_is_active(timers[0]) ? timers[0]->expires :
+              (hw_timer_update() + periods[0]);
+
+    for (index = 0U; index < count; index++)
+    {
+        CY_ASSERT((periods[index] != 0U) &&
+                  (periods[index] <= SOFT_TIMER_MAX_DELAY));
+
+        if (timers[index]->pprev != NULL)
+        {
+            wheel_unlink(timers[index]);
+        }
+
+        timers[index]->expires = expires;
+        timers[index]->period = periods[index];
+        wheel_link(timers[index]);
+    }
+
+    soft_timer_reprogram();
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_is_active
+********************************************************************************
+* Summary:
+* This function checks whether a soft timer is running.
+*
+* Parameters:
+*  timer       Timer to check
+*
+* Return:
+*  bool        true if the timer is running
+*
+*******************************************************************************/
+bool soft_timer_is_active(const soft_timer_t *timer)
+{
+    return (timer->pprev != NULL);
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_now
+********************************************************************************
+* Summary:
+* This function returns the current soft timer time.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    Current time in ticks
+*
+*******************************************************************************/
+uint32_t soft_timer_now(void)
+{
+    return hw_timer_update();
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_next_delay
+********************************************************************************
+* Summary:
+* This function returns the time until the wheel next has to be processed.
+* That is the next expiry or an earlier cascade of a higher wheel level, so
+* the delay may be shorter than that of any running timer.
+*
+* Parameters:
+*  delay       Location to store the ticks until the next deadline, 0 if it
+*              is already due
+*
+* Return:
+*  bool        false if no soft timer is running
+*
+*******************************************************************************/
+bool soft_timer_next_delay(uint32_t *delay)
+{
+    uint32_t deadline;
+    uint32_t now = hw_timer_update();
+
+    if (!wheel_next_deadline(&deadline))
+    {
+        return false;
+    }
+
+    *delay = deadline - now;
+    if (*delay > SOFT_TIMER_MAX_DELAY)
+    {
+        *delay = 0U;
+    }
+
+    return true;
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_advance
+********************************************************************************
+* Summary:
+* This function adds time that passed while the hardware counter was
+* stopped, such as a Deep Sleep measured by another clock. Timers that have
+* become due run from the event loop. It must be called with interrupts
+* masked or from the event loop.
+*
+* Parameters:
+*  ticks       Ticks the hardware counter missed
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void soft_timer_advance(uint32_t ticks)
+{
+    (void)hw_timer_update();
+    hw_ticks += ticks;
+
+    soft_timer_post_tick();
+}
+
+
+/*******************************************************************************
+* Function Name: isr_soft_timer
+********************************************************************************
+* Summary:
+* This is the interrupt handler function for the hardware compare match. The
+* wheel is processed from the event loop.
+*
+* Parameters:
+*    callback_arg    Arguments passed to the interrupt callback
+*    event           Timer/counter interrupt triggers
+*
+* Return:
+*  void
+*******************************************************************************/
+static void isr_soft_timer(void *callback_arg, cyhal_timer_event_t event)
+{
+    (void) callback_arg;
+    (void) event;
+
+    PROFILE_BEGIN(PROFILE_ISR_SOFT_TIMER);
+
+    (void)event_post(EVENT_TIMER_TICK, 0);
+
+    PROFILE_END(PROFILE_ISR_SOFT_TIMER);
+}
+
+
+/*******************************************************************************
+* Function Name: soft_timer_clock_notify
+********************************************************************************
+* Summary:
+* This function is the notifier of the power governor. A CLK_PERI that no
+* integer divider brings to the tick rate is refused; after the change the
+* HAL derives the divider again. The counter keeps its value, so the wheel
+* only sees the ticks of the change itself at the wrong rate.
+*
+* Parameters:
+*  phase       POWER_GOV_CHECK or POWER_GOV_CHANGED
+*  peri_hz     CLK_PERI of the new operating point
+*  arg         Not used
+*
+* Return:
+*  bool        false to refuse the operating point
+*
+*******************************************************************************/
+static bool soft_timer_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                    void *arg)
+{
+    (void)arg;
+
+    if (phase == POWER_GOV_CHECK)
+    {
+        return ((peri_hz % soft_timer_tick_hz) == 0U) &&
+               ((peri_hz / soft_timer_tick_hz) <= TIMER_CFG_MAX_DIVIDER);
+    }
+
+    return cyhal_timer_set_frequency(&soft_timer_hw, soft_timer_tick_hz) ==
+           CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
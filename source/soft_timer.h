@@ -0,0 +1,110 @@
+/******************************************************************************
+* File Name:   soft_timer.h
+*
+* Description: This file contains the declarations of the software timers that
+*              are multiplexed onto a single hardware timer through a
+*              hierarchical timer wheel.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef SOFT_TIMER_H
+#define SOFT_TIMER_H
+
+#include "cyhal.h"
+#include "timer_cfg.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Hardware timer interrupt priority */
+#ifndef SOFT_TIMER_INTR_PRIORITY
+#define SOFT_TIMER_INTR_PRIORITY    (7U)
+#endif
+
+/* Longest delay, in ticks, that a soft timer can be started with */
+#define SOFT_TIMER_MAX_DELAY        (0x7FFFFFFFUL)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Function called from the event loop when a soft timer expires */
+typedef void (*soft_timer_callback_t)(void *callback_arg);
+
+/* Soft timer object. All members are private to soft_timer.c. */
+typedef struct soft_timer
+{
+    struct soft_timer *next;        /* Next timer in the same wheel slot */
+    struct soft_timer **pprev;      /* Link pointing to this timer, NULL when
+                                     * the timer is not running */
+    uint32_t slot;                  /* Wheel slot index, level * 64 + slot */
+    uint32_t expires;               /* Absolute expiry time in ticks */
+    uint32_t period;                /* Reload value in ticks, 0 for one-shot */
+    soft_timer_callback_t callback; /* Function to call on expiry */
+    void *callback_arg;             /* Argument passed to the callback */
+} soft_timer_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t soft_timer_init(const timer_cfg_t *cfg);
+void soft_timer_setup(soft_timer_t *timer, soft_timer_callback_t callback,
+                      void *callback_arg);
+void soft_timer_start(soft_timer_t *timer, uint32_t delay, uint32_t period);
+void soft_timer_stop(soft_timer_t *timer);
+void soft_timer_set_period(soft_timer_t *timer, uint32_t period);
+void soft_timer_align(soft_timer_t *const timers[], const uint32_t periods[],
+                      uint32_t count);
+bool soft_timer_is_active(const soft_timer_t *timer);
+uint32_t soft_timer_now(void);
+bool soft_timer_next_delay(uint32_t *delay);
+void soft_timer_advance(uint32_t ticks);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SOFT_TIMER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,423 @@
+/******************************************************************************
+* File Name:   timebase.c
+*
+* Description: This file contains the CM4 side of the shared timebase. The CM4
+*              starts the counter, counts its wraps, adds the time of each Deep
+*              Sleep and checks the tick rate against the CPU clock.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cyhal.h"
+#include "timebase.h"
+#include "timer_cfg.h"
+#include "cycle_counter.h"
+#include "ipc_shared.h"
+#include "power_gov.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Tick rate, the slowest one that meets TIMEBASE_RESOLUTION_NS */
+#define TIMEBASE_TICK_HZ            \
+    TIMER_CFG_TICK_HZ(TIMER_CFG_DIVIDER(TIMEBASE_RESOLUTION_NS))
+
+/* Block whose counters have 32 bits */
+#define TIMEBASE_TCPWM_BLOCK        (0U)
+
+/* Fractional bits of the 16.5 divider */
+#define TIMEBASE_FRAC_DIVS          (32U)
+
+TIMER_CFG_ASSERT_TICK(TIMEBASE_TICK_HZ);
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static cyhal_timer_t timebase_timer;
+
+/* Own 16.5 divider: it gives TIMEBASE_TICK_HZ on average from the CLK_PERI
+ * of every operating point of the power governor */
+static cyhal_clock_t timebase_clock;
+static power_gov_notifier_t timebase_notifier;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void timebase_isr(void *callback_arg, cyhal_timer_event_t event);
+static void timebase_add(uint64_t ticks);
+static bool timebase_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                  void *arg);
+
+
+/*******************************************************************************
+* Function Name: timebase_init
+********************************************************************************
+* Summary:
+* This function starts the counter of the timebase and publishes it to the
+* CM0+ in ipc_shared. It takes the first free counter, so it runs after the
+* PWMs that need the counter of their pin. The counter runs on a 16.5
+* divider of its own, set again when the power governor changes CLK_PERI.
+* The CM0+ has cleared the state before it started the CM4; until the
+* counter is published, both cores read 0.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  cy_rslt_t   Result of the timer initialization, or
+*              TIMEBASE_RSLT_ERR_NO_COUNTER
+*
+*******************************************************************************/
+cy_rslt_t timebase_init(void)
+{
+    cy_rslt_t result;
+    timebase_t *timebase = &ipc_shared.timebase;
+
+    const cyhal_timer_cfg_t timebase_timer_cfg =
+    {
+        .compare_value = 0,                 /* Not used */
+        .period = (uint32_t)(TIMEBASE_PERIOD - 1U), /* Full 32 bits */
+        .direction = CYHAL_TIMER_DIR_UP,    /* Timer counts up */
+        .is_compare = false,                /* No compare interrupt */
+        .is_continuous = true,              /* Run timer indefinitely */
+        .value = 0                          /* Initial value of counter */
+    };
+
+    result = cyhal_clock_allocate(&timebase_clock,
+                                  CYHAL_CLOCK_BLOCK_PERIPHERAL_16_5BIT);
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_clock_set_frequency(&timebase_clock, TIMEBASE_TICK_HZ,
+                                           NULL);
+        if (result == CY_RSLT_SUCCESS)
+        {
+            result = cyhal_clock_set_enabled(&timebase_clock, true, true);
+        }
+        if (result == CY_RSLT_SUCCESS)
+        {
+            result = cyhal_timer_init(&timebase_timer, NC, &timebase_clock);
+        }
+        if (result != CY_RSLT_SUCCESS)
+        {
+            cyhal_clock_free(&timebase_clock);
+        }
+    }
+
+    if ((result == CY_RSLT_SUCCESS) &&
+        (timebase_timer.tcpwm.resource.block_num != TIMEBASE_TCPWM_BLOCK))
+    {
+        cyhal_timer_free(&timebase_timer);
+        cyhal_clock_free(&timebase_clock);
+        result = TIMEBASE_RSLT_ERR_NO_COUNTER;
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        result = cyhal_timer_configure(&timebase_timer, &timebase_timer_cfg);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        timebase->counter = timebase_timer.tcpwm.resource.channel_num;
+        timebase->tick_hz = TIMEBASE_TICK_HZ;
+        timebase->seq = 0U;
+        timebase->high = 0U;
+
+        timebase_notifier.name = "timebase";
+        timebase_notifier.callback = timebase_clock_notify;
+        power_gov_register(&timebase_notifier);
+
+        cyhal_timer_register_callback(&timebase_timer, timebase_isr, NULL);
+        cyhal_timer_enable_event(&timebase_timer,
+                                 CYHAL_TIMER_IRQ_TERMINAL_COUNT,
+                                 TIMEBASE_INTR_PRIORITY, true);
+
+        result = cyhal_timer_start(&timebase_timer);
+    }
+
+    if (result == CY_RSLT_SUCCESS)
+    {
+        /* The CM0+ only reads the state once it sees the block */
+        __DMB();
+        timebase->base = timebase_timer.tcpwm.base;
+    }
+
+    return result;
+}
+
+
+/*******************************************************************************
+* Function Name: timebase_now
+********************************************************************************
+* Summary:
+* This function returns the 64-bit count of the timebase.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint64_t    Ticks since timebase_init(), 0 before
+*
+*******************************************************************************/
+uint64_t timebase_now(void)
+{
+    return timebase_read(&ipc_shared.timebase);
+}
+
+
+/*******************************************************************************
+* Function Name: timebase_frequency
+********************************************************************************
+* Summary:
+* This function returns the tick rate of the timebase, the one it was started
+* with unless timebase_calibrate() has found it to be off.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    Ticks per second
+*
+*******************************************************************************/
+uint32_t timebase_frequency(void)
+{
+    return ipc_shared.timebase.tick_hz;
+}
+
+
+/*******************************************************************************
+* Function Name: timebase_advance
+********************************************************************************
+* Summary:
+* This function adds the time the counter has not counted, like
+* soft_timer_advance(). The counter stops in Deep Sleep; the idle manager
+* measures the whole time on the LPTimer and passes it here on the wakeup,
+* converted to ticks of the timebase. What the counter has counted of it,
+* while the other core kept the system awake, is not added twice.
+*
+* Parameters:
+*  start       Count of the timebase before the time
+*  elapsed     Length of the time, in ticks of the timebase
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timebase_advance(uint64_t start, uint64_t elapsed)
+{
+    uint64_t counted = timebase_now() - start;
+
+    if (elapsed > counted)
+    {
+        timebase_add(elapsed - counted);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: timebase_calibrate
+********************************************************************************
+* Summary:
+* This function counts the ticks of the timebase over TIMEBASE_CALIBRATE_US of
+* the CPU cycle counter and times TIMEBASE_CALIBRATE_READS reads. Both clocks
+* come from the same FLL, so the measured rate only differs from the set one
+* by the resolution of the measurement, unless CLK_PERI is not what
+* timer_cfg.h assumes. A rate off by more than TIMER_CFG_TOLERANCE_PPM
+* replaces the set one, so that the trace output converts ticks right. It
+* busy-waits the whole time.
+*
+* Parameters:
+*  cal         Location to store the result
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timebase_calibrate(timebase_cal_t *cal)
+{
+    uint32_t window = cycle_counter_per_us() * TIMEBASE_CALIBRATE_US;
+    uint32_t tick_hz = timebase_frequency();
+    uint32_t state;
+    uint32_t start;
+    uint32_t cycles;
+    uint64_t ticks;
+    uint32_t index;
+
+    /* Both counters are read back to back, with nothing in between */
+    state = cyhal_system_critical_section_enter();
+    start = cycle_counter_read();
+    ticks = timebase_now();
+    cyhal_system_critical_section_exit(state);
+
+    while ((cycle_counter_read() - start) < window)
+    {
+    }
+
+    state = cyhal_system_critical_section_enter();
+    cycles = cycle_counter_read() - start;
+    ticks = timebase_now() - ticks;
+
+    start = cycle_counter_read();
+    for (index = 0U; index < TIMEBASE_CALIBRATE_READS; index++)
+    {
+        (void)timebase_now();
+    }
+    cal->read_cycles = (cycle_counter_read() - start) /
+                       TIMEBASE_CALIBRATE_READS;
+    cyhal_system_critical_section_exit(state);
+
+    cal->tick_hz = (uint32_t)((ticks * cycle_counter_per_us() *
+                               TIMER_CFG_US_PER_S) / cycles);
+    cal->error_ppm = 0;
+
+    /* The host clock may not run while the CPU is busy */
+    if (cal->tick_hz != 0U)
+    {
+        cal->error_ppm = (int32_t)((((int64_t)tick_hz - (int64_t)cal->tick_hz) *
+                                    (int64_t)TIMER_CFG_US_PER_S) /
+                                   (int64_t)cal->tick_hz);
+
+        if ((uint32_t)TIMER_CFG_ABS_DIFF(cal->error_ppm, 0) >
+            TIMER_CFG_TOLERANCE_PPM)
+        {
+            ipc_shared.timebase.tick_hz = cal->tick_hz;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: timebase_isr
+********************************************************************************
+* Summary:
+* This function counts a wrap of the counter. The flag is cleared before
+* 'high' grows, all under the odd sequence number: a reader that sees the
+* new 'high' must not also count the flag. The HAL clears the flag again
+* after the callback, which is harmless.
+*
+* Parameters:
+*  callback_arg    Not used
+*  event           The terminal count event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void timebase_isr(void *callback_arg, cyhal_timer_event_t event)
+{
+    timebase_t *timebase = &ipc_shared.timebase;
+
+    (void)callback_arg;
+    (void)event;
+
+    timebase->seq++;
+    __DMB();
+    Cy_TCPWM_ClearInterrupt(timebase->base, timebase->counter,
+                            CY_TCPWM_INT_ON_TC);
+    timebase->high += TIMEBASE_PERIOD;
+    __DMB();
+    timebase->seq++;
+}
+
+
+/*******************************************************************************
+* Function Name: timebase_add
+********************************************************************************
+* Summary:
+* This function adds ticks to 'high' under the sequence number. The wrap
+* interrupt is masked meanwhile, as it updates 'high' too.
+*
+* Parameters:
+*  ticks       Ticks to add
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void timebase_add(uint64_t ticks)
+{
+    timebase_t *timebase = &ipc_shared.timebase;
+    uint32_t state = cyhal_system_critical_section_enter();
+
+    timebase->seq++;
+    __DMB();
+    timebase->high += ticks;
+    __DMB();
+    timebase->seq++;
+
+    cyhal_system_critical_section_exit(state);
+}
+
+
+/*******************************************************************************
+* Function Name: timebase_clock_notify
+********************************************************************************
+* Summary:
+* This function is the notifier of the power governor. A CLK_PERI the 16.5
+* divider cannot bring to TIMEBASE_TICK_HZ exactly, on average, is refused;
+* after the change the divider is set again. Between the two, the power
+* governor corrects the count, see power_gov_change().
+*
+* Parameters:
+*  phase       POWER_GOV_CHECK or POWER_GOV_CHANGED
+*  peri_hz     CLK_PERI of the new operating point
+*  arg         Not used
+*
+* Return:
+*  bool        false to refuse the operating point
+*
+*******************************************************************************/
+static bool timebase_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                  void *arg)
+{
+    (void)arg;
+
+    if (phase == POWER_GOV_CHECK)
+    {
+        return (peri_hz >= TIMEBASE_TICK_HZ) &&
+               ((((uint64_t)peri_hz * TIMEBASE_FRAC_DIVS) %
+                 TIMEBASE_TICK_HZ) == 0U);
+    }
+
+    return cyhal_clock_set_frequency(&timebase_clock, TIMEBASE_TICK_HZ,
+                                     NULL) == CY_RSLT_SUCCESS;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,178 @@
+/******************************************************************************
+* File Name:   timebase.h
+*
+* Description: This file contains the interface of the shared timebase: a TCPWM
+*              counter that both cores read and extend to 64 bits, so that their
+*              trace records can be put in one order.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <stdint.h>
+#include "cy_device_headers.h"
+#include "cy_tcpwm_counter.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Tick of the timebase. 100 ns resolves an RPC round trip, and the 32-bit
+ * counter then wraps every 7 minutes. */
+#define TIMEBASE_RESOLUTION_NS      (100UL)
+
+/* Counter period, and the counter values that are taken to be just after a
+ * wrap when the wrap is still pending */
+#define TIMEBASE_PERIOD             (0x100000000ULL)
+#define TIMEBASE_HALF               (0x80000000UL)
+
+/* Priority of the wrap interrupt on the CM4. It must not be preempted, see
+ * timebase_read(). */
+#define TIMEBASE_INTR_PRIORITY      (0U)
+
+/* Time timebase_calibrate() counts both clocks, and reads it times */
+#define TIMEBASE_CALIBRATE_US       (10000UL)
+#define TIMEBASE_CALIBRATE_READS    (64U)
+
+/* No 32-bit counter was free: only the counters of TCPWM0 have 32 bits */
+#define TIMEBASE_RSLT_ERR_NO_COUNTER \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x17U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* State of the timebase in ipc_shared. The CM4 starts the counter and is the
+ * only one to write here; the CM0+ reads the same counter. The count is
+ * 'high' plus the counter, and 'high' grows by TIMEBASE_PERIOD on every wrap
+ * and by the time spent in Deep Sleep, when the counter stops. */
+typedef struct
+{
+    TCPWM_Type *volatile base;  /* Block of the counter, NULL until started */
+    uint32_t counter;           /* Counter number in the block */
+    volatile uint32_t tick_hz;  /* Tick rate, as set or as calibrated */
+    volatile uint32_t seq;      /* Odd while the CM4 updates 'high' */
+    volatile uint64_t high;     /* Ticks before the current counter period */
+} timebase_t;
+
+/* Result of timebase_calibrate() */
+typedef struct
+{
+    uint32_t tick_hz;           /* Tick rate measured against the CPU clock */
+    int32_t error_ppm;          /* Of the set tick rate against the measured */
+    uint32_t read_cycles;       /* CM4 cycles of one timebase_read() */
+} timebase_cal_t;
+
+
+/*******************************************************************************
+* Function Name: timebase_read
+********************************************************************************
+* Summary:
+* This function returns the 64-bit count of the timebase, on either core.
+* Both see the same counter, so their counts need no offset to be compared.
+*
+* The CM4 counts the wraps in an interrupt, under a sequence number that is
+* odd while it updates 'high'; the read is repeated if the number was odd or
+* has changed. A wrap whose interrupt has not run yet shows in the interrupt
+* flag, which is read after the counter: a set flag with a counter in the
+* lower half means the counter has wrapped before it was read. The wrap
+* interrupt has the highest priority, so a reader on the CM4 never
+* interrupts an update and spins, and a reader with the interrupts masked
+* relies on the flag.
+*
+* Parameters:
+*  timebase    State of the timebase, &ipc_shared.timebase
+*
+* Return:
+*  uint64_t    Ticks since the timebase was started, 0 before
+*
+*******************************************************************************/
+__STATIC_INLINE uint64_t timebase_read(const timebase_t *timebase)
+{
+    TCPWM_Type *base = timebase->base;
+    uint32_t seq;
+    uint64_t high;
+    uint32_t count;
+    uint32_t status;
+
+    if (base == NULL)
+    {
+        return 0U;
+    }
+
+    do
+    {
+        seq = timebase->seq;
+        __DMB();
+        high = timebase->high;
+        count = Cy_TCPWM_Counter_GetCounter(base, timebase->counter);
+        status = Cy_TCPWM_GetInterruptStatus(base, timebase->counter);
+        __DMB();
+    } while (((seq & 1U) != 0U) || (seq != timebase->seq));
+
+    if (((status & CY_TCPWM_INT_ON_TC) != 0U) && (count < TIMEBASE_HALF))
+    {
+        high += TIMEBASE_PERIOD;
+    }
+
+    return high + count;
+}
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+/* CM4 only */
+cy_rslt_t timebase_init(void);
+uint64_t timebase_now(void);
+uint32_t timebase_frequency(void);
+void timebase_advance(uint64_t start, uint64_t elapsed);
+void timebase_calibrate(timebase_cal_t *cal);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TIMEBASE_H */
+
+/* [] END OF FILE */
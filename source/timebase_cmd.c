@@ -0,0 +1,102 @@
+/******************************************************************************
+* File Name:   timebase_cmd.c
+*
+* Description: This file contains the shell command of the shared timebase and
+*              the cross-core trace.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "shell.h"
+#include "timebase.h"
+#include "trace.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Function Name: command_trace
+********************************************************************************
+* Summary:
+* This function is the 'trace' command. It prints the timebase and the trace
+* buffers of both cores, prints their records merged in time order with
+* 'dump', skips the records so far with 'clear', or checks the tick rate of
+* the timebase and the cost of reading it with 'cal'.
+*
+* Parameters:
+*  argc        Number of arguments
+*  argv        Arguments
+*
+* Return:
+*  int         0, or 1 for an unknown argument
+*
+*******************************************************************************/
+int command_trace(int argc, char *argv[])
+{
+    timebase_cal_t cal;
+
+    if (argc == 1)
+    {
+        trace_print_status();
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "dump") == 0))
+    {
+        trace_dump();
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "clear") == 0))
+    {
+        trace_clear();
+    }
+    else if ((argc == 2) && (strcmp(argv[1], "cal") == 0))
+    {
+        timebase_calibrate(&cal);
+
+        APP_LOG("Timebase: %lu Hz measured, %ld ppm off, now %lu Hz\r\n",
+                (unsigned long)cal.tick_hz, (long)cal.error_ppm,
+                (unsigned long)timebase_frequency());
+        APP_LOG("Read: %lu cycles on the CM4\r\n",
+                (unsigned long)cal.read_cycles);
+    }
+    else
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,190 @@
+/******************************************************************************
+* File Name:   timer_cfg.h
+*
+* Description: This file contains macros that derive timer settings at compile
+*              time: the slowest clock divider that meets a tick resolution, and
+*              the period in ticks of a time. TIMER_CFG_INIT() turns them into a
+*              cyhal_timer_cfg_t with its divider. TIMER_CFG_ASSERT_TICK(),
+*              TIMER_CFG_ASSERT_PERIOD() and TIMER_CFG_ASSERT_INIT() stop the
+*              build when a setting cannot be met within its tolerance.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TIMER_CFG_H
+#define TIMER_CFG_H
+
+#include <stdint.h>
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Frequency of CLK_PERI, which feeds the TCPWM clock dividers: CLK_HF0 (the
+ * 100 MHz FLL of design.modus) divided by CY_CFG_SYSCLK_CLKPERI_DIVIDER + 1.
+ * Define it on the command line when the clock configuration changes. */
+#ifndef TIMER_CFG_CLK_PERI_HZ
+#define TIMER_CFG_CLK_PERI_HZ       (100000000UL)
+#endif
+
+/* Largest value of the 16-bit integer clock dividers */
+#define TIMER_CFG_MAX_DIVIDER       (65536UL)
+
+/* Allowed error of a period in TIMER_CFG_ASSERT_PERIOD(), in ppm */
+#define TIMER_CFG_TOLERANCE_PPM     (1000UL)
+
+#define TIMER_CFG_NS_PER_S          (1000000000ULL)
+#define TIMER_CFG_US_PER_S          (1000000ULL)
+
+/* Slowest divider of CLK_PERI whose tick is not longer than resolution_ns.
+ * The counter and its clock tree toggle least at the slowest tick that
+ * still resolves the shortest time the timer has to measure. */
+#define TIMER_CFG_DIVIDER(resolution_ns) \
+    ((uint32_t)(((uint64_t)TIMER_CFG_CLK_PERI_HZ * (resolution_ns)) / \
+                TIMER_CFG_NS_PER_S))
+
+/* Tick rate of a divider of CLK_PERI */
+#define TIMER_CFG_TICK_HZ(divider) \
+    ((uint32_t)(TIMER_CFG_CLK_PERI_HZ / (divider)))
+
+/* Ticks of tick_hz in period_us, rounded to the nearest tick */
+#define TIMER_CFG_TICKS(tick_hz, period_us) \
+    ((uint32_t)((((uint64_t)(tick_hz) * (period_us)) + \
+                 (TIMER_CFG_US_PER_S / 2U)) / TIMER_CFG_US_PER_S))
+
+/* Error of TIMER_CFG_TICKS() against period_us, in ppm, unsigned */
+#define TIMER_CFG_ERROR_PPM(tick_hz, period_us) \
+    ((uint32_t)(TIMER_CFG_ABS_DIFF( \
+        (uint64_t)TIMER_CFG_TICKS(tick_hz, period_us) * TIMER_CFG_US_PER_S, \
+        (uint64_t)(tick_hz) * (period_us)) * TIMER_CFG_US_PER_S / \
+        ((uint64_t)(tick_hz) * (period_us))))
+
+#define TIMER_CFG_ABS_DIFF(a, b)    (((a) > (b)) ? ((a) - (b)) : ((b) - (a)))
+
+/* Divider of TIMER_CFG_INIT(): TIMER_CFG_DIVIDER() of resolution_us, within
+ * the dividers there are. TIMER_CFG_ASSERT_INIT() fails when even the
+ * undivided clock cannot resolve resolution_us. */
+#define TIMER_CFG_INIT_DIVIDER(resolution_us) \
+    ((TIMER_CFG_DIVIDER((resolution_us) * 1000ULL) > TIMER_CFG_MAX_DIVIDER) ? \
+     (uint32_t)TIMER_CFG_MAX_DIVIDER : \
+     (TIMER_CFG_DIVIDER((resolution_us) * 1000ULL) == 0U) ? 1U : \
+     TIMER_CFG_DIVIDER((resolution_us) * 1000ULL))
+
+/* Tick rate and period register value of TIMER_CFG_INIT() */
+#define TIMER_CFG_INIT_HZ(resolution_us) \
+    TIMER_CFG_TICK_HZ(TIMER_CFG_INIT_DIVIDER(resolution_us))
+#define TIMER_CFG_INIT_PERIOD(period_us, resolution_us) \
+    (TIMER_CFG_TICKS(TIMER_CFG_INIT_HZ(resolution_us), period_us) - 1U)
+
+/* Initializer of a timer_cfg_t: a continuous up counter that wraps every
+ * period_us, on the slowest divider of CLK_PERI that resolves resolution_us.
+ * Check it with TIMER_CFG_ASSERT_INIT(). */
+#define TIMER_CFG_INIT(period_us, resolution_us) \
+    { \
+        .timer = \
+        { \
+            .is_continuous = true, \
+            .direction = CYHAL_TIMER_DIR_UP, \
+            .is_compare = false, \
+            .period = TIMER_CFG_INIT_PERIOD(period_us, resolution_us), \
+            .compare_value = 0U, \
+            .value = 0U \
+        }, \
+        .divider = TIMER_CFG_INIT_DIVIDER(resolution_us), \
+        .tick_hz = TIMER_CFG_INIT_HZ(resolution_us) \
+    }
+
+#if defined(__cplusplus)
+#define TIMER_CFG_STATIC_ASSERT     static_assert
+#else
+#define TIMER_CFG_STATIC_ASSERT     _Static_assert
+#endif
+
+/* Stops the build unless an integer divider of CLK_PERI gives tick_hz
+ * exactly. cyhal_timer_set_frequency() then finds that divider. This checks
+ * the LP clock only; the clock notifiers of power_gov.h check the slower
+ * operating points at run time. */
+#define TIMER_CFG_ASSERT_TICK(tick_hz) \
+    TIMER_CFG_STATIC_ASSERT(((tick_hz) > 0U) && \
+                   ((TIMER_CFG_CLK_PERI_HZ % (tick_hz)) == 0U) && \
+                   ((TIMER_CFG_CLK_PERI_HZ / (tick_hz)) <= \
+                    TIMER_CFG_MAX_DIVIDER), \
+                   "No divider of CLK_PERI gives " #tick_hz)
+
+/* Stops the build unless period_us is between 1 and max_ticks ticks of
+ * tick_hz and within TIMER_CFG_TOLERANCE_PPM of a whole number of ticks */
+#define TIMER_CFG_ASSERT_PERIOD(tick_hz, period_us, max_ticks) \
+    TIMER_CFG_STATIC_ASSERT((TIMER_CFG_TICKS(tick_hz, period_us) >= 1U) && \
+                   (TIMER_CFG_TICKS(tick_hz, period_us) <= (max_ticks)) && \
+                   (TIMER_CFG_ERROR_PPM(tick_hz, period_us) <= \
+                    TIMER_CFG_TOLERANCE_PPM), \
+                   #period_us " us is out of range of " #tick_hz " Hz")
+
+/* Stops the build unless TIMER_CFG_INIT(period_us, resolution_us) resolves
+ * resolution_us on an exact tick and its period fits max_ticks */
+#define TIMER_CFG_ASSERT_INIT(period_us, resolution_us, max_ticks) \
+    TIMER_CFG_STATIC_ASSERT(TIMER_CFG_DIVIDER((resolution_us) * 1000ULL) >= \
+                            1U, \
+                   "CLK_PERI cannot resolve " #resolution_us " us"); \
+    TIMER_CFG_ASSERT_TICK(TIMER_CFG_INIT_HZ(resolution_us)); \
+    TIMER_CFG_ASSERT_PERIOD(TIMER_CFG_INIT_HZ(resolution_us), period_us, \
+                            max_ticks)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Timer configuration of TIMER_CFG_INIT() */
+typedef struct
+{
+    cyhal_timer_cfg_t timer;    /* Counter configuration */
+    uint32_t divider;           /* Divider of CLK_PERI */
+    uint32_t tick_hz;           /* CLK_PERI / divider */
+} timer_cfg_t;
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TIMER_CFG_H */
+
+/* [] END OF FILE */
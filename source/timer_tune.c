@@ -0,0 +1,203 @@
+/******************************************************************************
+* File Name:   timer_tune.c
+*
+* Description: This file contains the timer frequency solver. For a source clock
+*              and a requested frequency it searches the clock dividers from the
+*              smallest one whose period fits in the counter, and keeps the
+*              divider and period with the smallest frequency error.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "timer_tune.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define TIMER_TUNE_MHZ_PER_HZ       (1000ULL)
+#define TIMER_TUNE_PPM              (1000000LL)
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static int32_t timer_tune_error_ppm(uint32_t clock_hz, uint32_t freq_mhz,
+                                    uint32_t divider, uint32_t period);
+
+
+/*******************************************************************************
+* Function Name: timer_tune_solve
+********************************************************************************
+* Summary:
+* This function finds the divider and period for a requested frequency. The
+* period is rounded to the nearest tick for every divider tried, and the
+* smallest absolute error wins; on a tie the smaller divider, which gives the
+* finer duty cycle, is kept. The search stops early on an exact match.
+*
+* Parameters:
+*  clock_hz    Frequency of the clock in front of the divider
+*  freq_mhz    Requested frequency in millihertz
+*  max_divider Largest divider, 1 if the clock cannot be divided
+*  max_period  Largest period the counter supports, in ticks
+*  tune        Location to store the divider, period and error
+*
+* Return:
+*  cy_rslt_t   CY_RSLT_SUCCESS, or TIMER_TUNE_RSLT_ERR_RANGE if the frequency
+*              is out of reach
+*
+*******************************************************************************/
+cy_rslt_t timer_tune_solve(uint32_t clock_hz, uint32_t freq_mhz,
+                           uint32_t max_divider, uint32_t max_period,
+                           timer_tune_t *tune)
+{
+    /* Source ticks per requested period, times 1000 */
+    uint64_t ticks_mhz = (uint64_t)clock_hz * TIMER_TUNE_MHZ_PER_HZ;
+    uint64_t divided;
+    uint32_t divider;
+    uint32_t last_divider;
+    uint32_t period;
+    int32_t error_ppm;
+    uint32_t best_error = UINT32_MAX;
+
+    if ((freq_mhz == 0U) || (max_divider == 0U) || (max_period == 0U))
+    {
+        return TIMER_TUNE_RSLT_ERR_RANGE;
+    }
+
+    /* Smallest divider with a period that fits: ticks / (f * max_period) */
+    divider = (uint32_t)((ticks_mhz + ((uint64_t)freq_mhz * max_period) - 1U) /
+                         ((uint64_t)freq_mhz * max_period));
+    if (divider == 0U)
+    {
+        divider = 1U;
+    }
+    if (divider > max_divider)
+    {
+        return TIMER_TUNE_RSLT_ERR_RANGE;
+    }
+
+    last_divider = ((max_divider - divider) < TIMER_TUNE_SEARCH) ?
+                   max_divider : (divider + TIMER_TUNE_SEARCH - 1U);
+
+    for (; (divider <= last_divider) && (divider != 0U); divider++)
+    {
+        divided = (uint64_t)freq_mhz * divider;
+        period = (uint32_t)((ticks_mhz + (divided / 2U)) / divided);
+        if ((period == 0U) || (period > max_period))
+        {
+            continue;
+        }
+
+        error_ppm = timer_tune_error_ppm(clock_hz, freq_mhz, divider, period);
+        if ((uint32_t)((error_ppm < 0) ? -error_ppm : error_ppm) < best_error)
+        {
+            best_error = (uint32_t)((error_ppm < 0) ? -error_ppm : error_ppm);
+            tune->divider = divider;
+            tune->period = period;
+            tune->error_ppm = error_ppm;
+            tune->freq_mhz = (uint32_t)((ticks_mhz +
+                                         ((uint64_t)divider * period / 2U)) /
+                                        ((uint64_t)divider * period));
+
+            if (error_ppm == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    return (best_error == UINT32_MAX) ? TIMER_TUNE_RSLT_ERR_RANGE :
+           CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: timer_tune_print
+********************************************************************************
+* Summary:
+* This function prints a solution with its achieved frequency and error.
+*
+* Parameters:
+*  tune        Solution of timer_tune_solve()
+*  name        Label printed in front
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void timer_tune_print(const timer_tune_t *tune, const char *name)
+{
+    APP_LOG("%s: %lu.%03lu Hz (divider %lu, period %lu), error %ld ppm\r\n",
+            name, (unsigned long)(tune->freq_mhz / 1000U),
+            (unsigned long)(tune->freq_mhz % 1000U),
+            (unsigned long)tune->divider, (unsigned long)tune->period,
+            (long)tune->error_ppm);
+}
+
+
+/*******************************************************************************
+* Function Name: timer_tune_error_ppm
+********************************************************************************
+* Summary:
+* This function computes the frequency error of a divider and period in
+* parts per million, rounded.
+*
+* Parameters:
+*  clock_hz    Frequency of the clock in front of the divider
+*  freq_mhz    Requested frequency in millihertz
+*  divider     Clock divider
+*  period      Counter ticks per period
+*
+* Return:
+*  int32_t     Achieved minus requested frequency, in ppm of the request
+*
+*******************************************************************************/
+static int32_t timer_tune_error_ppm(uint32_t clock_hz, uint32_t freq_mhz,
+                                    uint32_t divider, uint32_t period)
+{
+    /* achieved / requested = clock / (divider * period * f) */
+    uint64_t numerator = (uint64_t)clock_hz * TIMER_TUNE_MHZ_PER_HZ *
+                         (uint64_t)TIMER_TUNE_PPM;
+    uint64_t denominator = (uint64_t)divider * period * freq_mhz;
+
+    return (int32_t)((int64_t)((numerator + (denominator / 2U)) / denominator) -
+                     TIMER_TUNE_PPM);
+}
+
+/* [] END OF FILE */
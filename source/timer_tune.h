@@ -0,0 +1,96 @@
+/******************************************************************************
+* File Name:   timer_tune.h
+*
+* Description: This file contains the declarations of the timer frequency
+*              solver. It picks the clock divider and counter period that come
+*              closest to a requested frequency and reports the frequency error
+*              of the result.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TIMER_TUNE_H
+#define TIMER_TUNE_H
+
+#include <stdint.h>
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Number of dividers tried above the smallest one whose period fits. Larger
+ * dividers can only reduce the error by luck, and they reduce the duty
+ * cycle resolution. */
+#define TIMER_TUNE_SEARCH           (256U)
+
+/* No divider and period within the limits reach the requested frequency */
+#define TIMER_TUNE_RSLT_ERR_RANGE   \
+    CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_MIDDLEWARE_BASE, 0x13U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef struct
+{
+    uint32_t divider;           /* Clock divider, 1 for the undivided clock */
+    uint32_t period;            /* Counter ticks per period */
+    uint32_t freq_mhz;          /* Achieved frequency in millihertz */
+    int32_t error_ppm;          /* Achieved minus requested, in ppm */
+} timer_tune_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t timer_tune_solve(uint32_t clock_hz, uint32_t freq_mhz,
+                           uint32_t max_divider, uint32_t max_period,
+                           timer_tune_t *tune);
+void timer_tune_print(const timer_tune_t *tune, const char *name);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TIMER_TUNE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,539 @@
+/******************************************************************************
+* File Name:   trace.c
+*
+* Description: This file contains the trace buffers. The recording side runs on
+*              both cores; the CM4 also keeps its own buffer and prints both of
+*              them merged in time order for tools/trace_view.py.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <stdio.h>
+#include "cy_device_headers.h"
+#include "cy_syslib.h"
+#include "trace.h"
+#include "timebase.h"
+#include "ipc_shared.h"
+#include "app_log.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Buffers merged by trace_dump() */
+#define TRACE_SOURCES               (2U)
+
+/* Tick counts are printed as two parts of up to 9 digits */
+#define TRACE_TICKS_SPLIT           (1000000000ULL)
+
+/* Marks of the record types in the output */
+#define TRACE_TYPE_CHARS            "BEI"
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Progress of trace_dump() through one buffer */
+typedef struct
+{
+    const trace_buf_t *buf;
+    uint32_t next;              /* Index of the next record to print */
+    uint32_t end;               /* Records written when the dump started */
+    uint32_t lost;              /* Records overwritten before they were read */
+    bool valid;                 /* 'record' holds the record at 'next' */
+    trace_record_t record;
+} trace_cursor_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+trace_buf_t *trace_local = NULL;
+
+/* Buffer of the CM4. The CM0+ image does not reference it, so it is
+ * discarded at its link. */
+static trace_record_t trace_cm4_records[TRACE_CM4_RECORDS];
+static trace_buf_t trace_cm4;
+
+/* Names of the buffers in the output, and where 'trace clear' left them */
+static const char *const trace_source_names[TRACE_SOURCES] =
+{
+    "cm4",
+    "cm0p"
+};
+static uint32_t trace_cleared[TRACE_SOURCES];
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static const trace_buf_t *trace_source(uint32_t source);
+static bool trace_cursor_load(trace_cursor_t *cursor);
+static uint64_t trace_record_time(const trace_record_t *record);
+static void trace_print_ticks(uint64_t ticks);
+
+
+/*******************************************************************************
+* Function Name: trace_buf_init
+********************************************************************************
+* Summary:
+* This function initializes an empty buffer on top of caller-provided
+* storage. The CM0+ buffer is initialized with the shared memory, before the
+* CM4 starts.
+*
+* Parameters:
+*  buf         Buffer to initialize
+*  records     Storage for 'count' records
+*  count       Number of records, a power of two
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_buf_init(trace_buf_t *buf, trace_record_t *records, uint32_t count)
+{
+    buf->records = records;
+    buf->mask = count - 1U;
+    buf->head = 0U;
+}
+
+
+/*******************************************************************************
+* Function Name: trace_start
+********************************************************************************
+* Summary:
+* This function makes a buffer the one the events of this core go to.
+*
+* Parameters:
+*  buf         Buffer of this core
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_start(trace_buf_t *buf)
+{
+    trace_local = buf;
+}
+
+
+/*******************************************************************************
+* Function Name: trace_record
+********************************************************************************
+* Summary:
+* This function appends an event to a buffer, with the current time of the
+* shared timebase. The time is read inside the critical section, so the
+* records of a buffer are in time order even when an interrupt records in
+* between. The head is published after the record.
+*
+* Parameters:
+*  buf         Buffer of the calling core
+*  type        Kind of event
+*  name        Name of the event, a string literal
+*  arg         Value shown with the event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_record(trace_buf_t *buf, trace_type_t type, const char *name,
+                  uint32_t arg)
+{
+    trace_record_t *record;
+    uint64_t time;
+    uint32_t head;
+    uint32_t state = Cy_SysLib_EnterCriticalSection();
+
+    time = timebase_read(&ipc_shared.timebase);
+    head = buf->head;
+    record = &buf->records[head & buf->mask];
+
+    record->time_lo = (uint32_t)time;
+    record->time_hi = (uint16_t)(time >> 32);
+    record->type = (uint16_t)type;
+    record->name = (uint32_t)(uintptr_t)name;
+    record->arg = arg;
+
+    __DMB();
+    buf->head = head + 1U;
+
+    Cy_SysLib_ExitCriticalSection(state);
+}
+
+
+/*******************************************************************************
+* Function Name: trace_event
+********************************************************************************
+* Summary:
+* This function appends an event to the buffer of this core, if tracing has
+* started. Use the TRACE_BEGIN(), TRACE_END() and TRACE_MARK() macros.
+*
+* Parameters:
+*  type        Kind of event
+*  name        Name of the event, a string literal
+*  arg         Value shown with the event
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_event(trace_type_t type, const char *name, uint32_t arg)
+{
+    if (trace_local != NULL)
+    {
+        trace_record(trace_local, type, name, arg);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: trace_get
+********************************************************************************
+* Summary:
+* This function copies a record out of a buffer that its core may be writing
+* meanwhile. The head is read after the copy: the record is intact if it is
+* still among the last 'mask' records. The oldest slot is not trusted, since
+* the writer fills it before it moves the head.
+*
+* Parameters:
+*  buf         Buffer to read
+*  index       Index of the record, counted from the first one written
+*  record      Location to store the record
+*
+* Return:
+*  bool        true if the record was written and is intact
+*
+*******************************************************************************/
+bool trace_get(const trace_buf_t *buf, uint32_t index, trace_record_t *record)
+{
+    *record = buf->records[index & buf->mask];
+    __DMB();
+
+    return ((buf->head - index) - 1U) < buf->mask;
+}
+
+
+/*******************************************************************************
+* Function Name: trace_init
+********************************************************************************
+* Summary:
+* This function starts tracing on the CM4, into its own buffer. The timebase
+* should run first; records made before carry the time 0.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_init(void)
+{
+    trace_buf_init(&trace_cm4, trace_cm4_records, TRACE_CM4_RECORDS);
+    trace_start(&trace_cm4);
+}
+
+
+/*******************************************************************************
+* Function Name: trace_clear
+********************************************************************************
+* Summary:
+* This function makes trace_dump() skip the records written so far. The
+* buffers themselves are only written by their cores.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_clear(void)
+{
+    const trace_buf_t *buf;
+    uint32_t source;
+
+    for (source = 0U; source < TRACE_SOURCES; source++)
+    {
+        buf = trace_source(source);
+        trace_cleared[source] = (buf != NULL) ? buf->head : 0U;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: trace_print_status
+********************************************************************************
+* Summary:
+* This function prints the timebase and the record counts of both buffers.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_print_status(void)
+{
+    const trace_buf_t *buf;
+    uint32_t source;
+
+    APP_LOG("Timebase: %lu Hz, now ",
+            (unsigned long)ipc_shared.timebase.tick_hz);
+    trace_print_ticks(timebase_read(&ipc_shared.timebase));
+    APP_LOG(" ticks\r\n");
+
+    for (source = 0U; source < TRACE_SOURCES; source++)
+    {
+        buf = trace_source(source);
+        if (buf == NULL)
+        {
+            APP_LOG("Trace %s: not running\r\n", trace_source_names[source]);
+            continue;
+        }
+
+        APP_LOG("Trace %s: %lu records, %lu since clear, %lu held\r\n",
+                trace_source_names[source], (unsigned long)buf->head,
+                (unsigned long)(buf->head - trace_cleared[source]),
+                (unsigned long)buf->mask);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: trace_dump
+********************************************************************************
+* Summary:
+* This function prints the records of both buffers since the last clear,
+* merged in time order, one per line:
+*
+*   trace: <ticks> <core> <B|E|I> <name> <arg>
+*
+* after a line with the tick rate. Both cores stamp their records from the
+* same counter, so merging needs no offset. Only the records written when
+* the dump starts are printed; records the cores overwrite while the dump
+* runs are counted as lost. tools/trace_view.py turns the output into a
+* timeline.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void trace_dump(void)
+{
+    trace_cursor_t cursors[TRACE_SOURCES];
+    trace_cursor_t *first;
+    const trace_record_t *record;
+    uint32_t source;
+
+    APP_LOG("trace: hz %lu\r\n", (unsigned long)ipc_shared.timebase.tick_hz);
+
+    for (source = 0U; source < TRACE_SOURCES; source++)
+    {
+        cursors[source].buf = trace_source(source);
+        cursors[source].lost = 0U;
+        cursors[source].valid = false;
+        cursors[source].next = 0U;
+        cursors[source].end = 0U;
+
+        if (cursors[source].buf != NULL)
+        {
+            cursors[source].end = cursors[source].buf->head;
+            cursors[source].next = trace_cleared[source];
+            if ((cursors[source].end - cursors[source].next) >
+                cursors[source].buf->mask)
+            {
+                cursors[source].lost = (cursors[source].end -
+                                        cursors[source].next) -
+                                       cursors[source].buf->mask;
+                cursors[source].next = cursors[source].end -
+                                       cursors[source].buf->mask;
+            }
+        }
+    }
+
+    for (;;)
+    {
+        first = NULL;
+        for (source = 0U; source < TRACE_SOURCES; source++)
+        {
+            if (trace_cursor_load(&cursors[source]) &&
+                ((first == NULL) ||
+                 (trace_record_time(&cursors[source].record) <
+                  trace_record_time(&first->record))))
+            {
+                first = &cursors[source];
+            }
+        }
+        if (first == NULL)
+        {
+            break;
+        }
+
+        record = &first->record;
+        APP_LOG("trace: ");
+        trace_print_ticks(trace_record_time(record));
+        APP_LOG(" %s %c %s %lu\r\n",
+                trace_source_names[first - cursors],
+                (record->type < (sizeof(TRACE_TYPE_CHARS) - 1U)) ?
+                    TRACE_TYPE_CHARS[record->type] : '?',
+                (const char *)(uintptr_t)record->name,
+                (unsigned long)record->arg);
+
+        first->valid = false;
+        first->next++;
+    }
+
+    for (source = 0U; source < TRACE_SOURCES; source++)
+    {
+        if (cursors[source].lost != 0U)
+        {
+            APP_LOG("trace: lost %s %lu\r\n", trace_source_names[source],
+                    (unsigned long)cursors[source].lost);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: trace_source
+********************************************************************************
+* Summary:
+* This function returns a buffer trace_dump() merges. The CM0+ buffer is
+* only there if the CM0+ image has set up the shared memory.
+*
+* Parameters:
+*  source      0 for the CM4, 1 for the CM0+
+*
+* Return:
+*  const trace_buf_t *  Buffer, or NULL if that core does not trace
+*
+*******************************************************************************/
+static const trace_buf_t *trace_source(uint32_t source)
+{
+    if (source == 0U)
+    {
+        return (trace_local == &trace_cm4) ? &trace_cm4 : NULL;
+    }
+
+    return ipc_shared_valid() ? &ipc_shared.trace : NULL;
+}
+
+
+/*******************************************************************************
+* Function Name: trace_cursor_load
+********************************************************************************
+* Summary:
+* This function reads the next record of a cursor, unless it holds it
+* already. Records overwritten meanwhile are skipped and counted as lost.
+*
+* Parameters:
+*  cursor      Cursor of one buffer
+*
+* Return:
+*  bool        true if the cursor holds a record, false at its end
+*
+*******************************************************************************/
+static bool trace_cursor_load(trace_cursor_t *cursor)
+{
+    while ((!cursor->valid) && (cursor->next != cursor->end))
+    {
+        if (trace_get(cursor->buf, cursor->next, &cursor->record))
+        {
+            cursor->valid = true;
+        }
+        else
+        {
+            cursor->lost++;
+            cursor->next++;
+        }
+    }
+
+    return cursor->valid;
+}
+
+
+/*******************************************************************************
+* Function Name: trace_record_time
+********************************************************************************
+* Summary:
+* This function returns the time of a record in ticks of the timebase.
+*
+* Parameters:
+*  record      Record
+*
+* Return:
+*  uint64_t    Low 48 bits of the timebase count when it was recorded
+*
+*******************************************************************************/
+static uint64_t trace_record_time(const trace_record_t *record)
+{
+    return ((uint64_t)record->time_hi << 32) | record->time_lo;
+}
+
+
+/*******************************************************************************
+* Function Name: trace_print_ticks
+********************************************************************************
+* Summary:
+* This function prints a tick count in decimal. The printf of newlib-nano
+* has no 64-bit conversion, so it is printed in two parts.
+*
+* Parameters:
+*  ticks       Tick count
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void trace_print_ticks(uint64_t ticks)
+{
+    if (ticks >= TRACE_TICKS_SPLIT)
+    {
+        APP_LOG("%lu%09lu", (unsigned long)(ticks / TRACE_TICKS_SPLIT),
+                (unsigned long)(ticks % TRACE_TICKS_SPLIT));
+    }
+    else
+    {
+        APP_LOG("%lu", (unsigned long)ticks);
+    }
+}
+
+/* [] END OF FILE */
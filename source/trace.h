@@ -0,0 +1,135 @@
+/******************************************************************************
+* File Name:   trace.h
+*
+* Description: This file contains the interface of the trace buffers. Each core
+*              records begin, end and mark events with a time of the shared
+*              timebase into its own buffer, and the CM4 prints both buffers
+*              merged in time order.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Records of each buffer, powers of two. The CM0+ buffer is in the shared
+ * SRAM, next to the message rings. */
+#define TRACE_CM4_RECORDS           (256U)
+#define TRACE_CM0P_RECORDS          (64U)
+
+/* Records an event on the core's own buffer. The name must be a string
+ * literal: only its address is stored, and the CM4 prints the string from
+ * the flash of either image. */
+#define TRACE_BEGIN(name, arg)      trace_event(TRACE_TYPE_BEGIN, (name), (arg))
+#define TRACE_END(name, arg)        trace_event(TRACE_TYPE_END, (name), (arg))
+#define TRACE_MARK(name, arg)       trace_event(TRACE_TYPE_MARK, (name), (arg))
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+typedef enum
+{
+    TRACE_TYPE_BEGIN,           /* Start of a span */
+    TRACE_TYPE_END,             /* End of the innermost span */
+    TRACE_TYPE_MARK             /* Single point in time */
+} trace_type_t;
+
+/* One event. The time is the low 48 bits of the timebase count, which at
+ * 100 ns wrap after 325 days. */
+typedef struct
+{
+    uint32_t time_lo;
+    uint16_t time_hi;
+    uint16_t type;              /* trace_type_t */
+    uint32_t name;              /* Address of the name string */
+    uint32_t arg;
+} trace_record_t;
+
+/* Buffer of one core, which overwrites its oldest record when full. Only
+ * the core it belongs to writes it, and the CM4 reads it from the other
+ * side without a lock, see trace_get(). */
+typedef struct
+{
+    trace_record_t *records;    /* Storage of 'mask + 1' records */
+    uint32_t mask;              /* Record count minus one */
+    volatile uint32_t head;     /* Records written */
+} trace_buf_t;
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Buffer the events of this core go to, NULL until trace_start() */
+extern trace_buf_t *trace_local;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+void trace_buf_init(trace_buf_t *buf, trace_record_t *records,
+                    uint32_t count);
+void trace_start(trace_buf_t *buf);
+void trace_record(trace_buf_t *buf, trace_type_t type, const char *name,
+                  uint32_t arg);
+void trace_event(trace_type_t type, const char *name, uint32_t arg);
+bool trace_get(const trace_buf_t *buf, uint32_t index, trace_record_t *record);
+
+/* CM4 only */
+void trace_init(void);
+void trace_clear(void);
+void trace_print_status(void);
+void trace_dump(void);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* TRACE_H */
+
+/* [] END OF FILE */
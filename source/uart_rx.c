@@ -0,0 +1,533 @@
+/******************************************************************************
+* File Name:   uart_rx.c
+*
+* Description: This file contains the DMA driven receive ring buffer for the
+*              debug UART. A DataWire channel copies every received byte into
+*              the ring without CPU involvement; the CPU is only interrupted
+*              when half of the ring has been filled and when the line goes
+*              idle.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include "cy_dma.h"
+#include "cy_sysint.h"
+#include "cy_trigmux.h"
+#include "cy_scb_uart.h"
+#include "cyhal_hwmgr.h"
+#include "uart_rx.h"
+#include "event_loop.h"
+#include "soft_timer.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define UART_RX_HALF_SIZE           (UART_RX_BUFFER_SIZE / 2U)
+
+/* Payload of EVENT_UART_RX */
+#define UART_RX_EVENT_ACTIVITY      (0U)    /* First byte after an idle line */
+#define UART_RX_EVENT_HALF_FULL     (1U)    /* A DMA descriptor completed */
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static cyhal_uart_t *uart_rx_uart;
+static uart_rx_callback_t uart_rx_callback;
+
+/* Ring storage and the two descriptors that each fill one half of it */
+static uint8_t uart_rx_buffer[UART_RX_BUFFER_SIZE];
+static cy_stc_dma_descriptor_t uart_rx_descriptor[2];
+
+/* Halves completed by the DMA, incremented by the DMA interrupt */
+static volatile uint32_t uart_rx_halves = 0;
+
+/* Free running write and read positions of the ring */
+static uint32_t uart_rx_head = 0;
+static uint32_t uart_rx_tail = 0;
+
+/* Idle line detection */
+static soft_timer_t uart_rx_idle_timer;
+static uint32_t uart_rx_idle_ticks;
+static uint32_t uart_rx_idle_head = 0;
+
+static uart_rx_stats_t uart_rx_stats;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void isr_uart_rx_dma(void);
+static void isr_uart_rx(void *callback_arg, cyhal_uart_event_t event);
+static void uart_rx_handle_event(const event_t *event);
+static void uart_rx_idle_callback(void *callback_arg);
+
+
+/*******************************************************************************
+* Function Name: uart_rx_dma_position
+********************************************************************************
+* Summary:
+* This function returns the number of bytes the DMA has written since it was
+* started. The DMA progress is the number of completed halves plus the X index
+* of the active descriptor. A half whose completion interrupt is still pending
+* shows up as an active descriptor that does not match the count.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  uint32_t    Free running write position
+*
+*******************************************************************************/
+static uint32_t uart_rx_dma_position(void)
+{
+    uint32_t halves;
+    uint32_t index;
+    cy_stc_dma_descriptor_t *descriptor;
+
+    do
+    {
+        halves = uart_rx_halves;
+        descriptor = Cy_DMA_Channel_GetCurrentDescriptor(UART_RX_DMA_HW,
+                                                         UART_RX_DMA_CHANNEL);
+        index = _FLD2VAL(DW_CH_STRUCT_CH_IDX_X_IDX,
+                         DW_CH_IDX(UART_RX_DMA_HW, UART_RX_DMA_CHANNEL));
+    } while ((halves != uart_rx_halves) ||
+             (descriptor != Cy_DMA_Channel_GetCurrentDescriptor(UART_RX_DMA_HW,
+                                                                UART_RX_DMA_CHANNEL)));
+
+    if (descriptor != &uart_rx_descriptor[halves & 1U])
+    {
+        halves++;
+    }
+
+    return (halves * UART_RX_HALF_SIZE) + index;
+}
+
+
+/*******************************************************************************
+* Function Name: uart_rx_update
+********************************************************************************
+* Summary:
+* This function brings the write position up to date and accounts for ring
+* and receive FIFO overruns. When the DMA has lapped the reader, the unread
+* data is no longer consistent and is discarded.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_rx_update(void)
+{
+    uint32_t head = uart_rx_dma_position();
+
+    uart_rx_stats.bytes_received += head - uart_rx_head;
+    uart_rx_head = head;
+
+    if ((uart_rx_head - uart_rx_tail) > UART_RX_BUFFER_SIZE)
+    {
+        uart_rx_stats.ring_overruns++;
+        uart_rx_stats.bytes_lost += uart_rx_head - uart_rx_tail;
+        uart_rx_tail = uart_rx_head;
+    }
+
+    if ((Cy_SCB_GetRxInterruptStatus(uart_rx_uart->base) &
+         CY_SCB_RX_INTR_OVERFLOW) != 0U)
+    {
+        Cy_SCB_ClearRxInterrupt(uart_rx_uart->base, CY_SCB_RX_INTR_OVERFLOW);
+        uart_rx_stats.fifo_overflows++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: uart_rx_init
+********************************************************************************
+* Summary:
+* This function takes over the receive path of an initialized UART. It
+* reserves and starts the DMA channel that drains the receive FIFO into the
+* ring and enables line activity detection. Soft timers must have been
+* initialized before.
+*
+* Parameters:
+*  uart        UART object, normally cy_retarget_io_uart_obj
+*  idle_ticks  Soft timer ticks without new data after which the line is
+*              considered idle
+*  callback    Function called from the event loop when data is available
+*
+* Return:
+*  cy_rslt_t   Result of the DMA channel reservation
+*
+*******************************************************************************/
+cy_rslt_t uart_rx_init(cyhal_uart_t *uart, uint32_t idle_ticks,
+                       uart_rx_callback_t callback)
+{
+    cy_rslt_t result;
+    uint32_t half;
+    cy_stc_dma_channel_config_t channel_config;
+    const cyhal_resource_inst_t dma_resource =
+    {
+        .type = CYHAL_RSC_DW,
+        .block_num = UART_RX_DMA_BLOCK,
+        .channel_num = UART_RX_DMA_CHANNEL
+    };
+    const cy_stc_sysint_t dma_irq_config =
+    {
+        .intrSrc = UART_RX_DMA_IRQ,
+        .intrPriority = UART_RX_INTR_PRIORITY
+    };
+
+    CY_ASSERT((UART_RX_BUFFER_SIZE % 2U) == 0U);
+    CY_ASSERT(UART_RX_HALF_SIZE <= 256U);
+
+    /* Keep the HAL from handing the channel to another driver */
+    result = cyhal_hwmgr_reserve(&dma_resource);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    uart_rx_uart = uart;
+    uart_rx_callback = callback;
+    uart_rx_idle_ticks = idle_ticks;
+
+    /* Two descriptors chained into a loop, each filling one half of the ring.
+     * The source is the receive FIFO read register, one byte per trigger. */
+    for (half = 0; half < 2U; half++)
+    {
+        const cy_stc_dma_descriptor_config_t descriptor_config =
+        {
+            .retrigger = CY_DMA_WAIT_FOR_REACT,
+            .interruptType = CY_DMA_DESCR,
+            .triggerOutType = CY_DMA_1ELEMENT,
+            .channelState = CY_DMA_CHANNEL_ENABLED,
+            .triggerInType = CY_DMA_1ELEMENT,
+            .dataSize = CY_DMA_BYTE,
+            .srcTransferSize = CY_DMA_TRANSFER_SIZE_WORD,
+            .dstTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+            .descriptorType = CY_DMA_1D_TRANSFER,
+            .srcAddress = (void *)&uart->base->RX_FIFO_RD,
+            .dstAddress = &uart_rx_buffer[half * UART_RX_HALF_SIZE],
+            .srcXincrement = 0,
+            .dstXincrement = 1,
+            .xCount = UART_RX_HALF_SIZE,
+            .srcYincrement = 0,
+            .dstYincrement = 0,
+            .yCount = 1,
+            .nextDescriptor = &uart_rx_descriptor[half ^ 1U]
+        };
+
+        (void)Cy_DMA_Descriptor_Init(&uart_rx_descriptor[half],
+                                     &descriptor_config);
+    }
+
+    channel_config.descriptor = &uart_rx_descriptor[0];
+    channel_config.preemptable = false;
+    channel_config.priority = 0;
+    channel_config.enable = false;
+    channel_config.bufferable = false;
+    (void)Cy_DMA_Channel_Init(UART_RX_DMA_HW, UART_RX_DMA_CHANNEL,
+                              &channel_config);
+
+    (void)Cy_SysInt_Init(&dma_irq_config, isr_uart_rx_dma);
+    NVIC_EnableIRQ(UART_RX_DMA_IRQ);
+    Cy_DMA_Channel_SetInterruptMask(UART_RX_DMA_HW, UART_RX_DMA_CHANNEL,
+                                    CY_DMA_INTR_MASK);
+
+    /* Request a transfer whenever the FIFO holds at least one byte */
+    Cy_SCB_SetRxFifoLevel(uart->base, 0U);
+    (void)Cy_TrigMux_Select(UART_RX_DMA_TRIGGER, false, TRIGGER_TYPE_LEVEL);
+
+    Cy_DMA_Enable(UART_RX_DMA_HW);
+    Cy_DMA_Channel_Enable(UART_RX_DMA_HW, UART_RX_DMA_CHANNEL);
+
+    /* Line activity is detected with the receive-not-empty interrupt. It is
+     * masked while data is flowing and re-enabled once the line is idle. */
+    soft_timer_setup(&uart_rx_idle_timer, uart_rx_idle_callback, NULL);
+    event_loop_register(EVENT_UART_RX, uart_rx_handle_event);
+    cyhal_uart_register_callback(uart, isr_uart_rx, NULL);
+    cyhal_uart_enable_event(uart, CYHAL_UART_IRQ_RX_NOT_EMPTY,
+                            UART_RX_INTR_PRIORITY, true);
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: uart_rx_available
+********************************************************************************
+* Summary:
+* This function returns the number of received bytes that have not been
+* consumed yet.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  size_t      Number of unread bytes
+*
+*******************************************************************************/
+size_t uart_rx_available(void)
+{
+    uart_rx_update();
+
+    return (size_t)(uart_rx_head - uart_rx_tail);
+}
+
+
+/*******************************************************************************
+* Function Name: uart_rx_peek
+********************************************************************************
+* Summary:
+* This function returns the longest contiguous span of unread bytes directly
+* in the ring, without copying. The span stays valid until it is consumed or
+* until the DMA laps the reader, so it must be processed promptly. When the
+* unread data wraps around the end of the ring, a second call after
+* uart_rx_consume() returns the remainder.
+*
+* Parameters:
+*  data        Location to store a pointer to the first unread byte
+*
+* Return:
+*  size_t      Number of bytes in the span, 0 if nothing is available
+*
+*******************************************************************************/
+size_t uart_rx_peek(const uint8_t **data)
+{
+    uint32_t offset;
+    uint32_t length;
+
+    uart_rx_update();
+
+    offset = uart_rx_tail % UART_RX_BUFFER_SIZE;
+    length = uart_rx_head - uart_rx_tail;
+
+    if (length > (UART_RX_BUFFER_SIZE - offset))
+    {
+        length = UART_RX_BUFFER_SIZE - offset;
+    }
+
+    *data = &uart_rx_buffer[offset];
+
+    return (size_t)length;
+}
+
+
+/*******************************************************************************
+* Function Name: uart_rx_consume
+********************************************************************************
+* Summary:
+* This function releases bytes returned by uart_rx_peek().
+*
+* Parameters:
+*  length      Number of bytes to release, at most the length of the span
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_rx_consume(size_t length)
+{
+    CY_ASSERT(length <= (size_t)(uart_rx_head - uart_rx_tail));
+
+    uart_rx_tail += (uint32_t)length;
+}
+
+
+/*******************************************************************************
+* Function Name: uart_rx_get_stats
+********************************************************************************
+* Summary:
+* This function returns a snapshot of the receive statistics.
+*
+* Parameters:
+*  stats       Location to store the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_rx_get_stats(uart_rx_stats_t *stats)
+{
+    uart_rx_update();
+
+    *stats = uart_rx_stats;
+}
+
+
+/*******************************************************************************
+* Function Name: uart_rx_handle_event
+********************************************************************************
+* Summary:
+* This function runs from the event loop when the line becomes active or half
+* of the ring has been filled. It starts idle detection and hands the data to
+* the application.
+*
+* Parameters:
+*  event       Receive event, payload is UART_RX_EVENT_ACTIVITY or
+*              UART_RX_EVENT_HALF_FULL
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_rx_handle_event(const event_t *event)
+{
+    if ((event->data == UART_RX_EVENT_ACTIVITY) &&
+        (!soft_timer_is_active(&uart_rx_idle_timer)))
+    {
+        uart_rx_idle_head = uart_rx_head;
+        soft_timer_start(&uart_rx_idle_timer, uart_rx_idle_ticks,
+                         uart_rx_idle_ticks);
+    }
+
+    if ((uart_rx_available() != 0U) && (uart_rx_callback != NULL))
+    {
+        uart_rx_callback(false);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: uart_rx_idle_callback
+********************************************************************************
+* Summary:
+* This function polls the DMA progress while the line is active. When no byte
+* has arrived for a whole idle period, the line is idle: polling stops and the
+* receive-not-empty interrupt is re-armed to detect the next activity.
+*
+* Parameters:
+*  callback_arg    Argument registered with the soft timer, not used
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+static void uart_rx_idle_callback(void *callback_arg)
+{
+    (void) callback_arg;
+
+    uart_rx_update();
+
+    if (uart_rx_head != uart_rx_idle_head)
+    {
+        uart_rx_idle_head = uart_rx_head;
+        return;
+    }
+
+    soft_timer_stop(&uart_rx_idle_timer);
+    cyhal_uart_enable_event(uart_rx_uart, CYHAL_UART_IRQ_RX_NOT_EMPTY,
+                            UART_RX_INTR_PRIORITY, true);
+    uart_rx_stats.idle_events++;
+
+    /* A byte that arrived just before the interrupt was re-armed keeps the
+     * line active */
+    uart_rx_update();
+    if (uart_rx_head != uart_rx_idle_head)
+    {
+        uart_rx_idle_head = uart_rx_head;
+        soft_timer_start(&uart_rx_idle_timer, uart_rx_idle_ticks,
+                         uart_rx_idle_ticks);
+    }
+
+    if ((uart_rx_available() != 0U) && (uart_rx_callback != NULL))
+    {
+        uart_rx_callback(true);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: isr_uart_rx
+********************************************************************************
+* Summary:
+* This is the interrupt handler function for the UART receive-not-empty
+* interrupt. It only fires for the first byte after an idle line: the
+* interrupt is masked here and the DMA moves the data.
+*
+* Parameters:
+*    callback_arg    Arguments passed to the interrupt callback
+*    event           UART interrupt triggers
+*
+* Return:
+*  void
+*******************************************************************************/
+static void isr_uart_rx(void *callback_arg, cyhal_uart_event_t event)
+{
+    (void) callback_arg;
+
+    if (0U != (event & CYHAL_UART_IRQ_RX_NOT_EMPTY))
+    {
+        cyhal_uart_enable_event(uart_rx_uart, CYHAL_UART_IRQ_RX_NOT_EMPTY,
+                                UART_RX_INTR_PRIORITY, false);
+
+        (void)event_post(EVENT_UART_RX, UART_RX_EVENT_ACTIVITY);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: isr_uart_rx_dma
+********************************************************************************
+* Summary:
+* This is the interrupt handler function for the receive DMA channel. It runs
+* once per filled half of the ring.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*******************************************************************************/
+static void isr_uart_rx_dma(void)
+{
+    uint32_t cause = Cy_DMA_Channel_GetStatus(UART_RX_DMA_HW,
+                                              UART_RX_DMA_CHANNEL);
+
+    Cy_DMA_Channel_ClearInterrupt(UART_RX_DMA_HW, UART_RX_DMA_CHANNEL);
+
+    if (cause == CY_DMA_INTR_CAUSE_COMPLETION)
+    {
+        uart_rx_halves++;
+        (void)event_post(EVENT_UART_RX, UART_RX_EVENT_HALF_FULL);
+    }
+}
+
+/* [] END OF FILE */
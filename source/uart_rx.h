@@ -0,0 +1,111 @@
+/******************************************************************************
+* File Name:   uart_rx.h
+*
+* Description: This file contains the declarations of the DMA driven receive
+*              ring buffer for the debug UART.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef UART_RX_H
+#define UART_RX_H
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the receive ring in bytes. The ring is filled by two chained DMA
+ * descriptors of half this size each, so it must be even and at most 512. */
+#ifndef UART_RX_BUFFER_SIZE
+#define UART_RX_BUFFER_SIZE         (512U)
+#endif
+
+/* DataWire channel that moves bytes from the SCB5 receive FIFO (debug UART,
+ * CYBSP_DEBUG_UART_RX on P5_0) into the ring, and its trigger and interrupt */
+#ifndef UART_RX_DMA_HW
+#define UART_RX_DMA_HW              DW0
+#define UART_RX_DMA_BLOCK           (0U)
+#define UART_RX_DMA_CHANNEL         (27U)
+#define UART_RX_DMA_TRIGGER         TRIG_OUT_1TO1_0_SCB5_RX_TO_PDMA0_TR_IN27
+#define UART_RX_DMA_IRQ             cpuss_interrupts_dw0_27_IRQn
+#endif
+
+/* Receive DMA and receive-not-empty interrupt priority */
+#define UART_RX_INTR_PRIORITY       (7U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Function called from the event loop when received data is available.
+ * 'idle' is true when the line has gone quiet after the data. */
+typedef void (*uart_rx_callback_t)(bool idle);
+
+/* Receive statistics */
+typedef struct
+{
+    uint32_t bytes_received;    /* Bytes written into the ring by the DMA */
+    uint32_t idle_events;       /* Line idle periods detected after data */
+    uint32_t ring_overruns;     /* Times the ring was overwritten unread */
+    uint32_t bytes_lost;        /* Bytes discarded because of ring overruns */
+    uint32_t fifo_overflows;    /* Times the SCB receive FIFO overflowed */
+} uart_rx_stats_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t uart_rx_init(cyhal_uart_t *uart, uint32_t idle_ticks,
+                       uart_rx_callback_t callback);
+size_t uart_rx_available(void);
+size_t uart_rx_peek(const uint8_t **data);
+void uart_rx_consume(size_t length);
+void uart_rx_get_stats(uart_rx_stats_t *stats);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* UART_RX_H */
+
+/* [] END OF FILE */
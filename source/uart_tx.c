@@ -0,0 +1,506 @@
+/******************************************************************************
+* File Name:   uart_tx.c
+*
+* Description: This file contains the non-blocking, DMA driven transmit path of
+*              the debug UART. printf output is copied into a lock-free ring and
+*              a DataWire channel drains it into the UART transmit FIFO, so the
+*              caller only pays for formatting.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#include <string.h>
+#include "cy_dma.h"
+#include "cy_sysint.h"
+#include "cy_trigmux.h"
+#include "cy_scb_uart.h"
+#include "cyhal_hwmgr.h"
+#include "cy_retarget_io.h"
+#include "uart_tx.h"
+#include "idle.h"
+#include "power_gov.h"
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define UART_TX_BUFFER_MASK         (UART_TX_BUFFER_SIZE - 1U)
+
+/* Largest X loop count of a DataWire 1D descriptor */
+#define UART_TX_DMA_MAX_LENGTH      (256U)
+
+/* The transmit FIFO requests data while it holds fewer bytes than this */
+#define UART_TX_FIFO_LEVEL          (63U)
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+static cyhal_uart_t *uart_tx_uart = NULL;
+static volatile uart_tx_policy_t uart_tx_policy;
+
+/* Ring storage. The writer owns 'head', the DMA interrupt owns 'tail' and
+ * 'in_flight', so no lock is needed between them. */
+static uint8_t uart_tx_buffer[UART_TX_BUFFER_SIZE];
+static volatile uint32_t uart_tx_head = 0;
+static volatile uint32_t uart_tx_tail = 0;
+
+/* Number of bytes handed to the DMA, 0 while the channel is idle */
+static uint32_t uart_tx_in_flight = 0;
+
+/* An idle lock is held while the ring is not empty */
+static bool uart_tx_locked = false;
+
+static cy_stc_dma_descriptor_t uart_tx_descriptor;
+static uart_tx_stats_t uart_tx_stats;
+
+/* The baud rate is derived from CLK_PERI, which the power governor changes */
+static power_gov_notifier_t uart_tx_notifier;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+static void isr_uart_tx_dma(void);
+static bool uart_tx_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                 void *arg);
+
+
+/*******************************************************************************
+* Function Name: uart_tx_init
+********************************************************************************
+* Summary:
+* This function takes over the transmit path of an initialized UART. It
+* reserves the DMA channel that feeds the transmit FIFO. From then on printf
+* output is queued instead of written synchronously.
+*
+* Parameters:
+*  uart        UART object, normally cy_retarget_io_uart_obj
+*  policy      Behavior when the ring is full
+*
+* Return:
+*  cy_rslt_t   Result of the DMA channel reservation
+*
+*******************************************************************************/
+cy_rslt_t uart_tx_init(cyhal_uart_t *uart, uart_tx_policy_t policy)
+{
+    cy_rslt_t result;
+    cy_stc_dma_channel_config_t channel_config;
+    const cyhal_resource_inst_t dma_resource =
+    {
+        .type = CYHAL_RSC_DW,
+        .block_num = UART_TX_DMA_BLOCK,
+        .channel_num = UART_TX_DMA_CHANNEL
+    };
+    const cy_stc_sysint_t dma_irq_config =
+    {
+        .intrSrc = UART_TX_DMA_IRQ,
+        .intrPriority = UART_TX_INTR_PRIORITY
+    };
+    const cy_stc_dma_descriptor_config_t descriptor_config =
+    {
+        .retrigger = CY_DMA_WAIT_FOR_REACT,
+        .interruptType = CY_DMA_DESCR,
+        .triggerOutType = CY_DMA_1ELEMENT,
+        .channelState = CY_DMA_CHANNEL_DISABLED,
+        .triggerInType = CY_DMA_1ELEMENT,
+        .dataSize = CY_DMA_BYTE,
+        .srcTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+        .dstTransferSize = CY_DMA_TRANSFER_SIZE_WORD,
+        .descriptorType = CY_DMA_1D_TRANSFER,
+        .srcAddress = uart_tx_buffer,
+        .dstAddress = (void *)&uart->base->TX_FIFO_WR,
+        .srcXincrement = 1,
+        .dstXincrement = 0,
+        .xCount = 1,
+        .srcYincrement = 0,
+        .dstYincrement = 0,
+        .yCount = 1,
+        .nextDescriptor = NULL
+    };
+
+    CY_ASSERT((UART_TX_BUFFER_SIZE & UART_TX_BUFFER_MASK) == 0U);
+
+    /* Keep the HAL from handing the channel to another driver */
+    result = cyhal_hwmgr_reserve(&dma_resource);
+    if (result != CY_RSLT_SUCCESS)
+    {
+        return result;
+    }
+
+    uart_tx_policy = policy;
+
+    (void)Cy_DMA_Descriptor_Init(&uart_tx_descriptor, &descriptor_config);
+
+    channel_config.descriptor = &uart_tx_descriptor;
+    channel_config.preemptable = false;
+    channel_config.priority = 0;
+    channel_config.enable = false;
+    channel_config.bufferable = false;
+    (void)Cy_DMA_Channel_Init(UART_TX_DMA_HW, UART_TX_DMA_CHANNEL,
+                              &channel_config);
+    Cy_DMA_Channel_SetInterruptMask(UART_TX_DMA_HW, UART_TX_DMA_CHANNEL,
+                                    CY_DMA_INTR_MASK);
+    Cy_DMA_Enable(UART_TX_DMA_HW);
+
+    (void)Cy_SysInt_Init(&dma_irq_config, isr_uart_tx_dma);
+    NVIC_EnableIRQ(UART_TX_DMA_IRQ);
+
+    Cy_SCB_SetTxFifoLevel(uart->base, UART_TX_FIFO_LEVEL);
+    (void)Cy_TrigMux_Select(UART_TX_DMA_TRIGGER, false, TRIGGER_TYPE_LEVEL);
+
+    uart_tx_notifier.name = "uart_tx";
+    uart_tx_notifier.callback = uart_tx_clock_notify;
+    power_gov_register(&uart_tx_notifier);
+
+    /* Publish the UART last: printf stays synchronous until here */
+    uart_tx_uart = uart;
+
+    return CY_RSLT_SUCCESS;
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_set_policy
+********************************************************************************
+* Summary:
+* This function changes the behavior of uart_tx_write() when the ring is full.
+*
+* Parameters:
+*  policy      UART_TX_POLICY_BLOCK or UART_TX_POLICY_DROP
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_set_policy(uart_tx_policy_t policy)
+{
+    uart_tx_policy = policy;
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_write
+********************************************************************************
+* Summary:
+* This function copies data into the transmit ring and makes sure the DMA is
+* draining it. It returns as soon as the data is queued. When the ring is full
+* it either sleeps until there is room or drops the remainder, depending on
+* the policy. It must only be called from one context, normally the main
+* loop, and never from an interrupt or a critical section with the blocking
+* policy.
+*
+* Parameters:
+*  data        Bytes to transmit
+*  length      Number of bytes
+*
+* Return:
+*  size_t      Number of bytes queued
+*
+*******************************************************************************/
+size_t uart_tx_write(const void *data, size_t length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    uint32_t head = uart_tx_head;
+    uint32_t space;
+    uint32_t chunk;
+    uint32_t offset;
+    size_t queued = 0;
+
+    while (queued < length)
+    {
+        space = UART_TX_BUFFER_SIZE - (head - uart_tx_tail);
+
+        if (space == 0U)
+        {
+            if (uart_tx_policy == UART_TX_POLICY_DROP)
+            {
+                uart_tx_stats.bytes_dropped += (uint32_t)(length - queued);
+                break;
+            }
+
+            /* The DMA interrupt frees space and wakes the CPU */
+            cyhal_syspm_sleep();
+            continue;
+        }
+
+        /* Copy up to the free space, split at the end of the ring */
+        offset = head & UART_TX_BUFFER_MASK;
+        chunk = (uint32_t)(length - queued);
+        if (chunk > space)
+        {
+            chunk = space;
+        }
+        if (chunk > (UART_TX_BUFFER_SIZE - offset))
+        {
+            chunk = UART_TX_BUFFER_SIZE - offset;
+        }
+
+        memcpy(&uart_tx_buffer[offset], &bytes[queued], chunk);
+
+        /* The data must be visible before the DMA interrupt sees the head */
+        __DMB();
+        head += chunk;
+        uart_tx_head = head;
+        queued += chunk;
+
+        if ((head - uart_tx_tail) > uart_tx_stats.peak_occupancy)
+        {
+            uart_tx_stats.peak_occupancy = head - uart_tx_tail;
+        }
+
+        /* Let the DMA interrupt start a transfer if the channel is idle */
+        NVIC_SetPendingIRQ(UART_TX_DMA_IRQ);
+    }
+
+    uart_tx_stats.bytes_queued += (uint32_t)queued;
+
+    return queued;
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_flush
+********************************************************************************
+* Summary:
+* This function waits until the ring is empty and the UART has shifted out
+* the last byte.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_flush(void)
+{
+    while (uart_tx_tail != uart_tx_head)
+    {
+        cyhal_syspm_sleep();
+    }
+
+    if (uart_tx_uart != NULL)
+    {
+        while (cyhal_uart_is_tx_active(uart_tx_uart))
+        {
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_get_stats
+********************************************************************************
+* Summary:
+* This function returns a snapshot of the transmit statistics.
+*
+* Parameters:
+*  stats       Location to store the statistics
+*
+* Return:
+*  void
+*
+*******************************************************************************/
+void uart_tx_get_stats(uart_tx_stats_t *stats)
+{
+    *stats = uart_tx_stats;
+}
+
+
+/*******************************************************************************
+* Function Name: isr_uart_tx_dma
+********************************************************************************
+* Summary:
+* This is the interrupt handler function for the transmit DMA channel. It
+* runs when a transfer completes and when the writer pends it after queuing
+* data. It retires the completed transfer and starts the next one on the
+* longest contiguous span of queued data. This is the only place a transfer
+* is started, so no lock is needed against the writer.
+*
+* Parameters:
+*  none
+*
+* Return:
+*  void
+*******************************************************************************/
+static void isr_uart_tx_dma(void)
+{
+    uint32_t tail = uart_tx_tail;
+    uint32_t length;
+    uint32_t offset;
+
+    if ((Cy_DMA_Channel_GetInterruptStatus(UART_TX_DMA_HW, UART_TX_DMA_CHANNEL)
+         & CY_DMA_INTR_MASK) != 0U)
+    {
+        Cy_DMA_Channel_ClearInterrupt(UART_TX_DMA_HW, UART_TX_DMA_CHANNEL);
+
+        tail += uart_tx_in_flight;
+        uart_tx_tail = tail;
+        uart_tx_in_flight = 0;
+    }
+
+    if (uart_tx_in_flight != 0U)
+    {
+        /* Pended by the writer while a transfer is still running */
+        return;
+    }
+
+    /* The DMA stops in Deep Sleep, so the system stays awake until the ring
+     * has drained. The UART driver itself refuses Deep Sleep until the FIFO
+     * is empty. */
+    length = uart_tx_head - tail;
+    if (length == 0U)
+    {
+        if (uart_tx_locked)
+        {
+            uart_tx_locked = false;
+            idle_unlock();
+        }
+        return;
+    }
+    if (!uart_tx_locked)
+    {
+        uart_tx_locked = true;
+        idle_lock();
+    }
+
+    offset = tail & UART_TX_BUFFER_MASK;
+    if (length > (UART_TX_BUFFER_SIZE - offset))
+    {
+        length = UART_TX_BUFFER_SIZE - offset;
+    }
+    if (length > UART_TX_DMA_MAX_LENGTH)
+    {
+        length = UART_TX_DMA_MAX_LENGTH;
+    }
+
+    /* Read the data only after observing the head that published it */
+    __DMB();
+
+    Cy_DMA_Descriptor_SetSrcAddress(&uart_tx_descriptor, &uart_tx_buffer[offset]);
+    Cy_DMA_Descriptor_SetXloopDataCount(&uart_tx_descriptor, length);
+    Cy_DMA_Channel_SetDescriptor(UART_TX_DMA_HW, UART_TX_DMA_CHANNEL,
+                                 &uart_tx_descriptor);
+
+    uart_tx_in_flight = length;
+    Cy_DMA_Channel_Enable(UART_TX_DMA_HW, UART_TX_DMA_CHANNEL);
+}
+
+
+/*******************************************************************************
+* Function Name: uart_tx_clock_notify
+********************************************************************************
+* Summary:
+* This function is the notifier of the power governor. The ring is drained
+* before the change, so that no byte is shifted out at a wrong bit rate,
+* and the HAL derives the divider of the baud rate again after it.
+*
+* Parameters:
+*  phase       POWER_GOV_CHECK or POWER_GOV_CHANGED
+*  peri_hz     CLK_PERI of the new operating point, not used
+*  arg         Not used
+*
+* Return:
+*  bool        true, the UART takes every operating point
+*
+*******************************************************************************/
+static bool uart_tx_clock_notify(power_gov_phase_t phase, uint32_t peri_hz,
+                                 void *arg)
+{
+    (void)peri_hz;
+    (void)arg;
+
+    if (phase == POWER_GOV_CHECK)
+    {
+        uart_tx_flush();
+        return true;
+    }
+
+    return cyhal_uart_set_baud(uart_tx_uart, CY_RETARGET_IO_BAUDRATE, NULL) ==
+           CY_RSLT_SUCCESS;
+}
+
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION) && !defined(APP_UART_CM0P)
+/*******************************************************************************
+* Function Name: _write
+********************************************************************************
+* Summary:
+* This function overrides the weak retarget-io implementation used by the GCC
+* C library for stdout. Output is queued on the transmit ring once
+* uart_tx_init() has run, and written synchronously before that.
+*
+* Parameters:
+*  fd          File descriptor, not used
+*  ptr         Characters to write
+*  len         Number of characters
+*
+* Return:
+*  int         Number of characters consumed
+*
+*******************************************************************************/
+int _write(int fd, const char *ptr, int len)
+{
+    int index;
+
+    (void) fd;
+
+    if ((ptr == NULL) || (len <= 0))
+    {
+        return 0;
+    }
+
+    if (uart_tx_uart != NULL)
+    {
+        /* Dropped characters are counted, not reported as an error */
+        (void)uart_tx_write(ptr, (size_t)len);
+    }
+    else
+    {
+        for (index = 0; index < len; index++)
+        {
+            (void)cyhal_uart_putc(&cy_retarget_io_uart_obj,
+                                  (uint32_t)ptr[index]);
+        }
+    }
+
+    return len;
+}
+#endif /* defined(__GNUC__) && !defined(__ARMCC_VERSION) &&
+        * !defined(APP_UART_CM0P) */
+
+/* [] END OF FILE */
@@ -0,0 +1,111 @@
+/******************************************************************************
+* File Name:   uart_tx.h
+*
+* Description: This file contains the declarations of the non-blocking, DMA
+*              driven transmit path of the debug UART used by printf.
+*
+* Related Document: See README.md
+*
+*
+*******************************************************************************
+* Copyright 2022-2024, Cypress Semiconductor Corporation (an Infineon company) or
+* an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+*
+* This software, including source code, documentation and related
+* materials ("Software") is owned by Cypress Semiconductor Corporation
+* or one of its affiliates ("Cypress") and is protected by and subject to
+* worldwide patent protection (United States and foreign),
+* United States copyright laws and international treaty provisions.
+* Therefore, you may use this Software only as provided in the license
+* agreement accompanying the software package from which you
+* obtained this Software ("EULA").
+* If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+* non-transferable license to copy, modify, and compile the Software
+* source code solely for use in connection with Cypress's
+* integrated circuit products.  Any reproduction, modification, translation,
+* compilation, or representation of this Software except as specified
+* above is prohibited without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+* reserves the right to make changes to the Software without notice. Cypress
+* does not assume any liability arising out of the application or use of the
+* Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use in any products where a malfunction or
+* failure of the Cypress product may reasonably be expected to result in
+* significant property damage, injury or death ("High Risk Product"). By
+* including Cypress's product in a High Risk Product, the manufacturer
+* of such system or application assumes all risk of such use and in doing
+* so agrees to indemnify Cypress against all liability.
+*******************************************************************************/
+
+#ifndef UART_TX_H
+#define UART_TX_H
+
+#include "cyhal.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Size of the transmit ring in bytes, must be a power of two */
+#ifndef UART_TX_BUFFER_SIZE
+#define UART_TX_BUFFER_SIZE         (1024U)
+#endif
+
+/* DataWire channel that moves bytes from the ring into the SCB5 transmit
+ * FIFO (debug UART, CYBSP_DEBUG_UART_TX on P5_1), and its trigger and
+ * interrupt */
+#ifndef UART_TX_DMA_HW
+#define UART_TX_DMA_HW              DW0
+#define UART_TX_DMA_BLOCK           (0U)
+#define UART_TX_DMA_CHANNEL         (26U)
+#define UART_TX_DMA_TRIGGER         TRIG_OUT_1TO1_0_SCB5_TX_TO_PDMA0_TR_IN26
+#define UART_TX_DMA_IRQ             cpuss_interrupts_dw0_26_IRQn
+#endif
+
+/* Transmit DMA interrupt priority */
+#define UART_TX_INTR_PRIORITY       (7U)
+
+
+/*******************************************************************************
+* Data Types
+*******************************************************************************/
+/* Behavior of uart_tx_write() when the ring is full */
+typedef enum
+{
+    UART_TX_POLICY_BLOCK,       /* Sleep until the DMA has made room */
+    UART_TX_POLICY_DROP         /* Discard what does not fit and count it */
+} uart_tx_policy_t;
+
+/* Transmit statistics */
+typedef struct
+{
+    uint32_t bytes_queued;      /* Bytes accepted into the ring */
+    uint32_t bytes_dropped;     /* Bytes discarded because the ring was full */
+    uint32_t peak_occupancy;    /* Highest number of bytes held in the ring */
+} uart_tx_stats_t;
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+cy_rslt_t uart_tx_init(cyhal_uart_t *uart, uart_tx_policy_t policy);
+void uart_tx_set_policy(uart_tx_policy_t policy);
+size_t uart_tx_write(const void *data, size_t length);
+void uart_tx_flush(void);
+void uart_tx_get_stats(uart_tx_stats_t *stats);
+
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* UART_TX_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,173 @@
+#!/usr/bin/env python3
+"""Decodes the tokenized log output of the application back to text.
+
+Build the application with DEFINES=APP_LOG_TOKENIZED, then run for example
+
+    stty -F /dev/ttyACM0 115200 raw
+    python3 tools/app_log_decode.py \
+        build/APP_CY8CKIT-062S2-43012/Debug/mtb-example-hal-hello-world.elf \
+        /dev/ttyACM0
+
+The format strings are read from the non-loaded .app_log_fmt section of the
+ELF file. Plain text on the UART (the printf output) is passed through as is,
+tokenized frames are formatted and printed in its place. The wire format is
+described in source/app_log.c.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+FRAME_MARKER = 0x00
+SECTION_NAME = ".app_log_fmt"
+
+# Conversion specifications of printf, with the pieces python does not know
+# (length modifiers) split out
+CONVERSION = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<precision>\*|\d+))?"
+    r"(?P<length>hh|h|ll|l|j|z|t|L)?(?P<conversion>[diouxXcsfFeEgGaAp%])")
+
+
+def load_format_section(elf_path):
+    """Returns (address, bytes) of the format string section of the ELF."""
+    with open(elf_path, "rb") as elf_file:
+        elf = elf_file.read()
+
+    if elf[:4] != b"\x7fELF":
+        raise ValueError("%s is not an ELF file" % elf_path)
+    is_64 = elf[4] == 2
+    endian = "<" if elf[5] == 1 else ">"
+
+    if is_64:
+        shoff, = struct.unpack_from(endian + "Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x3A)
+        header = endian + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(endian + "I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + "HHH", elf, 0x2E)
+        header = endian + "IIIIIIIIII"
+
+    sections = [struct.unpack_from(header, elf, shoff + index * shentsize)
+                for index in range(shnum)]
+    names_offset = sections[shstrndx][4]
+
+    for name, _, _, address, offset, size, _, _, _, _ in sections:
+        end = elf.index(b"\0", names_offset + name)
+        if elf[names_offset + name:end].decode() == SECTION_NAME:
+            return address, elf[offset:offset + size]
+
+    raise ValueError("%s has no %s section, was the application built with "
+                     "DEFINES=APP_LOG_TOKENIZED?" % (elf_path, SECTION_NAME))
+
+
+def read_varint(payload, position):
+    value = 0
+    shift = 0
+    while True:
+        byte = payload[position]
+        position += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte < 0x80:
+            return value, position
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def format_entry(fmt, payload, position):
+    """Formats one log entry, consuming its arguments from the payload."""
+    output = []
+    last = 0
+
+    for match in CONVERSION.finditer(fmt):
+        output.append(fmt[last:match.start()])
+        last = match.end()
+        conversion = match.group("conversion")
+        if conversion == "%":
+            output.append("%")
+            continue
+
+        if position >= len(payload):
+            output.append("<truncated>")
+            break
+
+        length = match.group("length") or ""
+        if conversion == "s":
+            size = payload[position]
+            value = payload[position + 1:position + 1 + size].decode(
+                "utf-8", "replace")
+            position += 1 + size
+        elif conversion in "fFeEgGaA":
+            value, = struct.unpack_from("<f", payload, position)
+            position += 4
+        else:
+            value, position = read_varint(payload, position)
+            value = unzigzag(value)
+            if conversion in "ouxXp" and value < 0:
+                value &= (1 << 64) - 1 if length in ("ll", "j") else 0xFFFFFFFF
+
+        spec = "%" + match.group("flags") + (match.group("width") or "")
+        if match.group("precision") is not None:
+            spec += "." + match.group("precision")
+        if conversion == "p":
+            output.append("0x%08x" % value)
+        elif conversion in "aA":
+            output.append(float(value).hex())
+        else:
+            output.append((spec + conversion) % value)
+
+    output.append(fmt[last:])
+    return "".join(output)
+
+
+def decode_stream(stream, address, section, out):
+    """Copies text through and replaces each frame by its formatted entry."""
+    while True:
+        byte = stream.read(1)
+        if not byte:
+            return
+        if byte[0] != FRAME_MARKER:
+            out.write(byte.decode("latin-1"))
+            continue
+
+        length = stream.read(1)
+        if not length:
+            return
+        payload = stream.read(length[0])
+
+        try:
+            token, position = read_varint(payload, 0)
+            offset = token - address
+            if not 0 <= offset < len(section):
+                raise ValueError("unknown token 0x%x" % token)
+            fmt = section[offset:section.index(b"\0", offset)].decode()
+            out.write(format_entry(fmt, payload, position))
+        except (IndexError, ValueError, struct.error) as error:
+            out.write("<bad frame: %s>\n" % error)
+        out.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("elf", help="application ELF file")
+    parser.add_argument("input", nargs="?", default="-",
+                        help="serial device or capture file, - for stdin")
+    arguments = parser.parse_args()
+
+    address, section = load_format_section(arguments.elf)
+    if arguments.input == "-":
+        stream = sys.stdin.buffer
+    else:
+        stream = open(arguments.input, "rb", buffering=0)
+
+    try:
+        decode_stream(stream, address, section, sys.stdout)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
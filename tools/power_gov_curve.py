@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+"""Turns the measurements of the power governor into a power/latency curve.
+
+Run the 'gov curve' command on the debug UART and pass the output, for
+example
+
+    python3 tools/power_gov_curve.py capture.txt
+
+The last measurement of each operating point in the input is used; the line
+format is described at gov_curve() in source/power_gov_cmd.c. The current of
+a point is modelled as a base current plus a current per MHz of CLK_HF0,
+running and in Sleep, with separate figures for the LP and the ULP regulator
+mode. The defaults are typical PSoC 62 figures at 3.3 V on the buck regulator with the
+CM0+ asleep. They are only a starting point: take the figures of the actual
+operating points from the datasheet or a measurement.
+
+For each point the latency of the work unit and of a call to the CM0+, the
+active current and the charge of a work unit are printed, then the charge
+of a change into the point and back and the Sleep time it takes to recover
+it. The curve gives the average current at a few loads, expressed as the
+share of the time the work keeps LP busy.
+"""
+
+import argparse
+import re
+import sys
+
+CURVE_LINE = re.compile(
+    r"gov curve: (\w+) (\d+) ([01]) (\d+) (\d+) (\d+) (\d+)")
+REFUSED_LINE = re.compile(r"gov curve: (\w+) not reached(.*)")
+
+LOADS = (0.01, 0.05, 0.10, 0.25, 0.50, 0.90)
+
+
+def parse_curve(lines):
+    """Returns the points and the points not reached, in input order.
+
+    A point is a dict of name, hz, ulp and the enter, exit, work and call
+    times in ns. A point not reached is (name, reason).
+    """
+    points = {}
+    missed = {}
+
+    for line in lines:
+        match = CURVE_LINE.search(line)
+        if match:
+            name = match.group(1)
+            missed.pop(name, None)
+            points[name] = {
+                "name": name,
+                "hz": int(match.group(2)),
+                "ulp": match.group(3) == "1",
+                "enter_ns": int(match.group(4)),
+                "exit_ns": int(match.group(5)),
+                "work_ns": int(match.group(6)),
+                "call_ns": int(match.group(7)),
+            }
+            continue
+        match = REFUSED_LINE.search(line)
+        if match:
+            points.pop(match.group(1), None)
+            missed[match.group(1)] = match.group(2).lstrip(", ")
+
+    return list(points.values()), list(missed.items())
+
+
+def current_ma(point, arguments, sleeping):
+    """Returns the modelled current of a point in mA."""
+    mode = "ulp" if point["ulp"] else "lp"
+    state = "sleep" if sleeping else "active"
+    base = getattr(arguments, "%s_%s_ma" % (mode, state))
+    per_mhz = getattr(arguments, "%s_%s_ma_mhz" % (mode, state))
+    return base + per_mhz * point["hz"] / 1e6
+
+
+def average_ma(point, arguments, rate):
+    """Returns the average current in mA at rate work units per second.
+
+    None is returned when the point cannot keep up with the rate.
+    """
+    busy = rate * point["work_ns"] / 1e9
+    if busy > 1.0:
+        return None
+    return (busy * current_ma(point, arguments, False) +
+            (1.0 - busy) * current_ma(point, arguments, True))
+
+
+def report(points, missed, arguments, out):
+    for name, reason in missed:
+        out.write("%s not reached%s\n" % (name, ", " + reason
+                                           if reason else ""))
+    if not points:
+        return
+
+    lp = next((point for point in points if not point["ulp"]), points[0])
+
+    out.write("%-6s %9s %4s %9s %9s %9s %9s\n"
+              % ("Point", "CLK_HF0", "mode", "work us", "call us",
+                 "active mA", "work nC"))
+    for point in points:
+        active = current_ma(point, arguments, False)
+        out.write("%-6s %5.1f MHz %4s %9.3f %9.3f %9.3f %9.3f\n"
+                  % (point["name"], point["hz"] / 1e6,
+                     "ULP" if point["ulp"] else "LP",
+                     point["work_ns"] / 1e3, point["call_ns"] / 1e3,
+                     active, active * point["work_ns"] / 1e3))
+
+    out.write("\n%-6s %9s %9s %10s %12s\n"
+              % ("Point", "enter us", "exit us", "change nC",
+                 "break-even ms"))
+    for point in points:
+        if point is lp:
+            continue
+        # The change runs with the interrupts off; charge it the higher
+        # of the two active currents.
+        change_nc = ((point["enter_ns"] + point["exit_ns"]) / 1e3 *
+                     max(current_ma(point, arguments, False),
+                         current_ma(lp, arguments, False)))
+        saving_ma = (current_ma(lp, arguments, True) -
+                     current_ma(point, arguments, True))
+        out.write("%-6s %9.3f %9.3f %10.3f %12s\n"
+                  % (point["name"], point["enter_ns"] / 1e3,
+                     point["exit_ns"] / 1e3, change_nc,
+                     "%.3f" % (change_nc / saving_ma / 1e3)
+                     if saving_ma > 0.0 else "never"))
+
+    if lp["work_ns"] == 0:
+        return
+    out.write("\nAverage current in mA at a load of LP busy\n")
+    out.write("%-6s" % "Point")
+    for load in LOADS:
+        out.write(" %8.0f%%" % (load * 100.0))
+    out.write("\n")
+    for point in points:
+        out.write("%-6s" % point["name"])
+        for load in LOADS:
+            value = average_ma(point, arguments, load * 1e9 / lp["work_ns"])
+            out.write(" %9s" % ("-" if value is None else "%.3f" % value))
+        out.write("\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("input", nargs="?", default="-",
+                        help="UART capture with 'gov curve' output, "
+                             "- for stdin")
+    parser.add_argument("--lp-active-ma", type=float, default=0.9,
+                        help="LP active base current in mA "
+                             "(default %(default)s)")
+    parser.add_argument("--lp-active-ma-mhz", type=float, default=0.047,
+                        help="LP active current per MHz in mA "
+                             "(default %(default)s)")
+    parser.add_argument("--lp-sleep-ma", type=float, default=0.5,
+                        help="LP Sleep base current in mA "
+                             "(default %(default)s)")
+    parser.add_argument("--lp-sleep-ma-mhz", type=float, default=0.01,
+                        help="LP Sleep current per MHz in mA "
+                             "(default %(default)s)")
+    parser.add_argument("--ulp-active-ma", type=float, default=0.6,
+                        help="ULP active base current in mA "
+                             "(default %(default)s)")
+    parser.add_argument("--ulp-active-ma-mhz", type=float, default=0.03,
+                        help="ULP active current per MHz in mA "
+                             "(default %(default)s)")
+    parser.add_argument("--ulp-sleep-ma", type=float, default=0.35,
+                        help="ULP Sleep base current in mA "
+                             "(default %(default)s)")
+    parser.add_argument("--ulp-sleep-ma-mhz", type=float, default=0.007,
+                        help="ULP Sleep current per MHz in mA "
+                             "(default %(default)s)")
+    arguments = parser.parse_args()
+
+    stream = sys.stdin if arguments.input == "-" else open(arguments.input)
+    points, missed = parse_curve(stream.read().splitlines())
+    if not points and not missed:
+        parser.error("no 'gov curve:' line in the input")
+
+    report(points, missed, arguments, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Estimates the average current of the PSoC 6 from the power state record.
+
+Run the 'power record' command on the debug UART and pass the output, for
+example
+
+    python3 tools/power_model.py capture.txt
+    python3 tools/power_model.py --record 0130030500...
+
+Every "power record:" line of the input is decoded; the layout is described
+at power_stats_record() in source/power_stats.c. The current of each state
+defaults to typical PSoC 62 figures at 3.3 V on the buck regulator with the
+CM4 at 100 MHz and the CM0+ asleep. They are only a starting point: take the
+figures of the actual operating point from the datasheet or a measurement.
+The rest of the kit (KitProg, LEDs, the 43012) is not included.
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+RECORD_VERSION = 1
+RECORD_LINE = re.compile(r"power record: ([0-9a-fA-F]+)")
+
+STATES = ("Active", "Sleep", "Deep Sleep")
+SOURCES = ("timer", "UART", "GPIO", "CapSense", "other")
+
+
+def decode_record(data):
+    """Returns (time_ms, entries, wakeups) of a binary record."""
+    if len(data) < 4:
+        raise ValueError("record too short")
+    version, size, states, sources = struct.unpack_from("<BBBB", data, 0)
+    if version != RECORD_VERSION:
+        raise ValueError("record version %u, expected %u"
+                         % (version, RECORD_VERSION))
+    if size != len(data) or size != 4 + 4 * (2 * states + sources):
+        raise ValueError("record of %u bytes does not match its header"
+                         % len(data))
+    if states != len(STATES) or sources != len(SOURCES):
+        raise ValueError("record has %u states and %u sources" % (states,
+                                                                  sources))
+
+    values = struct.unpack_from("<%uI" % (2 * states + sources), data, 4)
+    return (values[:states], values[states:2 * states],
+            values[2 * states:])
+
+
+def estimate(time_ms, entries, currents_ma, wakeup_us):
+    """Returns the average current in mA.
+
+    The Deep Sleep wakeup is counted as Deep Sleep time by the application,
+    as the SysPm callbacks only run once it is over. Each wakeup is charged
+    the Active current for wakeup_us instead.
+    """
+    total_ms = sum(time_ms)
+    if total_ms == 0:
+        return 0.0
+
+    charge = sum(ms * ma for ms, ma in zip(time_ms, currents_ma))
+    charge += (entries[2] * wakeup_us / 1000.0 *
+               (currents_ma[0] - currents_ma[2]))
+    return charge / total_ms
+
+
+def report(data, arguments, out):
+    time_ms, entries, wakeups = decode_record(data)
+    total_ms = sum(time_ms)
+    currents_ma = (arguments.active_ma, arguments.sleep_ma,
+                   arguments.deepsleep_ua / 1000.0)
+
+    out.write("%-10s %12s %7s %9s %10s\n"
+              % ("State", "time s", "share", "entries", "current"))
+    for name, ms, count, ma in zip(STATES, time_ms, entries, currents_ma):
+        share = 100.0 * ms / total_ms if total_ms else 0.0
+        out.write("%-10s %12.3f %6.1f%% %9u %7.3f mA\n"
+                  % (name, ms / 1000.0, share, count, ma))
+
+    total_wakeups = sum(wakeups)
+    out.write("Wakeups: %s\n" % ", ".join(
+        "%s %u" % (name, count) for name, count in zip(SOURCES, wakeups)))
+    if total_ms:
+        out.write("Wakeup rate: %.2f /s\n" % (total_wakeups * 1000.0 /
+                                             total_ms))
+
+    average_ma = estimate(time_ms, entries, currents_ma, arguments.wakeup_us)
+    out.write("Average current: %.4f mA" % average_ma)
+    if average_ma > 0.0:
+        out.write(", %.0f h from %.0f mAh" % (arguments.capacity_mah /
+                                              average_ma,
+                                              arguments.capacity_mah))
+    out.write("\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("input", nargs="?", default="-",
+                        help="UART capture with 'power record' output, "
+                             "- for stdin")
+    parser.add_argument("--record", help="hex record instead of an input")
+    parser.add_argument("--active-ma", type=float, default=5.6,
+                        help="Active current in mA (default %(default)s)")
+    parser.add_argument("--sleep-ma", type=float, default=1.5,
+                        help="Sleep current in mA (default %(default)s)")
+    parser.add_argument("--deepsleep-ua", type=float, default=7.0,
+                        help="Deep Sleep current in uA (default %(default)s)")
+    parser.add_argument("--wakeup-us", type=float, default=25.0,
+                        help="Deep Sleep wakeup time at the Active current "
+                             "in us (default %(default)s)")
+    parser.add_argument("--capacity-mah", type=float, default=1000.0,
+                        help="battery capacity for the run time estimate "
+                             "(default %(default)s)")
+    arguments = parser.parse_args()
+
+    if arguments.record is not None:
+        records = [arguments.record]
+    else:
+        stream = sys.stdin if arguments.input == "-" else open(arguments.input)
+        records = RECORD_LINE.findall(stream.read())
+        if not records:
+            parser.error("no 'power record:' line in the input")
+
+    for index, record in enumerate(records):
+        if index:
+            sys.stdout.write("\n")
+        try:
+            report(bytes.fromhex(record), arguments, sys.stdout)
+        except ValueError as error:
+            sys.stdout.write("bad record: %s\n" % error)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""Decodes the profile scopes exported on the SWO pin by a PROFILE_ITM build.
+
+Build the application with DEFINES=PROFILE_ITM, capture the SWO output with a
+trace probe at the PROFILE_ITM_BAUD rate (500000 by default) into a file of
+raw bytes, then run for example
+
+    python3 tools/profile_itm_decode.py swo.bin
+    python3 tools/profile_itm_decode.py --runs swo.bin
+
+Every closed scope is one 4-byte software packet on stimulus port
+PROFILE_ITM_PORT: the scope ID in the top byte and the cycles in the lower
+24 bits, saturated. The scope names are read from source/profile.c. Packets of
+other ports, synchronization and protocol packets are skipped. The table has
+the same columns as the 'profile' command.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+CYCLES_MAX = 0x00FFFFFF
+NAMES_SOURCE = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                            os.pardir, "source", "profile.c")
+
+
+def load_scope_names(path):
+    """Returns the scope names of profile_names[], in the order of the IDs."""
+    with open(path) as source_file:
+        source = source_file.read()
+
+    table = re.search(r"profile_names\[[^\]]*\]\s*=\s*\{(?P<body>[^}]*)\}",
+                      source)
+    if table is None:
+        raise ValueError("%s has no profile_names table" % path)
+
+    return re.findall(r'"([^"]*)"', table.group("body"))
+
+
+def itm_packets(data):
+    """Yields (port, value) of every software source packet of the stream."""
+    index = 0
+    while index < len(data):
+        header = data[index]
+        index += 1
+
+        if header == 0x00:
+            # Synchronization: zeros ended by 0x80
+            while index < len(data) and data[index] == 0x00:
+                index += 1
+            index += 1
+            continue
+
+        size = header & 0x03
+        if size == 0:
+            # Overflow, timestamp and extension packets: the header and each
+            # payload byte but the last have the continuation bit set
+            while header & 0x80 and index < len(data):
+                header = data[index]
+                index += 1
+            continue
+
+        length = 4 if size == 3 else size
+        payload = data[index:index + length]
+        index += length
+        if len(payload) < length:
+            break
+        if header & 0x04:
+            # Hardware source packet of the DWT, not a stimulus port
+            continue
+
+        yield header >> 3, int.from_bytes(payload, "little")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="raw SWO bytes")
+    parser.add_argument("--port", type=int, default=1,
+                        help="stimulus port, PROFILE_ITM_PORT (default 1)")
+    parser.add_argument("--runs", action="store_true",
+                        help="print every run before the table")
+    args = parser.parse_args()
+
+    names = load_scope_names(NAMES_SOURCE)
+    with open(args.capture, "rb") as capture_file:
+        data = capture_file.read()
+
+    stats = {}
+    for port, value in itm_packets(data):
+        if port != args.port:
+            continue
+        scope = value >> 24
+        cycles = value & CYCLES_MAX
+        name = names[scope] if scope < len(names) else "scope %d" % scope
+        if args.runs:
+            print("%-16s %10d%s" % (name, cycles,
+                                    "+" if cycles == CYCLES_MAX else ""))
+
+        entry = stats.setdefault(name, [0, cycles, cycles, 0])
+        entry[0] += 1
+        entry[1] = min(entry[1], cycles)
+        entry[2] = max(entry[2], cycles)
+        entry[3] += cycles
+
+    print("  scope                 count        min       mean        max")
+    for name, (count, low, high, total) in stats.items():
+        print("  %-16s %10d %10d %10d %10d" % (name, count, low,
+                                               total // count, high))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
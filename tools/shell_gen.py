@@ -0,0 +1,220 @@
+#!/usr/bin/env python3
+"""Generates the perfect hash command table of the debug UART shell.
+
+    python3 tools/shell_gen.py
+
+reads source/shell_commands.def and writes source/shell_commands.c and
+source/shell_commands.h.
+
+    python3 tools/shell_gen.py --check
+
+only compares the two files with what it would write and fails if they are
+out of date. The PREBUILD step of the Makefile and "make -C host test" run
+it. The generated files stay in the repository, so that tools which compile
+the sources without running PREBUILD still find them.
+
+The table has a power-of-two size and a seed chosen
+so that every command name hashes to its own slot. A lookup on the device is
+then one hash of the command word and one compare against the single
+candidate, whatever the number of commands. The hash must match shell_hash()
+and the slot shell_lookup() in source/shell.c.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+SHELL_COMMAND = re.compile(
+    r'^\s*SHELL_COMMAND\(\s*(?P<name>[A-Za-z0-9_-]+)\s*,\s*'
+    r'(?P<handler>[A-Za-z_][A-Za-z0-9_]*)\s*,\s*"(?P<help>(?:[^"\\]|\\.)*)"\s*\)',
+    re.MULTILINE)
+
+FNV_BASIS = 2166136261
+FNV_PRIME = 16777619
+
+# Seeds tried per table size before the table is doubled
+SEED_LIMIT = 100000
+
+REPO_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+
+def shell_hash(seed, name):
+    """Seeded 32-bit FNV-1a, same as shell_hash() in source/shell.h."""
+    value = FNV_BASIS ^ seed
+    for byte in name.encode():
+        value ^= byte
+        value = (value * FNV_PRIME) & 0xFFFFFFFF
+    return value
+
+
+def shell_slot(seed, bits, name):
+    """Table slot of a name. The top bits are used: the low bits of FNV-1a
+    only depend on the low bits of the seed."""
+    return shell_hash(seed, name) >> (32 - bits)
+
+
+def find_perfect_hash(names):
+    """Returns (bits, seed) of the smallest collision-free table."""
+    bits = 1
+    while (1 << bits) < len(names):
+        bits += 1
+
+    while True:
+        for seed in range(SEED_LIMIT):
+            slots = {shell_slot(seed, bits, name) for name in names}
+            if len(slots) == len(names):
+                return bits, seed
+        bits += 1
+
+
+def header(file_name, description):
+    """Returns the file header of the repository for a generated file."""
+    with open(os.path.join(REPO_DIR, "source", "shell.h")) as source:
+        text = source.read()
+    copyright_start = text.index("*******************************************************************************\n* Copyright")
+    copyright_end = text.index("*/", copyright_start) + 2
+    lines = ["/" + "*" * 78,
+             "* File Name:   " + file_name,
+             "*"]
+    lines += description
+    lines += ["*", "* Related Document: See README.md", "*", "*"]
+    return "\n".join(lines) + "\n" + text[copyright_start:copyright_end] + "\n"
+
+
+def generate_header(commands, bits, seed):
+    out = [header("shell_commands.h",
+                  ["* Description: This file is generated by tools/shell_gen.py "
+                   "from",
+                   "*              shell_commands.def. Do not edit."])]
+    out.append("""
+#ifndef SHELL_COMMANDS_H
+#define SHELL_COMMANDS_H
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Perfect hash of the command names: slot = shell_hash() >> shift */
+#define SHELL_HASH_SEED             (0x%08XUL)
+#define SHELL_HASH_SHIFT            (%uU)
+#define SHELL_TABLE_SIZE            (%uU)
+#define SHELL_COMMAND_COUNT         (%uU)
+
+
+/*******************************************************************************
+* Function Prototypes
+*******************************************************************************/
+""" % (seed, 32 - bits, 1 << bits, len(commands)))
+    for _, handler, _ in commands:
+        out.append("int %s(int argc, char *argv[]);\n" % handler)
+    out.append("""
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* SHELL_COMMANDS_H */
+
+/* [] END OF FILE */
+""")
+    return "".join(out)
+
+
+def generate_source(commands, bits, seed):
+    slots = [None] * (1 << bits)
+    for command in commands:
+        slots[shell_slot(seed, bits, command[0])] = command
+
+    out = [header("shell_commands.c",
+                  ["* Description: This file is generated by tools/shell_gen.py "
+                   "from",
+                   "*              shell_commands.def. Do not edit."])]
+    out.append("""
+#include "shell.h"
+
+
+/*******************************************************************************
+* Global Variables
+*******************************************************************************/
+/* Commands by hash slot, empty slots are zero and have a length of 0 */
+const shell_command_t shell_command_table[SHELL_TABLE_SIZE] =
+{
+""")
+    for slot, entry in enumerate(slots):
+        if entry is not None:
+            name, handler, help_text = entry
+            out.append('    [%u] =\n    {\n        "%s", %uU, %s,\n'
+                       '        "%s"\n    },\n'
+                       % (slot, name, len(name), handler, help_text))
+    out.append("""};
+
+/* Slots in the order of shell_commands.def, for the help listing */
+const uint8_t shell_command_order[SHELL_COMMAND_COUNT] =
+{
+""")
+    order = [shell_slot(seed, bits, name) for name, _, _ in commands]
+    out.append("    " + ", ".join("%uU" % slot for slot in order) + "\n")
+    out.append("""};
+
+/* [] END OF FILE */
+""")
+    return "".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--source-dir", default=os.path.join(REPO_DIR, "source"),
+                        help="directory of shell_commands.def and the output")
+    parser.add_argument("--check", action="store_true",
+                        help="fail if the generated files are out of date "
+                             "instead of writing them")
+    args = parser.parse_args()
+
+    with open(os.path.join(args.source_dir, "shell_commands.def")) as def_file:
+        commands = [(match.group("name"), match.group("handler"),
+                     match.group("help"))
+                    for match in SHELL_COMMAND.finditer(def_file.read())]
+
+    names = [name for name, _, _ in commands]
+    if not names:
+        sys.exit("shell_commands.def has no SHELL_COMMAND() entries")
+    if len(set(names)) != len(names):
+        sys.exit("shell_commands.def has duplicate command names")
+    if len(names) > 255:
+        sys.exit("shell_commands.def has more than 255 commands")
+
+    bits, seed = find_perfect_hash(names)
+    outputs = [("shell_commands.h", generate_header(commands, bits, seed)),
+               ("shell_commands.c", generate_source(commands, bits, seed))]
+
+    if args.check:
+        stale = []
+        for file_name, text in outputs:
+            try:
+                with open(os.path.join(args.source_dir, file_name),
+                          newline="") as current:
+                    if current.read() != text:
+                        stale.append(file_name)
+            except FileNotFoundError:
+                stale.append(file_name)
+        if stale:
+            sys.exit("%s out of date with shell_commands.def, run "
+                     "python3 tools/shell_gen.py" % " and ".join(stale))
+        return
+
+    for file_name, text in outputs:
+        with open(os.path.join(args.source_dir, file_name), "w",
+                  newline="\n") as out:
+            out.write(text)
+
+    print("%u commands, table of %u slots, seed 0x%08X"
+          % (len(commands), 1 << bits, seed))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""Turns the merged trace of both cores into a timeline.
+
+Run the 'trace dump' command on the debug UART and pass the output, for
+example
+
+    python3 tools/trace_view.py capture.txt -o trace.json
+
+and open trace.json in https://ui.perfetto.dev or chrome://tracing. Each core
+is a thread of the timeline; the spans of TRACE_BEGIN()/TRACE_END() nest on
+it and TRACE_MARK() events are instants. The last dump of the input is used;
+the line format is described at trace_dump() in source/trace.c. A summary of
+the spans is printed, with the time in microseconds.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+HZ_LINE = re.compile(r"trace: hz (\d+)")
+RECORD_LINE = re.compile(r"trace: (\d+) (\w+) ([BEI?]) (\S+) (\d+)")
+LOST_LINE = re.compile(r"trace: lost (\w+) (\d+)")
+
+CORES = ("cm4", "cm0p")
+
+
+def parse_dump(lines):
+    """Returns (hz, records, lost) of the last dump in the lines.
+
+    records is a list of (ticks, core, type, name, arg), lost maps the cores
+    to the records they overwrote before the dump read them.
+    """
+    hz = None
+    records = []
+    lost = {}
+
+    for line in lines:
+        match = HZ_LINE.search(line)
+        if match:
+            hz = int(match.group(1))
+            records = []
+            lost = {}
+            continue
+        match = RECORD_LINE.search(line)
+        if match and hz is not None:
+            records.append((int(match.group(1)), match.group(2),
+                            match.group(3), match.group(4),
+                            int(match.group(5))))
+            continue
+        match = LOST_LINE.search(line)
+        if match and hz is not None:
+            lost[match.group(1)] = int(match.group(2))
+
+    if hz is None:
+        raise ValueError("no 'trace: hz' line in the input")
+    if hz == 0:
+        raise ValueError("the timebase was not running")
+    return hz, records, lost
+
+
+def check_order(records):
+    """Returns the number of records earlier than the one before them."""
+    return sum(1 for before, after in zip(records, records[1:])
+               if after[0] < before[0])
+
+
+def timeline(hz, records):
+    """Returns the events of the Chrome trace event format."""
+    cores = list(CORES) + sorted({record[1] for record in records} -
+                                 set(CORES))
+    events = [{"name": "thread_name", "ph": "M", "pid": 0,
+               "tid": index, "args": {"name": core}}
+              for index, core in enumerate(cores)]
+
+    for ticks, core, kind, name, arg in records:
+        event = {"name": name, "pid": 0, "tid": cores.index(core),
+                 "ts": ticks * 1e6 / hz, "args": {"arg": arg}}
+        if kind == "B":
+            event["ph"] = "B"
+        elif kind == "E":
+            event["ph"] = "E"
+        else:
+            event["ph"] = "i"
+            event["s"] = "t"
+        events.append(event)
+
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def spans(records):
+    """Returns {(core, name): [durations in ticks]} of the complete spans.
+
+    An end closes the innermost open span of its core. Ends without a begin,
+    from before the oldest record, are skipped, as are spans still open.
+    """
+    open_spans = {}
+    durations = {}
+
+    for ticks, core, kind, name, _ in records:
+        stack = open_spans.setdefault(core, [])
+        if kind == "B":
+            stack.append((name, ticks))
+        elif kind == "E" and stack:
+            begin_name, begin = stack.pop()
+            durations.setdefault((core, begin_name), []).append(ticks - begin)
+
+    return durations
+
+
+def report(hz, records, lost, out):
+    out.write("%u records at %u Hz" % (len(records), hz))
+    if records:
+        out.write(", %.3f ms" % ((records[-1][0] - records[0][0]) *
+                                 1e3 / hz))
+    out.write("\n")
+
+    for core, count in sorted(lost.items()):
+        out.write("%s lost %u records\n" % (core, count))
+    disorder = check_order(records)
+    if disorder:
+        out.write("%u records out of time order\n" % disorder)
+
+    durations = spans(records)
+    if durations:
+        out.write("%-6s %-16s %7s %10s %10s %10s\n"
+                  % ("Core", "Span", "count", "min us", "avg us", "max us"))
+    for (core, name), ticks in sorted(durations.items()):
+        out.write("%-6s %-16s %7u %10.3f %10.3f %10.3f\n"
+                  % (core, name, len(ticks), min(ticks) * 1e6 / hz,
+                     sum(ticks) * 1e6 / hz / len(ticks),
+                     max(ticks) * 1e6 / hz))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("input", nargs="?", default="-",
+                        help="UART capture with 'trace dump' output, "
+                             "- for stdin")
+    parser.add_argument("-o", "--output",
+                        help="Chrome trace event file to write")
+    arguments = parser.parse_args()
+
+    stream = sys.stdin if arguments.input == "-" else open(arguments.input)
+    try:
+        hz, records, lost = parse_dump(stream.read().splitlines())
+    except ValueError as error:
+        parser.error(str(error))
+
+    report(hz, records, lost, sys.stdout)
+
+    if arguments.output is not None:
+        with open(arguments.output, "w") as output:
+            json.dump(timeline(hz, records), output)
+
+
+if __name__ == "__main__":
+    main()